@@ -102,3 +102,8 @@ bool CoreArgParser::singleInstanceOnly() const
 {
   return m_singleInstance;
 }
+
+QString CoreArgParser::compileConfigFile() const
+{
+  return m_parser.value(CoreArgs::compileConfigOption);
+}
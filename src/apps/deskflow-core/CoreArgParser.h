@@ -34,6 +34,7 @@ public:
   bool serverMode() const;
   bool clientMode() const;
   bool singleInstanceOnly() const;
+  QString compileConfigFile() const;
 
 private:
   [[noreturn]] void showHelpText() const;
@@ -19,6 +19,11 @@ struct CoreArgs
       QCommandLineOption("new-instance", "Skip the check for a running instance, always makes a new instance");
   inline static const auto configOption =
       QCommandLineOption({"s", "settings"}, "override configuration file to use", "configFile");
+  inline static const auto compileConfigOption = QCommandLineOption(
+      "compile-config", "Write the server configuration in compiled form to file and exit", "file"
+  );
 
-  inline static const auto options = {helpOption, versionOption, multiInstanceOption, configOption};
+  inline static const auto options = {
+      helpOption, versionOption, multiInstanceOption, configOption, compileConfigOption
+  };
 };
@@ -13,6 +13,7 @@
 #include "base/Log.h"
 #include "common/Constants.h"
 #include "common/ExitCodes.h"
+#include "common/Settings.h"
 #include "deskflow/ClientApp.h"
 #include "deskflow/ServerApp.h"
 #include "deskflow/ipc/CoreIpcServer.h"
@@ -99,6 +100,16 @@ int main(int argc, char **argv)
     return s_exitSuccess;
   }
 
+  // Compiling a config is a one shot job, so it may run beside a running instance
+  if (const auto compiledFile = parser.compileConfigFile(); !compiledFile.isEmpty()) {
+    parser.parse();
+    if (!parser.serverMode()) {
+      LOG_ERR("only a server configuration can be compiled");
+      return s_exitArgs;
+    }
+    return ServerApp::compileConfig(Settings::serverConfigFile(), compiledFile) ? s_exitSuccess : s_exitConfig;
+  }
+
   // Before we check any more args we need to check for a duplicate process.
   // Create a shared memory segment with a unique key
   // This is to prevent a new instance from running if one is already running
@@ -125,6 +136,9 @@ int main(int argc, char **argv)
   QObject::connect(
       ipcServer, &deskflow::core::ipc::IpcServer::stopProcessRequested, coreApp, &App::quit, Qt::DirectConnection
   );
+  QObject::connect(ipcServer, &deskflow::core::ipc::CoreIpcServer::reloadRequested, [&events] {
+    events.addEvent(Event(EventTypes::ServerAppReloadConfig, events.getSystemTarget()));
+  });
   ipcServer->listen();
 
   QThread coreThread;
@@ -0,0 +1,97 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "BaseBenchmarks.h"
+
+#include "base/EventQueue.h"
+#include "base/Unicode.h"
+
+#include <string>
+
+namespace {
+
+// events per loop, about what a fast mouse makes in a second
+const int kEvents = 1000;
+
+// about the size of a large text selection
+const size_t kTextSize = 64 * 1024;
+
+std::string makeText(const std::string &pattern)
+{
+  std::string text;
+  text.reserve(kTextSize + pattern.size());
+  while (text.size() < kTextSize) {
+    text += pattern;
+  }
+  return text;
+}
+
+void addTexts()
+{
+  QTest::addColumn<std::string>("text");
+
+  QTest::newRow("ascii") << makeText("The quick brown fox jumps over the lazy dog.\n");
+  // two, three and four byte sequences, spelled out for any source charset
+  QTest::newRow("mixed") << makeText(
+      "Gr\xc3\xbc\xc3\x9f \xd0\xbf\xd1\x80\xd0\xb8 "
+      "\xe3\x81\x93\xe3\x82\x93 \xf0\x9f\x91\x8b\n"
+  );
+}
+
+} // namespace
+
+void BaseBenchmarks::eventQueue_dispatch()
+{
+  EventQueue events;
+  int dispatched = 0;
+  events.addHandler(EventTypes::StreamInputReady, this, [&dispatched](const auto &) { ++dispatched; });
+
+  QBENCHMARK {
+    for (int i = 0; i < kEvents; ++i) {
+      events.addEvent(Event(EventTypes::StreamInputReady, this));
+    }
+    events.addEvent(Event(EventTypes::Quit));
+    events.loop();
+  }
+
+  events.removeHandler(EventTypes::StreamInputReady, this);
+  QCOMPARE(dispatched % kEvents, 0);
+}
+
+void BaseBenchmarks::unicode_utf8ToUtf16_data()
+{
+  addTexts();
+}
+
+void BaseBenchmarks::unicode_utf8ToUtf16()
+{
+  QFETCH(std::string, text);
+
+  std::string result;
+  QBENCHMARK {
+    result = Unicode::UTF8ToUTF16(text);
+  }
+
+  QVERIFY(!result.empty());
+}
+
+void BaseBenchmarks::unicode_utf16ToUtf8_data()
+{
+  addTexts();
+}
+
+void BaseBenchmarks::unicode_utf16ToUtf8()
+{
+  QFETCH(std::string, text);
+
+  const auto utf16 = Unicode::UTF8ToUTF16(text);
+  std::string result;
+  QBENCHMARK {
+    result = Unicode::UTF16ToUTF8(utf16);
+  }
+
+  QCOMPARE(result, text);
+}
@@ -0,0 +1,20 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <QTest>
+
+class BaseBenchmarks : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void eventQueue_dispatch();
+  void unicode_utf8ToUtf16_data();
+  void unicode_utf8ToUtf16();
+  void unicode_utf16ToUtf8_data();
+  void unicode_utf16ToUtf8();
+};
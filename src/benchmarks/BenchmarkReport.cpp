@@ -0,0 +1,124 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "BenchmarkReport.h"
+
+#include "common/VersionInfo.h"
+
+#include <QFile>
+#include <QHash>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QSysInfo>
+#include <QTextStream>
+#include <QXmlStreamReader>
+
+bool BenchmarkReport::addQtTestLog(const QString &path)
+{
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  QXmlStreamReader xml(&file);
+  QString suite;
+  QString function;
+  while (!xml.atEnd()) {
+    if (xml.readNext() != QXmlStreamReader::StartElement) {
+      continue;
+    }
+
+    const auto attributes = xml.attributes();
+    if (xml.name() == QLatin1String("TestCase")) {
+      suite = attributes.value(QLatin1String("name")).toString();
+    } else if (xml.name() == QLatin1String("TestFunction")) {
+      function = attributes.value(QLatin1String("name")).toString();
+    } else if (xml.name() == QLatin1String("BenchmarkResult")) {
+      m_results.append(QJsonObject{
+          {QStringLiteral("suite"), suite},
+          {QStringLiteral("function"), function},
+          {QStringLiteral("tag"), attributes.value(QLatin1String("tag")).toString()},
+          {QStringLiteral("metric"), attributes.value(QLatin1String("metric")).toString()},
+          {QStringLiteral("value"), attributes.value(QLatin1String("value")).toDouble()},
+          {QStringLiteral("iterations"), attributes.value(QLatin1String("iterations")).toInt()}
+      });
+    }
+  }
+  return !xml.hasError();
+}
+
+bool BenchmarkReport::load(const QString &path)
+{
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  const auto report = QJsonDocument::fromJson(file.readAll()).object();
+  if (report.value(QStringLiteral("format")).toInt() != kFormatVersion) {
+    return false;
+  }
+  m_results = report.value(QStringLiteral("results")).toArray();
+  return true;
+}
+
+bool BenchmarkReport::save(const QString &path) const
+{
+  const QJsonObject report{
+      {QStringLiteral("format"), kFormatVersion},
+      {QStringLiteral("version"), QString::fromLatin1(kDisplayVersion)},
+      {QStringLiteral("qt"), QString::fromLatin1(qVersion())},
+      {QStringLiteral("os"), QSysInfo::prettyProductName()},
+      {QStringLiteral("cpu"), QSysInfo::currentCpuArchitecture()},
+      {QStringLiteral("results"), m_results}
+  };
+
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly)) {
+    return false;
+  }
+  file.write(QJsonDocument(report).toJson());
+  return file.commit();
+}
+
+int BenchmarkReport::compare(const BenchmarkReport &baseline, double threshold, QTextStream &out) const
+{
+  QHash<QString, double> baselineValues;
+  for (const auto &result : baseline.m_results) {
+    baselineValues.insert(keyOf(result.toObject()), result.toObject().value(QStringLiteral("value")).toDouble());
+  }
+
+  int regressions = 0;
+  for (const auto &result : m_results) {
+    const auto key = keyOf(result.toObject());
+    const auto value = result.toObject().value(QStringLiteral("value")).toDouble();
+    const auto it = baselineValues.constFind(key);
+    if (it == baselineValues.constEnd() || *it <= 0.0) {
+      out << key << ": " << value << " (new)\n";
+      continue;
+    }
+
+    const auto change = (value - *it) * 100.0 / *it;
+    const bool regressed = change > threshold;
+    out << key << ": " << *it << " -> " << value << " (" << (change >= 0.0 ? "+" : "")
+        << QString::number(change, 'f', 1) << "%)" << (regressed ? " REGRESSION" : "") << "\n";
+    if (regressed) {
+      ++regressions;
+    }
+  }
+  return regressions;
+}
+
+QString BenchmarkReport::keyOf(const QJsonObject &result)
+{
+  auto key = QStringLiteral("%1::%2").arg(
+      result.value(QStringLiteral("suite")).toString(), result.value(QStringLiteral("function")).toString()
+  );
+  if (const auto tag = result.value(QStringLiteral("tag")).toString(); !tag.isEmpty()) {
+    key += QStringLiteral("(%1)").arg(tag);
+  }
+  return QStringLiteral("%1 [%2]").arg(key, result.value(QStringLiteral("metric")).toString());
+}
@@ -0,0 +1,81 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+
+class QTextStream;
+
+//! Machine readable benchmark results
+/*!
+Collects the results QtTest logs for each benchmark and writes them as
+JSON, one object per result:
+
+\code
+{"suite": "IoBenchmarks", "function": "streamBuffer_writeRead", "tag": "64 bytes",
+ "metric": "WalltimeMilliseconds", "value": 0.0213, "iterations": 4096}
+\endcode
+
+\c value is per iteration, in the unit of \c metric.  Two reports can be
+compared to find results that got worse.
+*/
+class BenchmarkReport
+{
+public:
+  //! Version of the JSON written
+  static constexpr int kFormatVersion = 1;
+
+  //! @name manipulators
+  //@{
+
+  //! Add results from a QtTest XML log
+  /*!
+  Reads the benchmark results in the log at \p path, as written by
+  QtTest's \c -o path,xml option.  Returns false if the log can't be read.
+  */
+  bool addQtTestLog(const QString &path);
+
+  //! Load a report
+  /*!
+  Reads a report written by save().  Returns false if \p path isn't one.
+  */
+  bool load(const QString &path);
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Save the report
+  /*!
+  Writes the results as JSON to \p path.  Returns false on failure.
+  */
+  bool save(const QString &path) const;
+
+  //! Compare to an earlier report
+  /*!
+  Writes a line to \p out for each result in both reports with its
+  change from \p baseline.  Lower is better for every QtTest metric, so
+  a result more than \p threshold percent higher than in \p baseline is
+  marked as a regression.  Returns the number of regressions.
+  */
+  int compare(const BenchmarkReport &baseline, double threshold, QTextStream &out) const;
+
+  //! Get the number of results
+  qsizetype size() const
+  {
+    return m_results.size();
+  }
+
+  //@}
+
+private:
+  static QString keyOf(const QJsonObject &result);
+
+  QJsonArray m_results;
+};
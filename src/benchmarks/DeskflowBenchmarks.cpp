@@ -0,0 +1,521 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "DeskflowBenchmarks.h"
+
+#include "base/EventQueue.h"
+#include "deskflow/Clipboard.h"
+#include "deskflow/ChunkPool.h"
+#include "deskflow/ClipboardBuffer.h"
+#include "deskflow/ClipboardChunk.h"
+#include "deskflow/PacketStreamFilter.h"
+#include "deskflow/ProtocolTypes.h"
+#include "deskflow/ProtocolUtil.h"
+#include "deskflow/StreamChunker.h"
+#include "io/MemoryStream.h"
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef Q_OS_WIN
+#include <Windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using deskflow::KeyMap;
+
+namespace {
+
+// messages per iteration, alternating mouse moves and key presses
+const int kMessages = 1000;
+
+// a large copy, sent in chunks of the size the server uses
+const size_t kClipboardSize = 4 * 1024 * 1024;
+const size_t kClipboardChunkSize = 512 * 1024;
+
+// a copy far larger than the chunk pool holds
+const size_t kLargeClipboardSize = 256 * 1024 * 1024;
+
+const char *const kTypedText = "The quick brown fox jumps over the lazy dog.  PACK MY BOX WITH FIVE DOZEN JUGS!";
+
+std::vector<uint8_t> encodeMessages()
+{
+  std::vector<uint8_t> buffer;
+  for (int i = 0; i < kMessages; ++i) {
+    if (i % 2 == 0) {
+      ProtocolUtil::appendf(buffer, kMsgDMouseMove, i % 3840, i % 2160);
+    } else {
+      ProtocolUtil::appendf(buffer, kMsgDKeyDown, 'a' + i % 26, 0, 38 + i % 26);
+    }
+  }
+  return buffer;
+}
+
+// a burst of small moves, like a mouse polled at a high rate, with
+// either the fixed or the compact message
+std::vector<uint8_t> encodeMoves(bool compact)
+{
+  std::vector<uint8_t> buffer;
+  for (int i = 0; i < kMessages; ++i) {
+    const int32_t dx = (i % 7) - 3;
+    const int32_t dy = (i % 5) - 2;
+    ProtocolUtil::appendf(buffer, compact ? kMsgDMouseRelMoveCompact : kMsgDMouseRelMove, dx, dy);
+  }
+  return buffer;
+}
+
+void addMoveEncodings()
+{
+  QTest::addColumn<bool>("compact");
+
+  QTest::newRow("fixed") << false;
+  QTest::newRow("compact") << true;
+}
+
+std::string makeClipboardText(size_t size = kClipboardSize)
+{
+  std::string text;
+  text.reserve(size);
+  while (text.size() < size) {
+    text += kTypedText;
+    text += '\n';
+  }
+  text.resize(size);
+  return text;
+}
+
+// text as the server shares it with its clients, without the hash that
+// only resumable transfers need
+std::shared_ptr<const Clipboard::Snapshot> makeClipboardSnapshot(size_t size = kClipboardSize)
+{
+  auto snapshot = std::make_shared<Clipboard::Snapshot>();
+  snapshot->m_data = makeClipboardText(size);
+  return snapshot;
+}
+
+// chunks the text and sends the chunks as the server does, returns the
+// number of chunks sent
+int sendClipboard(EventQueue &events, const std::shared_ptr<const Clipboard::Snapshot> &snapshot)
+{
+  deskflow::MemoryStream stream({});
+  StreamChunker chunker(&events, nullptr);
+  chunker.sendClipboard(snapshot, kClipboardClipboard, 1);
+
+  int sent = 0;
+  Event event;
+  while (events.getEvent(event, 0.0)) {
+    ClipboardChunk::send(&stream, event.getDataObject());
+    Event::deleteData(event);
+    chunker.sent();
+    ++sent;
+  }
+  return sent;
+}
+
+// the most memory the process has had resident, in bytes
+qreal peakResidentBytes()
+{
+#ifdef Q_OS_WIN
+  PROCESS_MEMORY_COUNTERS counters{};
+  GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+  return static_cast<qreal>(counters.PeakWorkingSetSize);
+#else
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef Q_OS_MACOS
+  return static_cast<qreal>(usage.ru_maxrss);
+#else
+  return static_cast<qreal>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+// a US layout on the first group and cyrillic letters on the second,
+// with about as many ids as a real keyboard map
+void addKeys(KeyMap &keyMap)
+{
+  const struct
+  {
+    KeyID id;
+    KeyButton button;
+    KeyModifierMask mask;
+  } modifiers[] = {
+      {kKeyShift_L, 50, KeyModifierShift},     {kKeyControl_L, 37, KeyModifierControl},
+      {kKeyAlt_L, 64, KeyModifierAlt},         {kKeyAltGr, 108, KeyModifierAltGr},
+      {kKeyCapsLock, 66, KeyModifierCapsLock},
+  };
+
+  KeyMap::KeyItem item;
+  for (int32_t group = 0; group < 2; ++group) {
+    item.m_group = group;
+    for (const auto &modifier : modifiers) {
+      item.m_id = modifier.id;
+      item.m_button = modifier.button;
+      item.m_generates = modifier.mask;
+      item.m_lock = modifier.mask == KeyModifierCapsLock;
+      keyMap.addKeyEntry(item);
+    }
+    item.m_generates = 0;
+    item.m_lock = false;
+
+    for (KeyID id = 0x20; id < 0x7f; ++id) {
+      const bool upper = id >= 'A' && id <= 'Z';
+      item.m_id = group == 0 ? id : id + 0x3e0;
+      item.m_button = static_cast<KeyButton>(10 + id % 48);
+      item.m_required = upper ? KeyModifierShift : 0;
+      item.m_sensitive = KeyModifierShift | KeyModifierCapsLock;
+      keyMap.addKeyEntry(item);
+    }
+    for (KeyID id = 0xa0; id < 0x600; ++id) {
+      item.m_id = id + group * 0x1000;
+      item.m_button = static_cast<KeyButton>(10 + id % 60);
+      item.m_required = KeyModifierAltGr;
+      item.m_sensitive = KeyModifierShift | KeyModifierAltGr;
+      keyMap.addKeyEntry(item);
+    }
+    for (KeyID id = 0xef00; id < 0xf000; ++id) {
+      item.m_id = id;
+      item.m_button = static_cast<KeyButton>(100 + id % 100);
+      item.m_required = 0;
+      item.m_sensitive = 0;
+      keyMap.addKeyEntry(item);
+    }
+  }
+  keyMap.finish();
+}
+
+} // namespace
+
+void DeskflowBenchmarks::initTestCase()
+{
+  addKeys(m_keyMap);
+}
+
+void DeskflowBenchmarks::protocolUtil_writef()
+{
+  deskflow::MemoryStream stream({});
+  QBENCHMARK {
+    for (int i = 0; i < kMessages; ++i) {
+      if (i % 2 == 0) {
+        ProtocolUtil::writef(&stream, kMsgDMouseMove, i % 3840, i % 2160);
+      } else {
+        ProtocolUtil::writef(&stream, kMsgDKeyDown, 'a' + i % 26, 0, 38 + i % 26);
+      }
+    }
+  }
+}
+
+void DeskflowBenchmarks::protocolUtil_readf()
+{
+  const auto buffer = encodeMessages();
+  const std::string data(buffer.begin(), buffer.end());
+
+  int32_t sum = 0;
+  QBENCHMARK {
+    deskflow::MemoryStream stream(data);
+    uint8_t code[4];
+    while (stream.read(code, 4) == 4) {
+      int16_t x = 0;
+      int16_t y = 0;
+      if (std::memcmp(code, kMsgDMouseMove, 4) == 0) {
+        ProtocolUtil::readf(&stream, kMsgDMouseMove + 4, &x, &y);
+      } else {
+        uint16_t id = 0;
+        uint16_t mask = 0;
+        uint16_t button = 0;
+        ProtocolUtil::readf(&stream, kMsgDKeyDown + 4, &id, &mask, &button);
+        x = static_cast<int16_t>(id);
+      }
+      sum += x + y;
+    }
+  }
+
+  QVERIFY(sum != 0);
+}
+
+void DeskflowBenchmarks::protocolUtil_encodeMoves_data()
+{
+  addMoveEncodings();
+}
+
+void DeskflowBenchmarks::protocolUtil_encodeMoves()
+{
+  QFETCH(bool, compact);
+
+  std::vector<uint8_t> buffer;
+  QBENCHMARK {
+    buffer = encodeMoves(compact);
+  }
+
+  QVERIFY(!buffer.empty());
+}
+
+void DeskflowBenchmarks::protocolUtil_decodeMoves_data()
+{
+  addMoveEncodings();
+}
+
+void DeskflowBenchmarks::protocolUtil_decodeMoves()
+{
+  QFETCH(bool, compact);
+
+  const auto buffer = encodeMoves(compact);
+  const std::string data(buffer.begin(), buffer.end());
+  const char *format = (compact ? kMsgDMouseRelMoveCompact : kMsgDMouseRelMove) + 4;
+
+  int32_t sum = 0;
+  QBENCHMARK {
+    deskflow::MemoryStream stream(data);
+    uint8_t code[4];
+    while (stream.read(code, 4) == 4) {
+      int32_t dx = 0;
+      int32_t dy = 0;
+      if (compact) {
+        ProtocolUtil::readf(&stream, format, &dx, &dy);
+      } else {
+        int16_t x = 0;
+        int16_t y = 0;
+        ProtocolUtil::readf(&stream, format, &x, &y);
+        dx = x;
+        dy = y;
+      }
+      sum += dx + dy;
+    }
+  }
+
+  QVERIFY(sum != std::numeric_limits<int32_t>::min());
+}
+
+void DeskflowBenchmarks::protocolUtil_moveBytes_data()
+{
+  addMoveEncodings();
+}
+
+void DeskflowBenchmarks::protocolUtil_moveBytes()
+{
+  QFETCH(bool, compact);
+
+  // bytes on the wire for the burst, there's no metric for a plain size
+  QTest::setBenchmarkResult(static_cast<qreal>(encodeMoves(compact).size()), QTest::BytesAllocated);
+}
+
+void DeskflowBenchmarks::packetStreamFilter_read()
+{
+  // the messages as they arrive, each after its length
+  std::vector<uint8_t> packets;
+  for (int i = 0; i < kMessages; ++i) {
+    std::vector<uint8_t> message;
+    ProtocolUtil::appendf(message, kMsgDMouseMove, i % 3840, i % 2160);
+    ProtocolUtil::appendf(packets, "%4i", static_cast<uint32_t>(message.size()));
+    packets.insert(packets.end(), message.begin(), message.end());
+  }
+  const std::string data(packets.begin(), packets.end());
+
+  // a queue that's running, so the filter's events can be drained
+  EventQueue events;
+  events.addEvent(Event(EventTypes::Quit));
+  events.loop();
+
+  int read = 0;
+  QBENCHMARK {
+    deskflow::MemoryStream stream(data);
+    PacketStreamFilter filter(&events, &stream, false);
+    events.dispatchEvent(Event(EventTypes::StreamInputReady, stream.getEventTarget()));
+
+    uint8_t message[8];
+    while (filter.read(message, sizeof(message)) != 0) {
+      ++read;
+    }
+
+    Event event;
+    while (events.getEvent(event, 0.0)) {
+      Event::deleteData(event);
+    }
+  }
+
+  QCOMPARE(read % kMessages, 0);
+}
+
+void DeskflowBenchmarks::clipboard_marshall()
+{
+  Clipboard clipboard;
+  QVERIFY(clipboard.open(0));
+  clipboard.empty();
+  clipboard.add(IClipboard::Format::Text, makeClipboardText());
+  clipboard.add(IClipboard::Format::HTML, "<p>" + makeClipboardText() + "</p>");
+  clipboard.close();
+
+  std::string data;
+  QBENCHMARK {
+    data = clipboard.marshall();
+  }
+
+  QVERIFY(data.size() > 2 * kClipboardSize);
+}
+
+void DeskflowBenchmarks::clipboard_unmarshall()
+{
+  Clipboard source;
+  QVERIFY(source.open(0));
+  source.empty();
+  source.add(IClipboard::Format::Text, makeClipboardText());
+  source.add(IClipboard::Format::HTML, "<p>" + makeClipboardText() + "</p>");
+  source.close();
+  const auto data = source.marshall();
+
+  Clipboard clipboard;
+  QBENCHMARK {
+    clipboard.unmarshall(data, 0);
+  }
+
+  QCOMPARE(clipboard.marshall(), data);
+}
+
+void DeskflowBenchmarks::clipboardChunk_assemble()
+{
+  // the chunks as they arrive, without the message code
+  const auto text = makeClipboardText();
+  const auto format = kMsgDClipboard + 4;
+  const uint32_t sequence = 1;
+  std::vector<uint8_t> chunks;
+  auto size = std::to_string(text.size());
+  ProtocolUtil::appendf(chunks, format, kClipboardClipboard, sequence, ChunkType::DataStart, &size);
+  for (size_t offset = 0; offset < text.size(); offset += kClipboardChunkSize) {
+    auto chunk = text.substr(offset, kClipboardChunkSize);
+    ProtocolUtil::appendf(chunks, format, kClipboardClipboard, sequence, ChunkType::DataChunk, &chunk);
+  }
+  std::string end;
+  ProtocolUtil::appendf(chunks, format, kClipboardClipboard, sequence, ChunkType::DataEnd, &end);
+  const std::string data(chunks.begin(), chunks.end());
+
+  ClipboardBuffer assembled;
+  QBENCHMARK {
+    deskflow::MemoryStream stream(data);
+    ClipboardChunkAssemblyState state;
+    ClipboardID id = 0;
+    uint32_t received = 0;
+    auto result = TransferState::Started;
+    while (result == TransferState::Started || result == TransferState::InProgress) {
+      result = ClipboardChunk::assemble(&stream, assembled, id, received, state, kClipboardSize);
+    }
+    QCOMPARE(result, TransferState::Finished);
+  }
+
+  QCOMPARE(assembled.view(), std::string_view(text));
+}
+
+void DeskflowBenchmarks::clipboardChunk_transferId()
+{
+  // hashed once per clipboard change, on the event thread
+  const auto text = makeClipboardText();
+  uint64_t transferId = 0;
+  QBENCHMARK {
+    transferId = ClipboardChunk::transferIdOf(text);
+  }
+  QVERIFY(transferId != 0);
+}
+
+void DeskflowBenchmarks::clipboardChunk_send_data()
+{
+  QTest::addColumn<size_t>("poolCapacity");
+  QTest::newRow("pooled") << ChunkPool::kDefaultCapacity;
+  QTest::newRow("unpooled") << size_t{0};
+}
+
+void DeskflowBenchmarks::clipboardChunk_send()
+{
+  QFETCH(size_t, poolCapacity);
+  const auto text = makeClipboardSnapshot();
+  EventQueue events;
+  events.addEvent(Event(EventTypes::Quit));
+  events.loop();
+  auto &pool = ChunkPool::instance();
+  pool.clear();
+  pool.setCapacity(poolCapacity);
+
+  int sent = 0;
+  QBENCHMARK {
+    sent = sendClipboard(events, text);
+  }
+
+  pool.setCapacity(ChunkPool::kDefaultCapacity);
+  QVERIFY(sent > static_cast<int>(kClipboardSize / kClipboardChunkSize));
+}
+
+void DeskflowBenchmarks::clipboardChunk_sendAllocations_data()
+{
+  clipboardChunk_send_data();
+}
+
+void DeskflowBenchmarks::clipboardChunk_sendAllocations()
+{
+  // buffers taken from the heap by a transfer, once the pool has filled; the
+  // copy is far larger than the pool so only chunks being written may be held
+  QFETCH(size_t, poolCapacity);
+  const auto text = makeClipboardSnapshot(kLargeClipboardSize);
+  EventQueue events;
+  events.addEvent(Event(EventTypes::Quit));
+  events.loop();
+  auto &pool = ChunkPool::instance();
+  pool.clear();
+  pool.setCapacity(poolCapacity);
+  sendClipboard(events, text);
+
+  const auto before = pool.stats().allocations;
+  sendClipboard(events, text);
+  const auto allocations = pool.stats().allocations - before;
+  pool.setCapacity(ChunkPool::kDefaultCapacity);
+
+  QTest::setBenchmarkResult(static_cast<qreal>(allocations), QTest::Events);
+  if (poolCapacity != 0) {
+    QCOMPARE(allocations, uint64_t{0});
+  }
+}
+
+void DeskflowBenchmarks::clipboardChunk_sendPeakRss()
+{
+  // how far sending a large copy raises the peak, beyond the copy itself
+  const auto text = makeClipboardSnapshot(kLargeClipboardSize);
+  EventQueue events;
+  events.addEvent(Event(EventTypes::Quit));
+  events.loop();
+  const auto before = peakResidentBytes();
+  sendClipboard(events, text);
+  const auto grown = peakResidentBytes() - before;
+
+  QTest::setBenchmarkResult(grown, QTest::BytesAllocated);
+  QVERIFY(grown < static_cast<qreal>(kLargeClipboardSize / 4));
+}
+
+void DeskflowBenchmarks::keyMap_mapKey()
+{
+  std::vector<KeyID> ids;
+  for (const char *c = kTypedText; *c != '\0'; ++c) {
+    ids.push_back(static_cast<KeyID>(*c));
+  }
+  ids.push_back(kKeyReturn);
+  ids.push_back(kKeyBackSpace);
+
+  size_t strokes = 0;
+  QBENCHMARK {
+    for (const auto id : ids) {
+      KeyMap::Keystrokes keys;
+      KeyMap::ModifierToKeys activeModifiers;
+      KeyModifierMask currentState = 0;
+      const KeyModifierMask desiredMask = id >= 'A' && id <= 'Z' ? KeyModifierShift : 0;
+      if (m_keyMap.mapKey(keys, id, 0, activeModifiers, currentState, desiredMask, false, "") != nullptr) {
+        strokes += keys.size();
+      }
+    }
+  }
+
+  QVERIFY(strokes != 0);
+}
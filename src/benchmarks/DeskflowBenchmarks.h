@@ -0,0 +1,40 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "deskflow/KeyMap.h"
+
+#include <QTest>
+
+class DeskflowBenchmarks : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void initTestCase();
+  void protocolUtil_writef();
+  void protocolUtil_readf();
+  void protocolUtil_encodeMoves_data();
+  void protocolUtil_encodeMoves();
+  void protocolUtil_decodeMoves_data();
+  void protocolUtil_decodeMoves();
+  void protocolUtil_moveBytes_data();
+  void protocolUtil_moveBytes();
+  void packetStreamFilter_read();
+  void clipboard_marshall();
+  void clipboard_unmarshall();
+  void clipboardChunk_assemble();
+  void clipboardChunk_transferId();
+  void clipboardChunk_send_data();
+  void clipboardChunk_send();
+  void clipboardChunk_sendAllocations_data();
+  void clipboardChunk_sendAllocations();
+  void clipboardChunk_sendPeakRss();
+  void keyMap_mapKey();
+
+private:
+  deskflow::KeyMap m_keyMap;
+};
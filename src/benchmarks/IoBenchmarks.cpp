@@ -0,0 +1,49 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "IoBenchmarks.h"
+
+#include "io/StreamBuffer.h"
+
+#include <vector>
+
+namespace {
+
+// bytes through the buffer per iteration
+const uint32_t kStreamBytes = 256 * 1024;
+
+} // namespace
+
+void IoBenchmarks::streamBuffer_writeRead_data()
+{
+  QTest::addColumn<uint32_t>("writeSize");
+  QTest::addColumn<uint32_t>("readSize");
+
+  // input events are written and read a message at a time, clipboard
+  // data arrives in socket sized reads and is read in chunks
+  QTest::newRow("messages") << uint32_t{16} << uint32_t{16};
+  QTest::newRow("socket reads") << uint32_t{4096} << uint32_t{512};
+}
+
+void IoBenchmarks::streamBuffer_writeRead()
+{
+  QFETCH(uint32_t, writeSize);
+  QFETCH(uint32_t, readSize);
+
+  const std::vector<char> written(writeSize, 'x');
+  std::vector<char> read(readSize);
+  StreamBuffer buffer;
+  QBENCHMARK {
+    for (uint32_t n = 0; n < kStreamBytes; n += writeSize) {
+      buffer.write(written.data(), writeSize);
+    }
+    while (buffer.read(read.data(), readSize) != 0) {
+      // drain
+    }
+  }
+
+  QCOMPARE(buffer.getSize(), uint32_t{0});
+}
@@ -0,0 +1,17 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <QTest>
+
+class IoBenchmarks : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void streamBuffer_writeRead_data();
+  void streamBuffer_writeRead();
+};
@@ -0,0 +1,124 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "ServerBenchmarks.h"
+
+#include "server/Config.h"
+#include "server/ConfigDiff.h"
+
+#include <sstream>
+
+using deskflow::server::Config;
+using deskflow::server::ConfigDiff;
+
+namespace {
+
+// a video wall of screens, each linked to the ones around it
+const int kWallColumns = 5;
+const int kWallRows = 4;
+
+std::string screenName(int column, int row)
+{
+  return "screen-" + std::to_string(row) + "-" + std::to_string(column);
+}
+
+Config makeWall()
+{
+  Config config(nullptr);
+  for (int row = 0; row < kWallRows; ++row) {
+    for (int column = 0; column < kWallColumns; ++column) {
+      config.addScreen(screenName(column, row));
+      config.addAlias(screenName(column, row), screenName(column, row) + ".lan");
+      config.addOption(screenName(column, row), kOptionHalfDuplexCapsLock, row % 2);
+    }
+  }
+
+  for (int row = 0; row < kWallRows; ++row) {
+    for (int column = 0; column < kWallColumns; ++column) {
+      const auto name = screenName(column, row);
+      if (column > 0) {
+        config.connect(name, Direction::Left, 0.0f, 1.0f, screenName(column - 1, row), 0.0f, 1.0f);
+      }
+      if (column + 1 < kWallColumns) {
+        config.connect(name, Direction::Right, 0.0f, 1.0f, screenName(column + 1, row), 0.0f, 1.0f);
+      }
+      if (row > 0) {
+        config.connect(name, Direction::Top, 0.0f, 1.0f, screenName(column, row - 1), 0.0f, 1.0f);
+      }
+      if (row + 1 < kWallRows) {
+        config.connect(name, Direction::Bottom, 0.0f, 1.0f, screenName(column, row + 1), 0.0f, 1.0f);
+      }
+    }
+  }
+
+  config.addOption("", kOptionHeartbeat, 5000);
+  config.addOption("", kOptionScreenSwitchDelay, 250);
+  return config;
+}
+
+std::string format(const Config &config)
+{
+  std::ostringstream stream;
+  stream << config;
+  return stream.str();
+}
+
+Config parse(const std::string &text)
+{
+  Config config(nullptr);
+  std::istringstream stream(text);
+  stream >> config;
+  return config;
+}
+
+} // namespace
+
+void ServerBenchmarks::initTestCase()
+{
+  auto wall = makeWall();
+  m_wall = format(wall);
+
+  // the edit of one link, as from the server config dialog
+  const auto name = screenName(2, 1);
+  wall.disconnect(name, Direction::Right);
+  wall.connect(name, Direction::Right, 0.0f, 0.5f, screenName(3, 1), 0.0f, 1.0f);
+  m_relinkedWall = format(wall);
+}
+
+void ServerBenchmarks::config_read()
+{
+  QBENCHMARK {
+    const auto config = parse(m_wall);
+    QVERIFY(config.isScreen(screenName(0, 0)));
+  }
+}
+
+void ServerBenchmarks::configDiff_oneLink()
+{
+  const auto oldConfig = parse(m_wall);
+  const auto newConfig = parse(m_relinkedWall);
+
+  QBENCHMARK {
+    const ConfigDiff diff(oldConfig, newConfig);
+    QCOMPARE(diff.relinkedScreens().size(), size_t{1});
+  }
+}
+
+void ServerBenchmarks::config_reload()
+{
+  // what the server does on reload, less what it sends to clients
+  auto live = parse(m_wall);
+  bool relinked = false;
+
+  QBENCHMARK {
+    relinked = !relinked;
+    const auto config = parse(relinked ? m_relinkedWall : m_wall);
+    const ConfigDiff diff(live, config);
+    live = config;
+    QVERIFY(diff.linksChanged());
+    QVERIFY(!diff.optionsChanged(screenName(0, 0)));
+  }
+}
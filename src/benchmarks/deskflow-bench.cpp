@@ -0,0 +1,169 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "BaseBenchmarks.h"
+#include "BenchmarkReport.h"
+#include "DeskflowBenchmarks.h"
+#include "IoBenchmarks.h"
+#include "ServerBenchmarks.h"
+
+#include "arch/Arch.h"
+#include "base/Log.h"
+#include "common/ExitCodes.h"
+
+#include <QCoreApplication>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include <algorithm>
+#include <array>
+
+namespace {
+
+// each benchmark is run this many times and the median reported, which
+// keeps one slow run from skewing a comparison
+const auto kMedianRuns = QStringLiteral("5");
+
+// how much slower than the baseline is a regression, in percent
+const double kDefaultThreshold = 10.0;
+
+void showHelp()
+{
+  QTextStream(stdout)
+      << "Usage: deskflow-bench [--json FILE] [SUITE[::FUNCTION]...] [-- QTEST_OPTIONS...]\n"
+         "       deskflow-bench --compare BASELINE CURRENT [--threshold PERCENT]\n"
+         "\n"
+         "Runs the benchmarks, or the SUITEs and FUNCTIONs given, and writes\n"
+         "the results to FILE as JSON.  QTEST_OPTIONS are passed to each suite,\n"
+         "e.g. -tickcounter to count CPU ticks instead of timing.\n"
+         "\n"
+         "With --compare, reads two JSON results and lists the change in each\n"
+         "benchmark.  Exits with 1 if any is more than PERCENT slower than\n"
+         "BASELINE, 10 by default.\n";
+}
+
+int compare(const QString &baselinePath, const QString &currentPath, double threshold)
+{
+  QTextStream out(stdout);
+  BenchmarkReport baseline;
+  BenchmarkReport current;
+  if (!baseline.load(baselinePath) || !current.load(currentPath)) {
+    QTextStream(stderr) << "unable to read benchmark results\n";
+    return s_exitArgs;
+  }
+
+  const auto regressions = current.compare(baseline, threshold, out);
+  out << regressions << " regression(s) over " << threshold << "%\n";
+  return regressions == 0 ? s_exitSuccess : s_exitFailed;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  QCoreApplication app(argc, argv);
+
+  Arch arch;
+  arch.init();
+
+  // keep logging out of the measurements
+  Log log;
+  log.setFilter(LogLevel::Level::Warning);
+
+  BaseBenchmarks base;
+  IoBenchmarks io;
+  DeskflowBenchmarks deskflow;
+  ServerBenchmarks server;
+  const std::array<QObject *, 4> suites{&base, &io, &deskflow, &server};
+
+  QString jsonPath;
+  QStringList comparePaths;
+  double threshold = kDefaultThreshold;
+  QStringList selectors;
+  QStringList testOptions;
+  const auto args = QCoreApplication::arguments();
+  for (qsizetype i = 1; i < args.size(); ++i) {
+    const auto &arg = args.at(i);
+    const bool hasValue = i + 1 < args.size();
+    if (arg == QLatin1String("--")) {
+      testOptions = args.mid(i + 1);
+      break;
+    } else if (arg == QLatin1String("--help") || arg == QLatin1String("-h")) {
+      showHelp();
+      return s_exitSuccess;
+    } else if (arg == QLatin1String("--json") && hasValue) {
+      jsonPath = args.at(++i);
+    } else if (arg == QLatin1String("--compare") && i + 2 < args.size()) {
+      comparePaths = args.mid(i + 1, 2);
+      i += 2;
+    } else if (arg == QLatin1String("--threshold") && hasValue) {
+      threshold = args.at(++i).toDouble();
+    } else if (!arg.startsWith(QLatin1Char('-'))) {
+      selectors.append(arg);
+    } else {
+      QTextStream(stderr) << "unknown or incomplete option: " << arg << "\n";
+      return s_exitArgs;
+    }
+  }
+
+  if (!comparePaths.isEmpty()) {
+    return compare(comparePaths.at(0), comparePaths.at(1), threshold);
+  }
+
+  for (const auto &selector : selectors) {
+    const auto name = selector.section(QStringLiteral("::"), 0, 0);
+    if (std::none_of(suites.begin(), suites.end(), [&name](auto *suite) {
+          return name == QLatin1String(suite->metaObject()->className());
+        })) {
+      QTextStream(stderr) << "unknown benchmark suite: " << name << "\n";
+      return s_exitArgs;
+    }
+  }
+
+  QTemporaryDir logDir;
+  BenchmarkReport report;
+  int failures = 0;
+  for (auto *suite : suites) {
+    const auto name = QString::fromLatin1(suite->metaObject()->className());
+    bool selected = selectors.isEmpty();
+    QStringList functions;
+    for (const auto &selector : selectors) {
+      if (selector.section(QStringLiteral("::"), 0, 0) == name) {
+        selected = true;
+        if (const auto function = selector.section(QStringLiteral("::"), 1); !function.isEmpty()) {
+          functions.append(function);
+        }
+      }
+    }
+    if (!selected) {
+      continue;
+    }
+
+    // the console gets the usual output, the report is read from the xml
+    const auto logPath = logDir.filePath(name + QStringLiteral(".xml"));
+    QStringList testArgs{args.first(), "-o", "-,txt", "-o", logPath + QStringLiteral(",xml")};
+    if (!testOptions.contains(QLatin1String("-median"))) {
+      testArgs << "-median" << kMedianRuns;
+    }
+    testArgs << testOptions << functions;
+
+    failures += QTest::qExec(suite, testArgs);
+    if (!report.addQtTestLog(logPath)) {
+      QTextStream(stderr) << "unable to read results of " << name << "\n";
+      ++failures;
+    }
+  }
+
+  if (!jsonPath.isEmpty()) {
+    if (!report.save(jsonPath)) {
+      QTextStream(stderr) << "unable to write " << jsonPath << "\n";
+      return s_exitFailed;
+    }
+    QTextStream(stdout) << "wrote " << report.size() << " result(s) to " << jsonPath << "\n";
+  }
+
+  return failures == 0 ? s_exitSuccess : s_exitFailed;
+}
@@ -0,0 +1,435 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "common/Constants.h"
+#include "common/ExitCodes.h"
+#include "common/Settings.h"
+#include "net/Fingerprint.h"
+#include "net/FingerprintDatabase.h"
+#include "net/SecureUtils.h"
+
+#include <QCoreApplication>
+#include <QDeadlineTimer>
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QSaveFile>
+#include <QSettings>
+#include <QSslCertificate>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// time for the clients to connect before input starts, and for the last
+// events to arrive and be logged after it stops, in seconds
+const int kStartDelay = 3;
+const int kGracePeriod = 3;
+
+const QStringList kKinds = {QStringLiteral("move"), QStringLiteral("key"), QStringLiteral("clipboard")};
+
+const auto kEventLog = QStringLiteral("events.log");
+
+struct Options
+{
+  int clients = 2;
+  int duration = 10;
+  bool tls = false;
+  double flickRate = 1000;
+  double typingRate = 20;
+  qint64 clipboardSize = 0;
+  double clipboardInterval = 2;
+  int port = 24900;
+  int ioThreads = 0;
+  QString core;
+  QString jsonPath;
+  bool keep = false;
+};
+
+// times of each event by kind and tag, in nanoseconds
+using EventTimes = QHash<QString, QHash<quint64, std::vector<qint64>>>;
+
+struct Log
+{
+  EventTimes events;
+  qint64 cpu = 0;
+};
+
+void showHelp()
+{
+  QTextStream(stdout)
+      << "Usage: deskflow-loadtest [--clients N] [--duration SECONDS] [--tls]\n"
+         "                         [--flick RATE] [--typing RATE] [--clipboard BYTES]\n"
+         "                         [--interval SECONDS] [--port PORT] [--core PATH]\n"
+         "                         [--io-threads N] [--json FILE] [--keep]\n"
+         "\n"
+         "Runs a server and N clients over loopback with synthetic screens.\n"
+         "The server flicks the pointer across the clients RATE times a second,\n"
+         "types RATE keys a second and, with --clipboard, copies BYTES of text\n"
+         "every --interval seconds.  Reports the throughput and latency of\n"
+         "each, and the CPU time used per event.  No display is needed.\n"
+         "--io-threads sets how many threads the server uses for client\n"
+         "sockets, 0 picks from the number of cores.\n"
+         "\n"
+         "Defaults: 2 clients for 10 seconds, 1000 moves and 20 keys a second,\n"
+         "port 24900 and the core next to this program.  --keep leaves the\n"
+         "settings and logs in place.\n";
+}
+
+QString screenName(int index)
+{
+  return index == 0 ? QStringLiteral("server") : QStringLiteral("client%1").arg(index);
+}
+
+bool writeFile(const QString &path, const QByteArray &data)
+{
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly)) {
+    return false;
+  }
+  file.write(data);
+  return file.commit();
+}
+
+// the screens in a row, left to right
+QByteArray serverConfig(int clients)
+{
+  QByteArray config = "section: screens\n";
+  for (int i = 0; i <= clients; ++i) {
+    config += "\t" + screenName(i).toUtf8() + ":\n";
+  }
+  config += "end\n\nsection: links\n";
+  for (int i = 0; i <= clients; ++i) {
+    config += "\t" + screenName(i).toUtf8() + ":\n";
+    if (i > 0) {
+      config += "\t\tleft = " + screenName(i - 1).toUtf8() + "\n";
+    }
+    if (i < clients) {
+      config += "\t\tright = " + screenName(i + 1).toUtf8() + "\n";
+    }
+  }
+  config += "end\n";
+  return config;
+}
+
+QString writeSettings(const QDir &dir, int index, const Options &options, const QString &certificate)
+{
+  const auto name = screenName(index);
+  const auto path = dir.filePath(name + QStringLiteral(".conf"));
+  const auto log = dir.filePath(kEventLog);
+
+  QSettings settings(path, QSettings::IniFormat);
+  settings.setValue(Settings::Core::ComputerName, name);
+  settings.setValue(Settings::Core::Port, options.port);
+  settings.setValue(Settings::Security::TlsEnabled, options.tls);
+  settings.setValue(Settings::Security::CheckPeers, false);
+  settings.setValue(Settings::Security::Certificate, certificate);
+
+  if (index == 0) {
+    const auto configPath = dir.filePath(QStringLiteral("server-layout.conf"));
+    if (!writeFile(configPath, serverConfig(options.clients))) {
+      return {};
+    }
+    settings.setValue(Settings::Server::ExternalConfig, true);
+    settings.setValue(Settings::Server::ExternalConfigFile, configPath);
+    settings.setValue(Settings::Server::ClipboardSize, options.clipboardSize / (1024 * 1024) + 1);
+    settings.setValue(Settings::Server::IoThreads, options.ioThreads);
+    const QStringList spec{
+        QStringLiteral("flick=%1").arg(options.flickRate),
+        QStringLiteral("typing=%1").arg(options.typingRate),
+        QStringLiteral("clipboard=%1").arg(options.clipboardSize),
+        QStringLiteral("interval=%1").arg(options.clipboardInterval),
+        QStringLiteral("delay=%1").arg(kStartDelay),
+        QStringLiteral("duration=%1").arg(options.duration),
+        QStringLiteral("screens=%1").arg(options.clients),
+        QStringLiteral("log=%1").arg(log)
+    };
+    settings.setValue(Settings::Core::SyntheticScreen, spec.join(QLatin1Char(',')));
+  } else {
+    settings.setValue(Settings::Client::RemoteHost, QStringLiteral("127.0.0.1"));
+    settings.setValue(Settings::Core::SyntheticScreen, QStringLiteral("log=%1").arg(log));
+  }
+
+  settings.sync();
+  return settings.status() == QSettings::NoError ? path : QString();
+}
+
+// clients check the server against the trusted servers next to their settings
+bool trustCertificate(const QDir &dir, const QString &certificate)
+{
+  const auto certs = QSslCertificate::fromPath(certificate);
+  if (certs.isEmpty()) {
+    return false;
+  }
+
+  Fingerprint fingerprint;
+  fingerprint.type = QCryptographicHash::Sha256;
+  fingerprint.data = certs.first().digest(QCryptographicHash::Sha256);
+
+  FingerprintDatabase db;
+  db.addTrusted(fingerprint);
+  return dir.mkpath(QStringLiteral("tls")) && db.write(dir.filePath(QStringLiteral("tls/trusted-servers")));
+}
+
+Log readLog(const QString &path)
+{
+  Log log;
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return log;
+  }
+
+  while (!file.atEnd()) {
+    const auto fields = file.readLine().trimmed().split(' ');
+    if (fields.size() == 2 && fields.at(0) == "cpu") {
+      // the last is the total
+      log.cpu = fields.at(1).toLongLong();
+    } else if (fields.size() == 3) {
+      log.events[QString::fromLatin1(fields.at(0))][fields.at(1).toULongLong()].push_back(fields.at(2).toLongLong());
+    }
+  }
+  return log;
+}
+
+qint64 percentile(const std::vector<qint64> &sorted, double fraction)
+{
+  const auto index = std::min(sorted.size() - 1, static_cast<size_t>(fraction * static_cast<double>(sorted.size())));
+  return sorted.at(index);
+}
+
+int report(const QDir &dir, const Options &options)
+{
+  const auto sent = readLog(QDir(dir.filePath(screenName(0))).filePath(kEventLog));
+  qint64 cpu = sent.cpu;
+  std::vector<Log> received;
+  for (int i = 1; i <= options.clients; ++i) {
+    received.push_back(readLog(QDir(dir.filePath(screenName(i))).filePath(kEventLog)));
+    cpu += received.back().cpu;
+  }
+
+  QTextStream out(stdout);
+  out << options.clients << " client(s), " << options.duration << "s, " << (options.tls ? "tls" : "plain")
+      << ", io threads " << (options.ioThreads > 0 ? QString::number(options.ioThreads) : QStringLiteral("auto"))
+      << "\n";
+  out << "kind          sent      recv     per s   p50 us   p99 us  p999 us\n";
+
+  QJsonArray results;
+  qint64 totalSent = 0;
+  for (const auto &kind : kKinds) {
+    const auto sentTags = sent.events.value(kind);
+    qint64 sentCount = 0;
+    for (const auto &times : sentTags) {
+      sentCount += static_cast<qint64>(times.size());
+    }
+
+    // each event is matched to the last one sent with its tag
+    std::vector<qint64> latencies;
+    for (const auto &log : received) {
+      const auto tags = log.events.value(kind);
+      for (auto it = tags.cbegin(); it != tags.cend(); ++it) {
+        const auto sentTimes = sentTags.value(it.key());
+        for (const auto time : it.value()) {
+          const auto match = std::upper_bound(sentTimes.begin(), sentTimes.end(), time);
+          if (match != sentTimes.begin()) {
+            latencies.push_back(time - *(match - 1));
+          }
+        }
+      }
+    }
+    totalSent += sentCount;
+    if (sentCount == 0) {
+      continue;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    const auto perSecond = static_cast<double>(latencies.size()) / options.duration;
+    QJsonObject result{
+        {QStringLiteral("kind"), kind},
+        {QStringLiteral("sent"), sentCount},
+        {QStringLiteral("received"), static_cast<qint64>(latencies.size())},
+        {QStringLiteral("perSecond"), perSecond}
+    };
+    out << kind.leftJustified(10) << QString::number(sentCount).rightJustified(8)
+        << QString::number(latencies.size()).rightJustified(10)
+        << QString::number(perSecond, 'f', 0).rightJustified(10);
+    if (!latencies.empty()) {
+      const double p50 = percentile(latencies, 0.5) / 1000.0;
+      const double p99 = percentile(latencies, 0.99) / 1000.0;
+      const double p999 = percentile(latencies, 0.999) / 1000.0;
+      result.insert(QStringLiteral("p50"), p50);
+      result.insert(QStringLiteral("p99"), p99);
+      result.insert(QStringLiteral("p999"), p999);
+      out << QString::number(p50, 'f', 0).rightJustified(9) << QString::number(p99, 'f', 0).rightJustified(9)
+          << QString::number(p999, 'f', 0).rightJustified(9);
+    }
+    out << "\n";
+    results.append(result);
+  }
+
+  if (totalSent == 0) {
+    QTextStream(stderr) << "no input was generated, see the logs in " << dir.path() << "\n";
+    return s_exitFailed;
+  }
+
+  const auto cpuPerEvent = static_cast<double>(cpu) / static_cast<double>(totalSent);
+  out << "cpu " << QString::number(cpu / 1e6, 'f', 0) << " ms, " << QString::number(cpuPerEvent / 1000.0, 'f', 1)
+      << " us per event sent\n";
+
+  if (!options.jsonPath.isEmpty()) {
+    const QJsonObject json{
+        {QStringLiteral("clients"), options.clients},
+        {QStringLiteral("duration"), options.duration},
+        {QStringLiteral("tls"), options.tls},
+        {QStringLiteral("ioThreads"), options.ioThreads},
+        {QStringLiteral("cpuPerEvent"), cpuPerEvent / 1000.0},
+        {QStringLiteral("results"), results}
+    };
+    if (!writeFile(options.jsonPath, QJsonDocument(json).toJson())) {
+      QTextStream(stderr) << "unable to write " << options.jsonPath << "\n";
+      return s_exitFailed;
+    }
+  }
+  return s_exitSuccess;
+}
+
+void stop(QProcess &process)
+{
+  process.terminate();
+  if (!process.waitForFinished(5000)) {
+    process.kill();
+    process.waitForFinished();
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  QCoreApplication app(argc, argv);
+
+  Options options;
+  options.core = QDir(QCoreApplication::applicationDirPath()).filePath(QString::fromLatin1(kCoreBinName));
+
+  const auto args = QCoreApplication::arguments();
+  for (qsizetype i = 1; i < args.size(); ++i) {
+    const auto &arg = args.at(i);
+    const bool hasValue = i + 1 < args.size();
+    bool ok = true;
+    if (arg == QLatin1String("--help") || arg == QLatin1String("-h")) {
+      showHelp();
+      return s_exitSuccess;
+    } else if (arg == QLatin1String("--tls")) {
+      options.tls = true;
+    } else if (arg == QLatin1String("--keep")) {
+      options.keep = true;
+    } else if (arg == QLatin1String("--clients") && hasValue) {
+      options.clients = args.at(++i).toInt(&ok);
+      ok = ok && options.clients > 0;
+    } else if (arg == QLatin1String("--duration") && hasValue) {
+      options.duration = args.at(++i).toInt(&ok);
+      ok = ok && options.duration > 0;
+    } else if (arg == QLatin1String("--flick") && hasValue) {
+      options.flickRate = args.at(++i).toDouble(&ok);
+    } else if (arg == QLatin1String("--typing") && hasValue) {
+      options.typingRate = args.at(++i).toDouble(&ok);
+    } else if (arg == QLatin1String("--clipboard") && hasValue) {
+      options.clipboardSize = args.at(++i).toLongLong(&ok);
+    } else if (arg == QLatin1String("--interval") && hasValue) {
+      options.clipboardInterval = args.at(++i).toDouble(&ok);
+    } else if (arg == QLatin1String("--port") && hasValue) {
+      options.port = args.at(++i).toInt(&ok);
+    } else if (arg == QLatin1String("--io-threads") && hasValue) {
+      options.ioThreads = args.at(++i).toInt(&ok);
+      ok = ok && options.ioThreads >= 0;
+    } else if (arg == QLatin1String("--core") && hasValue) {
+      options.core = args.at(++i);
+    } else if (arg == QLatin1String("--json") && hasValue) {
+      options.jsonPath = args.at(++i);
+    } else {
+      ok = false;
+    }
+
+    if (!ok) {
+      QTextStream(stderr) << "invalid or incomplete option: " << arg << "\n";
+      return s_exitArgs;
+    }
+  }
+
+  QTemporaryDir workDir;
+  workDir.setAutoRemove(!options.keep);
+  const QDir dir(workDir.path());
+
+  QString certificate;
+  if (options.tls) {
+    certificate = dir.filePath(QStringLiteral("load-test.pem"));
+    try {
+      deskflow::generatePemSelfSignedCert(certificate);
+    } catch (const std::exception &e) {
+      QTextStream(stderr) << "unable to create certificate: " << e.what() << "\n";
+      return s_exitFailed;
+    }
+  }
+
+  // one directory per process, as clients look for trusted servers there
+  std::vector<std::unique_ptr<QProcess>> processes;
+  for (int i = 0; i <= options.clients; ++i) {
+    const auto name = screenName(i);
+    QDir processDir(dir.filePath(name));
+    if (!dir.mkpath(name) || (options.tls && i > 0 && !trustCertificate(processDir, certificate))) {
+      QTextStream(stderr) << "unable to set up " << name << " in " << dir.path() << "\n";
+      return s_exitFailed;
+    }
+
+    const auto settings = writeSettings(processDir, i, options, certificate);
+    if (settings.isEmpty()) {
+      QTextStream(stderr) << "unable to write settings for " << name << "\n";
+      return s_exitFailed;
+    }
+
+    auto process = std::make_unique<QProcess>();
+    process->setProcessChannelMode(QProcess::MergedChannels);
+    process->setStandardOutputFile(processDir.filePath(QStringLiteral("output.log")));
+    process->start(
+        options.core, {i == 0 ? QStringLiteral("server") : QStringLiteral("client"), QStringLiteral("--new-instance"),
+                       QStringLiteral("--settings"), settings}
+    );
+    if (!process->waitForStarted()) {
+      QTextStream(stderr) << "unable to start " << options.core << ": " << process->errorString() << "\n";
+      return s_exitFailed;
+    }
+    processes.push_back(std::move(process));
+  }
+
+  QTextStream(stdout) << "running " << options.clients << " client(s) for " << options.duration << "s in "
+                      << dir.path() << "\n";
+
+  // the server stops generating input by itself, the rest is waiting for
+  // the last events to land in the logs
+  QDeadlineTimer deadline(std::chrono::seconds(kStartDelay + options.duration + kGracePeriod));
+  bool exited = false;
+  while (!deadline.hasExpired() && !exited) {
+    exited = processes.front()->waitForFinished(static_cast<int>(std::min<qint64>(deadline.remainingTime(), 100)));
+  }
+  for (auto &process : processes) {
+    stop(*process);
+  }
+
+  if (exited) {
+    QTextStream(stderr) << "server exited early, see " << dir.filePath(QStringLiteral("server/output.log")) << "\n";
+    workDir.setAutoRemove(false);
+    return s_exitFailed;
+  }
+
+  return report(dir, options);
+}
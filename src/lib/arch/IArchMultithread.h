@@ -195,6 +195,15 @@ public:
   */
   virtual void setPriorityOfThread(ArchThread, int n) = 0;
 
+  //! Use real-time scheduling for the calling thread
+  /*!
+  Asks for the calling thread to be scheduled ahead of normal threads,
+  for latency sensitive work.  This works for any thread, including
+  ones not started through this interface.  Returns false if it isn't
+  permitted, which is usual for unprivileged processes on Unix.
+  */
+  virtual bool setCurrentThreadRealtime() = 0;
+
   //! Cancellation point
   /*!
   This method does nothing but is a cancellation point.  Clients
@@ -211,6 +211,15 @@ public:
   */
   virtual size_t writeSocket(ArchSocket s, const void *buf, size_t len) = 0;
 
+  //! Read a datagram from socket
+  /*!
+  Like \c readSocket() but for an unconnected datagram socket.  Reads
+  one datagram, truncated to \c len bytes, and sets \c addr to the
+  sender, which the caller must release with \c closeAddr().  Returns 0
+  and sets \c addr to nullptr if no datagram is queued.
+  */
+  virtual size_t readFromSocket(ArchSocket s, void *buf, size_t len, ArchNetAddress *addr) = 0;
+
   //! Reset the writable poll hint for a socket
   /*!
   Tells pollSocket() to wait for a fresh writable notification instead of
@@ -248,6 +257,13 @@ public:
   */
   virtual bool setReuseAddrOnSocket(ArchSocket, bool reuse) = 0;
 
+  //! Get the local address of a socket
+  /*!
+  Returns the address socket \c s is bound to, with the port the
+  system picked if it was bound to port 0.
+  */
+  virtual ArchNetAddress getSocketAddr(ArchSocket s) = 0;
+
   //! Create an "any" network address
   virtual ArchNetAddress newAnyAddr(AddressFamily) = 0;
 
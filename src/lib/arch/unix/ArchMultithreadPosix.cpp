@@ -11,6 +11,7 @@
 #include "arch/ArchException.h"
 
 #include <cerrno>
+#include <sched.h>
 #include <signal.h>
 #include <sys/time.h>
 #include <time.h>
@@ -382,6 +383,15 @@ void ArchMultithreadPosix::setPriorityOfThread(ArchThread thread, int /*n*/)
   // FIXME
 }
 
+bool ArchMultithreadPosix::setCurrentThreadRealtime()
+{
+  // lowest real-time priority, that's enough to run ahead of every
+  // normal thread without starving other real-time work
+  sched_param param{};
+  param.sched_priority = sched_get_priority_min(SCHED_RR);
+  return pthread_setschedparam(pthread_self(), SCHED_RR, &param) == 0;
+}
+
 void ArchMultithreadPosix::testCancelThread()
 {
   // find current thread
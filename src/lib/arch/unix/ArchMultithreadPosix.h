@@ -70,6 +70,7 @@ public:
   void closeThread(ArchThread) final;
   void cancelThread(ArchThread) override;
   void setPriorityOfThread(ArchThread, int n) override;
+  bool setCurrentThreadRealtime() override;
   void testCancelThread() override;
   bool wait(ArchThread, double timeout) override;
   bool isSameThread(ArchThread, ArchThread) override;
@@ -364,6 +364,26 @@ size_t ArchNetworkBSD::writeSocket(ArchSocket s, const void *buf, size_t len)
   return n;
 }
 
+size_t ArchNetworkBSD::readFromSocket(ArchSocket s, void *buf, size_t len, ArchNetAddress *addr)
+{
+  assert(s != nullptr);
+  assert(addr != nullptr);
+
+  auto *from = new ArchNetAddressImpl;
+  ssize_t n = recvfrom(s->m_fd, buf, len, 0, TYPED_ADDR(struct sockaddr, from), &from->m_len);
+  if (n == -1) {
+    int err = errno;
+    delete from;
+    *addr = nullptr;
+    if (err == EINTR || err == EAGAIN) {
+      return 0;
+    }
+    throwError(err);
+  }
+  *addr = from;
+  return n;
+}
+
 void ArchNetworkBSD::throwErrorOnSocket(ArchSocket s)
 {
   assert(s != nullptr);
@@ -450,6 +470,19 @@ bool ArchNetworkBSD::setReuseAddrOnSocket(ArchSocket s, bool reuse)
   return (oflag != 0);
 }
 
+ArchNetAddress ArchNetworkBSD::getSocketAddr(ArchSocket s)
+{
+  assert(s != nullptr);
+
+  auto *addr = new ArchNetAddressImpl;
+  if (getsockname(s->m_fd, TYPED_ADDR(struct sockaddr, addr), &addr->m_len) == -1) {
+    int err = errno;
+    delete addr;
+    throwError(err);
+  }
+  return addr;
+}
+
 ArchNetAddress ArchNetworkBSD::newAnyAddr(AddressFamily family)
 {
   using enum AddressFamily;
@@ -511,8 +544,8 @@ std::vector<ArchNetAddress> ArchNetworkBSD::nameToAddr(const std::string &name)
     hints.ai_flags |= AI_NUMERICHOST;
   }
 
-  // done with static buffer
-  std::scoped_lock lock{m_mutex};
+  // getaddrinfo is thread safe and can take seconds, so don't hold the
+  // mutex that socket calls on other threads need
   struct addrinfo *pResult = nullptr;
 
   if (int ret = getaddrinfo(name.c_str(), nullptr, &hints, &pResult); ret != 0) {
@@ -386,6 +386,12 @@ void ArchMultithreadWindows::setPriorityOfThread(ArchThread thread, int n)
   SetThreadPriority(thread->m_thread, s_pClass[index].m_level);
 }
 
+bool ArchMultithreadWindows::setCurrentThreadRealtime()
+{
+  // time critical is the top of the process' priority class
+  return SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL) != FALSE;
+}
+
 void ArchMultithreadWindows::testCancelThread()
 {
   // find current thread
@@ -77,6 +77,7 @@ public:
   void closeThread(ArchThread) override;
   void cancelThread(ArchThread) override;
   void setPriorityOfThread(ArchThread, int n) override;
+  bool setCurrentThreadRealtime() override;
   void testCancelThread() override;
   bool wait(ArchThread, double timeout) override;
   bool isSameThread(ArchThread, ArchThread) override;
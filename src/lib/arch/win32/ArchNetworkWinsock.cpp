@@ -29,6 +29,7 @@ static int(PASCAL FAR *close_winsock)(SOCKET s);
 static int(PASCAL FAR *connect_winsock)(SOCKET s, const struct sockaddr FAR *name, int namelen);
 static int(PASCAL FAR *gethostname_winsock)(char FAR *name, int namelen);
 static int(PASCAL FAR *getsockerror_winsock)(void);
+static int(PASCAL FAR *getsockname_winsock)(SOCKET s, struct sockaddr FAR *name, int FAR *namelen);
 static int(PASCAL FAR *getsockopt_winsock)(SOCKET s, int level, int optname, void FAR *optval, int FAR *optlen);
 static u_short(PASCAL FAR *htons_winsock)(u_short v);
 static char FAR *(PASCAL FAR *inet_ntoa_winsock)(struct in_addr in);
@@ -37,6 +38,9 @@ static int(PASCAL FAR *ioctl_winsock)(SOCKET s, int cmd, void FAR *data);
 static int(PASCAL FAR *listen_winsock)(SOCKET s, int backlog);
 static u_short(PASCAL FAR *ntohs_winsock)(u_short v);
 static int(PASCAL FAR *recv_winsock)(SOCKET s, void FAR *buf, int len, int flags);
+static int(PASCAL FAR *recvfrom_winsock)(
+    SOCKET s, void FAR *buf, int len, int flags, struct sockaddr FAR *from, int FAR *fromlen
+);
 static int(PASCAL FAR *select_winsock)(
     int nfds, fd_set FAR *readfds, fd_set FAR *writefds, fd_set FAR *exceptfds, const struct timeval FAR *timeout
 );
@@ -150,6 +154,7 @@ void ArchNetworkWinsock::initModule(HMODULE module)
   setfunc(connect_winsock, connect, int(PASCAL FAR *)(SOCKET s, const struct sockaddr FAR *name, int namelen));
   setfunc(gethostname_winsock, gethostname, int(PASCAL FAR *)(char FAR *name, int namelen));
   setfunc(getsockerror_winsock, WSAGetLastError, int(PASCAL FAR *)(void));
+  setfunc(getsockname_winsock, getsockname, int(PASCAL FAR *)(SOCKET s, struct sockaddr FAR * name, int FAR *namelen));
   setfunc(
       getsockopt_winsock, getsockopt,
       int(PASCAL FAR *)(SOCKET s, int level, int optname, void FAR *optval, int FAR *optlen)
@@ -161,6 +166,10 @@ void ArchNetworkWinsock::initModule(HMODULE module)
   setfunc(listen_winsock, listen, int(PASCAL FAR *)(SOCKET s, int backlog));
   setfunc(ntohs_winsock, ntohs, u_short(PASCAL FAR *)(u_short v));
   setfunc(recv_winsock, recv, int(PASCAL FAR *)(SOCKET s, void FAR *buf, int len, int flags));
+  setfunc(
+      recvfrom_winsock, recvfrom,
+      int(PASCAL FAR *)(SOCKET s, void FAR *buf, int len, int flags, struct sockaddr FAR *from, int FAR *fromlen)
+  );
   setfunc(
       select_winsock, select,
       int(PASCAL FAR *)(
@@ -558,6 +567,31 @@ size_t ArchNetworkWinsock::writeSocket(ArchSocket s, const void *buf, size_t len
   return static_cast<size_t>(n);
 }
 
+size_t ArchNetworkWinsock::readFromSocket(ArchSocket s, void *buf, size_t len, ArchNetAddress *addr)
+{
+  assert(s != nullptr);
+  assert(addr != nullptr);
+
+  ArchNetAddress from = ArchNetAddressImpl::alloc(sizeof(struct sockaddr_in6));
+  int n = recvfrom_winsock(s->m_socket, buf, (int)len, 0, TYPED_ADDR(struct sockaddr, from), &from->m_len);
+  if (n == SOCKET_ERROR) {
+    int err = getsockerror_winsock();
+    if (err == WSAEMSGSIZE) {
+      // truncated to fit, like on unix
+      *addr = from;
+      return len;
+    }
+    free(from);
+    *addr = nullptr;
+    if (err == WSAEINTR || err == WSAEWOULDBLOCK) {
+      return 0;
+    }
+    throwError(err);
+  }
+  *addr = from;
+  return static_cast<size_t>(n);
+}
+
 void ArchNetworkWinsock::resetPollWriteOnSocket(ArchSocket s)
 {
   assert(s != nullptr);
@@ -629,6 +663,19 @@ bool ArchNetworkWinsock::setReuseAddrOnSocket(ArchSocket s, bool reuse)
   return false;
 }
 
+ArchNetAddress ArchNetworkWinsock::getSocketAddr(ArchSocket s)
+{
+  assert(s != nullptr);
+
+  ArchNetAddress addr = ArchNetAddressImpl::alloc(sizeof(struct sockaddr_in6));
+  if (getsockname_winsock(s->m_socket, TYPED_ADDR(struct sockaddr, addr), &addr->m_len) == SOCKET_ERROR) {
+    int err = getsockerror_winsock();
+    free(addr);
+    throwError(err);
+  }
+  return addr;
+}
+
 ArchNetAddress ArchNetworkWinsock::newAnyAddr(AddressFamily family)
 {
   ArchNetAddressImpl *addr = nullptr;
@@ -677,7 +724,8 @@ std::vector<ArchNetAddress> ArchNetworkWinsock::nameToAddr(const std::string &na
   hints.ai_family = AF_UNSPEC;
   int ret = -1;
 
-  std::scoped_lock lock{m_mutex};
+  // getaddrinfo is thread safe and can take seconds, so don't hold the
+  // mutex that socket calls on other threads need
   if ((ret = getaddrinfo(name.c_str(), nullptr, &hints, &pResult)) != 0) {
     throwNameError(ret);
   }
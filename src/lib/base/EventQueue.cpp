@@ -18,6 +18,35 @@
 
 #include <stdexcept>
 
+namespace {
+
+// placed in the buffer to wake the loop for the input lane.  event ids
+// count up from zero so never reach it.
+const uint32_t kInputLaneID = UINT32_MAX;
+
+bool isInputEvent(EventTypes type)
+{
+  switch (type) {
+    using enum EventTypes;
+  case KeyStateKeyDown:
+  case KeyStateKeyUp:
+  case KeyStateKeyRepeat:
+  case PrimaryScreenButtonDown:
+  case PrimaryScreenButtonUp:
+  case PrimaryScreenMotionOnPrimary:
+  case PrimaryScreenMotionOnSecondary:
+  case PrimaryScreenWheel:
+  case PrimaryScreenHotkeyDown:
+  case PrimaryScreenHotkeyUp:
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+} // namespace
+
 // interrupt handler.  this just adds a quit event to the queue.
 static void interrupt(Arch::ThreadSignal, void *data)
 {
@@ -57,7 +86,11 @@ int EventQueue::loop()
   while (!m_pending.empty()) {
     LOG_DEBUG("add pending events to buffer");
     Event &event = m_pending.front();
-    addEventToBuffer(std::move(event));
+    if (isInputEvent(event.getType())) {
+      addInputEvent(std::move(event));
+    } else {
+      addEventToBuffer(std::move(event));
+    }
     m_pending.pop();
   }
 
@@ -94,6 +127,9 @@ void EventQueue::adoptBuffer(IEventQueueBuffer *buffer)
   }
   m_events.clear();
   m_oldEventIDs.clear();
+  for (; !m_input.empty(); m_input.pop()) {
+    Event::deleteData(m_input.front());
+  }
 
   // use new buffer
   m_buffer.reset(buffer);
@@ -104,6 +140,11 @@ void EventQueue::adoptBuffer(IEventQueueBuffer *buffer)
 
 bool EventQueue::processEvent(Event &event, double timeout, Stopwatch &timer)
 {
+  // input goes before anything in the buffer
+  if (takeInputEvent(event)) {
+    return true;
+  }
+
   // if no events are waiting then handle timers and then wait
   while (m_buffer->isEmpty()) {
     // handle timers first
@@ -147,6 +188,13 @@ bool EventQueue::processEvent(Event &event, double timeout, Stopwatch &timer)
     return true;
 
   case User: {
+    if (dataID == kInputLaneID) {
+      // the input may have been taken already, then keep waiting
+      if (takeInputEvent(event)) {
+        return true;
+      }
+      return (timeout < 0.0 || timeout > timer.getTime()) && processEvent(event, timeout, timer);
+    }
     std::scoped_lock lock{m_mutex};
     event = removeEvent(dataID);
     return true;
@@ -196,11 +244,36 @@ void EventQueue::addEvent(Event &&event)
     Event::deleteData(event);
   } else if (!(*m_readyCondVar)) {
     m_pending.push(std::move(event));
+  } else if (isInputEvent(event.getType())) {
+    addInputEvent(std::move(event));
   } else {
     addEventToBuffer(std::move(event));
   }
 }
 
+void EventQueue::addInputEvent(Event &&event)
+{
+  std::scoped_lock lock{m_mutex};
+
+  // the loop only needs waking once for any number of queued events
+  const bool wake = m_input.empty();
+  m_input.push(std::move(event));
+  if (wake && !m_buffer->addEvent(kInputLaneID)) {
+    LOG_DEBUG("unable to wake event queue for input");
+  }
+}
+
+bool EventQueue::takeInputEvent(Event &event)
+{
+  std::scoped_lock lock{m_mutex};
+  if (m_input.empty()) {
+    return false;
+  }
+  event = std::move(m_input.front());
+  m_input.pop();
+  return true;
+}
+
 void EventQueue::addEventToBuffer(Event &&event)
 {
   std::scoped_lock lock{m_mutex};
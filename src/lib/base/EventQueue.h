@@ -24,6 +24,11 @@
 /*!
 An event queue that implements the platform independent parts and
 delegates the platform dependent parts to a subclass.
+
+Input events (keys, buttons, motion, wheel and hot keys) go in a lane of
+their own that is drained before the buffer, so they don't wait behind
+clipboard transfers, config reloads or log traffic.  Input events keep
+their order among themselves but may overtake other events.
 */
 class EventQueue : public IEventQueue
 {
@@ -57,6 +62,8 @@ private:
   bool hasTimerExpired(Event &event);
   double getNextTimerTimeout() const;
   void addEventToBuffer(Event &&event);
+  void addInputEvent(Event &&event);
+  bool takeInputEvent(Event &event);
 
   //!
   //! \brief processEvent Internal event proccessing
@@ -119,6 +126,9 @@ private:
   // event handlers
   HandlerTable m_handlers;
 
+  // input lane, protected by m_mutex
+  std::queue<Event> m_input;
+
   Mutex *m_readyMutex = nullptr;
   CondVar<bool> *m_readyCondVar = nullptr;
   std::queue<Event> m_pending;
@@ -90,6 +90,11 @@ enum class EventTypes : uint32_t
   */
   SocketDisconnected,
 
+  /** A HostResolver sends this event when a lookup has completed.
+      The data is a pointer to a HostResolver::Result.
+  */
+  HostResolved,
+
   OsxScreenConfirmSleep,
 
   /// This event is sent whenever a server accepts a client.
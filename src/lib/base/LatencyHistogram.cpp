@@ -0,0 +1,113 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "base/LatencyHistogram.h"
+
+#include <bit>
+#include <chrono>
+#include <cmath>
+
+//
+// LatencyHistogram
+//
+
+void LatencyHistogram::record(uint64_t nanoseconds)
+{
+  m_buckets[bucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+  m_count.fetch_add(1, std::memory_order_relaxed);
+
+  uint64_t max = m_max.load(std::memory_order_relaxed);
+  while (nanoseconds > max && !m_max.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed)) {
+    // max is reloaded by compare_exchange_weak
+  }
+}
+
+void LatencyHistogram::recordSince(uint64_t startNanos)
+{
+  if (startNanos == 0) {
+    return;
+  }
+
+  const uint64_t end = now();
+  record(end > startNanos ? end - startNanos : 0);
+}
+
+void LatencyHistogram::reset()
+{
+  for (auto &bucket : m_buckets) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  m_count.store(0, std::memory_order_relaxed);
+  m_max.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::count() const
+{
+  return m_count.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::max() const
+{
+  return m_max.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::valueAtPercentile(double percentile) const
+{
+  const uint64_t total = count();
+  if (total == 0) {
+    return 0;
+  }
+
+  percentile = std::fmin(std::fmax(percentile, 0.0), 100.0);
+  auto target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(total)));
+  if (target == 0) {
+    target = 1;
+  }
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBuckets; ++i) {
+    seen += m_buckets[i].load(std::memory_order_relaxed);
+    if (seen >= target) {
+      const uint64_t value = bucketHighestValue(i);
+      const uint64_t highest = max();
+      return value < highest ? value : highest;
+    }
+  }
+
+  // buckets were updated while we walked them
+  return max();
+}
+
+uint64_t LatencyHistogram::now()
+{
+  const auto since = std::chrono::steady_clock::now().time_since_epoch();
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(since).count());
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t value)
+{
+  if (value < kSubBuckets) {
+    return static_cast<size_t>(value);
+  }
+
+  // the top bit selects the power of two, the next kSubBucketBits bits
+  // select the linear sub-bucket within it
+  const int shift = std::bit_width(value) - 1 - kSubBucketBits;
+  const auto subBucket = static_cast<size_t>((value >> shift) & (kSubBuckets - 1));
+  return static_cast<size_t>(shift + 1) * kSubBuckets + subBucket;
+}
+
+uint64_t LatencyHistogram::bucketHighestValue(size_t index)
+{
+  if (index < kSubBuckets) {
+    return index;
+  }
+
+  const auto shift = static_cast<int>(index / kSubBuckets) - 1;
+  const uint64_t subBucket = index % kSubBuckets;
+  const uint64_t lowest = (kSubBuckets + subBucket) << shift;
+  return lowest + ((uint64_t{1} << shift) - 1);
+}
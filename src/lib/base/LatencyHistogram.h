@@ -0,0 +1,85 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+//! Log-linear latency histogram
+/*!
+Records durations in nanoseconds into HDR-style buckets: each power of
+two is split into 16 linear sub-buckets, so any recorded value can be
+reported back with a relative error of at most 1/16 while the whole
+range of \c uint64_t fits in a fixed array.
+
+Recording is wait-free and may happen on one thread while another reads
+percentiles; readers see a consistent-enough view for reporting but not
+an atomic snapshot.
+*/
+class LatencyHistogram
+{
+public:
+  LatencyHistogram() = default;
+  LatencyHistogram(const LatencyHistogram &) = delete;
+  LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+  //! @name manipulators
+  //@{
+
+  //! Record a duration in nanoseconds
+  void record(uint64_t nanoseconds);
+
+  //! Record the time elapsed since \p startNanos
+  /*!
+  \p startNanos must come from now().  Does nothing if \p startNanos is
+  zero, which callers use for "no timestamp".
+  */
+  void recordSince(uint64_t startNanos);
+
+  //! Discard all recorded values
+  void reset();
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Get the number of recorded values
+  uint64_t count() const;
+
+  //! Get the largest recorded value
+  uint64_t max() const;
+
+  //! Get value at percentile
+  /*!
+  Returns the highest value equivalent to the bucket containing the
+  given \p percentile (0 to 100) of recorded values, or 0 if nothing
+  has been recorded.
+  */
+  uint64_t valueAtPercentile(double percentile) const;
+
+  //! Get monotonic time
+  /*!
+  Returns a monotonic timestamp in nanoseconds.  Only differences
+  between timestamps from the same process are meaningful.
+  */
+  static uint64_t now();
+
+  //@}
+
+private:
+  static constexpr int kSubBucketBits = 4;
+  static constexpr uint64_t kSubBuckets = 1 << kSubBucketBits;
+  static constexpr size_t kBuckets = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+  static size_t bucketIndex(uint64_t value);
+  static uint64_t bucketHighestValue(size_t index);
+
+  std::array<std::atomic<uint64_t>, kBuckets> m_buckets{};
+  std::atomic<uint64_t> m_count = 0;
+  std::atomic<uint64_t> m_max = 0;
+};
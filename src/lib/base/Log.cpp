@@ -11,10 +11,14 @@
 #include "common/Constants.h"
 #include "common/LogLevel.h"
 
+#include <array>
 #include <cstdarg>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
 
 #if HAVE_FORMAT
 #include <format>
@@ -24,6 +28,14 @@
 
 const int kPriorityPrefixLength = 3;
 
+// messages shorter than this are formatted without touching the heap
+const size_t kStackBufferSize = 512;
+
+// async queue size, and the longest message it will take; together they
+// bound the memory the queue can hold on to
+const uint64_t kAsyncQueueSize = 2048;
+const size_t kAsyncMaxLength = 1024;
+
 // if NDEBUG (not debug) is not specified, i.e. you're building in debug,
 // then set default log level to DEBUG, otherwise the max level is INFO.
 //
@@ -51,15 +63,14 @@ LogLevel::Level getPriority(const char *&fmt)
   return static_cast<LogLevel::Level>(fmt[2] - '0');
 }
 
-std::vector<char> makeMessage(const char *filename, int lineNumber, const char *message, LogLevel::Level priority)
+std::vector<char>
+makeMessage(int64_t time, const char *filename, int lineNumber, const char *message, LogLevel::Level priority)
 {
 
   // base size includes null terminator, colon, space, etc.
   const int baseSize = 10;
 
-  const auto currentPriority = static_cast<int>(priority);
-
-  auto timeStr = QDateTime::currentDateTime().toString(Qt::ISODateWithMs).toStdString();
+  auto timeStr = QDateTime::fromMSecsSinceEpoch(time).toString(Qt::ISODateWithMs).toStdString();
 
   auto sectionName = LogLevel::toOption(priority).toStdString();
 
@@ -97,6 +108,177 @@ std::vector<char> makeMessage(const char *filename, int lineNumber, const char *
 }
 } // namespace
 
+//
+// Log::AsyncQueue
+//
+
+/*
+Bounded multi-producer, single-consumer queue after Dmitry Vyukov's
+design.  Each entry carries a sequence number which tells a producer
+whether the entry is free for the position it claimed and tells the
+consumer whether the entry at its position has been published, so
+neither side needs a lock.  Entries keep their string buffers when
+they are reused, so once warmed up pushing doesn't allocate.
+*/
+class Log::AsyncQueue
+{
+public:
+  explicit AsyncQueue(Log *log);
+  AsyncQueue(AsyncQueue const &) = delete;
+  AsyncQueue &operator=(AsyncQueue const &) = delete;
+  ~AsyncQueue();
+
+  // returns false if the message is too long to queue
+  bool push(LogLevel::Level priority, int64_t time, const char *file, int line, const char *text, size_t length);
+  void flush();
+  uint64_t dropped() const;
+
+private:
+  struct Entry
+  {
+    std::atomic<uint64_t> m_sequence = 0;
+    LogLevel::Level m_priority = LogLevel::Level::Info;
+    int64_t m_time = 0;
+    const char *m_file = nullptr;
+    int m_line = 0;
+    std::string m_text;
+  };
+
+  void run();
+
+  Log *m_log;
+  std::unique_ptr<Entry[]> m_entries;
+  alignas(64) std::atomic<uint64_t> m_enqueuePos = 0;
+  alignas(64) std::atomic<uint64_t> m_published = 0;
+  alignas(64) std::atomic<uint64_t> m_processed = 0;
+  std::atomic<uint64_t> m_dropped = 0;
+  std::atomic<bool> m_stopping = false;
+  std::thread m_thread; // NOSONAR - No jthread on Windows
+};
+
+static_assert((kAsyncQueueSize & (kAsyncQueueSize - 1)) == 0, "queue size must be a power of two");
+
+Log::AsyncQueue::AsyncQueue(Log *log) : m_log(log), m_entries(std::make_unique<Entry[]>(kAsyncQueueSize))
+{
+  for (uint64_t i = 0; i < kAsyncQueueSize; ++i) {
+    m_entries[i].m_sequence.store(i, std::memory_order_relaxed);
+  }
+  m_thread = std::thread(&AsyncQueue::run, this); // NOSONAR - No jthread on Windows
+}
+
+Log::AsyncQueue::~AsyncQueue()
+{
+  flush();
+
+  m_stopping.store(true, std::memory_order_release);
+  m_published.fetch_add(1, std::memory_order_release);
+  m_published.notify_one();
+  m_thread.join();
+}
+
+bool Log::AsyncQueue::push(
+    LogLevel::Level priority, int64_t time, const char *file, int line, const char *text, size_t length
+)
+{
+  if (length > kAsyncMaxLength) {
+    return false;
+  }
+
+  // claim a position
+  uint64_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+  Entry *entry;
+  while (true) {
+    entry = &m_entries[pos & (kAsyncQueueSize - 1)];
+    const uint64_t sequence = entry->m_sequence.load(std::memory_order_acquire);
+    if (const auto diff = static_cast<int64_t>(sequence - pos); diff == 0) {
+      if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // full, the consumer hasn't got to this entry since last time round
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    } else {
+      pos = m_enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+
+  entry->m_priority = priority;
+  entry->m_time = time;
+  entry->m_file = file;
+  entry->m_line = line;
+  entry->m_text.assign(text, length);
+
+  // publish and wake the consumer
+  entry->m_sequence.store(pos + 1, std::memory_order_release);
+  m_published.fetch_add(1, std::memory_order_release);
+  m_published.notify_one();
+  return true;
+}
+
+void Log::AsyncQueue::flush()
+{
+  // an outputter logging from the consumer would wait for itself
+  if (std::this_thread::get_id() == m_thread.get_id()) {
+    return;
+  }
+
+  // every claimed position gets published, so wait for all of them
+  const uint64_t target = m_enqueuePos.load(std::memory_order_acquire);
+  uint64_t processed = m_processed.load(std::memory_order_acquire);
+  while (processed < target) {
+    m_processed.wait(processed, std::memory_order_acquire);
+    processed = m_processed.load(std::memory_order_acquire);
+  }
+}
+
+uint64_t Log::AsyncQueue::dropped() const
+{
+  return m_dropped.load(std::memory_order_relaxed);
+}
+
+void Log::AsyncQueue::run()
+{
+  uint64_t pos = 0;
+  uint64_t reportedDrops = 0;
+
+  while (true) {
+    // read the wake counter before looking at the queue so a publish
+    // after this point always ends the wait below
+    const uint64_t published = m_published.load(std::memory_order_acquire);
+
+    bool idle = true;
+    while (true) {
+      Entry &entry = m_entries[pos & (kAsyncQueueSize - 1)];
+      if (entry.m_sequence.load(std::memory_order_acquire) != pos + 1) {
+        break;
+      }
+
+      m_log->output(entry.m_priority, entry.m_time, entry.m_file, entry.m_line, entry.m_text.c_str());
+
+      // hand the entry back to producers for the next time round
+      entry.m_sequence.store(pos + kAsyncQueueSize, std::memory_order_release);
+      ++pos;
+      m_processed.store(pos, std::memory_order_release);
+      m_processed.notify_all();
+      idle = false;
+    }
+
+    if (const uint64_t drops = m_dropped.load(std::memory_order_relaxed); drops != reportedDrops) {
+      const auto text = std::to_string(drops - reportedDrops) + " log messages dropped, queue full";
+      m_log->output(LogLevel::Level::Warning, QDateTime::currentMSecsSinceEpoch(), nullptr, 0, text.c_str());
+      reportedDrops = drops;
+    }
+
+    if (idle) {
+      if (m_stopping.load(std::memory_order_acquire)) {
+        break;
+      }
+      m_published.wait(published, std::memory_order_acquire);
+    }
+  }
+}
+
 //
 // Log
 //
@@ -125,6 +307,10 @@ Log::Log(Log *src)
 
 Log::~Log()
 {
+  // write anything still queued while the outputters exist
+  m_activeAsync.store(nullptr, std::memory_order_release);
+  m_async.reset();
+
   // clean up
   for (auto index = m_outputters.begin(); index != m_outputters.end(); ++index) {
     delete *index;
@@ -134,17 +320,8 @@ Log::~Log()
   }
 }
 
-Log *Log::getInstance()
-{
-  assert(s_log != nullptr);
-  return s_log;
-}
-
 void Log::print(const char *file, int line, const char *fmt, ...)
 {
-  const int initBufferSize = 1024;
-  const int bufferResizeScale = 2;
-
   const auto priority = getPriority(fmt);
   fmt += kPriorityPrefixLength;
 
@@ -152,29 +329,40 @@ void Log::print(const char *file, int line, const char *fmt, ...)
     return;
   }
 
-  std::vector<char> buffer(initBufferSize);
-  auto length = static_cast<int>(buffer.size());
+  // format into a stack buffer, only going to the heap for long messages
+  std::array<char, kStackBufferSize> stackBuffer;
+  std::vector<char> heapBuffer;
+  const char *text = stackBuffer.data();
 
-  while (true) {
-    va_list args;
+  va_list args;
+  va_start(args, fmt);
+  const int length = vsnprintf(stackBuffer.data(), stackBuffer.size(), fmt, args);
+  va_end(args);
+
+  if (length < 0) {
+    return;
+  }
+
+  if (static_cast<size_t>(length) >= stackBuffer.size()) {
+    heapBuffer.resize(static_cast<size_t>(length) + 1);
     va_start(args, fmt);
-    int n = vsnprintf(buffer.data(), length, fmt, args);
+    vsnprintf(heapBuffer.data(), heapBuffer.size(), fmt, args);
     va_end(args);
+    text = heapBuffer.data();
+  }
 
-    if (n < 0 || n > length) {
-      length *= bufferResizeScale;
-      buffer.resize(length);
-    } else {
-      break;
+  const auto time = QDateTime::currentMSecsSinceEpoch();
+
+  if (auto *async = m_activeAsync.load(std::memory_order_acquire); async != nullptr) {
+    if (priority > LogLevel::Level::Fatal && async->push(priority, time, file, line, text, length)) {
+      return;
     }
-  }
 
-  if (priority == LogLevel::Level::Print) {
-    output(priority, buffer.data());
-  } else {
-    auto message = makeMessage(file, line, buffer.data(), priority);
-    output(priority, message.data());
+    // written here and now, but not before anything already queued
+    async->flush();
   }
+
+  output(priority, time, file, line, text);
 }
 
 void Log::insert(ILogOutputter *adoptedOutputter, bool alwaysAtHead)
@@ -193,6 +381,9 @@ void Log::insert(ILogOutputter *adoptedOutputter, bool alwaysAtHead)
 
 void Log::remove(ILogOutputter *outputter)
 {
+  // let the outputter see everything logged before it was removed
+  flush();
+
   std::scoped_lock lock{m_mutex};
   m_outputters.remove(outputter);
   m_alwaysOutputters.remove(outputter);
@@ -200,6 +391,8 @@ void Log::remove(ILogOutputter *outputter)
 
 void Log::pop_front(bool alwaysAtHead)
 {
+  flush();
+
   std::scoped_lock lock{m_mutex};
   OutputterList *list = alwaysAtHead ? &m_alwaysOutputters : &m_outputters;
   if (!list->empty()) {
@@ -219,14 +412,53 @@ bool Log::setFilter(const QString &maxPriority)
 
 void Log::setFilter(LogLevel::Level maxPriority)
 {
-  std::scoped_lock lock{m_mutex};
-  m_maxPriority = maxPriority;
+  m_maxPriority.store(maxPriority, std::memory_order_relaxed);
+}
+
+void Log::setAsync(bool enabled)
+{
+  if (enabled) {
+    std::scoped_lock lock{m_mutex};
+    if (!m_async) {
+      m_async = std::make_unique<AsyncQueue>(this);
+    }
+    m_activeAsync.store(m_async.get(), std::memory_order_release);
+  } else if (auto *async = m_activeAsync.exchange(nullptr, std::memory_order_acq_rel); async != nullptr) {
+    async->flush();
+  }
+}
+
+void Log::flush()
+{
+  if (auto *async = m_activeAsync.load(std::memory_order_acquire); async != nullptr) {
+    async->flush();
+  }
 }
 
 LogLevel::Level Log::getFilter() const
+{
+  return m_maxPriority.load(std::memory_order_relaxed);
+}
+
+bool Log::isAsync() const
+{
+  return m_activeAsync.load(std::memory_order_acquire) != nullptr;
+}
+
+uint64_t Log::getDropped() const
 {
   std::scoped_lock lock{m_mutex};
-  return m_maxPriority;
+  return m_async ? m_async->dropped() : 0;
+}
+
+void Log::output(LogLevel::Level priority, int64_t time, const char *file, int line, const char *msg)
+{
+  if (priority == LogLevel::Level::Print) {
+    output(priority, msg);
+  } else {
+    auto message = makeMessage(time, file, line, msg, priority);
+    output(priority, message.data());
+  }
 }
 
 void Log::output(LogLevel::Level priority, const char *msg)
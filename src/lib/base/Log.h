@@ -10,7 +10,11 @@
 
 #include "common/LogLevel.h"
 
+#include <atomic>
+#include <cassert>
+#include <cstdint>
 #include <list>
+#include <memory>
 #include <mutex>
 
 #include <QString>
@@ -91,6 +95,26 @@ public:
   //! Set the minimum priority filter (by ordinal).
   void setFilter(LogLevel::Level);
 
+  //! Enable or disable asynchronous output
+  /*!
+  When enabled, print() only formats the message text and queues it;
+  a background thread adds the timestamp and location and writes it to
+  the outputters.  The queue has a fixed size and messages are dropped
+  (and counted) rather than blocking the caller when it is full.
+
+  Fatal messages, \c CLOG_PRINT messages and messages too long for the
+  queue are still written synchronously, after everything queued before
+  them.  Disabling asynchronous output flushes the queue first.
+  */
+  void setAsync(bool enabled);
+
+  //! Wait for queued messages
+  /*!
+  Blocks until every message queued so far has been written to the
+  outputters.  Does nothing if output is synchronous.
+  */
+  void flush();
+
   //@}
   //! @name accessors
   //@{
@@ -106,8 +130,30 @@ public:
   //! Get the minimum priority level.
   LogLevel::Level getFilter() const;
 
+  //! Check if a priority passes the filter
+  /*!
+  Returns true if messages of priority \c level would be printed.  This
+  is a single relaxed load so it's cheap enough to call before building
+  the arguments of every message on the input path;  the \c LOG_XXX
+  macros do exactly that.
+  */
+  bool isEnabled(LogLevel::Level level) const
+  {
+    return level <= m_maxPriority.load(std::memory_order_relaxed);
+  }
+
+  //! Check for asynchronous output
+  bool isAsync() const;
+
+  //! Get the number of messages dropped because the queue was full
+  uint64_t getDropped() const;
+
   //! Get the singleton instance of the log
-  static Log *getInstance();
+  static Log *getInstance()
+  {
+    assert(s_log != nullptr);
+    return s_log;
+  }
 
   //! Get the console filter level (messages above this are not sent to
   //! console).
@@ -119,17 +165,25 @@ public:
   //@}
 
 private:
+  class AsyncQueue;
+
   void output(LogLevel::Level priority, const char *msg);
+  void output(LogLevel::Level priority, int64_t time, const char *file, int line, const char *msg);
 
 private:
   using OutputterList = std::list<ILogOutputter *>;
 
   static Log *s_log;
 
+  // created on first use and kept until destruction so callers racing
+  // with setAsync(false) never see it disappear
+  std::unique_ptr<AsyncQueue> m_async;
+  std::atomic<AsyncQueue *> m_activeAsync = nullptr;
+
   mutable std::mutex m_mutex;
   OutputterList m_outputters;
   OutputterList m_alwaysOutputters;
-  LogLevel::Level m_maxPriority;
+  std::atomic<LogLevel::Level> m_maxPriority;
 };
 
 /*!
@@ -149,6 +203,10 @@ If \c NOLOGGING is defined during the build then this macro expands to
 nothing.  If \c NDEBUG is defined during the build then it expands to a
 call to Log::print.  Otherwise it expands to a call to Log::print,
 which includes the filename and line number.
+
+The arguments are always evaluated and the message is only filtered
+inside Log::print.  Prefer the \c LOG_XXX macros, which skip filtered
+messages before evaluating anything.
 */
 
 /*!
@@ -212,10 +270,45 @@ otherwise it expands to a call that doesn't.
 #define CLOG_DEBUG CLOG_TRACE CLOG_TAG_DEBUG
 #define CLOG_VERBOSE CLOG_TRACE CLOG_TAG_VERBOSE
 
-#define LOG_PRINT(...) LOG((CLOG_PRINT __VA_ARGS__))
-#define LOG_CRIT(...) LOG((CLOG_CRIT __VA_ARGS__))
-#define LOG_ERR(...) LOG((CLOG_ERR __VA_ARGS__))
-#define LOG_WARN(...) LOG((CLOG_WARN __VA_ARGS__))
-#define LOG_INFO(...) LOG((CLOG_INFO __VA_ARGS__))
-#define LOG_DEBUG(...) LOG((CLOG_DEBUG __VA_ARGS__))
-#define LOG_VERBOSE(...) LOG((CLOG_VERBOSE __VA_ARGS__))
+/*!
+\def LOG_COMPILE_LEVEL
+The most verbose level compiled into the build, as a LogLevel::Level
+ordinal.  \c LOG_XXX calls for more verbose levels compile to nothing,
+arguments included.  Set with the \c LOG_COMPILE_LEVEL CMake option;
+defaults to everything.
+*/
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL 5
+#endif
+
+/*!
+\def LOG_AT(level, arg)
+Write to the log at \c level if it is compiled in and passes the filter.
+The filter is checked with Log::isEnabled() before the arguments are
+evaluated, so a filtered message costs one atomic load.  \c arg is the
+same parenthesized list passed to LOG() and its tag must match \c level;
+use the \c LOG_XXX macros rather than calling this directly.
+*/
+
+#if defined(NOLOGGING)
+#define LOG_AT(_level, _a1)                                                                                            \
+  do {                                                                                                                 \
+  } while (false)
+#else
+#define LOG_AT(_level, _a1)                                                                                            \
+  do {                                                                                                                 \
+    if constexpr (static_cast<int>(_level) <= LOG_COMPILE_LEVEL) {                                                     \
+      if (CLOG->isEnabled(_level)) {                                                                                   \
+        CLOG->print _a1;                                                                                               \
+      }                                                                                                                \
+    }                                                                                                                  \
+  } while (false)
+#endif
+
+#define LOG_PRINT(...) LOG_AT(LogLevel::Level::Print, (CLOG_PRINT __VA_ARGS__))
+#define LOG_CRIT(...) LOG_AT(LogLevel::Level::Fatal, (CLOG_CRIT __VA_ARGS__))
+#define LOG_ERR(...) LOG_AT(LogLevel::Level::Error, (CLOG_ERR __VA_ARGS__))
+#define LOG_WARN(...) LOG_AT(LogLevel::Level::Warning, (CLOG_WARN __VA_ARGS__))
+#define LOG_INFO(...) LOG_AT(LogLevel::Level::Info, (CLOG_INFO __VA_ARGS__))
+#define LOG_DEBUG(...) LOG_AT(LogLevel::Level::Debug, (CLOG_DEBUG __VA_ARGS__))
+#define LOG_VERBOSE(...) LOG_AT(LogLevel::Level::Verbose, (CLOG_VERBOSE __VA_ARGS__))
@@ -13,7 +13,7 @@
 #include "base/Log.h"
 #include "client/ServerProxy.h"
 #include "common/NetworkProtocol.h"
-#include "common/Settings.h"
+#include "common/SettingsSnapshot.h"
 #include "deskflow/Clipboard.h"
 #include "deskflow/DeskflowException.h"
 #include "deskflow/IPlatformScreen.h"
@@ -23,7 +23,10 @@
 #include "deskflow/Screen.h"
 #include "deskflow/StreamChunker.h"
 #include "deskflow/ipc/CoreIpc.h"
+#include "net/HappyEyeballsConnector.h"
+#include "net/HostResolver.h"
 #include "net/IDataSocket.h"
+#include "net/IDatagramSocket.h"
 #include "net/ISocketFactory.h"
 #include "net/SecureSocket.h"
 #include "net/TCPSocket.h"
@@ -33,6 +36,17 @@
 #include <cstdlib>
 #include <cstring>
 
+namespace {
+
+// seconds to wait for the server's name to resolve
+constexpr auto kResolveTimeout = 5.0;
+
+// seconds to wait for a connection and the hello, plus the head start
+// given to each address before the next one joins the race
+constexpr auto kConnectTimeout = 2.0;
+
+} // namespace
+
 //
 // Client
 //
@@ -59,14 +73,17 @@ Client::Client(
       m_socketFactory(socketFactory),
       m_screen(screen),
       m_events(events),
-      m_useSecureNetwork(Settings::value(Settings::Security::TlsEnabled).toBool()),
+      m_useSecureNetwork(SettingsSnapshot::current()->security.tlsEnabled),
       m_maximumClipboardReceiveSize(
-          static_cast<size_t>(Settings::value(Settings::Server::ClipboardSize).toUInt()) * 1024 * 1024
+          static_cast<size_t>(SettingsSnapshot::current()->server.clipboardSize) * 1024 * 1024
       )
 {
   assert(m_socketFactory != nullptr);
   assert(m_screen != nullptr);
 
+  m_resolver = std::make_unique<HostResolver>(m_events);
+  m_events->addHandler(EventTypes::HostResolved, getEventTarget(), [this](const auto &e) { handleResolved(e); });
+
   // register suspend/resume event handlers
   m_events->addHandler(EventTypes::ScreenSuspend, getEventTarget(), [this](const auto &) { handleSuspend(); });
   m_events->addHandler(EventTypes::ScreenResume, getEventTarget(), [this](const auto &) { handleResume(); });
@@ -74,6 +91,7 @@ Client::Client(
 
 Client::~Client()
 {
+  m_events->removeHandler(EventTypes::HostResolved, getEventTarget());
   m_events->removeHandler(EventTypes::ScreenSuspend, getEventTarget());
   m_events->removeHandler(EventTypes::ScreenResume, getEventTarget());
 
@@ -89,9 +107,9 @@ void Client::setServerAddress(const NetworkAddress &address)
   m_serverAddress = address;
 }
 
-void Client::connect(size_t addressIndex)
+void Client::connect()
 {
-  if (m_stream != nullptr) {
+  if (m_stream != nullptr || isConnecting()) {
     return;
   }
   if (m_suspended) {
@@ -99,46 +117,16 @@ void Client::connect(size_t addressIndex)
     return;
   }
 
-  auto securityLevel = m_useSecureNetwork ? SecurityLevel::PeerAuth : SecurityLevel::PlainText;
-
-  try {
-    // resolve the server hostname.  do this every time we connect
-    // in case we couldn't resolve the address earlier or the address
-    // has changed (which can happen frequently if this is a laptop
-    // being shuttled between various networks).  patch by Brent
-    // Priddy.
-    m_resolvedAddressesCount = m_serverAddress.resolve(addressIndex);
-
-    // m_serverAddress will be null if the hostname address is not reolved
-    if (m_serverAddress.getAddress() != nullptr) {
-      // to help users troubleshoot, show server host name (issue: 60)
-      LOG_DEBUG(
-          "connecting to '%s': %s:%i", m_serverAddress.getHostname().c_str(),
-          ARCH->addrToString(m_serverAddress.getAddress()).c_str(), m_serverAddress.getPort()
-      );
-      ipcSendConnectionState(deskflow::core::ConnectionState::Connecting);
-    }
-
-    // create the socket
-    IDataSocket *socket = m_socketFactory->create(ARCH->getAddrFamily(m_serverAddress.getAddress()), securityLevel);
-    bindNetworkInterface(socket);
-
-    // filter socket messages, including a packetizing filter
-    m_stream = new PacketStreamFilter(m_events, socket, true);
-
-    // connect
-    LOG_VERBOSE("connecting to server");
-    setupConnecting();
-    setupTimer();
-    socket->connect(m_serverAddress);
-  } catch (BaseException &e) {
-    cleanupTimer();
-    cleanupConnecting();
-    cleanupStream();
-    LOG_VERBOSE("connection failed");
-    sendConnectionFailedEvent(e.what());
-    return;
-  }
+  // resolve the server hostname.  do this every time we connect
+  // in case we couldn't resolve the address earlier or the address
+  // has changed (which can happen frequently if this is a laptop
+  // being shuttled between various networks).  patch by Brent
+  // Priddy.  the lookup runs in the background so a slow resolver
+  // can't hold up the event loop; if it outlasts the timeout the
+  // result is still cached for the next attempt.
+  LOG_VERBOSE("resolving '%s'", m_serverAddress.getHostname().c_str());
+  setupTimer(kResolveTimeout);
+  m_resolveId = m_resolver->resolve(m_serverAddress, getEventTarget());
 }
 
 void Client::disconnect(const char *msg)
@@ -192,6 +180,11 @@ NetworkAddress Client::getServerAddress() const
   return m_serverAddress;
 }
 
+ClipboardPartials &Client::getClipboardPartials()
+{
+  return m_clipboardPartials;
+}
+
 size_t Client::getMaximumClipboardReceiveSizeBytes() const
 {
   return m_maximumClipboardReceiveSize;
@@ -423,24 +416,6 @@ void Client::sendConnectionFailedEvent(const char *msg)
   m_events->addEvent(std::move(event));
 }
 
-void Client::setupConnecting()
-{
-  assert(m_stream != nullptr);
-
-  if (Settings::value(Settings::Security::TlsEnabled).toBool()) {
-    m_events->addHandler(EventTypes::DataSocketSecureConnected, m_stream->getEventTarget(), [this](const auto &) {
-      handleConnected();
-    });
-  } else {
-    m_events->addHandler(EventTypes::DataSocketConnected, m_stream->getEventTarget(), [this](const auto &) {
-      handleConnected();
-    });
-  }
-  m_events->addHandler(EventTypes::DataSocketConnectionFailed, m_stream->getEventTarget(), [this](const auto &e) {
-    handleConnectionFailed(e);
-  });
-}
-
 void Client::setupConnection()
 {
   assert(m_stream != nullptr);
@@ -470,19 +445,22 @@ void Client::setupScreen()
   assert(m_server == nullptr);
 
   m_ready = false;
-  m_server = new ServerProxy(this, m_stream, m_events);
+  m_server = new ServerProxy(this, m_stream, m_events, [this](int port) { return newMotionSocket(port); });
   m_events->addHandler(EventTypes::ScreenShapeChanged, getEventTarget(), [this](const auto &) {
     handleShapeChanged();
   });
   m_events->addHandler(EventTypes::ClipboardGrabbed, getEventTarget(), [this](const auto &e) {
     handleClipboardGrabbed(e);
   });
+  m_events->addHandler(EventTypes::ClipboardChanged, getEventTarget(), [this](const auto &e) {
+    handleClipboardChanged(e);
+  });
 }
 
-void Client::setupTimer()
+void Client::setupTimer(double timeout)
 {
   assert(m_timer == nullptr);
-  m_timer = m_events->newOneShotTimer(2.0, nullptr);
+  m_timer = m_events->newOneShotTimer(timeout, nullptr);
   m_events->addHandler(EventTypes::Timer, m_timer, [this](const auto &) { handleConnectTimeout(); });
 }
 
@@ -497,11 +475,9 @@ void Client::cleanup()
 
 void Client::cleanupConnecting()
 {
-  if (m_stream != nullptr) {
-    m_events->removeHandler(EventTypes::DataSocketConnected, m_stream->getEventTarget());
-    m_events->removeHandler(EventTypes::DataSocketSecureConnected, m_stream->getEventTarget());
-    m_events->removeHandler(EventTypes::DataSocketConnectionFailed, m_stream->getEventTarget());
-  }
+  // disregard any lookup still in progress and close pending attempts
+  m_resolveId = 0;
+  m_connector.reset();
 }
 
 void Client::cleanupConnection()
@@ -527,6 +503,7 @@ void Client::cleanupScreen()
     }
     m_events->removeHandler(EventTypes::ScreenShapeChanged, getEventTarget());
     m_events->removeHandler(EventTypes::ClipboardGrabbed, getEventTarget());
+    m_events->removeHandler(EventTypes::ClipboardChanged, getEventTarget());
     delete m_server;
     m_server = nullptr;
   }
@@ -547,10 +524,65 @@ void Client::cleanupStream()
   m_stream = nullptr;
 }
 
-void Client::handleConnected()
+void Client::handleResolved(const Event &event)
+{
+  const auto *result = static_cast<const HostResolver::Result *>(event.getDataObject());
+  if (result->m_id != m_resolveId) {
+    LOG_VERBOSE("disregarding stale lookup");
+    return;
+  }
+  m_resolveId = 0;
+
+  cleanupTimer();
+  if (result->m_addresses.empty()) {
+    LOG_VERBOSE("connection failed");
+    sendConnectionFailedEvent(result->m_error.c_str());
+    return;
+  }
+
+  auto candidates = HappyEyeballsConnector::interleave(result->m_addresses);
+
+  // to help users troubleshoot, show server host name (issue: 60)
+  LOG_DEBUG(
+      "connecting to '%s': %s:%i (%zu addresses)", m_serverAddress.getHostname().c_str(),
+      ARCH->addrToString(candidates.front().getAddress()).c_str(), m_serverAddress.getPort(), candidates.size()
+  );
+  ipcSendConnectionState(deskflow::core::ConnectionState::Connecting);
+
+  auto securityLevel = m_useSecureNetwork ? SecurityLevel::PeerAuth : SecurityLevel::PlainText;
+  auto createSocket = [this, securityLevel](const NetworkAddress &address) {
+    IDataSocket *socket = m_socketFactory->create(ARCH->getAddrFamily(address.getAddress()), securityLevel);
+    try {
+      bindNetworkInterface(socket);
+    } catch (...) {
+      delete socket;
+      throw;
+    }
+    return socket;
+  };
+
+  // a secure connection isn't usable until the handshake is done, so
+  // race all the way to that
+  auto connectedEvent = m_useSecureNetwork ? EventTypes::DataSocketSecureConnected : EventTypes::DataSocketConnected;
+
+  LOG_VERBOSE("connecting to server");
+  setupTimer(kConnectTimeout + HappyEyeballsConnector::kAttemptDelay * static_cast<double>(candidates.size() - 1));
+  m_connector = std::make_unique<HappyEyeballsConnector>(m_events, createSocket, connectedEvent);
+  m_connector->connect(
+      std::move(candidates),
+      [this](IDataSocket *socket, const NetworkAddress &address) { handleConnected(socket, address); },
+      [this](const std::string &what) { handleConnectionFailed(what); }
+  );
+}
+
+void Client::handleConnected(IDataSocket *socket, const NetworkAddress &address)
 {
   LOG_VERBOSE("connected, waiting for hello");
   cleanupConnecting();
+  m_connectedAddress = address;
+
+  // filter socket messages, including a packetizing filter
+  m_stream = new PacketStreamFilter(m_events, socket, true);
   setupConnection();
 
   // reset clipboard state
@@ -561,16 +593,12 @@ void Client::handleConnected()
   }
 }
 
-void Client::handleConnectionFailed(const Event &event)
+void Client::handleConnectionFailed(const std::string &what)
 {
-  auto *info = static_cast<IDataSocket::ConnectionFailedInfo *>(event.getData());
-
   cleanupTimer();
   cleanupConnecting();
-  cleanupStream();
   LOG_VERBOSE("connection failed");
-  sendConnectionFailedEvent(info->m_what.c_str());
-  delete info;
+  sendConnectionFailedEvent(what.c_str());
 }
 
 void Client::handleConnectTimeout()
@@ -645,6 +673,20 @@ void Client::handleClipboardGrabbed(const Event &event)
   }
 }
 
+void Client::handleClipboardChanged(const Event &event)
+{
+  if (!m_enableClipboard || (m_maximumClipboardSize == 0)) {
+    return;
+  }
+
+  // the screen got the data after we last sent the clipboard, send it
+  // again unless we'll do that when we leave anyway
+  const auto *info = static_cast<const IScreen::ClipboardInfo *>(event.getData());
+  if (m_ownClipboard[info->m_id] && !m_active) {
+    sendClipboard(info->m_id);
+  }
+}
+
 void Client::handleHello()
 {
   int16_t serverMajor;
@@ -718,6 +760,9 @@ void Client::handleResume()
   if (m_suspended) {
     LOG_INFO("resume");
     m_suspended = false;
+
+    // we may have woken up on a different network
+    m_resolver->clear();
     if (m_connectOnResume) {
       m_connectOnResume = false;
       connect();
@@ -725,9 +770,9 @@ void Client::handleResume()
   }
 }
 
-void Client::bindNetworkInterface(IDataSocket *socket) const
+void Client::bindNetworkInterface(ISocket *socket) const
 {
-  const auto address = Settings::value(Settings::Core::Interface).toString();
+  const auto address = SettingsSnapshot::current()->core.interfaceAddress;
   if (address.isEmpty())
     return;
 
@@ -738,3 +783,17 @@ void Client::bindNetworkInterface(IDataSocket *socket) const
 
   socket->bind(bindAddress);
 }
+
+IDatagramSocket *Client::newMotionSocket(int port) const
+{
+  // same server address as the connection, so the same path
+  std::unique_ptr<IDatagramSocket> socket(
+      m_socketFactory->createDatagram(ARCH->getAddrFamily(m_connectedAddress.getAddress()))
+  );
+  bindNetworkInterface(socket.get());
+
+  NetworkAddress address(ARCH->addrToString(m_connectedAddress.getAddress()), port);
+  address.resolve();
+  socket->connect(address);
+  return socket.release();
+}
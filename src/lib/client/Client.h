@@ -13,19 +13,25 @@
 #include "base/Event.h"
 #include "base/EventTypes.h"
 #include "common/Enums.h"
+#include "deskflow/ClipboardPartials.h"
 #include "deskflow/IClipboard.h"
 #include "net/NetworkAddress.h"
 
 #include <climits>
+#include <memory>
 #include <string>
 
 class Event;
 class EventQueueTimer;
+class HappyEyeballsConnector;
+class HostResolver;
 namespace deskflow {
 class Screen;
 }
 class ServerProxy;
 class IDataSocket;
+class IDatagramSocket;
+class ISocket;
 class ISocketFactory;
 namespace deskflow {
 class IStream;
@@ -108,9 +114,12 @@ public:
   //! Connect to server
   /*!
   Starts an attempt to connect to the server.  This is ignored if
-  the client is trying to connect or is already connected.
+  the client is trying to connect or is already connected.  The
+  server's name is resolved in the background and every address it
+  resolves to is tried, so a failure means none of them could be
+  reached.
   */
-  void connect(size_t addressIndex = 0);
+  void connect();
   void setServerAddress(const NetworkAddress &address);
 
   //! Disconnect
@@ -132,6 +141,13 @@ public:
   */
   virtual void handshakeComplete();
 
+  //! Get the clipboard transfers partly received from the server
+  /*!
+  Kept across reconnects, so a transfer interrupted by the connection
+  dropping can resume once connected again.
+  */
+  ClipboardPartials &getClipboardPartials();
+
   //@}
   //! @name accessors
   //@{
@@ -156,11 +172,6 @@ public:
   */
   NetworkAddress getServerAddress() const;
 
-  //! Return last resolved adresses count
-  size_t getLastResolvedAddressesCount() const
-  {
-    return m_resolvedAddressesCount;
-  }
   size_t getMaximumClipboardReceiveSizeBytes() const;
 
   //@}
@@ -195,37 +206,43 @@ private:
   void sendClipboard(ClipboardID);
   void sendEvent(deskflow::EventTypes);
   void sendConnectionFailedEvent(const char *msg);
-  void setupConnecting();
   void setupConnection();
   void setupScreen();
-  void setupTimer();
+  void setupTimer(double timeout);
   void cleanup();
   void cleanupConnecting();
   void cleanupConnection();
   void cleanupScreen();
   void cleanupTimer();
   void cleanupStream();
-  void handleConnected();
-  void handleConnectionFailed(const Event &event);
+  void handleResolved(const Event &event);
+  void handleConnected(IDataSocket *socket, const NetworkAddress &address);
+  void handleConnectionFailed(const std::string &what);
   void handleConnectTimeout();
   void handleOutputError();
   void handleDisconnected();
   void handleDisconnectRequested(const Event &event);
   void handleShapeChanged();
   void handleClipboardGrabbed(const Event &event);
+  void handleClipboardChanged(const Event &event);
   void handleHello();
   void handleSuspend();
   void handleResume();
   void sendClipboardThread(void *);
-  void bindNetworkInterface(IDataSocket *socket) const;
+  void bindNetworkInterface(ISocket *socket) const;
+  IDatagramSocket *newMotionSocket(int port) const;
 
 private:
   std::string m_name;
   NetworkAddress m_serverAddress;
+  NetworkAddress m_connectedAddress;
   ISocketFactory *m_socketFactory = nullptr;
   deskflow::Screen *m_screen = nullptr;
   deskflow::IStream *m_stream = nullptr;
   EventQueueTimer *m_timer = nullptr;
+  std::unique_ptr<HostResolver> m_resolver;
+  uint64_t m_resolveId = 0;
+  std::unique_ptr<HappyEyeballsConnector> m_connector;
   ServerProxy *m_server = nullptr;
   bool m_ready = false;
   bool m_active = false;
@@ -235,6 +252,7 @@ private:
   bool m_sentClipboard[kClipboardEnd];
   IClipboard::Time m_timeClipboard[kClipboardEnd];
   std::string m_dataClipboard[kClipboardEnd];
+  ClipboardPartials m_clipboardPartials;
   IEventQueue *m_events = nullptr;
   bool m_useSecureNetwork = false;
   bool m_enableClipboard = true;
@@ -244,5 +262,4 @@ private:
   int32_t m_relativeRestoreY = 0;
   size_t m_maximumClipboardReceiveSize = 0;
   size_t m_maximumClipboardSize = INT_MAX;
-  size_t m_resolvedAddressesCount = 0;
 };
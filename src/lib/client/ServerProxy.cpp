@@ -8,29 +8,39 @@
 
 #include "client/ServerProxy.h"
 
+#include "base/BaseException.h"
 #include "base/IEventQueue.h"
+#include "base/LatencyHistogram.h"
 #include "base/Log.h"
 #include "client/Client.h"
 #include "deskflow/Clipboard.h"
 #include "deskflow/ClipboardChunk.h"
+#include "deskflow/ClipboardView.h"
 #include "deskflow/DeskflowException.h"
+#include "deskflow/InputBatch.h"
 #include "deskflow/OptionTypes.h"
+#include "deskflow/PacketStreamFilter.h"
 #include "deskflow/ProtocolTypes.h"
 #include "deskflow/ProtocolUtil.h"
-#include "deskflow/StreamChunker.h"
 #include "deskflow/ipc/CoreIpc.h"
 #include "io/IStream.h"
+#include "io/MemoryStream.h"
+#include "net/IDatagramSocket.h"
 
 #include <cstring>
+#include <utility>
 
 //
 // ServerProxy
 //
 
-ServerProxy::ServerProxy(Client *client, deskflow::IStream *stream, IEventQueue *events)
+ServerProxy::ServerProxy(
+    Client *client, deskflow::IStream *stream, IEventQueue *events, const MotionChannel::SocketFactory &motionSockets
+)
     : m_client(client),
       m_stream(stream),
-      m_events(events)
+      m_events(events),
+      m_motionSockets(motionSockets)
 {
   assert(m_client != nullptr);
   assert(m_stream != nullptr);
@@ -39,12 +49,17 @@ ServerProxy::ServerProxy(Client *client, deskflow::IStream *stream, IEventQueue
   for (KeyModifierID id = 0; id < kKeyModifierIDLast; ++id)
     m_modifierTranslationTable[id] = id;
 
+  if (auto *filter = dynamic_cast<PacketStreamFilter *>(m_stream); filter != nullptr) {
+    filter->setStats(&m_stats);
+  }
+
   // handle data on stream
   m_events->addHandler(EventTypes::StreamInputReady, m_stream->getEventTarget(), [this](const auto &) {
     handleData();
   });
   m_events->addHandler(EventTypes::ClipboardSending, this, [this](const auto &e) {
     ClipboardChunk::send(m_stream, e.getDataObject());
+    m_clipboardChunker.sent();
   });
 
   // send heartbeat
@@ -56,6 +71,16 @@ ServerProxy::~ServerProxy()
   setKeepAliveRate(-1.0);
   m_events->removeHandler(EventTypes::StreamInputReady, m_stream->getEventTarget());
   m_events->removeHandler(EventTypes::ClipboardSending, this);
+
+  // a resumable transfer cut short can carry on once reconnected
+  if (m_clipboardChunkState.active && m_clipboardChunkState.transferId != 0) {
+    m_client->getClipboardPartials().keep(m_clipboardChunkState, std::move(m_clipboardDataCached));
+  }
+
+  // the stream is owned by the client and may outlive us
+  if (auto *filter = dynamic_cast<PacketStreamFilter *>(m_stream); filter != nullptr) {
+    filter->setStats(nullptr);
+  }
 }
 
 void ServerProxy::resetKeepAliveAlarm()
@@ -82,6 +107,7 @@ void ServerProxy::handleData()
   // handle messages until there are no more.  first read message code.
   uint8_t code[4];
   uint32_t n = m_stream->read(code, 4);
+  m_receiveTime = LatencyHistogram::now();
   while (n != 0) {
     // verify we got an entire code
     if (n != 4) {
@@ -92,10 +118,15 @@ void ServerProxy::handleData()
 
     // parse message
     LOG_VERBOSE("msg from server: %c%c%c%c", code[0], code[1], code[2], code[3]);
+    const bool isInputTime = memcmp(code, kMsgDInputTime, 4) == 0;
     try {
       switch ((this->*m_parser)(code)) {
         using enum ConnectionResult;
       case Okay:
+        // an input time only applies to the message right after it
+        if (!isInputTime) {
+          m_inputTime = 0;
+        }
         break;
 
       case Unknown:
@@ -210,15 +241,57 @@ ServerProxy::ConnectionResult ServerProxy::parseMessage(const uint8_t *code)
   using enum ConnectionResult;
 
   if (memcmp(code, kMsgDMouseMove, 4) == 0) {
-    mouseMove();
+    int16_t x = 0;
+    int16_t y = 0;
+    ProtocolUtil::readf(m_stream, kMsgDMouseMove + 4, &x, &y);
+    mouseMove(x, y);
+  }
+
+  else if (memcmp(code, kMsgDMouseMoveDelta, 4) == 0) {
+    int32_t dx = 0;
+    int32_t dy = 0;
+    ProtocolUtil::readf(m_stream, kMsgDMouseMoveDelta + 4, &dx, &dy);
+    mouseMove(m_xLastMove + dx, m_yLastMove + dy);
+  }
+
+  else if (memcmp(code, kMsgDMouseMoveSync, 4) == 0) {
+    mouseMoveSync();
   }
 
   else if (memcmp(code, kMsgDMouseRelMove, 4) == 0) {
-    mouseRelativeMove();
+    int16_t dx = 0;
+    int16_t dy = 0;
+    ProtocolUtil::readf(m_stream, kMsgDMouseRelMove + 4, &dx, &dy);
+    mouseRelativeMove(dx, dy);
+  }
+
+  else if (memcmp(code, kMsgDMouseRelMoveCompact, 4) == 0) {
+    int32_t dx = 0;
+    int32_t dy = 0;
+    ProtocolUtil::readf(m_stream, kMsgDMouseRelMoveCompact + 4, &dx, &dy);
+    mouseRelativeMove(dx, dy);
   }
 
   else if (memcmp(code, kMsgDMouseWheel, 4) == 0) {
-    mouseWheel();
+    int16_t xDelta = 0;
+    int16_t yDelta = 0;
+    ProtocolUtil::readf(m_stream, kMsgDMouseWheel + 4, &xDelta, &yDelta);
+    mouseWheel(xDelta, yDelta);
+  }
+
+  else if (memcmp(code, kMsgDMouseWheelCompact, 4) == 0) {
+    int32_t xDelta = 0;
+    int32_t yDelta = 0;
+    ProtocolUtil::readf(m_stream, kMsgDMouseWheelCompact + 4, &xDelta, &yDelta);
+    mouseWheel(xDelta, yDelta);
+  }
+
+  else if (memcmp(code, kMsgDInputTime, 4) == 0) {
+    inputTime();
+  }
+
+  else if (memcmp(code, kMsgDInputBatch, 4) == 0) {
+    inputBatch();
   }
 
   else if (memcmp(code, kMsgDKeyDown, 4) == 0) {
@@ -243,6 +316,24 @@ ServerProxy::ConnectionResult ServerProxy::parseMessage(const uint8_t *code)
     keyDown(id, mask, button, lang);
   }
 
+  else if (memcmp(code, kMsgDKeyDownLangId, 4) == 0) {
+    uint16_t id = 0;
+    uint16_t mask = 0;
+    uint16_t button = 0;
+    uint8_t index = 0;
+
+    ProtocolUtil::readf(m_stream, kMsgDKeyDownLangId + 4, &id, &mask, &button, &index);
+    const auto &languages = m_layoutManager.getRemoteLayouts();
+    if (index >= languages.size()) {
+      throw BadClientException("key down with unknown language");
+    }
+    LOG_VERBOSE(
+        "recv key down id=0x%08x, mask=0x%04x, button=0x%04x, lang=\"%s\"", id, mask, button, languages[index].c_str()
+    );
+
+    keyDown(id, mask, button, languages[index]);
+  }
+
   else if (memcmp(code, kMsgDKeyUp, 4) == 0) {
     keyUp();
   }
@@ -263,6 +354,15 @@ ServerProxy::ConnectionResult ServerProxy::parseMessage(const uint8_t *code)
     // echo keep alives and reset alarm
     ProtocolUtil::writef(m_stream, kMsgCKeepAlive);
     resetKeepAliveAlarm();
+
+    // piggyback a clock sample if the server understands them
+    if (m_keepAliveTimestamps) {
+      sendKeepAliveTime();
+    }
+  }
+
+  else if (memcmp(code, kMsgCKeepAliveTime, 4) == 0) {
+    keepAliveTime();
   }
 
   else if (memcmp(code, kMsgCNoop, 4) == 0) {
@@ -297,6 +397,10 @@ ServerProxy::ConnectionResult ServerProxy::parseMessage(const uint8_t *code)
     setClipboard();
   }
 
+  else if (memcmp(code, kMsgDClipboardResume, 4) == 0) {
+    clipboardResume();
+  }
+
   else if (memcmp(code, kMsgCResetOptions, 4) == 0) {
     resetOptions();
   }
@@ -374,10 +478,33 @@ bool ServerProxy::onGrabClipboard(ClipboardID id)
 
 void ServerProxy::onClipboardChanged(ClipboardID id, const IClipboard *clipboard)
 {
-  std::string data = IClipboard::marshall(clipboard);
+  auto snapshot = Clipboard::snapshotOf(clipboard);
   LOG_DEBUG("sending clipboard %d seqnum=%d", id, m_seqNum);
 
-  StreamChunker::sendClipboard(data, data.size(), id, m_seqNum, m_events, this);
+  m_clipboardChunker.sendClipboard(
+      std::move(snapshot), id, m_seqNum, m_clipboardResume ? &m_clipboardResumePoints[id] : nullptr
+  );
+}
+
+void ServerProxy::sendKeepAliveTime()
+{
+  const uint64_t now = LatencyHistogram::now();
+  ProtocolUtil::writef(
+      m_stream, kMsgCKeepAliveTime, static_cast<uint32_t>(now >> 32), static_cast<uint32_t>(now), 0, 0, 0, 0
+  );
+}
+
+void ServerProxy::recordInputAge(uint64_t captureTime)
+{
+  if (captureTime == 0 || !m_clock.isValid()) {
+    return;
+  }
+
+  // the capture time is on the server's clock
+  const auto captured = m_clock.toLocal(static_cast<int64_t>(captureTime));
+  const auto age = static_cast<int64_t>(LatencyHistogram::now()) - captured;
+  m_stats.latency(ConnectionStats::Stage::Age).record(age > 0 ? static_cast<uint64_t>(age) : 0);
+  LOG_VERBOSE("input age %.3fms", static_cast<double>(age) / 1.0e6);
 }
 
 void ServerProxy::flushCompressedMouse()
@@ -385,10 +512,14 @@ void ServerProxy::flushCompressedMouse()
   if (m_compressMouse) {
     m_compressMouse = false;
     m_client->mouseMove(m_xMouse, m_yMouse);
+    m_stats.latency(ConnectionStats::Stage::Inject).recordSince(m_receiveTime);
+    recordInputAge(m_compressedInputTime);
   }
   if (m_compressMouseRelative) {
     m_compressMouseRelative = false;
     m_client->mouseRelativeMove(m_dxMouse, m_dyMouse);
+    m_stats.latency(ConnectionStats::Stage::Inject).recordSince(m_receiveTime);
+    recordInputAge(m_compressedInputTime);
     m_dxMouse = 0;
     m_dyMouse = 0;
   }
@@ -521,6 +652,8 @@ void ServerProxy::enter()
   m_dxMouse = 0;
   m_dyMouse = 0;
   m_seqNum = seqNum;
+  m_xLastMove = x;
+  m_yLastMove = y;
   m_serverLayout = "";
   m_isUserNotifiedAboutLayoutSyncError = false;
 
@@ -547,7 +680,8 @@ void ServerProxy::setClipboard()
   uint32_t seq;
 
   auto r = ClipboardChunk::assemble(
-      m_stream, m_clipboardDataCached, id, seq, m_clipboardChunkState, m_client->getMaximumClipboardReceiveSizeBytes()
+      m_stream, m_clipboardDataCached, id, seq, m_clipboardChunkState, m_client->getMaximumClipboardReceiveSizeBytes(),
+      &m_client->getClipboardPartials()
   );
 
   if (r == TransferState::Started) {
@@ -556,12 +690,13 @@ void ServerProxy::setClipboard()
   } else if (r == TransferState::Finished) {
     LOG_DEBUG("received clipboard %d size=%zu", id, m_clipboardDataCached.size());
 
-    // forward
-    Clipboard clipboard;
-    clipboard.unmarshall(m_clipboardDataCached, 0);
+    // forward, reading the data in place.  the buffer is handed over
+    // with the view so a screen's clipboard that keeps shared data
+    // holds on to it rather than copying each format.
+    auto received = std::make_shared<const ClipboardBuffer>(std::move(m_clipboardDataCached));
+    ClipboardView clipboard(received->view(), 0, received);
     m_client->setClipboard(id, &clipboard);
     m_clipboardDataCached.clear();
-    m_clipboardDataCached.shrink_to_fit();
 
     LOG_INFO("clipboard was updated");
   } else if (r == TransferState::Error) {
@@ -569,6 +704,21 @@ void ServerProxy::setClipboard()
   }
 }
 
+void ServerProxy::clipboardResume()
+{
+  // the server only sends these once we've sent ours, so it resumes too
+  ClipboardID id;
+  ClipboardResumePoint point;
+  if (!ClipboardPartials::readOffset(m_stream, id, point)) {
+    requestDisconnect("invalid clipboard resume from server");
+    return;
+  }
+  LOG_DEBUG("recv clipboard %d resume offset=%u", id, point.offset);
+
+  m_clipboardResume = true;
+  m_clipboardResumePoints[id] = point;
+}
+
 void ServerProxy::grabClipboard()
 {
   // parse
@@ -680,16 +830,14 @@ void ServerProxy::mouseUp()
   m_client->mouseUp(static_cast<ButtonID>(id));
 }
 
-void ServerProxy::mouseMove()
+void ServerProxy::mouseMove(int32_t x, int32_t y)
 {
-  // parse
-  bool ignore;
-  int16_t x;
-  int16_t y;
-  ProtocolUtil::readf(m_stream, kMsgDMouseMove + 4, &x, &y);
+  // later compact moves are relative to this one, even if it's ignored
+  m_xLastMove = x;
+  m_yLastMove = y;
 
   // note if we should ignore the move
-  ignore = m_ignoreMouse;
+  bool ignore = m_ignoreMouse;
 
   // compress mouse motion events if more input follows
   if (!ignore && !m_compressMouse && m_stream->isReady()) {
@@ -702,6 +850,7 @@ void ServerProxy::mouseMove()
     ignore = true;
     m_xMouse = x;
     m_yMouse = y;
+    m_compressedInputTime = m_inputTime;
     m_dxMouse = 0;
     m_dyMouse = 0;
   }
@@ -710,19 +859,30 @@ void ServerProxy::mouseMove()
   // forward
   if (!ignore) {
     m_client->mouseMove(x, y);
+    m_stats.latency(ConnectionStats::Stage::Inject).recordSince(m_receiveTime);
+    recordInputAge(m_inputTime);
   }
 }
 
-void ServerProxy::mouseRelativeMove()
+void ServerProxy::mouseMoveSync()
 {
-  // parse
-  bool ignore;
-  int16_t dx;
-  int16_t dy;
-  ProtocolUtil::readf(m_stream, kMsgDMouseRelMove + 4, &dx, &dy);
+  uint32_t sequence = 0;
+  int16_t x = 0;
+  int16_t y = 0;
+  ProtocolUtil::readf(m_stream, kMsgDMouseMoveSync + 4, &sequence, &x, &y);
+  LOG_VERBOSE("recv mouse move sync %d,%d sequence=%u", x, y, sequence);
+
+  // motion on the channel up to here is out of date
+  if (m_motionChannel != nullptr) {
+    m_motionChannel->sync(sequence);
+  }
+  mouseMove(x, y);
+}
 
+void ServerProxy::mouseRelativeMove(int32_t dx, int32_t dy)
+{
   // note if we should ignore the move
-  ignore = m_ignoreMouse;
+  bool ignore = m_ignoreMouse;
 
   // compress mouse motion events if more input follows
   if (!ignore && !m_compressMouseRelative && m_stream->isReady()) {
@@ -734,28 +894,112 @@ void ServerProxy::mouseRelativeMove()
     ignore = true;
     m_dxMouse += dx;
     m_dyMouse += dy;
+    m_compressedInputTime = m_inputTime;
   }
   LOG_VERBOSE("recv mouse relative move %d,%d", dx, dy);
 
   // forward
   if (!ignore) {
     m_client->mouseRelativeMove(dx, dy);
+    m_stats.latency(ConnectionStats::Stage::Inject).recordSince(m_receiveTime);
+    recordInputAge(m_inputTime);
   }
 }
 
-void ServerProxy::mouseWheel()
+void ServerProxy::mouseWheel(int32_t xDelta, int32_t yDelta)
 {
   // get mouse up to date
   flushCompressedMouse();
 
-  // parse
-  int16_t xDelta;
-  int16_t yDelta;
-  ProtocolUtil::readf(m_stream, kMsgDMouseWheel + 4, &xDelta, &yDelta);
   LOG_VERBOSE("recv mouse wheel %+d,%+d", xDelta, yDelta);
 
   // forward
   m_client->mouseWheel(xDelta, yDelta);
+  m_stats.latency(ConnectionStats::Stage::Inject).recordSince(m_receiveTime);
+  recordInputAge(m_inputTime);
+}
+
+void ServerProxy::keepAliveTime()
+{
+  const uint64_t now = LatencyHistogram::now();
+
+  uint32_t originateHi;
+  uint32_t originateLo;
+  uint32_t receiveHi;
+  uint32_t receiveLo;
+  uint32_t transmitHi;
+  uint32_t transmitLo;
+  ProtocolUtil::readf(
+      m_stream, kMsgCKeepAliveTime + 4, &originateHi, &originateLo, &receiveHi, &receiveLo, &transmitHi, &transmitLo
+  );
+
+  const auto originate = static_cast<int64_t>((uint64_t{originateHi} << 32) | originateLo);
+  const auto receive = static_cast<int64_t>((uint64_t{receiveHi} << 32) | receiveLo);
+  const auto transmit = static_cast<int64_t>((uint64_t{transmitHi} << 32) | transmitLo);
+
+  if (receive == 0 && transmit == 0) {
+    // the server wants a clock sample of its own
+    const uint64_t reply = LatencyHistogram::now();
+    ProtocolUtil::writef(
+        m_stream, kMsgCKeepAliveTime, originateHi, originateLo, static_cast<uint32_t>(now >> 32),
+        static_cast<uint32_t>(now), static_cast<uint32_t>(reply >> 32), static_cast<uint32_t>(reply)
+    );
+    return;
+  }
+
+  // a reply to one of our requests
+  m_clock.addSample(originate, receive, transmit, static_cast<int64_t>(now));
+  m_stats.setClock(m_clock.rtt(), m_clock.offset());
+  LOG_VERBOSE(
+      "recv keep alive time, rtt=%.3fms offset=%.3fms", static_cast<double>(m_clock.rtt()) / 1.0e6,
+      static_cast<double>(m_clock.offset()) / 1.0e6
+  );
+}
+
+void ServerProxy::inputTime()
+{
+  uint32_t captureHi;
+  uint32_t captureLo;
+  ProtocolUtil::readf(m_stream, kMsgDInputTime + 4, &captureHi, &captureLo);
+  m_inputTime = (uint64_t{captureHi} << 32) | captureLo;
+}
+
+void ServerProxy::inputBatch()
+{
+  uint32_t baseHi;
+  uint32_t baseLo;
+  std::string records;
+  ProtocolUtil::readf(m_stream, kMsgDInputBatch + 4, &baseHi, &baseLo, &records);
+  LOG_VERBOSE("recv input batch size=%d", records.size());
+
+  // unpack the records with the usual handlers by reading them from the
+  // batch instead of the connection
+  deskflow::MemoryStream batch(records);
+  deskflow::IStream *stream = std::exchange(m_stream, &batch);
+  try {
+    uint64_t time = (uint64_t{baseHi} << 32) | baseLo;
+    while (batch.isReady()) {
+      uint64_t delta;
+      uint8_t code[4];
+      if (!InputBatch::readDelta(&batch, delta) || batch.read(code, 4) != 4) {
+        throw BadClientException("truncated input batch");
+      }
+      if (!InputBatch::isBatchable(code)) {
+        throw BadClientException("input batch contains a message that isn't input");
+      }
+
+      time += delta * 1000;
+      m_inputTime = time;
+      LOG_VERBOSE("batched msg from server: %c%c%c%c", code[0], code[1], code[2], code[3]);
+      if (parseMessage(code) != ConnectionResult::Okay) {
+        throw BadClientException("invalid message in input batch");
+      }
+    }
+  } catch (...) {
+    m_stream = stream;
+    throw;
+  }
+  m_stream = stream;
 }
 
 void ServerProxy::screensaver()
@@ -779,6 +1023,7 @@ void ServerProxy::resetOptions()
 
   // reset keep alive
   setKeepAliveRate(kKeepAliveRate);
+  m_keepAliveTimestamps = false;
 
   // reset modifier translation table
   for (KeyModifierID id = 0; id < kKeyModifierIDLast; ++id) {
@@ -819,6 +1064,17 @@ void ServerProxy::setOptions()
     } else if (options[i] == kOptionHeartbeat) {
       // update keep alive
       setKeepAliveRate(1.0e-3 * static_cast<double>(options[i + 1]));
+    } else if (options[i] == kOptionKeepAliveTimestamps) {
+      m_keepAliveTimestamps = options[i + 1] != 0;
+    } else if (options[i] == kOptionInputBatch && options[i + 1] != 0) {
+      // an empty batch tells the server we can unpack them
+      std::string none;
+      ProtocolUtil::writef(m_stream, kMsgDInputBatch, 0, 0, &none);
+    } else if (options[i] == kOptionClipboardResume && options[i + 1] != 0) {
+      // reporting what we kept tells the server we can resume transfers
+      m_client->getClipboardPartials().sendOffsets(m_stream);
+    } else if (options[i] == kOptionMotionChannel) {
+      openMotionChannel(static_cast<int>(options[i + 1]));
     }
 
     if (id != kKeyModifierIDNull) {
@@ -876,3 +1132,40 @@ void ServerProxy::setActiveServerLanguage(const std::string_view &language)
     LOG_VERBOSE("active server layout is empty");
   }
 }
+
+void ServerProxy::openMotionChannel(int port)
+{
+  // one try per connection, the server stops offering once we've asked
+  if (!m_motionSockets || port <= 0 || port > 65535) {
+    return;
+  }
+  const auto motionSockets = std::exchange(m_motionSockets, nullptr);
+
+  std::unique_ptr<IDatagramSocket> socket;
+  try {
+    socket.reset(motionSockets(port));
+  } catch (BaseException &e) {
+    LOG_WARN("can't open motion channel: %s", e.what());
+    return;
+  }
+
+  LOG_DEBUG("opening motion channel on port %d", port);
+  const auto key = MotionChannel::newKey();
+  ProtocolUtil::writef(m_stream, kMsgDMotionChannel, &key);
+
+  m_motionChannel = std::make_unique<MotionChannel>(m_events, socket.release(), key);
+  m_motionChannel->greet(
+      [this] { ProtocolUtil::writef(m_stream, kMsgCMotionChannelReady); },
+      [this](const MotionChannel::Datagram &datagram) {
+        if (datagram.m_kind == MotionChannel::Kind::Move) {
+          mouseMove(datagram.m_x, datagram.m_y);
+        } else {
+          mouseRelativeMove(datagram.m_x, datagram.m_y);
+        }
+      },
+      [this] {
+        LOG_INFO("no reply on motion channel, receiving motion on TCP");
+        m_motionChannel.reset();
+      }
+  );
+}
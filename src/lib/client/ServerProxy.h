@@ -10,9 +10,18 @@
 
 #include "common/Enums.h"
 #include "deskflow/ClipboardChunk.h"
+#include "deskflow/ClipboardBuffer.h"
+#include "deskflow/ClipboardPartials.h"
 #include "deskflow/ClipboardTypes.h"
+#include "deskflow/ClockOffsetEstimator.h"
+#include "deskflow/ConnectionStats.h"
 #include "deskflow/KeyTypes.h"
 #include "deskflow/KeyboardLayoutManager.h"
+#include "deskflow/MotionChannel.h"
+#include "deskflow/StreamChunker.h"
+
+#include <array>
+#include <memory>
 
 class Client;
 class ClientInfo;
@@ -33,9 +42,13 @@ class ServerProxy
 public:
   /*!
   Process messages from the server on \p stream and forward to
-  \p client.
+  \p client.  \p motionSockets makes the socket for a motion channel
+  when the server offers one, or is empty to never open one.
   */
-  ServerProxy(Client *client, deskflow::IStream *stream, IEventQueue *events);
+  ServerProxy(
+      Client *client, deskflow::IStream *stream, IEventQueue *events,
+      const MotionChannel::SocketFactory &motionSockets = {}
+  );
   ServerProxy(ServerProxy const &) = delete;
   ServerProxy(ServerProxy &&) = delete;
   ~ServerProxy();
@@ -70,6 +83,10 @@ private:
 
   void resetKeepAliveAlarm();
   void setKeepAliveRate(double);
+  void sendKeepAliveTime();
+
+  // log how long ago an injected event was captured on the server
+  void recordInputAge(uint64_t captureTime);
 
   // modifier key translation
   KeyID translateKey(KeyID) const;
@@ -86,14 +103,19 @@ private:
   void leave();
   void setClipboard();
   void grabClipboard();
+  void clipboardResume();
   void keyDown(uint16_t id, uint16_t mask, uint16_t button, const std::string &lang);
   void keyRepeat();
   void keyUp();
   void mouseDown();
   void mouseUp();
-  void mouseMove();
-  void mouseRelativeMove();
-  void mouseWheel();
+  void mouseMove(int32_t x, int32_t y);
+  void mouseRelativeMove(int32_t dx, int32_t dy);
+  void mouseWheel(int32_t xDelta, int32_t yDelta);
+  void mouseMoveSync();
+  void keepAliveTime();
+  void inputTime();
+  void inputBatch();
   void screensaver();
   void resetOptions();
   void setOptions();
@@ -102,6 +124,7 @@ private:
   void secureInputNotification();
   void setServerLanguages();
   void setActiveServerLanguage(const std::string_view &language);
+  void openMotionChannel(int port);
 
 private:
   using MessageParser = ConnectionResult (ServerProxy::*)(const uint8_t *);
@@ -118,6 +141,10 @@ private:
   int32_t m_dxMouse = 0;
   int32_t m_dyMouse = 0;
 
+  // last absolute position from the server, for compact moves
+  int32_t m_xLastMove = 0;
+  int32_t m_yLastMove = 0;
+
   bool m_ignoreMouse = false;
 
   KeyModifierID m_modifierTranslationTable[kKeyModifierIDLast];
@@ -128,8 +155,21 @@ private:
   MessageParser m_parser = &ServerProxy::parseHandshakeMessage;
   IEventQueue *m_events = nullptr;
   std::string m_serverLayout = "";
-  std::string m_clipboardDataCached;
+  ClipboardBuffer m_clipboardDataCached;
   ClipboardChunkAssemblyState m_clipboardChunkState;
+  bool m_clipboardResume = false;
+  std::array<ClipboardResumePoint, kClipboardEnd> m_clipboardResumePoints;
+  StreamChunker m_clipboardChunker{m_events, this};
   bool m_isUserNotifiedAboutLayoutSyncError = false;
   deskflow::KeyboardLayoutManager m_layoutManager;
+  ConnectionStats m_stats{"server"};
+  uint64_t m_receiveTime = 0;
+
+  bool m_keepAliveTimestamps = false;
+  ClockOffsetEstimator m_clock;
+  uint64_t m_inputTime = 0;
+  uint64_t m_compressedInputTime = 0;
+
+  MotionChannel::SocketFactory m_motionSockets;
+  std::unique_ptr<MotionChannel> m_motionChannel;
 };
@@ -8,6 +8,7 @@
 
 #include "LogLevel.h"
 #include "NetworkProtocol.h"
+#include "SettingsSnapshot.h"
 #include "UrlConstants.h"
 
 #include <QCoreApplication>
@@ -44,6 +45,7 @@ void Settings::setSettingsFile(const QString &settingsFile)
   instance()->cleanStateSettings();
   instance()->setupComputerName();
   instance()->checkIfSettingsWritableChange();
+  SettingsSnapshot::invalidate();
 }
 
 void Settings::setStateFile(const QString &stateFile)
@@ -207,6 +209,9 @@ QVariant Settings::defaultValue(const QString &key)
   if (key == Log::Level)
     return QVariant::fromValue(LogLevel::Level::Info).toString();
 
+  if (key == Log::StatsInterval)
+    return 0; // off
+
   if (key == Daemon::Elevate)
     return !Settings::isPortableMode();
 
@@ -245,6 +250,12 @@ QVariant Settings::defaultValue(const QString &key)
   if (key == Server::Heartbeat)
     return 5000;
 
+  if (key == Core::BufferPoolSize)
+    return 8; // 8 MiB
+
+  if (key == Server::IoThreads)
+    return 0; // pick from the number of cores
+
   if (key == Server::SwitchDelay || key == Server::SwitchDoubleTap)
     return 250;
 
@@ -274,6 +285,12 @@ void Settings::save(bool emitSaving)
   instance()->m_stateSettings->sync();
 }
 
+void Settings::sync()
+{
+  instance()->m_settings->sync();
+  instance()->m_stateSettings->sync();
+}
+
 QStringList Settings::validKeys()
 {
   return Settings::m_validKeys;
@@ -355,6 +372,7 @@ void Settings::setValue(const QString &key, const QVariant &value)
   }
 
   settings->sync();
+  SettingsSnapshot::invalidate();
   Q_EMIT instance()->settingsChanged(key);
 }
 
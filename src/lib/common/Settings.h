@@ -61,6 +61,8 @@ public:
     inline static const auto ScreenEnterCommand = QStringLiteral("core/enterCommand");
     inline static const auto EnableExitCommand = QStringLiteral("core/enableExitCommand");
     inline static const auto ScreenExitCommand = QStringLiteral("core/exitCommand");
+    inline static const auto SyntheticScreen = QStringLiteral("core/syntheticScreen");
+    inline static const auto BufferPoolSize = QStringLiteral("core/bufferPoolSize");
 
     // TODO: REMOVE In 2.0
     inline static const auto ScreenName = QStringLiteral("core/screenName"); // Replaced By ComputerName
@@ -94,6 +96,8 @@ public:
     inline static const auto Level = QStringLiteral("log/level");
     inline static const auto ToFile = QStringLiteral("log/toFile");
     inline static const auto GuiDebug = QStringLiteral("log/guiDebug");
+    inline static const auto StatsInterval = QStringLiteral("log/statsInterval");
+    inline static const auto Async = QStringLiteral("log/async");
   };
   struct Security
   {
@@ -101,6 +105,7 @@ public:
     inline static const auto Certificate = QStringLiteral("security/certificate");
     inline static const auto KeySize = QStringLiteral("security/keySize");
     inline static const auto TlsEnabled = QStringLiteral("security/tlsEnabled");
+    inline static const auto KernelTls = QStringLiteral("security/kernelTls");
   };
   struct Server
   {
@@ -116,7 +121,10 @@ public:
     inline static const auto GridHeight = QStringLiteral("server/gridHeight");
     inline static const auto GridWidth = QStringLiteral("server/gridWidth");
     inline static const auto Heartbeat = QStringLiteral("server/heartbeat");
+    inline static const auto IoThreads = QStringLiteral("server/ioThreads");
+    inline static const auto MotionChannel = QStringLiteral("server/motionChannel");
     inline static const auto Protocol = QStringLiteral("server/protocol");
+    inline static const auto RealtimeInput = QStringLiteral("server/realtimeInput");
     inline static const auto RelativeMouseMoves = QStringLiteral("server/relativeMouseMoves");
     inline static const auto SwitchDelay = QStringLiteral("server/switchDelay");
     inline static const auto SwitchDoubleTap = QStringLiteral("server/switchDoubleTap");
@@ -192,6 +200,7 @@ public:
   static QSettingsProxy &proxy();
   static NetworkProtocol networkProtocol();
   static void save(bool emitSaving = true);
+  static void sync();
   static QStringList validKeys();
   static QStringList validGroups();
   static QString portableSettingsFile();
@@ -276,6 +285,8 @@ private:
     , Core::Display
     , Core::UseHooks
     , Core::Language
+    , Core::SyntheticScreen
+    , Core::BufferPoolSize
     , Daemon::ConfigFile
     , Daemon::Elevate
     , Daemon::LogFile
@@ -284,6 +295,8 @@ private:
     , Log::Level
     , Log::ToFile
     , Log::GuiDebug
+    , Log::Async
+    , Log::StatsInterval
     , Gui::Autohide
     , Gui::AutoStartCore
     , Gui::AutoUpdateCheck
@@ -300,6 +313,7 @@ private:
     , Security::CheckPeers
     , Security::KeySize
     , Security::TlsEnabled
+    , Security::KernelTls
     , Server::ClipboardSize
     , Server::DefaultLockToComputerState
     , Server::DisableLockToComputer
@@ -312,7 +326,10 @@ private:
     , Server::GridHeight
     , Server::GridWidth
     , Server::Heartbeat
+    , Server::IoThreads
+    , Server::MotionChannel
     , Server::Protocol
+    , Server::RealtimeInput
     , Server::RelativeMouseMoves
     , Server::SwitchDelay
     , Server::SwitchDoubleTap
@@ -335,12 +352,16 @@ private:
     , Client::InvertXScroll
     , Log::ToFile
     , Log::GuiDebug
+    , Log::Async
+    , Security::KernelTls
     , Server::DefaultLockToComputerState
     , Server::DisableLockToComputer
     , Server::EnableHeatbeat
     , Server::EnableSwitchDelay
     , Server::EnableSwitchDoubleTap
     , Server::ExternalConfig
+    , Server::MotionChannel
+    , Server::RealtimeInput
     , Server::RelativeMouseMoves
   };
 
@@ -0,0 +1,101 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "SettingsSnapshot.h"
+
+#include "Settings.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace {
+
+// the published snapshot, swapped whole so readers never see a partial one.
+// the lock is only held to copy or swap the pointer, except on first use
+std::mutex s_mutex;
+std::shared_ptr<const SettingsSnapshot> s_current;
+
+} // namespace
+
+SettingsSnapshot SettingsSnapshot::read()
+{
+  SettingsSnapshot s;
+
+  s.client.dynamicConnectionRetry = Settings::value(Settings::Client::DynamicConnectionRetry).toBool();
+  s.client.invertYScroll = Settings::value(Settings::Client::InvertYScroll).toBool();
+  s.client.invertXScroll = Settings::value(Settings::Client::InvertXScroll).toBool();
+  s.client.yScrollScale = std::clamp(Settings::value(Settings::Client::YScrollScale).toDouble(), 0.1, 10.0);
+  s.client.xScrollScale = std::clamp(Settings::value(Settings::Client::XScrollScale).toDouble(), 0.1, 10.0);
+  s.client.languageSync = Settings::value(Settings::Client::LanguageSync).toBool();
+  s.client.remoteHost = Settings::value(Settings::Client::RemoteHost).toString();
+
+  s.core.interfaceAddress = Settings::value(Settings::Core::Interface).toString();
+  s.core.port = Settings::value(Settings::Core::Port).toInt();
+  s.core.preventSleep = Settings::value(Settings::Core::PreventSleep).toBool();
+  s.core.computerName = Settings::value(Settings::Core::ComputerName).toString();
+  s.core.display = Settings::value(Settings::Core::Display).toString();
+  s.core.useHooks = Settings::value(Settings::Core::UseHooks).toBool();
+  s.core.enableEnterCommand = Settings::value(Settings::Core::EnableEnterCommand).toBool();
+  s.core.screenEnterCommand = Settings::value(Settings::Core::ScreenEnterCommand).toString();
+  s.core.enableExitCommand = Settings::value(Settings::Core::EnableExitCommand).toBool();
+  s.core.screenExitCommand = Settings::value(Settings::Core::ScreenExitCommand).toString();
+  s.core.syntheticScreen = Settings::value(Settings::Core::SyntheticScreen).toString();
+  s.core.bufferPoolSize = Settings::value(Settings::Core::BufferPoolSize).toUInt();
+
+  s.log.toFile = Settings::value(Settings::Log::ToFile).toBool();
+  s.log.file = Settings::value(Settings::Log::File).toString();
+  s.log.level = Settings::logLevelText();
+  s.log.statsInterval = Settings::value(Settings::Log::StatsInterval).toInt();
+  s.log.async = Settings::value(Settings::Log::Async).toBool();
+
+  s.security.certificate = Settings::value(Settings::Security::Certificate).toString();
+  s.security.checkPeers = Settings::value(Settings::Security::CheckPeers).toBool();
+  s.security.tlsEnabled = Settings::value(Settings::Security::TlsEnabled).toBool();
+  s.security.kernelTls = Settings::value(Settings::Security::KernelTls).toBool();
+
+  s.server.clipboardSize = Settings::value(Settings::Server::ClipboardSize).toUInt();
+  s.server.enableClipboard = Settings::value(Settings::Server::EnableClipboard).toBool();
+  s.server.defaultLockToComputerState = Settings::value(Settings::Server::DefaultLockToComputerState).toBool();
+  s.server.disableLockToComputer = Settings::value(Settings::Server::DisableLockToComputer).toBool();
+  s.server.enableHeartbeat = Settings::value(Settings::Server::EnableHeatbeat).toBool();
+  s.server.heartbeat = Settings::value(Settings::Server::Heartbeat).toInt();
+  s.server.enableSwitchDelay = Settings::value(Settings::Server::EnableSwitchDelay).toBool();
+  s.server.switchDelay = Settings::value(Settings::Server::SwitchDelay).toInt();
+  s.server.enableSwitchDoubleTap = Settings::value(Settings::Server::EnableSwitchDoubleTap).toBool();
+  s.server.switchDoubleTap = Settings::value(Settings::Server::SwitchDoubleTap).toInt();
+  s.server.ioThreads = Settings::value(Settings::Server::IoThreads).toInt();
+  s.server.motionChannel = Settings::value(Settings::Server::MotionChannel).toBool();
+  s.server.protocol = Settings::networkProtocol();
+  s.server.realtimeInput = Settings::value(Settings::Server::RealtimeInput).toBool();
+  s.server.relativeMouseMoves = Settings::value(Settings::Server::RelativeMouseMoves).toBool();
+  s.server.win32KeepForeground = Settings::value(Settings::Server::Win32KeepForeground).toBool();
+
+  return s;
+}
+
+std::shared_ptr<const SettingsSnapshot> SettingsSnapshot::current()
+{
+  std::scoped_lock lock{s_mutex};
+  if (!s_current) {
+    s_current = std::make_shared<const SettingsSnapshot>(read());
+  }
+  return s_current;
+}
+
+void SettingsSnapshot::reload()
+{
+  Settings::sync();
+  auto snapshot = std::make_shared<const SettingsSnapshot>(read());
+
+  std::scoped_lock lock{s_mutex};
+  s_current = std::move(snapshot);
+}
+
+void SettingsSnapshot::invalidate()
+{
+  std::scoped_lock lock{s_mutex};
+  s_current.reset();
+}
@@ -0,0 +1,123 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "common/NetworkProtocol.h"
+
+#include <QString>
+
+#include <memory>
+
+//! Typed copy of the settings the core reads at runtime
+/*!
+Reading Settings is a string keyed QSettings lookup every time, so the core
+reads the fields of a snapshot instead.  Snapshots are immutable; reload()
+reads the settings files again and publishes a new one, which readers on
+any thread get from their next call to current().  Settings changed by
+another process are seen after the core is asked to reload over IPC.
+
+Keys that are only read once at startup, state keys and per-screen keys
+are still read from Settings.
+*/
+struct SettingsSnapshot
+{
+  struct Client
+  {
+    bool dynamicConnectionRetry = false;
+    bool invertYScroll = false;
+    bool invertXScroll = false;
+    double yScrollScale = 1.0; //!< Clamped to 0.1 - 10
+    double xScrollScale = 1.0; //!< Clamped to 0.1 - 10
+    bool languageSync = true;
+    QString remoteHost;
+  };
+
+  struct Core
+  {
+    QString interfaceAddress; //!< Core::Interface
+    int port = 0;
+    bool preventSleep = false;
+    QString computerName;
+    QString display;
+    bool useHooks = true;
+    bool enableEnterCommand = false;
+    QString screenEnterCommand;
+    bool enableExitCommand = false;
+    QString screenExitCommand;
+    QString syntheticScreen;
+    unsigned int bufferPoolSize = 0; //!< MiB
+  };
+
+  struct Log
+  {
+    bool toFile = false;
+    QString file;
+    QString level;
+    int statsInterval = 0;
+    bool async = false;
+  };
+
+  struct Security
+  {
+    QString certificate;
+    bool checkPeers = true;
+    bool tlsEnabled = true;
+    bool kernelTls = false;
+  };
+
+  struct Server
+  {
+    unsigned int clipboardSize = 0; //!< MiB
+    bool enableClipboard = true;
+    bool defaultLockToComputerState = false;
+    bool disableLockToComputer = false;
+    bool enableHeartbeat = false;
+    int heartbeat = 0;
+    bool enableSwitchDelay = false;
+    int switchDelay = 0;
+    bool enableSwitchDoubleTap = false;
+    int switchDoubleTap = 0;
+    int ioThreads = 0; //!< 0 picks from the number of cores
+    bool motionChannel = false;
+    NetworkProtocol protocol = NetworkProtocol::Barrier;
+    bool realtimeInput = false; //!< Whole event loop, not only input, runs real-time
+    bool relativeMouseMoves = false;
+    bool win32KeepForeground = true;
+  };
+
+  Client client;
+  Core core;
+  Log log;
+  Security security;
+  Server server;
+
+  //! Read the settings
+  static SettingsSnapshot read();
+
+  //! Get the published snapshot
+  /*!
+  Reads the settings the first time.  Afterwards it only takes a short
+  lock to copy the pointer; callers on a hot path should keep the
+  snapshot rather than call this for every event.  Callers may keep the
+  snapshot for as long as they like, it never changes.
+  */
+  static std::shared_ptr<const SettingsSnapshot> current();
+
+  //! Publish a new snapshot
+  /*!
+  Re-reads the settings files, picking up changes made by other processes,
+  and replaces the published snapshot.
+  */
+  static void reload();
+
+  //! Drop the published snapshot
+  /*!
+  The next call to current() reads the settings again.  Called by
+  Settings::setValue() so changes made in this process are seen.
+  */
+  static void invalidate();
+};
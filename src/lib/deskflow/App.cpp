@@ -12,7 +12,8 @@
 #include "base/Log.h"
 #include "base/LogOutputters.h"
 #include "common/ExitCodes.h"
-#include "common/Settings.h"
+#include "common/SettingsSnapshot.h"
+#include "deskflow/ChunkPool.h"
 #include "deskflow/DeskflowException.h"
 #include "mt/ThreadException.h"
 
@@ -123,8 +124,8 @@ void App::run(QThread &coreThread)
 
 void App::setupFileLogging()
 {
-  if (Settings::value(Settings::Log::ToFile).toBool()) {
-    const auto file = Settings::value(Settings::Log::File).toString();
+  if (const auto settings = SettingsSnapshot::current(); settings->log.toFile) {
+    const auto &file = settings->log.file;
     m_fileLog = new FileLogOutputter(file); // NOSONAR - Adopted by `Log`
     CLOG->insert(m_fileLog);
     LOG_VERBOSE("logging to file (%s) enabled", qPrintable(file));
@@ -133,7 +134,7 @@ void App::setupFileLogging()
 
 void App::loggingFilterWarning() const
 {
-  if ((CLOG->getFilter() > CLOG->getConsoleMaxLevel()) && (Settings::value(Settings::Log::ToFile).toBool())) {
+  if ((CLOG->getFilter() > CLOG->getConsoleMaxLevel()) && SettingsSnapshot::current()->log.toFile) {
     LOG_WARN(
         "log messages above %s are NOT sent to console (use file logging)",
         qPrintable(LogLevel::toOption(CLOG->getConsoleMaxLevel()))
@@ -146,7 +147,7 @@ void App::initApp()
   parseArgs();
 
   // set log filter
-  if (const auto logLevel = Settings::logLevelText(); !CLOG->setFilter(logLevel)) {
+  if (const auto logLevel = SettingsSnapshot::current()->log.level; !CLOG->setFilter(logLevel)) {
     LOG_CRIT(
         "%s: unrecognized log level `%s'" BYE, qPrintable(processName()), qPrintable(logLevel),
         qPrintable(processName())
@@ -158,6 +159,11 @@ void App::initApp()
   // setup file logging after parsing args
   setupFileLogging();
 
+  // keep formatting and writing log lines off the input path
+  CLOG->setAsync(SettingsSnapshot::current()->log.async);
+
+  ChunkPool::instance().setCapacity(size_t{SettingsSnapshot::current()->core.bufferPoolSize} * 1024 * 1024);
+
   // load configuration
   loadConfig();
 }
@@ -6,12 +6,14 @@
 
 #include "deskflow/Chunk.h"
 
-Chunk::Chunk(size_t size) : m_chunk{new char[size]}
+#include "deskflow/ChunkPool.h"
+
+Chunk::Chunk(size_t size) : m_chunk{ChunkPool::instance().acquire(size)}, m_bufferSize{size}
 {
-  memset(m_chunk, 0, size);
+  // do nothing
 }
 
 Chunk::~Chunk()
 {
-  delete[] m_chunk;
+  ChunkPool::instance().release(m_chunk, m_bufferSize);
 }
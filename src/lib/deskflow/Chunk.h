@@ -10,6 +10,11 @@
 
 #include <cstring>
 
+//! Event data holding a buffer to send
+/*!
+The buffer comes from ChunkPool and goes back to it when the event is
+deleted after it has been sent.  Its contents are not initialized.
+*/
 class Chunk : public EventData
 {
 public:
@@ -24,4 +29,7 @@ public:
 public:
   size_t m_dataSize = 0;
   char *m_chunk = nullptr;
+
+private:
+  size_t m_bufferSize = 0;
 };
@@ -0,0 +1,116 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "deskflow/ChunkPool.h"
+
+#include <algorithm>
+#include <bit>
+
+static_assert(ChunkPool::kLargestClass == ChunkPool::kSmallestClass << 14);
+
+ChunkPool &ChunkPool::instance()
+{
+  static ChunkPool pool;
+  return pool;
+}
+
+char *ChunkPool::acquire(size_t size)
+{
+  if (size > kLargestClass) {
+    std::scoped_lock lock(m_mutex);
+    ++m_stats.allocations;
+    return new char[size];
+  }
+
+  const auto index = classIndex(size);
+  {
+    std::scoped_lock lock(m_mutex);
+    if (auto &idle = m_idle[index]; !idle.empty()) {
+      auto *buffer = idle.back().release();
+      idle.pop_back();
+      m_stats.idleBytes -= classSize(size);
+      ++m_stats.reuses;
+      return buffer;
+    }
+    ++m_stats.allocations;
+  }
+  return new char[classSize(size)];
+}
+
+void ChunkPool::release(char *buffer, size_t size)
+{
+  if (buffer == nullptr) {
+    return;
+  }
+
+  std::unique_ptr<char[]> owned(buffer);
+  if (size > kLargestClass) {
+    return;
+  }
+
+  const auto bytes = classSize(size);
+  std::scoped_lock lock(m_mutex);
+  if (m_stats.idleBytes + bytes > m_capacity) {
+    ++m_stats.discards;
+    return;
+  }
+  m_idle[classIndex(size)].push_back(std::move(owned));
+  m_stats.idleBytes += bytes;
+}
+
+void ChunkPool::setCapacity(size_t bytes)
+{
+  std::scoped_lock lock(m_mutex);
+  m_capacity = bytes;
+  trim();
+}
+
+void ChunkPool::clear()
+{
+  std::scoped_lock lock(m_mutex);
+  for (auto &idle : m_idle) {
+    idle.clear();
+  }
+  m_stats = {};
+}
+
+size_t ChunkPool::capacity() const
+{
+  std::scoped_lock lock(m_mutex);
+  return m_capacity;
+}
+
+ChunkPool::Stats ChunkPool::stats() const
+{
+  std::scoped_lock lock(m_mutex);
+  return m_stats;
+}
+
+size_t ChunkPool::classSize(size_t size)
+{
+  if (size > kLargestClass) {
+    return size;
+  }
+  return std::bit_ceil(std::max(size, kSmallestClass));
+}
+
+size_t ChunkPool::classIndex(size_t size)
+{
+  return std::countr_zero(classSize(size)) - std::countr_zero(kSmallestClass);
+}
+
+void ChunkPool::trim()
+{
+  // the largest buffers go first, they are the least likely to be needed
+  for (auto index = kClasses; index-- > 0 && m_stats.idleBytes > m_capacity;) {
+    auto &idle = m_idle[index];
+    const auto bytes = kSmallestClass << index;
+    while (!idle.empty() && m_stats.idleBytes > m_capacity) {
+      idle.pop_back();
+      m_stats.idleBytes -= bytes;
+    }
+  }
+}
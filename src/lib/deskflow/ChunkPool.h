@@ -0,0 +1,98 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//! Recycled buffers for chunks
+/*!
+A large clipboard copy is sent as a run of half megabyte chunks, each of
+which used to be a fresh heap allocation freed again as soon as it was
+written to the socket.  The pool keeps released buffers in power of two
+size classes and hands them out again, so a transfer allocates only as
+many buffers as are queued at once.
+
+Idle buffers are kept up to a capacity and freed beyond it.  Buffers
+larger than the largest class are not pooled.  The pool is shared by all
+threads.
+*/
+class ChunkPool
+{
+public:
+  static constexpr size_t kSmallestClass = 64;
+  static constexpr size_t kLargestClass = 1024 * 1024;
+  static constexpr size_t kDefaultCapacity = 8 * 1024 * 1024;
+
+  struct Stats
+  {
+    uint64_t allocations = 0; //!< Buffers taken from the heap
+    uint64_t reuses = 0;      //!< Buffers taken from the pool
+    uint64_t discards = 0;    //!< Released buffers freed because the pool was full
+    size_t idleBytes = 0;     //!< Bytes held by the pool now
+  };
+
+  ChunkPool() = default;
+  ChunkPool(const ChunkPool &) = delete;
+  ChunkPool &operator=(const ChunkPool &) = delete;
+
+  //! Get the pool used by Chunk
+  static ChunkPool &instance();
+
+  //! @name manipulators
+  //@{
+
+  //! Get a buffer
+  /*!
+  Returns a buffer of at least \p size bytes.  Its contents are not
+  initialized.  It must be given back with release() and the same size.
+  */
+  char *acquire(size_t size);
+
+  //! Give a buffer back
+  void release(char *buffer, size_t size);
+
+  //! Set the most idle bytes kept
+  /*!
+  Frees idle buffers until no more than \p bytes are kept.  Zero stops
+  pooling.
+  */
+  void setCapacity(size_t bytes);
+
+  //! Free all idle buffers and reset the statistics
+  void clear();
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Get the most idle bytes kept
+  size_t capacity() const;
+
+  //! Get the statistics
+  Stats stats() const;
+
+  //! Get the size of the buffer acquire() returns for \p size
+  static size_t classSize(size_t size);
+
+  //@}
+
+private:
+  static constexpr size_t kClasses = 15; // 64 B to 1 MiB
+
+  static size_t classIndex(size_t size);
+  void trim();
+
+  mutable std::mutex m_mutex;
+  std::array<std::vector<std::unique_ptr<char[]>>, kClasses> m_idle;
+  size_t m_capacity = kDefaultCapacity;
+  Stats m_stats;
+};
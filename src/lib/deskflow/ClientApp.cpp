@@ -14,7 +14,7 @@
 #include "client/Client.h"
 #include "common/ExitCodes.h"
 #include "common/PlatformInfo.h"
-#include "common/Settings.h"
+#include "common/SettingsSnapshot.h"
 #include "deskflow/Screen.h"
 #include "deskflow/ScreenException.h"
 #include "deskflow/ipc/CoreIpc.h"
@@ -29,6 +29,8 @@
 
 #include <QFileInfo> // Must include before XWindowsScreen to avoid conflicts with xlib.h
 
+#include "platform/SyntheticScreen.h"
+
 #if WINAPI_XWINDOWS
 #include "platform/XWindowsScreen.h"
 #endif
@@ -51,8 +53,8 @@ ClientApp::ClientApp(IEventQueue *events, const QString &processName) : App(even
 void ClientApp::parseArgs()
 {
   // save server addresses (comma-separated list supported)
-  if (const auto addressList = Settings::value(Settings::Client::RemoteHost).toString(); !addressList.isEmpty()) {
-    const int port = Settings::value(Settings::Core::Port).toInt();
+  if (const auto addressList = SettingsSnapshot::current()->client.remoteHost; !addressList.isEmpty()) {
+    const int port = SettingsSnapshot::current()->core.port;
     const QStringList addresses = addressList.split(',', Qt::SkipEmptyParts);
 
     for (const QString &addr : addresses) {
@@ -100,17 +102,22 @@ const char *ClientApp::daemonName() const
 
 deskflow::Screen *ClientApp::createScreen()
 {
+  if (const auto spec = SettingsSnapshot::current()->core.syntheticScreen; !spec.isEmpty()) {
+    const auto options = deskflow::SyntheticScreen::Options::parse(spec);
+    return new deskflow::Screen(new deskflow::SyntheticScreen(false, getEvents(), options), getEvents());
+  }
+
 #if defined(Q_OS_WIN)
   return new deskflow::Screen(
       new MSWindowsScreen(
-          false, Settings::value(Settings::Core::UseHooks).toBool(), getEvents(),
-          Settings::value(Settings::Client::LanguageSync).toBool()
+          false, SettingsSnapshot::current()->core.useHooks, getEvents(),
+          SettingsSnapshot::current()->client.languageSync
       ),
       getEvents()
   );
 #elif defined(Q_OS_MAC)
   return new deskflow::Screen(
-      new OSXScreen(getEvents(), false, Settings::value(Settings::Client::LanguageSync).toBool()), getEvents()
+      new OSXScreen(getEvents(), false, SettingsSnapshot::current()->client.languageSync), getEvents()
   );
 #else
   if (deskflow::platform::isWayland()) {
@@ -124,7 +131,7 @@ deskflow::Screen *ClientApp::createScreen()
 #if WINAPI_XWINDOWS
   LOG_INFO("using legacy x windows screen");
   return new deskflow::Screen(
-      new XWindowsScreen(qPrintable(Settings::value(Settings::Core::Display).toString()), false, getEvents()),
+      new XWindowsScreen(qPrintable(SettingsSnapshot::current()->core.display), false, getEvents()),
       getEvents()
   );
 #endif
@@ -173,34 +180,23 @@ void ClientApp::handleClientConnected()
   ipcSendConnectionState(deskflow::core::ConnectionState::Connected);
   // Reset server index on successful connection
   m_currentServerIndex = 0;
-  m_lastServerAddressIndex = 0;
 }
 
 void ClientApp::handleClientFailed(const Event &e)
 {
-  if ((++m_lastServerAddressIndex) < m_client->getLastResolvedAddressesCount()) {
-    // Try next resolved address for current hostname
-    std::unique_ptr<Client::FailInfo> info(static_cast<Client::FailInfo *>(e.getData()));
+  // The client has already tried every resolved address for the current
+  // hostname, try next server in list
+  tryNextServer();
 
-    LOG_WARN("failed to connect to server=%s, trying next resolved address", qPrintable(info->m_what));
+  if (m_currentServerIndex == 0) {
+    // We've cycled through all servers, treat as refused
+    handleClientRefused(e);
+  } else {
+    std::unique_ptr<Client::FailInfo> info(static_cast<Client::FailInfo *>(e.getData()));
+    LOG_WARN("failed to connect to server=%s, trying next server in list", qPrintable(info->m_what));
     if (!m_suspended) {
       scheduleClientRestart(retryTime());
     }
-  } else {
-    // All resolved addresses exhausted, try next server in list
-    m_lastServerAddressIndex = 0;
-    tryNextServer();
-
-    if (m_currentServerIndex == 0) {
-      // We've cycled through all servers, treat as refused
-      handleClientRefused(e);
-    } else {
-      std::unique_ptr<Client::FailInfo> info(static_cast<Client::FailInfo *>(e.getData()));
-      LOG_WARN("failed to connect to server=%s, trying next server in list", qPrintable(info->m_what));
-      if (!m_suspended) {
-        scheduleClientRestart(retryTime());
-      }
-    }
   }
 }
 
@@ -277,7 +273,7 @@ bool ClientApp::startClient()
     if (m_clientScreen == nullptr) {
       clientScreen = openClientScreen();
       m_client = openClient(
-          Settings::value(Settings::Core::ComputerName).toString().toStdString(), getCurrentServerAddress(),
+          SettingsSnapshot::current()->core.computerName.toStdString(), getCurrentServerAddress(),
           clientScreen
       );
       m_clientScreen = clientScreen;
@@ -285,7 +281,7 @@ bool ClientApp::startClient()
     }
 
     m_client->setServerAddress(getCurrentServerAddress());
-    m_client->connect(m_lastServerAddressIndex);
+    m_client->connect();
 
     return true;
   } catch (ScreenUnavailableException &e) {
@@ -390,7 +386,7 @@ ISocketFactory *ClientApp::getSocketFactory() const
 
 double ClientApp::retryTime() const
 {
-  if (!Settings::value(Settings::Client::DynamicConnectionRetry).toBool() || m_retryCount < 300) // 5 minutes
+  if (!SettingsSnapshot::current()->client.dynamicConnectionRetry || m_retryCount < 300) // 5 minutes
     return 1;
   if (m_retryCount < 360) // 5 minutes
     return 5;
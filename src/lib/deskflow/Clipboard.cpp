@@ -1,5 +1,6 @@
 /*
  * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
  * SPDX-FileCopyrightText: (C) 2012 - 2016 Synergy App Ltd
  * SPDX-FileCopyrightText: (C) 2002 Chris Schoeneman
  * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
@@ -7,6 +8,21 @@
 
 #include "deskflow/Clipboard.h"
 #include "base/Log.h"
+#include "deskflow/ClipboardChunk.h"
+
+#include <string_view>
+#include <utility>
+
+namespace {
+
+// one pass over the data for both, marshalled clipboards can be very large
+void hashSnapshot(Clipboard::Snapshot &snapshot)
+{
+  snapshot.m_transferId = ClipboardChunk::transferIdOf(snapshot.m_data);
+  snapshot.m_hash = static_cast<std::size_t>(snapshot.m_transferId);
+}
+
+} // namespace
 
 //
 // Clipboard
@@ -35,6 +51,8 @@ bool Clipboard::empty()
 
   // save time
   m_timeOwned = m_time;
+  ++m_version;
+  m_snapshot.reset();
 
   // we're the owner now
   m_owner = true;
@@ -42,7 +60,7 @@ bool Clipboard::empty()
   return true;
 }
 
-void Clipboard::add(Format format, const std::string &data)
+void Clipboard::add(Format format, std::string data)
 {
   std::scoped_lock lock{m_mutex};
   if (!m_open) {
@@ -56,8 +74,10 @@ void Clipboard::add(Format format, const std::string &data)
   }
 
   const auto formatID = static_cast<int>(format);
-  m_data[formatID] = data;
+  m_data[formatID] = std::move(data);
   m_added[formatID] = true;
+  ++m_version;
+  m_snapshot.reset();
 }
 
 bool Clipboard::open(Time time) const
@@ -108,12 +128,54 @@ std::string Clipboard::get(Format format) const
   return m_data[static_cast<int>(format)];
 }
 
-void Clipboard::unmarshall(const std::string &data, Time time)
+void Clipboard::unmarshall(std::string_view data, Time time)
 {
   IClipboard::unmarshall(this, data, time);
 }
 
 std::string Clipboard::marshall() const
 {
-  return IClipboard::marshall(this);
+  return snapshot()->m_data;
+}
+
+std::shared_ptr<const Clipboard::Snapshot> Clipboard::snapshot() const
+{
+  std::uint64_t version = 0;
+  {
+    std::scoped_lock lock{m_mutex};
+    if (m_snapshot) {
+      return m_snapshot;
+    }
+    version = m_version;
+  }
+
+  // marshalling opens the clipboard, so the lock can't be held
+  auto snapshot = std::make_shared<Snapshot>();
+  snapshot->m_version = version;
+  snapshot->m_data = IClipboard::marshall(this);
+  hashSnapshot(*snapshot);
+
+  std::scoped_lock lock{m_mutex};
+  if (m_version == version) {
+    m_snapshot = snapshot;
+  }
+  return snapshot;
+}
+
+std::uint64_t Clipboard::version() const
+{
+  std::scoped_lock lock{m_mutex};
+  return m_version;
+}
+
+std::shared_ptr<const Clipboard::Snapshot> Clipboard::snapshotOf(const IClipboard *clipboard)
+{
+  if (const auto *cached = dynamic_cast<const Clipboard *>(clipboard); cached != nullptr) {
+    return cached->snapshot();
+  }
+
+  auto snapshot = std::make_shared<Snapshot>();
+  snapshot->m_data = IClipboard::marshall(clipboard);
+  hashSnapshot(*snapshot);
+  return snapshot;
 }
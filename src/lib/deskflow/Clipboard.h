@@ -1,5 +1,6 @@
 /*
  * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
  * SPDX-FileCopyrightText: (C) 2012 - 2016 Synergy App Ltd
  * SPDX-FileCopyrightText: (C) 2002 Chris Schoeneman
  * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
@@ -9,6 +10,8 @@
 
 #include "deskflow/IClipboard.h"
 
+#include <cstdint>
+#include <memory>
 #include <mutex>
 
 //! Memory buffer clipboard
@@ -18,6 +21,30 @@ This class implements a clipboard that stores data in memory.
 class Clipboard : public IClipboard
 {
 public:
+  //! Marshalled clipboard data
+  /*!
+  Taken once per change to a clipboard and never modified, so it can be
+  shared by everything that sends or compares the data.
+  */
+  struct Snapshot
+  {
+    std::uint64_t m_version = 0;    //!< Version of the clipboard it was taken from
+    std::string m_data;             //!< Marshalled data
+    std::size_t m_hash = 0;         //!< Hash of m_data
+    std::uint64_t m_transferId = 0; //!< Transfer id of m_data, see ClipboardChunk::transferIdOf()
+
+    //! Compare data
+    /*!
+    Returns true if \p other has the same data.  The size and hash tell
+    most changes apart without looking at the data, which is only
+    compared byte for byte when they match.
+    */
+    bool hasSameData(const Snapshot &other) const
+    {
+      return m_data.size() == other.m_data.size() && m_hash == other.m_hash && m_data == other.m_data;
+    }
+  };
+
   Clipboard();
   ~Clipboard() override = default;
 
@@ -29,7 +56,7 @@ public:
   Extract marshalled clipboard data and store it in this clipboard.
   Sets the clipboard time to \c time.
   */
-  void unmarshall(const std::string &data, Time time);
+  void unmarshall(std::string_view data, Time time);
 
   //@}
   //! @name accessors
@@ -42,11 +69,32 @@ public:
   */
   std::string marshall() const;
 
+  //! Get the marshalled data
+  /*!
+  Returns the snapshot of the current data, marshalling it only if the
+  clipboard changed since the last call.
+  */
+  std::shared_ptr<const Snapshot> snapshot() const;
+
+  //! Get the version
+  /*!
+  Returns a number that goes up each time the clipboard is emptied or
+  added to.
+  */
+  std::uint64_t version() const;
+
+  //! Get the marshalled data of any clipboard
+  /*!
+  Returns the cached snapshot if \p clipboard is a Clipboard, otherwise
+  marshalls it.
+  */
+  static std::shared_ptr<const Snapshot> snapshotOf(const IClipboard *clipboard);
+
   //@}
 
   // IClipboard overrides
   bool empty() final;
-  void add(Format, const std::string &data) override;
+  void add(Format, std::string data) override;
   bool open(Time) const final;
   void close() const override;
   Time getTime() const override;
@@ -61,4 +109,6 @@ private:
   Time m_timeOwned;
   bool m_added[static_cast<int>(Format::TotalFormats)] = {false, false, false};
   std::string m_data[static_cast<int>(Format::TotalFormats)] = {"", "", ""};
+  std::uint64_t m_version = 0;
+  mutable std::shared_ptr<const Snapshot> m_snapshot;
 };
@@ -0,0 +1,170 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "deskflow/ClipboardBuffer.h"
+
+#include "base/Log.h"
+
+#include <QDir>
+#include <QTemporaryFile>
+
+#include <cstring>
+#include <utility>
+
+ClipboardBuffer::ClipboardBuffer(size_t spillThreshold) : m_spillThreshold(spillThreshold)
+{
+  // do nothing
+}
+
+ClipboardBuffer::ClipboardBuffer(ClipboardBuffer &&other) noexcept
+    : m_spillThreshold(other.m_spillThreshold),
+      m_memory(std::move(other.m_memory)),
+      m_file(std::move(other.m_file)),
+      m_mapped(std::exchange(other.m_mapped, nullptr)),
+      m_capacity(std::exchange(other.m_capacity, 0)),
+      m_size(std::exchange(other.m_size, 0))
+{
+  other.m_memory.clear();
+}
+
+ClipboardBuffer::~ClipboardBuffer()
+{
+  unmap();
+}
+
+ClipboardBuffer &ClipboardBuffer::operator=(ClipboardBuffer &&other) noexcept
+{
+  if (this != &other) {
+    unmap();
+    m_spillThreshold = other.m_spillThreshold;
+    m_memory = std::move(other.m_memory);
+    other.m_memory.clear();
+    m_file = std::move(other.m_file);
+    m_mapped = std::exchange(other.m_mapped, nullptr);
+    m_capacity = std::exchange(other.m_capacity, 0);
+    m_size = std::exchange(other.m_size, 0);
+  }
+  return *this;
+}
+
+void ClipboardBuffer::reserve(size_t size)
+{
+  if (isSpilled()) {
+    if (size <= m_capacity) {
+      return;
+    }
+
+    // a resumed transfer that's larger than the file, start the file again
+    const std::string kept(view());
+    unmap();
+    m_memory = kept;
+  }
+
+  if (size > m_spillThreshold && spill(size)) {
+    return;
+  }
+  m_memory.reserve(size);
+}
+
+void ClipboardBuffer::append(std::string_view data)
+{
+  if (isSpilled() && m_size + data.size() <= m_capacity) {
+    std::memcpy(m_mapped + m_size, data.data(), data.size());
+    m_size += data.size();
+    return;
+  }
+
+  if (isSpilled()) {
+    // more than was reserved, which assemble() doesn't allow
+    reserve(m_size + data.size());
+    append(data);
+    return;
+  }
+
+  m_memory.append(data);
+  m_size = m_memory.size();
+}
+
+void ClipboardBuffer::truncate(size_t size)
+{
+  if (size >= m_size) {
+    return;
+  }
+
+  if (!isSpilled()) {
+    m_memory.resize(size);
+  }
+  m_size = size;
+}
+
+void ClipboardBuffer::clear()
+{
+  unmap();
+  m_memory.clear();
+  m_memory.shrink_to_fit();
+  m_size = 0;
+}
+
+std::string_view ClipboardBuffer::view() const
+{
+  if (isSpilled()) {
+    return {m_mapped, m_size};
+  }
+  return m_memory;
+}
+
+size_t ClipboardBuffer::size() const
+{
+  return m_size;
+}
+
+bool ClipboardBuffer::empty() const
+{
+  return m_size == 0;
+}
+
+bool ClipboardBuffer::isSpilled() const
+{
+  return m_mapped != nullptr;
+}
+
+bool ClipboardBuffer::spill(size_t capacity)
+{
+  auto file = std::make_unique<QTemporaryFile>(QDir::temp().filePath(QStringLiteral("clipboard-XXXXXX")));
+  if (!file->open() || !file->resize(static_cast<qint64>(capacity))) {
+    LOG_WARN("unable to make a temporary file for clipboard data, keeping it in memory");
+    return false;
+  }
+
+  auto *mapped = reinterpret_cast<char *>(file->map(0, static_cast<qint64>(capacity)));
+  if (mapped == nullptr) {
+    LOG_WARN("unable to map the temporary file for clipboard data, keeping it in memory");
+    return false;
+  }
+
+  LOG_DEBUG("receiving clipboard data of %zu bytes into %s", capacity, qPrintable(file->fileName()));
+  std::memcpy(mapped, m_memory.data(), m_memory.size());
+  m_memory.clear();
+  m_memory.shrink_to_fit();
+
+  m_file = std::move(file);
+  m_mapped = mapped;
+  m_capacity = capacity;
+  return true;
+}
+
+void ClipboardBuffer::unmap()
+{
+  if (m_file != nullptr) {
+    if (m_mapped != nullptr) {
+      m_file->unmap(reinterpret_cast<uchar *>(m_mapped));
+    }
+    // removed as it's closed
+    m_file.reset();
+  }
+  m_mapped = nullptr;
+  m_capacity = 0;
+}
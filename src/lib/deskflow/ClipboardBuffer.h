@@ -0,0 +1,98 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+class QTemporaryFile;
+
+//! Clipboard data being received
+/*!
+Holds the chunks of a clipboard transfer as they arrive.  Small
+transfers are kept in memory.  A transfer larger than the spill
+threshold is written to a memory mapped temporary file instead, so the
+data is backed by the file rather than by memory and the kernel can
+page it out; receiving a very large clipboard then costs address space
+rather than resident memory.  The data is read in place with view(),
+and a ClipboardView over it hands each format to the screen's clipboard.
+The X11 clipboard keeps the buffer itself and serves UTF-8 and HTML
+requests from it; other formats, and other platforms' clipboards,
+still make a copy of the format in memory.
+
+If the temporary file can't be made the data is kept in memory.
+*/
+class ClipboardBuffer
+{
+public:
+  //! Transfers larger than this go to a temporary file by default
+  static constexpr size_t kDefaultSpillThreshold = 16 * 1024 * 1024;
+
+  explicit ClipboardBuffer(size_t spillThreshold = kDefaultSpillThreshold);
+  ClipboardBuffer(const ClipboardBuffer &) = delete;
+  ClipboardBuffer(ClipboardBuffer &&other) noexcept;
+  ~ClipboardBuffer();
+
+  ClipboardBuffer &operator=(const ClipboardBuffer &) = delete;
+  ClipboardBuffer &operator=(ClipboardBuffer &&other) noexcept;
+
+  //! @name manipulators
+  //@{
+
+  //! Make room for the whole transfer
+  /*!
+  Called with the size of the transfer before its data is appended.
+  Moves the data to a temporary file if \p size is over the threshold.
+  */
+  void reserve(size_t size);
+
+  //! Add received data
+  void append(std::string_view data);
+
+  //! Drop data after the first \p size bytes
+  void truncate(size_t size);
+
+  //! Drop all data
+  /*!
+  Frees the memory or removes the temporary file.
+  */
+  void clear();
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Get the data
+  /*!
+  Valid until the buffer is next changed.
+  */
+  std::string_view view() const;
+
+  //! Get the size of the data
+  size_t size() const;
+
+  //! Test for no data
+  bool empty() const;
+
+  //! Test if the data is in a temporary file
+  bool isSpilled() const;
+
+  //@}
+
+private:
+  bool spill(size_t capacity);
+  void unmap();
+
+  size_t m_spillThreshold;
+  std::string m_memory;
+  std::unique_ptr<QTemporaryFile> m_file;
+  char *m_mapped = nullptr;
+  size_t m_capacity = 0;
+  size_t m_size = 0;
+};
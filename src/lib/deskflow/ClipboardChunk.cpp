@@ -8,23 +8,37 @@
 
 #include "base/Log.h"
 #include "base/String.h"
+#include "deskflow/ClipboardPartials.h"
 #include "deskflow/ProtocolTypes.h"
 #include "deskflow/ProtocolUtil.h"
 #include "io/IStream.h"
+#include <bit>
 #include <cstring>
+#include <format>
 #include <limits>
 
 namespace {
 
-void clearCachedData(std::string &dataCached)
+bool wouldExceed(size_t currentSize, size_t extraSize, size_t limit)
 {
-  dataCached.clear();
-  dataCached.shrink_to_fit();
+  return currentSize > limit || extraSize > limit - currentSize;
 }
 
-bool wouldExceed(size_t currentSize, size_t extraSize, size_t limit)
+// the size, transfer id and offset of a resumable start chunk
+bool parseResumeHeader(const std::string &data, unsigned long long &size, uint64_t &transferId, size_t &offset)
 {
-  return currentSize > limit || extraSize > limit - currentSize;
+  const auto fields = QString::fromStdString(data).split(QLatin1Char(' '));
+  if (fields.size() != 3) {
+    return false;
+  }
+
+  bool sizeOk = false;
+  bool transferOk = false;
+  bool offsetOk = false;
+  size = fields.at(0).toULongLong(&sizeOk);
+  transferId = fields.at(1).toULongLong(&transferOk);
+  offset = static_cast<size_t>(fields.at(2).toULongLong(&offsetOk));
+  return sizeOk && transferOk && offsetOk && transferId != 0 && offset <= size;
 }
 
 } // namespace
@@ -49,7 +63,16 @@ ClipboardChunk *ClipboardChunk::start(ClipboardID id, uint32_t sequence, const s
   return start;
 }
 
-ClipboardChunk *ClipboardChunk::data(ClipboardID id, uint32_t sequence, const std::string &data)
+ClipboardChunk *ClipboardChunk::resume(
+    ClipboardID id, uint32_t sequence, size_t size, uint64_t transferId, size_t offset
+)
+{
+  auto *resume = start(id, sequence, std::format("{} {} {}", size, transferId, offset));
+  resume->m_chunk[5] = ChunkType::DataResume;
+  return resume;
+}
+
+ClipboardChunk *ClipboardChunk::data(ClipboardID id, uint32_t sequence, std::string_view data)
 {
   size_t dataSize = data.size();
   auto *chunk = new ClipboardChunk(dataSize + s_clipboardChunkMetaSize);
@@ -58,7 +81,7 @@ ClipboardChunk *ClipboardChunk::data(ClipboardID id, uint32_t sequence, const st
   chunkData[0] = id;
   std::memcpy(&chunkData[1], &sequence, 4);
   chunkData[5] = ChunkType::DataChunk;
-  memcpy(&chunkData[6], data.c_str(), dataSize);
+  memcpy(&chunkData[6], data.data(), dataSize);
   chunkData[dataSize + s_clipboardChunkMetaSize - 1] = '\0';
 
   return chunk;
@@ -76,9 +99,44 @@ ClipboardChunk *ClipboardChunk::end(ClipboardID id, uint32_t sequence)
   return end;
 }
 
+uint64_t ClipboardChunk::transferIdOf(std::string_view data)
+{
+  const uint64_t prime = 1099511628211ull;
+  const auto *bytes = reinterpret_cast<const uint8_t *>(data.data());
+  const size_t size = data.size();
+  uint64_t hash = 14695981039346656037ull;
+
+  // eight bytes at a time, read as little endian on any host.  the high
+  // half is folded back after each multiply so every byte reaches the low
+  // bits, which a multiply alone doesn't do
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t word;
+    std::memcpy(&word, bytes + i, sizeof(word));
+    if constexpr (std::endian::native == std::endian::big) {
+      uint64_t swapped = 0;
+      for (size_t b = 0; b < sizeof(word); ++b, word >>= 8) {
+        swapped = (swapped << 8) | (word & 0xff);
+      }
+      word = swapped;
+    }
+    hash = (hash ^ word) * prime;
+    hash ^= hash >> 32;
+  }
+
+  // then the rest a byte at a time, as FNV-1a
+  for (; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= prime;
+  }
+
+  // zero means the transfer isn't resumable
+  return hash != 0 ? hash : 1;
+}
+
 TransferState ClipboardChunk::assemble(
-    deskflow::IStream *stream, std::string &dataCached, ClipboardID &id, uint32_t &sequence,
-    ClipboardChunkAssemblyState &state, size_t maxDataSize
+    deskflow::IStream *stream, ClipboardBuffer &dataCached, ClipboardID &id, uint32_t &sequence,
+    ClipboardChunkAssemblyState &state, size_t maxDataSize, ClipboardPartials *partials
 )
 {
   using enum TransferState;
@@ -86,7 +144,7 @@ TransferState ClipboardChunk::assemble(
   std::string data;
   auto reset = [&]() {
     state = {};
-    clearCachedData(dataCached);
+    dataCached.clear();
   };
 
   if (!ProtocolUtil::readf(stream, kMsgDClipboard + 4, &id, &sequence, &mark, &data)) {
@@ -100,18 +158,28 @@ TransferState ClipboardChunk::assemble(
     return Error;
   }
 
-  if (mark == ChunkType::DataStart) {
+  if (mark == ChunkType::DataStart || mark == ChunkType::DataResume) {
     bool ok = false;
-    const auto expected = QString::fromStdString(data).toULongLong(&ok);
+    unsigned long long expected = 0;
+    uint64_t transferId = 0;
+    size_t offset = 0;
+    if (mark == ChunkType::DataStart) {
+      expected = QString::fromStdString(data).toULongLong(&ok);
+    } else {
+      ok = parseResumeHeader(data, expected, transferId, offset);
+    }
     if (!ok || expected > std::numeric_limits<size_t>::max()) {
       LOG_ERR("clipboard invalid size header: %s", data.c_str());
       reset();
       return Error;
     }
 
-    clearCachedData(dataCached);
+    dataCached.clear();
     state.expectedSize = static_cast<size_t>(expected);
     state.active = true;
+    state.id = id;
+    state.transferId = transferId;
+    state.resumed = offset > 0;
 
     if (state.expectedSize > maxDataSize) {
       LOG_ERR("clipboard size exceeds limit, size: %zu, limit: %zu", state.expectedSize, maxDataSize);
@@ -119,7 +187,17 @@ TransferState ClipboardChunk::assemble(
       return Error;
     }
 
-    LOG_DEBUG("start receiving clipboard data, expected size=%zu", state.expectedSize);
+    // carry on from what was kept, anything else kept for this clipboard is stale
+    if (offset > 0 && (partials == nullptr || !partials->take(id, transferId, offset, dataCached))) {
+      LOG_ERR("clipboard resumed at %zu but that much of the transfer wasn't kept", offset);
+      reset();
+      return Error;
+    } else if (partials != nullptr) {
+      partials->drop(id);
+    }
+    dataCached.reserve(state.expectedSize);
+
+    LOG_DEBUG("start receiving clipboard data, expected size=%zu, resuming at %zu", state.expectedSize, offset);
     return Started;
   } else if (mark == ChunkType::DataChunk) {
     if (!state.active) {
@@ -153,6 +231,14 @@ TransferState ClipboardChunk::assemble(
       reset();
       return Error;
     }
+
+    // only data stitched from two transfers needs checking, a single
+    // transfer is as intact as the connection it came over
+    if (state.resumed && transferIdOf(dataCached.view()) != state.transferId) {
+      LOG_ERR("corrupted clipboard data, doesn't match its transfer id");
+      reset();
+      return Error;
+    }
     return Finished;
   }
 
@@ -172,15 +258,20 @@ void ClipboardChunk::send(deskflow::IStream *stream, void *data)
   uint32_t sequence;
   std::memcpy(&sequence, &chunk[1], 4);
   uint8_t mark = chunk[5];
-  std::string dataChunk(&chunk[6], clipboardData->m_dataSize);
+  const char *payload = &chunk[6];
+  const auto payloadSize = static_cast<uint32_t>(clipboardData->m_dataSize);
 
   switch (mark) {
   case ChunkType::DataStart:
-    LOG_VERBOSE("sending clipboard chunk start: size=%s", dataChunk.c_str());
+    LOG_VERBOSE("sending clipboard chunk start: size=%s", payload);
+    break;
+
+  case ChunkType::DataResume:
+    LOG_VERBOSE("sending clipboard chunk start: size, transfer and offset=%s", payload);
     break;
 
   case ChunkType::DataChunk:
-    LOG_VERBOSE("sending clipboard chunk data: size=%i", dataChunk.size());
+    LOG_VERBOSE("sending clipboard chunk data: size=%u", payloadSize);
     break;
 
   case ChunkType::DataEnd:
@@ -191,5 +282,7 @@ void ClipboardChunk::send(deskflow::IStream *stream, void *data)
     break;
   }
 
-  ProtocolUtil::writef(stream, kMsgDClipboard, id, sequence, mark, &dataChunk);
+  ProtocolUtil::writef(
+      stream, kMsgDClipboardBytes, id, sequence, mark, payloadSize, reinterpret_cast<const uint8_t *>(payload)
+  );
 }
@@ -11,7 +11,9 @@
 #include "deskflow/ProtocolTypes.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 constexpr static auto s_clipboardChunkMetaSize = 7;
 
@@ -19,10 +21,16 @@ namespace deskflow {
 class IStream;
 }
 
+class ClipboardBuffer;
+class ClipboardPartials;
+
 struct ClipboardChunkAssemblyState
 {
   size_t expectedSize = 0;
   bool active = false;
+  ClipboardID id = 0;
+  uint64_t transferId = 0; //!< Zero unless the transfer is resumable
+  bool resumed = false;    //!< Continues data kept from an earlier transfer
 };
 
 class ClipboardChunk : public Chunk
@@ -31,12 +39,33 @@ public:
   explicit ClipboardChunk(size_t size);
 
   static ClipboardChunk *start(ClipboardID id, uint32_t sequence, const std::string &size);
-  static ClipboardChunk *data(ClipboardID id, uint32_t sequence, const std::string &data);
+  static ClipboardChunk *data(ClipboardID id, uint32_t sequence, std::string_view data);
   static ClipboardChunk *end(ClipboardID id, uint32_t sequence);
 
+  //! Start a resumable transfer
+  /*!
+  Starts a transfer of \p size bytes whose data chunks begin at
+  \p offset, for a receiver that negotiated resumable transfers.
+  */
+  static ClipboardChunk *resume(ClipboardID id, uint32_t sequence, size_t size, uint64_t transferId, size_t offset);
+
+  //! Get the transfer id of clipboard data
+  /*!
+  A 64-bit hash of \p data, never zero.  FNV-1a taken eight bytes at a
+  time, see kMsgDClipboard, so it's quick enough for large clipboards.
+  */
+  static uint64_t transferIdOf(std::string_view data);
+
+  //! Read a chunk and add it to the data received
+  /*!
+  Resumed transfers continue from the data kept in \p partials, and a
+  transfer that is started replaces what was kept for its clipboard.
+  Without \p partials only transfers resumed from the start are accepted.
+  A large transfer is received into a temporary file, see ClipboardBuffer.
+  */
   static TransferState assemble(
-      deskflow::IStream *stream, std::string &dataCached, ClipboardID &id, uint32_t &sequence,
-      ClipboardChunkAssemblyState &state, size_t maxDataSize
+      deskflow::IStream *stream, ClipboardBuffer &dataCached, ClipboardID &id, uint32_t &sequence,
+      ClipboardChunkAssemblyState &state, size_t maxDataSize, ClipboardPartials *partials = nullptr
   );
 
   static void send(deskflow::IStream *stream, void *data);
@@ -0,0 +1,86 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "deskflow/ClipboardPartials.h"
+
+#include "base/Log.h"
+#include "deskflow/ClipboardChunk.h"
+#include "deskflow/ProtocolTypes.h"
+#include "deskflow/ProtocolUtil.h"
+
+#include <algorithm>
+#include <limits>
+
+void ClipboardPartials::keep(const ClipboardChunkAssemblyState &state, ClipboardBuffer &&data)
+{
+  if (!state.active || state.transferId == 0 || state.id >= kClipboardEnd) {
+    return;
+  }
+
+  LOG_DEBUG("keeping %zu of %zu bytes of clipboard %d to resume", data.size(), state.expectedSize, state.id);
+  auto &partial = m_partials[state.id];
+  partial.transferId = state.transferId;
+  partial.data = std::move(data);
+}
+
+bool ClipboardPartials::take(ClipboardID id, uint64_t transferId, size_t offset, ClipboardBuffer &data)
+{
+  if (id >= kClipboardEnd) {
+    return false;
+  }
+
+  auto &partial = m_partials[id];
+  if (partial.transferId != transferId || partial.data.size() < offset) {
+    drop(id);
+    return false;
+  }
+
+  partial.data.truncate(offset);
+  data = std::move(partial.data);
+  drop(id);
+  return true;
+}
+
+void ClipboardPartials::drop(ClipboardID id)
+{
+  if (id < kClipboardEnd) {
+    m_partials[id].transferId = 0;
+    m_partials[id].data.clear();
+  }
+}
+
+void ClipboardPartials::sendOffsets(deskflow::IStream *stream) const
+{
+  for (ClipboardID id = 0; id < kClipboardEnd; ++id) {
+    const auto &partial = m_partials[id];
+
+    // a shorter offset is still a valid place to resume from
+    const auto offset = std::min<size_t>(partial.data.size(), std::numeric_limits<uint32_t>::max());
+    ProtocolUtil::writef(
+        stream, kMsgDClipboardResume, id, static_cast<uint32_t>(partial.transferId >> 32),
+        static_cast<uint32_t>(partial.transferId), static_cast<uint32_t>(offset)
+    );
+  }
+}
+
+bool ClipboardPartials::readOffset(deskflow::IStream *stream, ClipboardID &id, ClipboardResumePoint &point)
+{
+  uint32_t transferHi;
+  uint32_t transferLo;
+  uint32_t offset;
+  if (!ProtocolUtil::readf(stream, kMsgDClipboardResume + 4, &id, &transferHi, &transferLo, &offset)) {
+    return false;
+  }
+
+  if (id >= kClipboardEnd) {
+    LOG_ERR("clipboard resume invalid id: %d", id);
+    return false;
+  }
+
+  point.transferId = (uint64_t{transferHi} << 32) | transferLo;
+  point.offset = point.transferId != 0 ? offset : 0;
+  return true;
+}
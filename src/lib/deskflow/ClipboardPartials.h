@@ -0,0 +1,94 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "deskflow/ClipboardBuffer.h"
+#include "deskflow/ClipboardTypes.h"
+
+#include <array>
+#include <cstdint>
+
+namespace deskflow {
+class IStream;
+}
+
+struct ClipboardChunkAssemblyState;
+
+//! How much of a resumable transfer the peer kept
+/*!
+What the peer reported with kMsgDClipboardResume, used once by the next
+transfer of that clipboard.
+*/
+struct ClipboardResumePoint
+{
+  uint64_t transferId = 0; //!< Zero if the peer kept nothing
+  uint32_t offset = 0;     //!< Bytes of data the peer holds
+};
+
+//! Partly received clipboard transfers
+/*!
+When a connection drops during a resumable clipboard transfer the
+receiver keeps the data it has so far.  After reconnecting it reports
+what it kept with kMsgDClipboardResume, and if the sender's clipboard
+still has the same data the transfer carries on from there instead of
+starting again.
+
+At most one transfer is kept per clipboard.  A new transfer of a
+clipboard replaces whatever was kept for it.
+*/
+class ClipboardPartials
+{
+public:
+  //! @name manipulators
+  //@{
+
+  //! Keep an interrupted transfer
+  /*!
+  Keeps \p data if \p state is part way through a resumable transfer,
+  otherwise does nothing.
+  */
+  void keep(const ClipboardChunkAssemblyState &state, ClipboardBuffer &&data);
+
+  //! Take a kept transfer to carry on with
+  /*!
+  If the first \p offset bytes of transfer \p transferId are kept for
+  clipboard \p id, moves them to \p data and returns true.  Returns
+  false otherwise.  Nothing is kept for \p id afterwards either way.
+  */
+  bool take(ClipboardID id, uint64_t transferId, size_t offset, ClipboardBuffer &data);
+
+  //! Forget the transfer kept for clipboard \p id
+  void drop(ClipboardID id);
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Report the kept transfers
+  /*!
+  Writes a kMsgDClipboardResume for each clipboard to \p stream.
+  */
+  void sendOffsets(deskflow::IStream *stream) const;
+
+  //! Read a kMsgDClipboardResume
+  /*!
+  Reads the message from \p stream, after its code.  Returns false if it
+  can't be read or names an invalid clipboard.
+  */
+  static bool readOffset(deskflow::IStream *stream, ClipboardID &id, ClipboardResumePoint &point);
+
+  //@}
+
+private:
+  struct Partial
+  {
+    uint64_t transferId = 0;
+    ClipboardBuffer data;
+  };
+
+  std::array<Partial, kClipboardEnd> m_partials;
+};
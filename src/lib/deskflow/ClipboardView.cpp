@@ -0,0 +1,64 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "deskflow/ClipboardView.h"
+
+#include "base/Log.h"
+
+ClipboardView::ClipboardView(std::string_view data, Time time, std::shared_ptr<const void> owner)
+    : m_time(time),
+      m_owner(std::move(owner))
+{
+  readFormats(data, [this](Format format, std::string_view formatData) {
+    const auto formatID = static_cast<int>(format);
+    m_data[formatID] = formatData;
+    m_added[formatID] = true;
+  });
+}
+
+bool ClipboardView::empty()
+{
+  LOG_WARN("cannot empty clipboard, it is read only");
+  return false;
+}
+
+void ClipboardView::add(Format, std::string)
+{
+  LOG_WARN("cannot add to clipboard, it is read only");
+}
+
+bool ClipboardView::open(Time) const
+{
+  return true;
+}
+
+void ClipboardView::close() const
+{
+  // do nothing
+}
+
+IClipboard::Time ClipboardView::getTime() const
+{
+  return m_time;
+}
+
+bool ClipboardView::has(Format format) const
+{
+  return m_added[static_cast<int>(format)];
+}
+
+std::string ClipboardView::get(Format format) const
+{
+  return std::string(m_data[static_cast<int>(format)]);
+}
+
+IClipboard::SharedData ClipboardView::getShared(Format format) const
+{
+  if (m_owner == nullptr) {
+    return {};
+  }
+  return {m_owner, m_data[static_cast<int>(format)]};
+}
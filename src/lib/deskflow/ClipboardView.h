@@ -0,0 +1,51 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "deskflow/IClipboard.h"
+
+#include <memory>
+#include <string_view>
+
+//! Read-only clipboard over marshalled data
+/*!
+Presents marshalled clipboard data, such as a transfer just received,
+as a clipboard without copying it.  A format's data is only copied by
+get().  If the view is given an owner that keeps the marshalled data
+alive, getShared() hands out the data with that owner, so copying the
+view to a platform clipboard that keeps shared data makes no copy at
+all and the data stays where it is, e.g. in a ClipboardBuffer's mapping.
+Otherwise the marshalled data must outlive the view.
+
+The view can't be changed; empty() fails and add() is ignored.
+*/
+class ClipboardView : public IClipboard
+{
+public:
+  //! Read \p data, which is in the form IClipboard::marshall() makes
+  /*!
+  \p owner, if given, keeps \p data alive and is shared by getShared().
+  */
+  ClipboardView(std::string_view data, Time time, std::shared_ptr<const void> owner = nullptr);
+  ~ClipboardView() override = default;
+
+  // IClipboard overrides
+  bool empty() override;
+  void add(Format, std::string data) override;
+  bool open(Time) const override;
+  void close() const override;
+  Time getTime() const override;
+  bool has(Format) const override;
+  std::string get(Format) const override;
+  SharedData getShared(Format) const override;
+
+private:
+  Time m_time;
+  std::shared_ptr<const void> m_owner;
+  bool m_added[static_cast<int>(Format::TotalFormats)] = {false, false, false};
+  std::string_view m_data[static_cast<int>(Format::TotalFormats)];
+};
@@ -0,0 +1,73 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "deskflow/ClockOffsetEstimator.h"
+
+//
+// ClockOffsetEstimator
+//
+
+void ClockOffsetEstimator::addSample(int64_t originate, int64_t receive, int64_t transmit, int64_t destination)
+{
+  const int64_t rtt = (destination - originate) - (transmit - receive);
+  if (rtt < 0) {
+    return;
+  }
+
+  // the midpoints of the request and reply legs; halving each leg first
+  // keeps the sum in range for any pair of monotonic clocks
+  const int64_t offset = (receive - originate) / 2 + (transmit - destination) / 2;
+
+  m_samples[m_next] = {offset, rtt};
+  m_next = (m_next + 1) % kWindow;
+  if (m_count < kWindow) {
+    ++m_count;
+  }
+
+  // smooth the round trip the same way tcp does, with a gain of 1/8
+  if (m_count == 1) {
+    m_smoothedRtt = rtt;
+  } else {
+    m_smoothedRtt += (rtt - m_smoothedRtt) / 8;
+  }
+
+  // take the offset from the least delayed exchange in the window
+  const Sample *best = &m_samples[0];
+  for (size_t i = 1; i < m_count; ++i) {
+    if (m_samples[i].m_rtt < best->m_rtt) {
+      best = &m_samples[i];
+    }
+  }
+  m_offset = best->m_offset;
+}
+
+void ClockOffsetEstimator::reset()
+{
+  m_count = 0;
+  m_next = 0;
+  m_offset = 0;
+  m_smoothedRtt = 0;
+}
+
+bool ClockOffsetEstimator::isValid() const
+{
+  return m_count > 0;
+}
+
+int64_t ClockOffsetEstimator::offset() const
+{
+  return m_offset;
+}
+
+int64_t ClockOffsetEstimator::rtt() const
+{
+  return m_smoothedRtt;
+}
+
+int64_t ClockOffsetEstimator::toLocal(int64_t peerTime) const
+{
+  return peerTime - m_offset;
+}
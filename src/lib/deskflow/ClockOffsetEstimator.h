@@ -0,0 +1,86 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+//! Peer clock offset estimator
+/*!
+Estimates the offset between the local monotonic clock and a peer's from
+NTP-style timestamp exchanges.  Each exchange gives four timestamps in
+nanoseconds: the request's transmit time (local clock), its receive time
+and the reply's transmit time (peer clock), and the reply's receive time
+(local clock).
+
+Network jitter makes any single exchange unreliable, but queuing delay
+can only ever lengthen the round trip, so the exchange with the
+shortest round trip in a recent window gives the best offset.  The
+window is kept short so the estimate follows any drift between clocks.
+*/
+class ClockOffsetEstimator
+{
+public:
+  //! @name manipulators
+  //@{
+
+  //! Add an exchange
+  /*!
+  \p originate and \p destination are from the local clock, \p receive
+  and \p transmit from the peer's.  Exchanges where the peer apparently
+  took longer than the whole round trip are discarded.
+  */
+  void addSample(int64_t originate, int64_t receive, int64_t transmit, int64_t destination);
+
+  //! Discard all exchanges
+  void reset();
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Check for an estimate
+  /*!
+  Returns \c true once at least one exchange has been added.
+  */
+  bool isValid() const;
+
+  //! Get clock offset
+  /*!
+  Returns the peer's clock minus the local clock in nanoseconds.
+  */
+  int64_t offset() const;
+
+  //! Get round trip time
+  /*!
+  Returns a smoothed round trip time in nanoseconds, excluding the time
+  the peer took to reply.
+  */
+  int64_t rtt() const;
+
+  //! Convert peer time to local time
+  int64_t toLocal(int64_t peerTime) const;
+
+  //@}
+
+  //! Number of exchanges considered for the offset
+  static constexpr size_t kWindow = 8;
+
+private:
+  struct Sample
+  {
+    int64_t m_offset = 0;
+    int64_t m_rtt = 0;
+  };
+
+  std::array<Sample, kWindow> m_samples{};
+  size_t m_count = 0;
+  size_t m_next = 0;
+  int64_t m_offset = 0;
+  int64_t m_smoothedRtt = 0;
+};
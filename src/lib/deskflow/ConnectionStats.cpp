@@ -0,0 +1,153 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "deskflow/ConnectionStats.h"
+
+#include "base/String.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+// all live instances, guarded by s_mutex
+std::mutex s_mutex;
+std::vector<const ConnectionStats *> s_instances;
+
+const char *stageName(ConnectionStats::Stage stage)
+{
+  using enum ConnectionStats::Stage;
+  switch (stage) {
+  case Queue:
+    return "queue";
+  case Send:
+    return "send";
+  case Inject:
+    return "inject";
+  case Age:
+    return "age";
+  default:
+    return "unknown";
+  }
+}
+
+std::string escapeJson(const std::string &in)
+{
+  std::string out;
+  out.reserve(in.size());
+  for (char c : in) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out += deskflow::string::sprintf("\\u%04x", static_cast<unsigned>(c));
+    } else {
+      out += c;
+    }
+  }
+  return out;
+}
+
+} // namespace
+
+//
+// ConnectionStats
+//
+
+ConnectionStats::ConnectionStats(const std::string &name) : m_name(name)
+{
+  std::scoped_lock lock{s_mutex};
+  s_instances.push_back(this);
+}
+
+ConnectionStats::~ConnectionStats()
+{
+  std::scoped_lock lock{s_mutex};
+  std::erase(s_instances, this);
+}
+
+void ConnectionStats::messageSent(uint32_t bytes)
+{
+  m_messagesSent.fetch_add(1, std::memory_order_relaxed);
+  m_bytesSent.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void ConnectionStats::messageReceived(uint32_t bytes)
+{
+  m_messagesReceived.fetch_add(1, std::memory_order_relaxed);
+  m_bytesReceived.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+LatencyHistogram &ConnectionStats::latency(Stage stage)
+{
+  return m_latency[static_cast<int>(stage)];
+}
+
+void ConnectionStats::setClock(int64_t rtt, int64_t offset)
+{
+  m_rtt.store(rtt, std::memory_order_relaxed);
+  m_offset.store(offset, std::memory_order_relaxed);
+}
+
+const LatencyHistogram &ConnectionStats::latency(Stage stage) const
+{
+  return m_latency[static_cast<int>(stage)];
+}
+
+std::string ConnectionStats::toJson() const
+{
+  std::scoped_lock lock{s_mutex};
+  return toJsonNoLock();
+}
+
+std::string ConnectionStats::toJsonNoLock() const
+{
+  // note -- s_mutex must be locked on entry
+
+  std::string json = deskflow::string::sprintf(
+      R"({"name":"%s","sent":{"messages":%llu,"bytes":%llu},"received":{"messages":%llu,"bytes":%llu},)"
+      R"("clock":{"rtt":%lld,"offset":%lld},"latency":{)",
+      escapeJson(m_name).c_str(), static_cast<unsigned long long>(m_messagesSent.load(std::memory_order_relaxed)),
+      static_cast<unsigned long long>(m_bytesSent.load(std::memory_order_relaxed)),
+      static_cast<unsigned long long>(m_messagesReceived.load(std::memory_order_relaxed)),
+      static_cast<unsigned long long>(m_bytesReceived.load(std::memory_order_relaxed)),
+      static_cast<long long>(m_rtt.load(std::memory_order_relaxed) / 1000),
+      static_cast<long long>(m_offset.load(std::memory_order_relaxed) / 1000)
+  );
+
+  // microseconds are plenty of precision for input and keep the numbers readable
+  for (int i = 0; i < static_cast<int>(Stage::NumStages); ++i) {
+    const auto &histogram = m_latency[i];
+    json += deskflow::string::sprintf(
+        R"(%s"%s":{"count":%llu,"p50":%llu,"p90":%llu,"p99":%llu,"max":%llu})", i == 0 ? "" : ",",
+        stageName(static_cast<Stage>(i)), static_cast<unsigned long long>(histogram.count()),
+        static_cast<unsigned long long>(histogram.valueAtPercentile(50.0) / 1000),
+        static_cast<unsigned long long>(histogram.valueAtPercentile(90.0) / 1000),
+        static_cast<unsigned long long>(histogram.valueAtPercentile(99.0) / 1000),
+        static_cast<unsigned long long>(histogram.max() / 1000)
+    );
+  }
+
+  json += "}}";
+  return json;
+}
+
+std::string ConnectionStats::report()
+{
+  std::string json = "[";
+
+  // hold the lock while reading so an instance can't be destroyed under us
+  std::scoped_lock lock{s_mutex};
+  for (const auto *stats : s_instances) {
+    if (json.size() > 1) {
+      json += ",";
+    }
+    json += stats->toJsonNoLock();
+  }
+  json += "]";
+  return json;
+}
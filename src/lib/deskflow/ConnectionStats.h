@@ -0,0 +1,96 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "base/LatencyHistogram.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+//! Per-connection telemetry
+/*!
+Counts messages and bytes in each direction on a connection and keeps a
+latency histogram for each stage an input event passes through.  Every
+instance registers itself on construction so report() can describe all
+live connections, e.g. in answer to the \c stats IPC command.
+
+Counters may be updated from the event thread while report() runs on
+another thread.
+*/
+class ConnectionStats
+{
+public:
+  //! Latency stages of an input event
+  enum class Stage
+  {
+    Queue,  //!< Captured on the primary until handled by the server
+    Send,   //!< Captured on the primary until written to the connection
+    Inject, //!< Received by the client until injected on the screen
+    Age,    //!< Captured on the primary until injected on the client
+    NumStages
+  };
+
+  explicit ConnectionStats(const std::string &name);
+  ConnectionStats(const ConnectionStats &) = delete;
+  ConnectionStats &operator=(const ConnectionStats &) = delete;
+  ~ConnectionStats();
+
+  //! @name manipulators
+  //@{
+
+  //! Count a message written to the connection
+  void messageSent(uint32_t bytes);
+
+  //! Count a message read from the connection
+  void messageReceived(uint32_t bytes);
+
+  //! Get the histogram for a stage
+  LatencyHistogram &latency(Stage stage);
+
+  //! Set clock estimate
+  /*!
+  Records the latest round trip time and the peer's clock offset, both
+  in nanoseconds, from timestamped keep-alives.
+  */
+  void setClock(int64_t rtt, int64_t offset);
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Get the histogram for a stage
+  const LatencyHistogram &latency(Stage stage) const;
+
+  //! Get stats as a single line of JSON
+  /*!
+  Latency percentiles are reported in microseconds.
+  */
+  std::string toJson() const;
+
+  //! Get stats for all live connections
+  /*!
+  Returns a single line JSON array with one object per connection, in
+  the order the connections were created.
+  */
+  static std::string report();
+
+  //@}
+
+private:
+  std::string toJsonNoLock() const;
+
+private:
+  std::string m_name;
+  std::atomic<uint64_t> m_messagesSent = 0;
+  std::atomic<uint64_t> m_bytesSent = 0;
+  std::atomic<uint64_t> m_messagesReceived = 0;
+  std::atomic<uint64_t> m_bytesReceived = 0;
+  std::atomic<int64_t> m_rtt = 0;
+  std::atomic<int64_t> m_offset = 0;
+  LatencyHistogram m_latency[static_cast<int>(Stage::NumStages)];
+};
@@ -20,55 +20,63 @@ void IClipboard::unmarshall(IClipboard *clipboard, const std::string_view &data,
 {
   assert(clipboard != nullptr);
 
-  const char *index = data.data();
-  const char *const end = index + data.size();
-
   if (clipboard->open(time)) {
     // clear existing data
     clipboard->empty();
 
-    // read the number of formats
-    const uint32_t numFormats = readUInt32(index);
-    if (end - index < 4) {
-      LOG_ERR("clipboard unmarshall: truncated header");
-      clipboard->close();
-      return;
+    readFormats(data, [clipboard](Format format, std::string_view formatData) {
+      clipboard->add(format, std::string(formatData));
+    });
+
+    // done
+    clipboard->close();
+  }
+}
+
+bool IClipboard::readFormats(std::string_view data, const std::function<void(Format, std::string_view)> &read)
+{
+  const char *index = data.data();
+  const char *const end = index + data.size();
+
+  // read the number of formats
+  if (end - index < 4) {
+    LOG_ERR("clipboard unmarshall: truncated header");
+    return false;
+  }
+  const uint32_t numFormats = readUInt32(index);
+  index += 4;
+
+  // read each format
+  for (uint32_t i = 0; i < numFormats; ++i) {
+    // need 8 bytes for format id + payload size
+    if (end - index < 8) {
+      LOG_ERR("clipboard unmarshall: truncated format header at %u/%u", i, numFormats);
+      return false;
     }
+    // get the format id
+    auto format = static_cast<IClipboard::Format>(readUInt32(index));
     index += 4;
 
-    // read each format
-    for (uint32_t i = 0; i < numFormats; ++i) {
-      // need 8 bytes for format id + payload size
-      if (end - index < 8) {
-        LOG_ERR("clipboard unmarshall: truncated format header at %u/%u", i, numFormats);
-        break;
-      }
-      // get the format id
-      auto format = static_cast<IClipboard::Format>(readUInt32(index));
-      index += 4;
-
-      // get the size of the format data
-      uint32_t size = readUInt32(index);
-      index += 4;
-
-      // peer-supplied size must not exceed remaining buffer
-      if (size > static_cast<uint32_t>(end - index)) {
-        LOG_ERR("clipboard unmarshall: payload size %u exceeds remaining %zd", size, end - index);
-        break;
-      }
+    // get the size of the format data
+    uint32_t size = readUInt32(index);
+    index += 4;
 
-      // save the data if it's a known format.  if either the client
-      // or server supports more clipboard formats than the other
-      // then one of them will get a format >= TotalFormats here.
-      if (format < IClipboard::Format::TotalFormats) {
-        clipboard->add(format, std::string(index, size));
-      }
-      index += size;
+    // peer-supplied size must not exceed remaining buffer
+    if (size > static_cast<uint32_t>(end - index)) {
+      LOG_ERR("clipboard unmarshall: payload size %u exceeds remaining %zd", size, end - index);
+      return false;
     }
 
-    // done
-    clipboard->close();
+    // save the data if it's a known format.  if either the client
+    // or server supports more clipboard formats than the other
+    // then one of them will get a format >= TotalFormats here.
+    if (format < IClipboard::Format::TotalFormats) {
+      read(format, std::string_view(index, size));
+    }
+    index += size;
   }
+
+  return true;
 }
 
 std::string IClipboard::marshall(const IClipboard *clipboard)
@@ -118,6 +126,22 @@ std::string IClipboard::marshall(const IClipboard *clipboard)
   return data;
 }
 
+void IClipboard::addShared(Format format, SharedData data)
+{
+  add(format, std::string(data.data));
+}
+
+IClipboard::SharedData IClipboard::getShared(Format) const
+{
+  return {};
+}
+
+IClipboard::SharedData IClipboard::share(std::string data)
+{
+  auto owner = std::make_shared<const std::string>(std::move(data));
+  return {owner, *owner};
+}
+
 bool IClipboard::copy(IClipboard *dst, const IClipboard *src)
 {
   assert(dst != nullptr);
@@ -138,7 +162,11 @@ bool IClipboard::copy(IClipboard *dst, const IClipboard *src, Time time)
         for (int32_t format = 0; format != static_cast<int>(Format::TotalFormats); ++format) {
           auto eFormat = (IClipboard::Format)format;
           if (src->has(eFormat)) {
-            dst->add(eFormat, src->get(eFormat));
+            if (auto shared = src->getShared(eFormat); shared.owner != nullptr) {
+              dst->addShared(eFormat, std::move(shared));
+            } else {
+              dst->add(eFormat, src->get(eFormat));
+            }
           }
         }
         success = true;
@@ -9,7 +9,10 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
+#include <string_view>
 
 //! Clipboard interface
 /*!
@@ -27,6 +30,18 @@ public:
   */
   using Time = uint32_t;
 
+  //! Shared clipboard data
+  /*!
+  One format's data and whatever keeps it alive, so a clipboard can
+  keep another clipboard's data without copying it.  A null \c owner
+  means there is nothing to share.
+  */
+  struct SharedData
+  {
+    std::shared_ptr<const void> owner;
+    std::string_view data;
+  };
+
   //! Clipboard formats
   /*!
   The list of known clipboard formats.  TotalFormats must be last and
@@ -69,9 +84,18 @@ public:
   //! Add data
   /*!
   Add data in the given format to the clipboard.  May only be
-  called after a successful empty().
+  called after a successful empty().  The data is taken by value so
+  clipboards that keep it can move it rather than copy it.
   */
-  virtual void add(Format, const std::string &data) = 0;
+  virtual void add(Format, std::string data) = 0;
+
+  //! Add shared data
+  /*!
+  Like add(), but \p data stays valid while its owner is held, so
+  clipboards that keep data can keep the owner instead of a copy.  By
+  default the data is copied into add().
+  */
+  virtual void addShared(Format, SharedData data);
 
   //@}
   //! @name accessors
@@ -119,6 +143,21 @@ public:
   */
   virtual std::string get(Format) const = 0;
 
+  //! Get shared data
+  /*!
+  Return the data in the given format along with its owner, if the
+  clipboard can share it.  By default there is no owner and the data
+  must be read with get().  Must be called between a successful open()
+  and close().
+  */
+  virtual SharedData getShared(Format) const;
+
+  //! Share data
+  /*!
+  Return \p data as shared data that owns it.
+  */
+  static SharedData share(std::string data);
+
   //! Marshall clipboard data
   /*!
   Merge \p clipboard's data into a single buffer that can be later
@@ -133,13 +172,22 @@ public:
   */
   static void unmarshall(IClipboard *clipboard, const std::string_view &data, Time time);
 
+  //! Read marshalled clipboard data
+  /*!
+  Calls \p read with each known format in \p data and a view of its
+  data, without copying it.  Stops at the first format that's cut
+  short.  Returns false if the data is cut short.
+  */
+  static bool readFormats(std::string_view data, const std::function<void(Format, std::string_view)> &read);
+
   //! Copy clipboard
   /*!
   Transfers all the data in one clipboard to another.  The
   clipboards can be of any concrete clipboard type (and
-  they don't have to be the same type).  This also sets
-  the destination clipboard's timestamp to source clipboard's
-  timestamp.  Returns true iff the copy succeeded.
+  they don't have to be the same type).  Data the source can share
+  is handed over with addShared(), anything else with add().  This
+  also sets the destination clipboard's timestamp to source
+  clipboard's timestamp.  Returns true iff the copy succeeded.
   */
   static bool copy(IClipboard *dst, const IClipboard *src);
 
@@ -7,6 +7,8 @@
 
 #include "deskflow/IPrimaryScreen.h"
 
+#include "base/LatencyHistogram.h"
+
 #include <cstdlib>
 
 //
@@ -43,6 +45,7 @@ IPrimaryScreen::MotionInfo *IPrimaryScreen::MotionInfo::alloc(int32_t x, int32_t
   auto *info = (MotionInfo *)malloc(sizeof(MotionInfo));
   info->m_x = x;
   info->m_y = y;
+  info->m_captureTime = LatencyHistogram::now();
   return info;
 }
 
@@ -55,6 +58,7 @@ IPrimaryScreen::WheelInfo *IPrimaryScreen::WheelInfo::alloc(int32_t xDelta, int3
   auto *info = (WheelInfo *)malloc(sizeof(WheelInfo));
   info->m_xDelta = xDelta;
   info->m_yDelta = yDelta;
+  info->m_captureTime = LatencyHistogram::now();
   return info;
 }
 
@@ -46,6 +46,8 @@ public:
   public:
     int32_t m_x;
     int32_t m_y;
+    //! Monotonic capture time, see LatencyHistogram::now()
+    uint64_t m_captureTime;
   };
   //! Wheel motion event data
   class WheelInfo
@@ -56,6 +58,8 @@ public:
   public:
     int32_t m_xDelta;
     int32_t m_yDelta;
+    //! Monotonic capture time, see LatencyHistogram::now()
+    uint64_t m_captureTime;
   };
   //! Hot key event data
   class HotKeyInfo
@@ -9,7 +9,7 @@
 #pragma once
 
 #include "common/Coordinate.h"
-#include "common/Settings.h"
+#include "common/SettingsSnapshot.h"
 #include "deskflow/MouseTypes.h"
 
 //! Secondary screen interface
@@ -22,10 +22,11 @@ class ISecondaryScreen
 public:
   ISecondaryScreen()
   {
-    m_invertYScroll = Settings::value(Settings::Client::InvertYScroll).toBool();
-    m_yScrollScale = std::clamp(Settings::value(Settings::Client::YScrollScale).toDouble(), 0.1, 10.0);
-    m_invertXScroll = Settings::value(Settings::Client::InvertXScroll).toBool();
-    m_xScrollScale = std::clamp(Settings::value(Settings::Client::XScrollScale).toDouble(), 0.1, 10.0);
+    const auto settings = SettingsSnapshot::current();
+    m_invertYScroll = settings->client.invertYScroll;
+    m_yScrollScale = settings->client.yScrollScale;
+    m_invertXScroll = settings->client.invertXScroll;
+    m_xScrollScale = settings->client.xScrollScale;
   }
 
   virtual ~ISecondaryScreen() = default;
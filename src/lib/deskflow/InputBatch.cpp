@@ -0,0 +1,113 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "deskflow/InputBatch.h"
+
+#include "deskflow/ProtocolTypes.h"
+#include "deskflow/ProtocolUtil.h"
+#include "io/IStream.h"
+
+#include <array>
+#include <cstring>
+
+namespace {
+
+// a 64 bit value never needs more than 10 groups of 7 bits
+const int kMaxVarintLength = 10;
+
+void appendVarint(uint64_t value, std::string &buffer)
+{
+  while (value >= 0x80U) {
+    buffer.push_back(static_cast<char>((value & 0x7fU) | 0x80U));
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<char>(value));
+}
+
+} // namespace
+
+//
+// InputBatch
+//
+
+void InputBatch::add(uint64_t time, const std::vector<uint8_t> &message)
+{
+  if (m_records.empty()) {
+    m_baseTime = time;
+    m_lastTime = time;
+  }
+
+  // keep the time as the client will rebuild it so rounding doesn't add up
+  const uint64_t delta = time > m_lastTime ? (time - m_lastTime) / 1000 : 0;
+  m_lastTime += delta * 1000;
+
+  appendVarint(delta, m_records);
+  m_records.append(message.begin(), message.end());
+}
+
+void InputBatch::send(deskflow::IStream *stream)
+{
+  if (m_records.empty()) {
+    return;
+  }
+
+  ProtocolUtil::writef(
+      stream, kMsgDInputBatch, static_cast<uint32_t>(m_baseTime >> 32), static_cast<uint32_t>(m_baseTime), &m_records
+  );
+  m_records.clear();
+}
+
+bool InputBatch::isEmpty() const
+{
+  return m_records.empty();
+}
+
+uint32_t InputBatch::getSize() const
+{
+  return static_cast<uint32_t>(m_records.size());
+}
+
+bool InputBatch::readDelta(deskflow::IStream *stream, uint64_t &delta)
+{
+  delta = 0;
+  for (int i = 0; i < kMaxVarintLength; ++i) {
+    uint8_t byte;
+    if (stream->read(&byte, 1) != 1) {
+      return false;
+    }
+    delta |= static_cast<uint64_t>(byte & 0x7fU) << (7 * i);
+    if ((byte & 0x80U) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool InputBatch::isBatchable(const uint8_t *code)
+{
+  static const std::array kBatchable = {
+      kMsgDKeyDown,
+      kMsgDKeyDownLang,
+      kMsgDKeyDownLangId,
+      kMsgDKeyRepeat,
+      kMsgDKeyUp,
+      kMsgDMouseDown,
+      kMsgDMouseUp,
+      kMsgDMouseMove,
+      kMsgDMouseMoveDelta,
+      kMsgDMouseMoveSync,
+      kMsgDMouseRelMove,
+      kMsgDMouseRelMoveCompact,
+      kMsgDMouseWheel,
+      kMsgDMouseWheelCompact,
+  };
+  for (const char *message : kBatchable) {
+    if (memcmp(code, message, 4) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
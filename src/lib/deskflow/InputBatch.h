@@ -0,0 +1,76 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace deskflow {
+class IStream;
+}
+
+//! Batch of input event messages
+/*!
+Collects input event messages into the records of a kMsgDInputBatch
+message.  Each record is the time since the previous record in
+microseconds, as an unsigned LEB128 varint, followed by the message
+exactly as it would be sent on its own.  Timestamps are nanoseconds
+from LatencyHistogram::now().
+*/
+class InputBatch
+{
+public:
+  //! @name manipulators
+  //@{
+
+  //! Add a message
+  /*!
+  Appends the formatted \p message, which happened at \p time.  Times
+  that go backwards are recorded as no time passing.
+  */
+  void add(uint64_t time, const std::vector<uint8_t> &message);
+
+  //! Send the batch
+  /*!
+  Writes the records to \p stream as a single kMsgDInputBatch message
+  and empties the batch.  Does nothing if the batch is empty.
+  */
+  void send(deskflow::IStream *stream);
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Check for records
+  bool isEmpty() const;
+
+  //! Get size of the records in bytes
+  uint32_t getSize() const;
+
+  //! Read a record's time
+  /*!
+  Reads the time delta at the start of a record from \p stream into
+  \p delta, in microseconds.  Returns false if the varint is truncated
+  or too long.
+  */
+  static bool readDelta(deskflow::IStream *stream, uint64_t &delta);
+
+  //! Check if a message may be batched
+  /*!
+  Returns true if the 4 byte message code \p code is an input event that
+  may appear in a batch.
+  */
+  static bool isBatchable(const uint8_t *code);
+
+  //@}
+
+private:
+  uint64_t m_baseTime = 0;
+  uint64_t m_lastTime = 0;
+  std::string m_records;
+};
@@ -12,11 +12,37 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <bit>
 #include <cctype>
 #include <cstdlib>
+#include <limits>
 
 namespace deskflow {
 
+namespace {
+
+// words in a written KeyItem
+const size_t kKeyItemWords = 9;
+
+bool readWord(std::span<const uint32_t> &words, uint32_t &word)
+{
+  if (words.empty()) {
+    return false;
+  }
+  word = words.front();
+  words = words.subspan(1);
+  return true;
+}
+
+// reads a count of things that are each at least wordsEach long, false
+// if there aren't enough words left for them
+bool readCount(std::span<const uint32_t> &words, size_t wordsEach, uint32_t &count)
+{
+  return readWord(words, count) && count <= words.size() / wordsEach;
+}
+
+} // namespace
+
 KeyMap::NameToKeyMap *KeyMap::s_nameToKeyMap = nullptr;
 KeyMap::NameToModifierMap *KeyMap::s_nameToModifierMap = nullptr;
 KeyMap::KeyToNameMap *KeyMap::s_keyToNameMap = nullptr;
@@ -38,6 +64,9 @@ KeyMap::KeyMap() : m_numGroups(0), m_composeAcrossGroups(false)
 void KeyMap::swap(KeyMap &x) noexcept
 {
   m_keyIDMap.swap(x.m_keyIDMap);
+  m_keyPageIndex.swap(x.m_keyPageIndex);
+  m_keyPages.swap(x.m_keyPages);
+  m_keyHash.swap(x.m_keyHash);
   m_modifierKeys.swap(x.m_modifierKeys);
   m_halfDuplex.swap(x.m_halfDuplex);
   m_halfDuplexMods.swap(x.m_halfDuplexMods);
@@ -61,7 +90,7 @@ void KeyMap::addKeyEntry(const KeyItem &item)
   if (getNumGroups() > numGroups) {
     numGroups = getNumGroups();
   }
-  KeyGroupTable &groupTable = m_keyIDMap[item.m_id];
+  KeyGroupTable &groupTable = findOrAddKey(item.m_id);
   if (groupTable.size() < static_cast<size_t>(numGroups)) {
     groupTable.resize(numGroups);
   }
@@ -87,9 +116,9 @@ void KeyMap::addKeyEntry(const KeyItem &item)
 
   // add item list
   entries.push_back(items);
-  LOG(
-      (CLOG_VERBOSE "add key: %04x %d %03x %04x (%04x %04x %04x)%s", newItem.m_id, newItem.m_group, newItem.m_button,
-       newItem.m_client, newItem.m_required, newItem.m_sensitive, newItem.m_generates, newItem.m_dead ? " dead" : "")
+  LOG_VERBOSE(
+      "add key: %04x %d %03x %04x (%04x %04x %04x)%s", newItem.m_id, newItem.m_group, newItem.m_button,
+      newItem.m_client, newItem.m_required, newItem.m_sensitive, newItem.m_generates, newItem.m_dead ? " dead" : ""
   );
 }
 
@@ -128,7 +157,7 @@ bool KeyMap::addKeyCombinationEntry(KeyID id, int32_t group, const KeyID *keys,
   if (getNumGroups() > numGroups) {
     numGroups = getNumGroups();
   }
-  KeyGroupTable &groupTable = m_keyIDMap[id];
+  KeyGroupTable &groupTable = findOrAddKey(id);
   if (groupTable.size() < static_cast<size_t>(numGroups)) {
     groupTable.resize(numGroups);
   }
@@ -140,23 +169,22 @@ bool KeyMap::addKeyCombinationEntry(KeyID id, int32_t group, const KeyID *keys,
   // convert to buttons
   KeyItemList items;
   for (uint32_t i = 0; i < numKeys; ++i) {
-    KeyIDMap::const_iterator gtIndex = m_keyIDMap.find(keys[i]);
-    if (gtIndex == m_keyIDMap.end()) {
+    const KeyGroupTable *groupTable = findKey(keys[i]);
+    if (groupTable == nullptr) {
       return false;
     }
-    const KeyGroupTable &groupTable = gtIndex->second;
 
     // if we allow group switching during composition then search all
     // groups for keys, otherwise search just the given group.
     int32_t n = 1;
     if (m_composeAcrossGroups) {
-      n = (int32_t)groupTable.size();
+      n = (int32_t)groupTable->size();
     }
 
     bool found = false;
     for (int32_t gd = 0; gd < n && !found; ++gd) {
       const auto eg = (group + gd) % getNumGroups();
-      const KeyEntryList &entries = groupTable[eg];
+      const KeyEntryList &entries = (*groupTable)[eg];
       for (const auto &entry : entries) {
         if (entry.size() == 1) {
           found = true;
@@ -224,14 +252,95 @@ void KeyMap::foreachKey(ForeachKeyCallback cb, void *userData)
   }
 }
 
+bool KeyMap::read(std::span<const uint32_t> &words)
+{
+  // parse everything before changing anything
+  auto rest = words;
+  uint32_t composeAcrossGroups = 0;
+  uint32_t numButtons = 0;
+  if (!readWord(rest, composeAcrossGroups) || composeAcrossGroups > 1 || !readCount(rest, 1, numButtons)) {
+    return false;
+  }
+  KeyButtonSet halfDuplex;
+  for (uint32_t i = 0; i < numButtons; ++i) {
+    if (rest[i] > std::numeric_limits<KeyButton>::max()) {
+      return false;
+    }
+    halfDuplex.insert(static_cast<KeyButton>(rest[i]));
+  }
+  rest = rest.subspan(numButtons);
+
+  KeyIDMap keyIDMap;
+  uint32_t numKeys = 0;
+  if (!readCount(rest, 2, numKeys)) {
+    return false;
+  }
+  for (uint32_t k = 0; k < numKeys; ++k) {
+    uint32_t id = 0;
+    uint32_t numGroups = 0;
+    if (!readWord(rest, id) || !readCount(rest, 1, numGroups)) {
+      return false;
+    }
+    auto [groupTable, inserted] = keyIDMap.try_emplace(id, numGroups);
+    if (!inserted) {
+      return false;
+    }
+    for (auto &entries : groupTable->second) {
+      uint32_t numEntries = 0;
+      if (!readCount(rest, 1, numEntries)) {
+        return false;
+      }
+      entries.resize(numEntries);
+      for (auto &items : entries) {
+        uint32_t numItems = 0;
+        if (!readCount(rest, kKeyItemWords, numItems)) {
+          return false;
+        }
+        items.resize(numItems);
+        for (auto &item : items) {
+          if (rest[2] > std::numeric_limits<KeyButton>::max() || rest[6] > 1 || rest[7] > 1) {
+            return false;
+          }
+          item.m_id = rest[0];
+          item.m_group = static_cast<int32_t>(rest[1]);
+          item.m_button = static_cast<KeyButton>(rest[2]);
+          item.m_required = rest[3];
+          item.m_sensitive = rest[4];
+          item.m_generates = rest[5];
+          item.m_dead = rest[6] != 0;
+          item.m_lock = rest[7] != 0;
+          item.m_client = rest[8];
+          rest = rest.subspan(kKeyItemWords);
+        }
+      }
+    }
+  }
+
+  m_keyIDMap.swap(keyIDMap);
+  m_halfDuplex.swap(halfDuplex);
+  m_composeAcrossGroups = composeAcrossGroups != 0;
+
+  m_keyPageIndex.fill(0);
+  m_keyPages.clear();
+  m_keyHash.clear();
+  for (const auto &[id, groupTable] : m_keyIDMap) {
+    indexKey(id, &groupTable);
+  }
+
+  // the modifier table points into the old entries
+  m_modifierKeys.clear();
+
+  words = rest;
+  return true;
+}
+
 const KeyMap::KeyItem *KeyMap::mapKey(
     Keystrokes &keys, KeyID id, int32_t group, ModifierToKeys &activeModifiers, KeyModifierMask &currentState,
     KeyModifierMask desiredMask, bool isAutoRepeat, const std::string &lang
 ) const
 {
-  LOG(
-      (CLOG_VERBOSE "mapKey %04x (%d) with mask %04x, start state: %04x, group: %d", id, id, desiredMask, currentState,
-       group)
+  LOG_VERBOSE(
+      "mapKey %04x (%d) with mask %04x, start state: %04x, group: %d", id, id, desiredMask, currentState, group
   );
 
   // handle group change
@@ -327,12 +436,12 @@ KeyMap::findCompatibleKey(KeyID id, int32_t group, KeyModifierMask required, Key
 {
   assert(group >= 0 && group < getNumGroups());
 
-  KeyIDMap::const_iterator i = m_keyIDMap.find(id);
-  if (i == m_keyIDMap.end()) {
+  const KeyGroupTable *groupTable = findKey(id);
+  if (groupTable == nullptr) {
     return nullptr;
   }
 
-  const KeyEntryList &entries = i->second[group];
+  const KeyEntryList &entries = (*groupTable)[group];
   for (const auto &entry : entries) {
     if ((entry.back().m_sensitive & sensitive) == 0 ||
         (entry.back().m_required & sensitive) == (required & sensitive)) {
@@ -361,6 +470,32 @@ KeyModifierMask KeyMap::getCommandModifiers() const
   return KeyModifierControl | KeyModifierAlt | KeyModifierAltGr | KeyModifierMeta | KeyModifierSuper;
 }
 
+void KeyMap::write(std::vector<uint32_t> &words) const
+{
+  words.push_back(m_composeAcrossGroups ? 1 : 0);
+
+  words.push_back(static_cast<uint32_t>(m_halfDuplex.size()));
+  words.insert(words.end(), m_halfDuplex.begin(), m_halfDuplex.end());
+
+  words.push_back(static_cast<uint32_t>(m_keyIDMap.size()));
+  for (const auto &[keyId, groupTable] : m_keyIDMap) {
+    words.push_back(keyId);
+    words.push_back(static_cast<uint32_t>(groupTable.size()));
+    for (const auto &entries : groupTable) {
+      words.push_back(static_cast<uint32_t>(entries.size()));
+      for (const auto &items : entries) {
+        words.push_back(static_cast<uint32_t>(items.size()));
+        for (const auto &item : items) {
+          words.insert(
+              words.end(), {item.m_id, static_cast<uint32_t>(item.m_group), item.m_button, item.m_required,
+                            item.m_sensitive, item.m_generates, item.m_dead, item.m_lock, item.m_client}
+          );
+        }
+      }
+    }
+  }
+}
+
 void KeyMap::collectButtons(const ModifierToKeys &mods, ButtonToKeyMap &keys)
 {
   keys.clear();
@@ -478,20 +613,19 @@ const KeyMap::KeyItem *KeyMap::mapCommandKey(
   static const KeyModifierMask s_overrideModifiers = 0xffffu;
 
   // find KeySym in table
-  KeyIDMap::const_iterator i = m_keyIDMap.find(id);
-  if (i == m_keyIDMap.end()) {
+  const KeyGroupTable *keyGroupTable = findKey(id);
+  if (keyGroupTable == nullptr) {
     // unknown key
     LOG_VERBOSE("key %04x is not on keyboard", id);
     return nullptr;
   }
-  const KeyGroupTable &keyGroupTable = i->second;
 
   // find the first key that generates this KeyID
   const KeyItem *keyItem = nullptr;
   const auto numGroups = getNumGroups();
   for (int32_t groupOffset = 0; groupOffset < numGroups; ++groupOffset) {
     const auto effectiveGroup = getEffectiveGroup(group, groupOffset);
-    const KeyEntryList &entryList = keyGroupTable[effectiveGroup];
+    const KeyEntryList &entryList = (*keyGroupTable)[effectiveGroup];
     for (const auto &entry : entryList) {
       if (entry.size() != 1) {
         continue;
@@ -577,8 +711,8 @@ const KeyMap::KeyItem *KeyMap::mapCharacterKey(
 ) const
 {
   // find KeySym in table
-  KeyIDMap::const_iterator i = m_keyIDMap.find(id);
-  if (i == m_keyIDMap.end()) {
+  const KeyGroupTable *keyGroupTable = findKey(id);
+  if (keyGroupTable == nullptr) {
     // unknown key
     LOG_VERBOSE("key %04x is not on keyboard", id);
 
@@ -586,7 +720,7 @@ const KeyMap::KeyItem *KeyMap::mapCharacterKey(
   }
 
   // get keys to press for key
-  const auto itemList = getKeyItemList(i->second, getLanguageGroupID(group, lang), desiredMask);
+  const auto itemList = getKeyItemList(*keyGroupTable, getLanguageGroupID(group, lang), desiredMask);
   if (!itemList || itemList->empty()) {
     // no mapping for this keysym
     LOG_VERBOSE("no mapping for key %04x", id);
@@ -623,6 +757,42 @@ const KeyMap::KeyItem *KeyMap::mapCharacterKey(
   return &keyItem;
 }
 
+const KeyMap::KeyGroupTable *KeyMap::findKey(KeyID id) const
+{
+  if (id <= 0xffff) {
+    const auto page = m_keyPageIndex[id >> 8];
+    return page == 0 ? nullptr : m_keyPages[page - 1][id & 0xff];
+  }
+
+  const auto i = m_keyHash.find(id);
+  return i == m_keyHash.end() ? nullptr : i->second;
+}
+
+KeyMap::KeyGroupTable &KeyMap::findOrAddKey(KeyID id)
+{
+  auto [i, inserted] = m_keyIDMap.try_emplace(id);
+  if (inserted) {
+    // map nodes don't move so the index stays valid
+    indexKey(id, &i->second);
+  }
+  return i->second;
+}
+
+void KeyMap::indexKey(KeyID id, const KeyGroupTable *groupTable)
+{
+  if (id > 0xffff) {
+    m_keyHash[id] = groupTable;
+    return;
+  }
+
+  auto &page = m_keyPageIndex[id >> 8];
+  if (page == 0) {
+    m_keyPages.emplace_back();
+    page = static_cast<uint16_t>(m_keyPages.size());
+  }
+  m_keyPages[page - 1][id & 0xff] = groupTable;
+}
+
 void KeyMap::addGroupToKeystroke(Keystrokes &keys, int32_t &group, const std::string &lang) const
 {
   group = getLanguageGroupID(group, lang);
@@ -730,9 +900,9 @@ bool KeyMap::keysForKeyItem(
     if (!keysForModifierState(
             keyItem.m_button, group, activeModifiers, currentState, keyItem.m_required, sensitive, 0, keystrokes
         )) {
-      LOG(
-          (CLOG_VERBOSE "unable to match modifier state (%04x,%04x) for key %d", keyItem.m_required,
-           keyItem.m_sensitive, keyItem.m_button)
+      LOG_VERBOSE(
+          "unable to match modifier state (%04x,%04x) for key %d", keyItem.m_required, keyItem.m_sensitive,
+          keyItem.m_button
       );
       return false;
     }
@@ -740,17 +910,16 @@ bool KeyMap::keysForKeyItem(
     // match desiredState as closely as possible.  we must not
     // change any modifiers in keyItem.m_sensitive.  and if the key
     // is a modifier, we don't want to change that modifier.
-    LOG(
-        (CLOG_VERBOSE "desired state: %04x %04x,%04x,%04x", desiredState, currentState, keyItem.m_required,
-         keyItem.m_sensitive)
+    LOG_VERBOSE(
+        "desired state: %04x %04x,%04x,%04x", desiredState, currentState, keyItem.m_required, keyItem.m_sensitive
     );
     if (!keysForModifierState(
             keyItem.m_button, group, activeModifiers, currentState, desiredState, ~(sensitive | keyItem.m_generates),
             s_notRequiredMask, keystrokes
         )) {
-      LOG(
-          (CLOG_VERBOSE "unable to match desired modifier state (%04x,%04x) for key %d", desiredState,
-           ~keyItem.m_sensitive & 0xffffu, keyItem.m_button)
+      LOG_VERBOSE(
+          "unable to match desired modifier state (%04x,%04x) for key %d", desiredState,
+          ~keyItem.m_sensitive & 0xffffu, keyItem.m_button
       );
       return false;
     }
@@ -770,6 +939,11 @@ bool KeyMap::keysToRestoreModifiers(
 {
   // XXX -- we're not considering modified modifiers here
 
+  // nothing to release or press, which is usual when typing
+  if (activeModifiers.empty() && desiredModifiers.empty()) {
+    return true;
+  }
+
   ModifierToKeys oldModifiers = activeModifiers;
 
   // get the pressed modifier buttons before and after
@@ -818,9 +992,9 @@ bool KeyMap::keysForModifierState(
   // to work if the key itself is a modifier (the numlock toggle can
   // interfere) so we don't try to match at all.
   flipMask &= ~notRequiredMask;
-  LOG(
-      (CLOG_VERBOSE "flip: %04x (%04x vs %04x in %04x - %04x)", flipMask, currentState, requiredState,
-       sensitiveMask & 0xffffu, notRequiredMask & 0xffffu)
+  LOG_VERBOSE(
+      "flip: %04x (%04x vs %04x in %04x - %04x)", flipMask, currentState, requiredState, sensitiveMask & 0xffffu,
+      notRequiredMask & 0xffffu
   );
   if (flipMask == 0) {
     return true;
@@ -886,10 +1060,9 @@ bool KeyMap::keysForModifierState(
 
     // current state should match required state
     if ((currentState & sensitive) != (keyItem->m_required & sensitive)) {
-      LOG(
-          (CLOG_VERBOSE "unable to match modifier state for modifier %04x (%04x "
-                        "vs %04x in %04x)",
-           mask, currentState, keyItem->m_required, sensitive)
+      LOG_VERBOSE(
+          "unable to match modifier state for modifier %04x (%04x vs %04x in %04x)", mask, currentState,
+          keyItem->m_required, sensitive
       );
       return false;
     }
@@ -1003,13 +1176,7 @@ void KeyMap::addKeystrokes(
 
 int32_t KeyMap::getNumModifiers(KeyModifierMask state)
 {
-  int32_t n = 0;
-  for (; state != 0; state >>= 1) {
-    if ((state & 1) != 0) {
-      ++n;
-    }
-  }
-  return n;
+  return std::popcount(state);
 }
 
 bool KeyMap::isDeadKey(KeyID key)
@@ -10,8 +10,11 @@
 #include "base/String.h"
 #include "deskflow/KeyTypes.h"
 
+#include <array>
 #include <map>
 #include <set>
+#include <span>
+#include <unordered_map>
 #include <vector>
 
 namespace deskflow {
@@ -200,6 +203,16 @@ public:
   */
   virtual void foreachKey(ForeachKeyCallback cb, void *userData);
 
+  //! Read a map written by \c write()
+  /*!
+  Replaces the key entries, half-duplex buttons and group composition
+  setting with those read from the front of \p words and moves \p words
+  past them.  Returns \c false and leaves the map and \p words alone if
+  \p words doesn't start with a valid map.  Call \c finish() afterwards
+  as when adding entries.
+  */
+  bool read(std::span<const uint32_t> &words);
+
   //@}
   //! @name accessors
   //@{
@@ -268,6 +281,14 @@ public:
   */
   KeyModifierMask getCommandModifiers() const;
 
+  //! Write the map
+  /*!
+  Appends the key entries, half-duplex buttons and group composition
+  setting to \p words for \c read().  Half-duplex modifiers are user
+  settings and aren't written.  The words are in host byte order.
+  */
+  void write(std::vector<uint32_t> &words) const;
+
   //! Get buttons from modifier map
   /*!
   Put all the keys in \p modifiers into \p keys.
@@ -427,6 +448,15 @@ private:
   const KeyItemList *
   getKeyItemList(const KeyGroupTable &keyGroupTable, int32_t group, KeyModifierMask desiredMask) const;
 
+  // Returns the ways to synthesize \p id or nullptr if there are none.
+  const KeyGroupTable *findKey(KeyID id) const;
+
+  // Returns the ways to synthesize \p id, adding \p id if it's new.
+  KeyGroupTable &findOrAddKey(KeyID id);
+
+  // Adds \p id to the index.
+  void indexKey(KeyID id, const KeyGroupTable *groupTable);
+
   // not implemented
   KeyMap(const KeyMap &);
   KeyMap &operator=(const KeyMap &);
@@ -447,6 +477,9 @@ private:
   // A set of buttons
   using KeyButtonSet = std::set<KeyButton>;
 
+  // Index of 256 consecutive KeyIDs
+  using KeyIndexPage = std::array<const KeyGroupTable *, 256>;
+
   // Key maps for parsing/formatting
   using NameToKeyMap = std::map<std::string, KeyID, deskflow::string::CaselessCmp>;
   using NameToModifierMap = std::map<std::string, KeyModifierMask, deskflow::string::CaselessCmp>;
@@ -456,6 +489,17 @@ private:
   // KeyID info
   KeyIDMap m_keyIDMap;
   int32_t m_numGroups;
+
+  // index of m_keyIDMap, kept in step with it.  mapping a key looks
+  // it up once or more so this avoids walking the map.  KeyIDs in the
+  // basic multilingual plane, which has all the special keys, are
+  // found through the page for their high byte, m_keyPages[n - 1]
+  // where n is m_keyPageIndex[id >> 8] and 0 means no page.  other
+  // KeyIDs are hashed.
+  std::array<uint16_t, 256> m_keyPageIndex{};
+  std::vector<KeyIndexPage> m_keyPages;
+  std::unordered_map<KeyID, const KeyGroupTable *> m_keyHash;
+
   ModifierToKeyTable m_modifierKeys;
 
   // composition info
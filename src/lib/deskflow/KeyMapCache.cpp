@@ -0,0 +1,124 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "deskflow/KeyMapCache.h"
+
+#include "base/Log.h"
+#include "common/Constants.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <cassert>
+#include <cstring>
+
+namespace deskflow {
+
+namespace {
+
+const uint32_t kMagic = 0x4d4b4644; // "DFKM" read little endian
+const qsizetype kHeaderWords = 3 + KeyMapCache::kFingerprintSize / static_cast<qsizetype>(sizeof(uint32_t));
+const auto kFileSuffix = QStringLiteral(".keymap");
+
+bool isValidHeader(std::span<const uint32_t> words, const QByteArray &fingerprint)
+{
+  return words.size() >= static_cast<size_t>(kHeaderWords) && words[0] == kMagic &&
+         words[1] == KeyMapCache::kFormatVersion && words[2] == words.size() - kHeaderWords &&
+         std::memcmp(&words[3], fingerprint.constData(), KeyMapCache::kFingerprintSize) == 0;
+}
+
+} // namespace
+
+KeyMapCache::KeyMapCache(const QString &dir) : m_dir(dir)
+{
+  // do nothing
+}
+
+void KeyMapCache::store(const QByteArray &fingerprint, std::span<const uint32_t> words) const
+{
+  assert(fingerprint.size() == kFingerprintSize);
+
+  if (!QDir().mkpath(m_dir)) {
+    LOG_WARN("unable to create keymap cache: %s", qPrintable(m_dir));
+    return;
+  }
+
+  // written aside and renamed so a reader never maps a partial file
+  QSaveFile file(pathFor(fingerprint));
+  if (!file.open(QIODevice::WriteOnly)) {
+    LOG_WARN("unable to write keymap cache: %s", qPrintable(file.errorString()));
+    return;
+  }
+  const uint32_t header[] = {kMagic, kFormatVersion, static_cast<uint32_t>(words.size())};
+  file.write(reinterpret_cast<const char *>(header), sizeof(header));
+  file.write(fingerprint);
+  file.write(reinterpret_cast<const char *>(words.data()), static_cast<qint64>(words.size_bytes()));
+  if (!file.commit()) {
+    LOG_WARN("unable to write keymap cache: %s", qPrintable(file.errorString()));
+    return;
+  }
+  LOG_DEBUG("stored keymap %s, %d words", fingerprint.toHex().left(8).constData(), static_cast<int>(words.size()));
+
+  prune();
+}
+
+bool KeyMapCache::load(const QByteArray &fingerprint, const Reader &read) const
+{
+  if (fingerprint.size() != kFingerprintSize) {
+    return false;
+  }
+
+  QFile file(pathFor(fingerprint));
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  const auto size = file.size();
+  bool valid = false;
+  if (size % sizeof(uint32_t) == 0 && size >= kHeaderWords * static_cast<qint64>(sizeof(uint32_t))) {
+    // mappings are page aligned so the words can be read in place
+    if (const uchar *data = file.map(0, size); data != nullptr) {
+      std::span<const uint32_t> words(reinterpret_cast<const uint32_t *>(data), size / sizeof(uint32_t));
+      valid = isValidHeader(words, fingerprint) && read(words.subspan(kHeaderWords));
+      file.unmap(const_cast<uchar *>(data));
+    }
+  }
+
+  if (!valid) {
+    LOG_DEBUG("discarding invalid keymap %s", fingerprint.toHex().left(8).constData());
+    file.remove();
+    return false;
+  }
+
+  // keep recently used maps when pruning
+  file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+  LOG_DEBUG("loaded keymap %s", fingerprint.toHex().left(8).constData());
+  return true;
+}
+
+QString KeyMapCache::defaultDir()
+{
+  return QStringLiteral("%1/%2/keymaps")
+      .arg(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation), kAppId);
+}
+
+QString KeyMapCache::pathFor(const QByteArray &fingerprint) const
+{
+  return QStringLiteral("%1/%2%3").arg(m_dir, QString::fromLatin1(fingerprint.toHex()), kFileSuffix);
+}
+
+void KeyMapCache::prune() const
+{
+  const auto files = QDir(m_dir).entryInfoList({QStringLiteral("*") + kFileSuffix}, QDir::Files, QDir::Time);
+  for (qsizetype i = kMaxEntries; i < files.size(); ++i) {
+    QFile::remove(files.at(i).absoluteFilePath());
+  }
+}
+
+} // namespace deskflow
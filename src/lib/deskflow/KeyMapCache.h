@@ -0,0 +1,99 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace deskflow {
+
+//! Cache of built keyboard maps
+/*!
+Building a \c KeyMap from the system's keyboard description can take a
+noticeable time, which delays startup and every layout switch.  This
+keeps built maps on disk, one file per map named after a fingerprint of
+the description it was built from, so that an unchanged layout can be
+read back instead of built again.
+
+A file is a header of magic, format version, payload size and the
+fingerprint, then the payload;  all words are in host byte order.  The
+file is memory mapped and the header checked before the payload is
+handed to the reader, so a hit costs little more than the reader.  A
+file that fails either check is removed.
+
+Only the \c kMaxEntries most recently used files are kept.
+*/
+class KeyMapCache
+{
+public:
+  //! Reads a payload, returns false if it's malformed
+  using Reader = std::function<bool(std::span<const uint32_t> words)>;
+
+  //! Version of the file format
+  static constexpr uint32_t kFormatVersion = 1;
+  //! Most files kept in the cache
+  static constexpr int kMaxEntries = 8;
+  //! Size of a fingerprint, a SHA-256 digest
+  static constexpr qsizetype kFingerprintSize = 32;
+
+  /*!
+  Keeps the cache in \p dir, which is made when first stored to.
+  */
+  explicit KeyMapCache(const QString &dir = defaultDir());
+  KeyMapCache(KeyMapCache const &) = delete;
+  KeyMapCache(KeyMapCache &&) = delete;
+  ~KeyMapCache() = default;
+
+  KeyMapCache &operator=(KeyMapCache const &) = delete;
+  KeyMapCache &operator=(KeyMapCache &&) = delete;
+
+  //! @name manipulators
+  //@{
+
+  //! Store a map
+  /*!
+  Writes \p words as the payload for \p fingerprint, replacing any
+  earlier payload for it, then removes the least recently used files
+  over \c kMaxEntries.  Failing to write is logged and otherwise
+  ignored, the map is built again next time.
+  */
+  void store(const QByteArray &fingerprint, std::span<const uint32_t> words) const;
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Load a map
+  /*!
+  Calls \p read with the payload stored for \p fingerprint and returns
+  what it returns.  Returns false without calling \p read if there is no
+  valid payload for \p fingerprint.  \p read must not keep the words,
+  they're only mapped for the call.
+  */
+  bool load(const QByteArray &fingerprint, const Reader &read) const;
+
+  //! Get the default directory
+  /*!
+  Returns the \c keymaps directory in the user's cache location.
+  */
+  static QString defaultDir();
+
+  //@}
+
+private:
+  QString pathFor(const QByteArray &fingerprint) const;
+  void prune() const;
+
+  QString m_dir;
+};
+
+} // namespace deskflow
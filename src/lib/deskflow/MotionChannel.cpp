@@ -0,0 +1,264 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "deskflow/MotionChannel.h"
+
+#include "base/BaseException.h"
+#include "base/IEventQueue.h"
+#include "base/Log.h"
+#include "deskflow/ProtocolTypes.h"
+#include "deskflow/ProtocolUtil.h"
+#include "io/MemoryStream.h"
+#include "net/IDatagramSocket.h"
+
+#include <QByteArray>
+#include <QMessageAuthenticationCode>
+#include <QRandomGenerator>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+namespace {
+
+const char *const kDatagramFormat = "%1i%4i%v%v";
+
+QByteArray tagOf(const std::string &key, const uint8_t *data, size_t size)
+{
+  const auto message = QByteArray::fromRawData(reinterpret_cast<const char *>(data), static_cast<qsizetype>(size));
+  const auto secret = QByteArray::fromRawData(key.data(), static_cast<qsizetype>(key.size()));
+  return QMessageAuthenticationCode::hash(message, secret, QCryptographicHash::Sha256)
+      .left(static_cast<qsizetype>(MotionChannel::kTagSize));
+}
+
+// takes the same time wherever the tags differ, so a forger can't
+// find a valid tag a byte at a time
+bool isEqualTag(const QByteArray &tag, const uint8_t *data)
+{
+  uint8_t difference = 0;
+  for (size_t i = 0; i < MotionChannel::kTagSize; ++i) {
+    difference |= static_cast<uint8_t>(tag[static_cast<qsizetype>(i)]) ^ data[i];
+  }
+  return difference == 0;
+}
+
+} // namespace
+
+//
+// MotionChannel
+//
+
+MotionChannel::MotionChannel(IEventQueue *events, IDatagramSocket *adoptedSocket, const std::string &key)
+    : m_events(events),
+      m_socket(adoptedSocket),
+      m_key(key)
+{
+  assert(m_events != nullptr);
+  assert(m_socket != nullptr);
+
+  m_events->addHandler(EventTypes::StreamInputReady, m_socket->getEventTarget(), [this](const auto &) {
+    handleReadable();
+  });
+}
+
+MotionChannel::~MotionChannel()
+{
+  stop();
+}
+
+void MotionChannel::accept()
+{
+  m_server = true;
+
+  // greetings that came before the key are still queued
+  handleReadable();
+}
+
+void MotionChannel::greet(ReadyHandler ready, MotionHandler motion, FailedHandler failed)
+{
+  m_readyHandler = std::move(ready);
+  m_motionHandler = std::move(motion);
+  m_failedHandler = std::move(failed);
+
+  m_sinceHeard.reset();
+  m_timer = m_events->newTimer(kMotionChannelHelloRate, nullptr);
+  m_events->addHandler(EventTypes::Timer, m_timer, [this](const auto &) { handleTimer(); });
+  send(Kind::Hello, 0, 0);
+}
+
+bool MotionChannel::sendMove(int32_t x, int32_t y)
+{
+  if (!isAlive()) {
+    return false;
+  }
+
+  // a datagram lost on the way counts as sent, that's what the channel is for
+  ++m_sequence;
+  send(Kind::Move, x, y);
+  return true;
+}
+
+bool MotionChannel::sendRelativeMove(int32_t dx, int32_t dy)
+{
+  if (!isAlive()) {
+    return false;
+  }
+
+  ++m_sequence;
+  send(Kind::RelativeMove, dx, dy);
+  return true;
+}
+
+void MotionChannel::sync(uint32_t sequence)
+{
+  m_sequence = std::max(m_sequence, sequence);
+}
+
+bool MotionChannel::isAlive() const
+{
+  return m_server && m_connected && m_sinceHeard.getTime() < kMotionChannelTimeout;
+}
+
+uint32_t MotionChannel::getSequence() const
+{
+  return m_sequence;
+}
+
+uint32_t MotionChannel::getDropped() const
+{
+  return m_dropped;
+}
+
+int MotionChannel::getPort() const
+{
+  return m_socket->getPort();
+}
+
+std::string MotionChannel::newKey()
+{
+  std::array<quint32, kKeySize / sizeof(quint32)> words;
+  QRandomGenerator::system()->generate(words.begin(), words.end());
+  return {reinterpret_cast<const char *>(words.data()), kKeySize};
+}
+
+std::vector<uint8_t> MotionChannel::seal(const std::string &key, const Datagram &datagram)
+{
+  std::vector<uint8_t> buffer;
+  buffer.reserve(kMaxSize);
+  ProtocolUtil::appendf(
+      buffer, kDatagramFormat, static_cast<uint32_t>(datagram.m_kind), datagram.m_sequence, datagram.m_x, datagram.m_y
+  );
+
+  const auto tag = tagOf(key, buffer.data(), buffer.size());
+  buffer.insert(buffer.end(), tag.begin(), tag.end());
+  return buffer;
+}
+
+bool MotionChannel::open(const std::string &key, const uint8_t *data, size_t size, Datagram &datagram)
+{
+  if (size <= kTagSize || size > kMaxSize) {
+    return false;
+  }
+
+  // check the tag before parsing anything
+  const size_t bodySize = size - kTagSize;
+  if (!isEqualTag(tagOf(key, data, bodySize), data + bodySize)) {
+    return false;
+  }
+
+  deskflow::MemoryStream stream({reinterpret_cast<const char *>(data), bodySize});
+  uint32_t kind = 0;
+  uint32_t sequence = 0;
+  int32_t x = 0;
+  int32_t y = 0;
+  try {
+    if (!ProtocolUtil::readf(&stream, kDatagramFormat, &kind, &sequence, &x, &y) || stream.getSize() != 0) {
+      return false;
+    }
+  } catch (BaseException &) {
+    return false;
+  }
+
+  if (kind < static_cast<uint32_t>(Kind::Hello) || kind > static_cast<uint32_t>(Kind::RelativeMove)) {
+    return false;
+  }
+
+  datagram = {static_cast<Kind>(kind), sequence, x, y};
+  return true;
+}
+
+void MotionChannel::handleReadable()
+{
+  // one byte spare so a datagram that's too big doesn't look like it fits
+  std::array<uint8_t, kMaxSize + 1> buffer;
+  while (uint32_t n = m_socket->receive(buffer.data(), static_cast<uint32_t>(buffer.size()))) {
+    Datagram datagram;
+    if (!open(m_key, buffer.data(), n, datagram)) {
+      ++m_dropped;
+      continue;
+    }
+
+    using enum Kind;
+    if (m_server && datagram.m_kind == Hello) {
+      if (!m_connected) {
+        // from now on the socket only hears from this client
+        LOG_DEBUG("motion channel connected");
+        m_socket->connectToSender();
+        m_connected = true;
+      }
+      m_sinceHeard.reset();
+      send(Reply, 0, 0);
+    } else if (!m_server && datagram.m_kind == Reply) {
+      m_sinceHeard.reset();
+      if (!m_ready) {
+        LOG_DEBUG("motion channel ready");
+        m_ready = true;
+        m_readyHandler();
+      }
+    } else if (!m_server && (datagram.m_kind == Move || datagram.m_kind == RelativeMove)) {
+      if (datagram.m_sequence <= m_sequence) {
+        // late or duplicated, newer motion was already used
+        ++m_dropped;
+        continue;
+      }
+      m_sequence = datagram.m_sequence;
+      m_motionHandler(datagram);
+    } else {
+      ++m_dropped;
+    }
+  }
+}
+
+void MotionChannel::handleTimer()
+{
+  if (m_sinceHeard.getTime() < kMotionChannelTimeout) {
+    send(Kind::Hello, 0, 0);
+    return;
+  }
+
+  LOG_DEBUG("motion channel timed out");
+  stop();
+
+  // the callback may delete us, so it must be the last thing we do
+  auto failed = std::move(m_failedHandler);
+  failed();
+}
+
+void MotionChannel::send(Kind kind, int32_t x, int32_t y)
+{
+  const auto datagram = seal(m_key, {kind, m_sequence, x, y});
+  m_socket->send(datagram.data(), static_cast<uint32_t>(datagram.size()));
+}
+
+void MotionChannel::stop()
+{
+  if (m_timer != nullptr) {
+    m_events->removeHandler(EventTypes::Timer, m_timer);
+    m_events->deleteTimer(m_timer);
+    m_timer = nullptr;
+  }
+  m_events->removeHandler(EventTypes::StreamInputReady, m_socket->getEventTarget());
+}
@@ -0,0 +1,197 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "base/Stopwatch.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class EventQueueTimer;
+class IDatagramSocket;
+class IEventQueue;
+
+//! Datagram side channel for pointer motion
+/*!
+Carries pointer motion from the server to a client over UDP so that a
+lost or late packet on the TCP connection doesn't hold up the motion
+behind it.  Everything else stays on TCP.
+
+Each datagram is a kind byte, a 4 byte sequence number in NBO, x and y
+as zig-zag varints, then the first \c kTagSize bytes of an HMAC-SHA256
+of all that under a key the client sent over the TCP connection.
+Datagrams that fail the check are dropped without a reply.
+
+The client greets the server every \c kMotionChannelHelloRate seconds
+and the server replies to each greeting, which keeps any NAT mapping
+open and tells each side the path still works.  If either side hears
+nothing for \c kMotionChannelTimeout the channel is dead;  the server
+then sends motion on TCP again and the client gives up on the channel.
+
+Everything happens on the event thread.
+*/
+class MotionChannel
+{
+public:
+  //! Kinds of datagram
+  enum class Kind : uint8_t
+  {
+    Hello = 1,       //!< Client greeting, sequence is the last motion it used
+    Reply = 2,       //!< Server reply to a greeting
+    Move = 3,        //!< Absolute motion
+    RelativeMove = 4 //!< Relative motion
+  };
+
+  //! Contents of a datagram
+  struct Datagram
+  {
+    Kind m_kind = Kind::Hello;
+    uint32_t m_sequence = 0;
+    int32_t m_x = 0;
+    int32_t m_y = 0;
+  };
+
+  //! Called on the client once the server has replied
+  using ReadyHandler = std::function<void()>;
+  //! Called on the client for each motion datagram in order
+  using MotionHandler = std::function<void(const Datagram &)>;
+  //! Called on the client when the server stops replying
+  using FailedHandler = std::function<void()>;
+  //! Makes a socket for a channel on \p port, bound (server) or connected (client)
+  using SocketFactory = std::function<IDatagramSocket *(int port)>;
+
+  //! Size of the key in bytes
+  static constexpr size_t kKeySize = 32;
+  //! Size of the authentication tag in bytes
+  static constexpr size_t kTagSize = 16;
+  //! Largest datagram, a kind, a sequence, two 5 byte varints and a tag
+  static constexpr size_t kMaxSize = 1 + 4 + 5 + 5 + kTagSize;
+
+  /*!
+  Uses \p adoptedSocket, which must already be bound (server) or
+  connected (client), with \p key for authentication.
+  */
+  MotionChannel(IEventQueue *events, IDatagramSocket *adoptedSocket, const std::string &key);
+  MotionChannel(MotionChannel const &) = delete;
+  MotionChannel(MotionChannel &&) = delete;
+  ~MotionChannel();
+
+  MotionChannel &operator=(MotionChannel const &) = delete;
+  MotionChannel &operator=(MotionChannel &&) = delete;
+
+  //! @name manipulators
+  //@{
+
+  //! Wait for a client
+  /*!
+  Server side.  Connects the socket to the first sender of an authentic
+  greeting and replies to every greeting from it.
+  */
+  void accept();
+
+  //! Greet the server
+  /*!
+  Client side.  Starts greeting the server.  \p ready is called with
+  the first reply, \p motion for each motion datagram that is newer
+  than any before it, and \p failed if the server doesn't reply in
+  time, after which the channel does nothing.  The channel may be
+  deleted from \p failed but not from the others.
+  */
+  void greet(ReadyHandler ready, MotionHandler motion, FailedHandler failed);
+
+  //! Send absolute motion
+  /*!
+  Server side.  Returns false if the channel isn't alive, in which case
+  nothing was sent.
+  */
+  bool sendMove(int32_t x, int32_t y);
+
+  //! Send relative motion
+  /*!
+  Like \c sendMove() for relative motion.
+  */
+  bool sendRelativeMove(int32_t dx, int32_t dy);
+
+  //! Catch up with motion sent on TCP
+  /*!
+  Client side.  Drops motion datagrams up to and including \p sequence
+  from now on, because the server has sent a later position on TCP.
+  */
+  void sync(uint32_t sequence);
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Check the channel
+  /*!
+  Server side.  Returns true if a client has greeted the server within
+  the timeout.
+  */
+  bool isAlive() const;
+
+  //! Get the sequence number
+  /*!
+  Returns the sequence number of the last motion sent (server) or used
+  (client).
+  */
+  uint32_t getSequence() const;
+
+  //! Get the number of dropped datagrams
+  /*!
+  Returns how many datagrams were dropped for being late, duplicated or
+  not authentic.
+  */
+  uint32_t getDropped() const;
+
+  //! Get the local port
+  int getPort() const;
+
+  //! Make a new key
+  /*!
+  Returns \c kKeySize bytes from the system's secure random generator.
+  */
+  static std::string newKey();
+
+  //! Seal a datagram
+  /*!
+  Returns \p datagram in wire format, authenticated with \p key.
+  */
+  static std::vector<uint8_t> seal(const std::string &key, const Datagram &datagram);
+
+  //! Open a datagram
+  /*!
+  Parses \p size bytes at \p data into \p datagram.  Returns false if
+  they're malformed or weren't sealed with \p key.
+  */
+  static bool open(const std::string &key, const uint8_t *data, size_t size, Datagram &datagram);
+
+  //@}
+
+private:
+  void handleReadable();
+  void handleTimer();
+  void send(Kind kind, int32_t x, int32_t y);
+  void stop();
+
+  IEventQueue *m_events;
+  std::unique_ptr<IDatagramSocket> m_socket;
+  std::string m_key;
+  bool m_server = false;
+  bool m_connected = false;
+  bool m_ready = false;
+  uint32_t m_sequence = 0;
+  uint32_t m_dropped = 0;
+  Stopwatch m_sinceHeard;
+  EventQueueTimer *m_timer = nullptr;
+  ReadyHandler m_readyHandler;
+  MotionHandler m_motionHandler;
+  FailedHandler m_failedHandler;
+};
@@ -59,6 +59,10 @@ static const OptionID kOptionDefaultLockToScreenState = OPTION_CODE("LTSS");
 static const OptionID kOptionDisableLockToScreen = OPTION_CODE("DLTS");
 static const OptionID kOptionClipboardSharing = OPTION_CODE("CLPS");
 static const OptionID kOptionClipboardSharingSize = OPTION_CODE("CLSZ");
+static const OptionID kOptionKeepAliveTimestamps = OPTION_CODE("KATS");
+static const OptionID kOptionInputBatch = OPTION_CODE("IBAT");
+static const OptionID kOptionMotionChannel = OPTION_CODE("UDPM");
+static const OptionID kOptionClipboardResume = OPTION_CODE("CLRS");
 //@}
 
 //! @name Screen switch corner masks
@@ -7,8 +7,11 @@
 
 #include "deskflow/PacketStreamFilter.h"
 #include "base/IEventQueue.h"
+#include "deskflow/ConnectionStats.h"
 #include "deskflow/ProtocolTypes.h"
+#include "net/IDataSocket.h"
 
+#include <algorithm>
 #include <cstring>
 
 //
@@ -17,13 +20,34 @@
 
 PacketStreamFilter::PacketStreamFilter(IEventQueue *events, deskflow::IStream *stream, bool adoptStream)
     : StreamFilter(events, stream, adoptStream),
+      m_framed(enableFraming(stream)),
       m_events(events)
 {
   // do nothing
 }
 
+bool PacketStreamFilter::enableFraming(deskflow::IStream *stream)
+{
+  auto *socket = dynamic_cast<IDataSocket *>(stream);
+  if (socket == nullptr) {
+    return false;
+  }
+  socket->setFramed(PROTOCOL_MAX_MESSAGE_LENGTH);
+  return true;
+}
+
+void PacketStreamFilter::setStats(ConnectionStats *stats)
+{
+  m_stats = stats;
+}
+
 void PacketStreamFilter::close()
 {
+  if (m_framed) {
+    StreamFilter::close();
+    return;
+  }
+
   std::scoped_lock lock{m_mutex};
   m_size = 0;
   m_buffer.pop(m_buffer.getSize());
@@ -36,6 +60,20 @@ uint32_t PacketStreamFilter::read(void *buffer, uint32_t n)
     return 0;
   }
 
+  if (m_framed) {
+    // the socket only reports the size of a whole packet, and that's the
+    // moment to count it
+    if (m_unread == 0) {
+      m_unread = getStream()->getSize();
+      if (auto *stats = m_stats.load(); stats != nullptr && m_unread != 0) {
+        stats->messageReceived(m_unread + 4);
+      }
+    }
+    n = getStream()->read(buffer, n);
+    m_unread -= std::min(n, m_unread);
+    return n;
+  }
+
   std::scoped_lock lock{m_mutex};
 
   // if not enough data yet then give up
@@ -68,6 +106,14 @@ uint32_t PacketStreamFilter::read(void *buffer, uint32_t n)
 
 void PacketStreamFilter::write(const void *buffer, uint32_t count)
 {
+  if (m_framed) {
+    getStream()->write(buffer, count);
+    if (auto *stats = m_stats.load(); stats != nullptr) {
+      stats->messageSent(count + 4);
+    }
+    return;
+  }
+
   // write the length of the payload
   uint8_t length[4];
   length[0] = (uint8_t)((count >> 24) & 0xff);
@@ -78,10 +124,20 @@ void PacketStreamFilter::write(const void *buffer, uint32_t count)
 
   // write the payload
   getStream()->write(buffer, count);
+
+  if (auto *stats = m_stats.load(); stats != nullptr) {
+    stats->messageSent(count + sizeof(length));
+  }
 }
 
 void PacketStreamFilter::shutdownInput()
 {
+  if (m_framed) {
+    m_unread = 0;
+    StreamFilter::shutdownInput();
+    return;
+  }
+
   std::scoped_lock lock{m_mutex};
   m_size = 0;
   m_buffer.pop(m_buffer.getSize());
@@ -90,12 +146,20 @@ void PacketStreamFilter::shutdownInput()
 
 bool PacketStreamFilter::isReady() const
 {
+  if (m_framed) {
+    return StreamFilter::isReady();
+  }
+
   std::scoped_lock lock{m_mutex};
   return isReadyNoLock();
 }
 
 uint32_t PacketStreamFilter::getSize() const
 {
+  if (m_framed) {
+    return StreamFilter::getSize();
+  }
+
   std::scoped_lock lock{m_mutex};
   return isReadyNoLock() ? m_size : 0;
 }
@@ -119,6 +183,9 @@ bool PacketStreamFilter::readPacketSize()
       m_events->addEvent(Event(EventTypes::StreamInputFormatError, getEventTarget()));
       return false;
     }
+    if (auto *stats = m_stats.load(); stats != nullptr) {
+      stats->messageReceived(m_size + sizeof(buffer));
+    }
   }
   return true;
 }
@@ -154,6 +221,11 @@ bool PacketStreamFilter::readMore()
 
 void PacketStreamFilter::filterEvent(const Event &event)
 {
+  if (m_framed) {
+    StreamFilter::filterEvent(event);
+    return;
+  }
+
   if (event.getType() == EventTypes::StreamInputReady) {
     std::scoped_lock lock{m_mutex};
     if (!readMore()) {
@@ -10,13 +10,20 @@
 #include "io/StreamBuffer.h"
 #include "io/StreamFilter.h"
 
+#include <atomic>
 #include <mutex>
 
+class ConnectionStats;
 class IEventQueue;
 
 //! Packetizing stream filter
 /*!
 Filters a stream to read and write packets.
+
+When the stream is a data socket, the socket does the framing itself on
+its own input buffer (see IDataSocket::setFramed), so reads copy straight
+out of the socket buffer and this filter only forwards and counts the
+packets.  Any other stream is framed here with a buffer of its own.
 */
 class PacketStreamFilter : public StreamFilter
 {
@@ -24,6 +31,13 @@ public:
   PacketStreamFilter(IEventQueue *events, deskflow::IStream *stream, bool adoptStream = true);
   ~PacketStreamFilter() override = default;
 
+  //! Set telemetry
+  /*!
+  Count every packet written and read in \p stats, which must outlive
+  this filter or be replaced with \c nullptr first.
+  */
+  void setStats(ConnectionStats *stats);
+
   // IStream overrides
   void close() override;
   uint32_t read(void *buffer, uint32_t n) override;
@@ -37,14 +51,20 @@ protected:
   void filterEvent(const Event &) override;
 
 private:
+  static bool enableFraming(deskflow::IStream *stream);
   bool isReadyNoLock() const;
   bool readPacketSize();
   bool readMore();
 
 private:
+  // true if the stream frames packets itself
+  const bool m_framed;
+  uint32_t m_unread = 0;
+
   mutable std::mutex m_mutex;
   uint32_t m_size = 0;
   StreamBuffer m_buffer;
   bool m_inputShutdown = false;
   IEventQueue *m_events = nullptr;
+  std::atomic<ConnectionStats *> m_stats = nullptr;
 };
@@ -22,7 +22,10 @@ const char *const kMsgCScreenSaver = "CSEC%1i";
 const char *const kMsgCResetOptions = "CROP";
 const char *const kMsgCInfoAck = "CIAK";
 const char *const kMsgCKeepAlive = "CALV";
+const char *const kMsgCKeepAliveTime = "CATM%4i%4i%4i%4i%4i%4i";
+const char *const kMsgCMotionChannelReady = "CUDP";
 const char *const kMsgDKeyDownLang = "DKDL%2i%2i%2i%s";
+const char *const kMsgDKeyDownLangId = "DKDI%2i%2i%2i%1i";
 const char *const kMsgDKeyDown = "DKDN%2i%2i%2i";
 const char *const kMsgDKeyDown1_0 = "DKDN%2i%2i";
 const char *const kMsgDKeyRepeat = "DKRP%2i%2i%2i%2i%s";
@@ -32,10 +35,19 @@ const char *const kMsgDKeyUp1_0 = "DKUP%2i%2i";
 const char *const kMsgDMouseDown = "DMDN%1i";
 const char *const kMsgDMouseUp = "DMUP%1i";
 const char *const kMsgDMouseMove = "DMMV%2i%2i";
+const char *const kMsgDInputTime = "DITM%4i%4i";
+const char *const kMsgDInputBatch = "DBAT%4i%4i%s";
+const char *const kMsgDMotionChannel = "DUDP%s";
 const char *const kMsgDMouseRelMove = "DMRM%2i%2i";
 const char *const kMsgDMouseWheel = "DMWM%2i%2i";
 const char *const kMsgDMouseWheel1_0 = "DMWM%2i";
+const char *const kMsgDMouseMoveDelta = "DMMD%v%v";
+const char *const kMsgDMouseRelMoveCompact = "DMRV%v%v";
+const char *const kMsgDMouseWheelCompact = "DMWV%v%v";
+const char *const kMsgDMouseMoveSync = "DMMS%4i%2i%2i";
 const char *const kMsgDClipboard = "DCLP%1i%4i%1i%s";
+const char *const kMsgDClipboardBytes = "DCLP%1i%4i%1i%S";
+const char *const kMsgDClipboardResume = "DCLR%1i%4i%4i%4i";
 const char *const kMsgDInfo = "DINF%2i%2i%2i%2i%2i%2i%2i";
 const char *const kMsgDSetOptions = "DSOP%4I";
 const char *const kMsgDFileTransfer = "DFTR%1i%s";
@@ -45,7 +45,7 @@ static const int16_t kProtocolMajorVersion = 1;
  * @note When incrementing the minor version, the Deskflow application version should also increment
  * @since Protocol version 1.0
  */
-static const int16_t kProtocolMinorVersion = 8;
+static const int16_t kProtocolMinorVersion = 9;
 
 /**
  * @brief Default TCP port for Deskflow connections
@@ -91,6 +91,49 @@ static const double kKeepAliveRate = 3.0;
  */
 static const double kKeepAlivesUntilDeath = 3.0;
 
+/**
+ * @brief Longest time the server holds input events for a batch, in seconds
+ *
+ * @see kMsgDInputBatch
+ * @since Protocol version 1.8
+ */
+static const double kInputBatchDelay = 0.002;
+
+/**
+ * @brief Size of batched input records that is sent without waiting, in bytes
+ *
+ * @see kMsgDInputBatch
+ * @since Protocol version 1.8
+ */
+static const uint32_t kInputBatchSize = 1024;
+
+/**
+ * @brief Motion and wheel events per input time sent without batching
+ *
+ * The server sends kMsgDInputTime before one in this many events, so the
+ * age of input is sampled without a second message for every motion.
+ *
+ * @see kMsgDInputTime
+ * @since Protocol version 1.3
+ */
+static const uint32_t kInputTimeInterval = 16;
+
+/**
+ * @brief Time between motion channel greetings from the client, in seconds
+ *
+ * @see kMsgDMotionChannel
+ * @since Protocol version 1.9
+ */
+static const double kMotionChannelHelloRate = 0.5;
+
+/**
+ * @brief Silence after which the motion channel is dead, in seconds
+ *
+ * @see kMsgDMotionChannel
+ * @since Protocol version 1.9
+ */
+static const double kMotionChannelTimeout = 3.0;
+
 /**
  * @brief Obsolete heartbeat rate (deprecated)
  *
@@ -157,9 +200,10 @@ static constexpr uint32_t PROTOCOL_MAX_STRING_LENGTH = 1024 * 1024;
  */
 struct ChunkType
 {
-  inline static const auto DataStart = 1; ///< Start of transfer (contains file size)
-  inline static const auto DataChunk = 2; ///< Data chunk (contains file content)
-  inline static const auto DataEnd = 3;   ///< End of transfer (transfer complete)
+  inline static const auto DataStart = 1;  ///< Start of transfer (contains file size)
+  inline static const auto DataChunk = 2;  ///< Data chunk (contains file content)
+  inline static const auto DataEnd = 3;    ///< End of transfer (transfer complete)
+  inline static const auto DataResume = 4; ///< Start of resumable transfer (clipboard only, negotiated)
 };
 
 /**
@@ -489,6 +533,54 @@ extern const char *const kMsgCInfoAck;
  */
 extern const char *const kMsgCKeepAlive;
 
+/**
+ * @brief Timestamped keep-alive message
+ *
+ * **Message Code**: `"CATM"`
+ * **Direction**: Primary ↔ Secondary
+ * **Format**: `$1$2$3$4$5$6` as six 4-byte values, which are three
+ * 64-bit timestamps each sent as its high then low half:
+ * - `$1$2`: Originate, when the request was sent (requester's clock)
+ * - `$3$4`: Receive, when the request arrived (responder's clock)
+ * - `$5$6`: Transmit, when the reply was sent (responder's clock)
+ *
+ * Timestamps are nanoseconds from each side's own monotonic clock and
+ * are only meaningful in differences.  A request has receive and
+ * transmit set to zero; the peer replies immediately with the originate
+ * time copied and its own receive and transmit times filled in.  From
+ * the four timestamps the requester estimates the round trip time and
+ * the offset between the two clocks, as NTP does.
+ *
+ * **Negotiation**:
+ * - The server advertises support with @ref kOptionKeepAliveTimestamps
+ *   in kMsgDSetOptions
+ * - A client that supports it sends a request after each kMsgCKeepAlive
+ * - The server starts sending its own requests, and kMsgDInputTime,
+ *   once it has received a request from the client
+ *
+ * Peers that don't negotiate never see this message.
+ *
+ * @see kMsgCKeepAlive, kMsgDInputTime
+ * @since Protocol version 1.3
+ */
+extern const char *const kMsgCKeepAliveTime;
+
+/**
+ * @brief Motion channel ready
+ *
+ * **Message Code**: `"CUDP"`
+ * **Direction**: Secondary → Primary
+ * **Format**: No parameters
+ *
+ * Sent by the client once the server has replied to its greeting on the
+ * motion channel, which shows datagrams get through both ways.  The
+ * server sends pointer motion on the channel from then on.
+ *
+ * @see kMsgDMotionChannel
+ * @since Protocol version 1.9
+ */
+extern const char *const kMsgCMotionChannelReady;
+
 /** @} */ // end of protocol_commands group
 
 /**
@@ -532,6 +624,35 @@ extern const char *const kMsgCKeepAlive;
  */
 extern const char *const kMsgDKeyDownLang;
 
+/**
+ * @brief Key press with interned language (v1.9+)
+ *
+ * **Message Code**: `"DKDI"`
+ * **Direction**: Primary → Secondary
+ * **Format**: `"DKDI%2i%2i%2i%1i"`
+ * **Parameters**:
+ * - `$1`: KeyID (2 bytes)
+ * - `$2`: KeyModifierMask (2 bytes)
+ * - `$3`: KeyButton (2 bytes)
+ * - `$4`: Language index (1 byte) - Position of the language in the
+ *   list sent with kMsgDLanguageSynchronisation
+ *
+ * **Example**:
+ *
+ * 'a' key (KeyID 0x61), no modifiers, physical key (KeyButton 0x1E), first language
+ * ```
+ * "DKDI\x00\x61\x00\x00\x00\x1E\x00"
+ * ```
+ *
+ * Same as kMsgDKeyDownLang but names the language by its index instead
+ * of sending the code with every key press.  The primary falls back to
+ * kMsgDKeyDownLang for languages that weren't in the list.
+ *
+ * @see kMsgDKeyDownLang, kMsgDLanguageSynchronisation
+ * @since Protocol version 1.9
+ */
+extern const char *const kMsgDKeyDownLangId;
+
 /**
  * @brief Key press event
  *
@@ -777,6 +898,117 @@ extern const char *const kMsgDMouseUp;
  */
 extern const char *const kMsgDMouseMove;
 
+/**
+ * @brief Input capture time message
+ *
+ * **Message Code**: `"DITM"`
+ * **Direction**: Primary → Secondary
+ * **Format**: `$1$2`
+ * - `$1$2`: Capture time in nanoseconds on the primary's monotonic
+ *   clock, as high then low 4-byte halves
+ *
+ * Sent immediately before a mouse motion or wheel message to say when
+ * the primary captured the event.  Only one in @ref kInputTimeInterval
+ * events is timestamped, the age is sampled rather than measured for
+ * every event.  The secondary converts it to its
+ * own clock with the offset estimated from kMsgCKeepAliveTime and logs
+ * the age of the event when it is injected.  It applies only to the
+ * next message and is otherwise ignored.
+ *
+ * Only sent once timestamped keep-alives have been negotiated.
+ *
+ * @see kMsgCKeepAliveTime
+ * @since Protocol version 1.3
+ */
+extern const char *const kMsgDInputTime;
+
+/**
+ * @brief Batch of input events
+ *
+ * **Message Code**: `"DBAT"`
+ * **Direction**: Primary ↔ Secondary
+ * **Format**: `"DBAT%4i%4i%s"`
+ * **Parameters**:
+ * - `$1$2`: Base time in nanoseconds on the primary's monotonic clock,
+ *   as high then low 4-byte halves
+ * - `$3`: Records (string)
+ *
+ * Carries several input events in one message.  Each record is the time
+ * since the previous record (the base time for the first) in
+ * microseconds as an unsigned LEB128 varint, followed by the event
+ * exactly as it would be sent on its own, message code included.  The
+ * time is when the primary captured the event, or queued it if the
+ * capture time is unknown, and replaces kMsgDInputTime for batched
+ * events.
+ *
+ * Only key and mouse button, motion and wheel messages may be batched,
+ * including the compact forms from protocol version 1.9; any other
+ * record is a protocol error.
+ *
+ * The primary sends a batch once it has held events for
+ * @ref kInputBatchDelay or the records reach @ref kInputBatchSize,
+ * and before any other message so that ordering is kept.
+ *
+ * **Negotiation**:
+ * - The server advertises support with @ref kOptionInputBatch in
+ *   kMsgDSetOptions
+ * - A client that supports it replies with an empty batch
+ * - The server only batches once it has received that reply
+ *
+ * Peers that don't negotiate keep getting one message per event.
+ *
+ * @see kMsgDInputTime
+ * @since Protocol version 1.3
+ */
+extern const char *const kMsgDInputBatch;
+
+/**
+ * @brief Motion channel key
+ *
+ * **Message Code**: `"DUDP"`
+ * **Direction**: Secondary → Primary
+ * **Format**: `"DUDP%s"`
+ * **Parameters**:
+ * - `$1`: Key (string) - 32 random bytes
+ *
+ * Opens the motion channel, a UDP side channel that carries pointer
+ * motion so that a lost TCP segment doesn't hold up the motion behind
+ * it.  Keys, buttons, the wheel and everything else stay on TCP.
+ *
+ * Each datagram is a kind byte, a 4-byte sequence number, x and y as
+ * zig-zag varints and a 16-byte tag, which is the start of an
+ * HMAC-SHA256 of the rest under the key.  The key is only ever sent
+ * here, so on a TLS connection nobody else can make or read a valid
+ * datagram.  Kinds are:
+ * - `1`: Greeting from the client, every @ref kMotionChannelHelloRate
+ * - `2`: Reply from the server to each greeting
+ * - `3`: Absolute motion, like kMsgDMouseMove
+ * - `4`: Relative motion, like kMsgDMouseRelMove
+ *
+ * Motion has a sequence number one higher than the last; the client
+ * drops any that isn't newer than the last it used.  When the server
+ * sends anything else after absolute motion on the channel it first
+ * sends kMsgDMouseMoveSync, so the pointer is where the motion left it.
+ *
+ * **Negotiation**:
+ * - The server advertises the channel with @ref kOptionMotionChannel
+ *   in kMsgDSetOptions, with its UDP port as the value
+ * - A client that supports it sends this message and starts greeting
+ *   the server on that port
+ * - The server replies to greetings from the first address that sends
+ *   a valid one
+ * - The client sends kMsgCMotionChannelReady with the first reply and
+ *   the server sends motion on the channel from then on
+ *
+ * If either side hears nothing for @ref kMotionChannelTimeout the
+ * channel is dead for the rest of the connection and motion goes back
+ * to TCP, so a firewall that blocks UDP only costs the timeout.
+ *
+ * @see kMsgCMotionChannelReady, kMsgDMouseMoveSync
+ * @since Protocol version 1.9
+ */
+extern const char *const kMsgDMotionChannel;
+
 /**
  * @brief Relative mouse movement
  *
@@ -863,6 +1095,89 @@ extern const char *const kMsgDMouseWheel;
  */
 extern const char *const kMsgDMouseWheel1_0;
 
+/**
+ * @brief Compact mouse movement (v1.9+)
+ *
+ * **Message Code**: `"DMMD"`
+ * **Direction**: Primary → Secondary
+ * **Format**: `"DMMD%v%v"`
+ * **Parameters**:
+ * - `$1`: X change (zig-zag varint) - From the last absolute position
+ * - `$2`: Y change (zig-zag varint) - From the last absolute position
+ *
+ * **Example**:
+ *
+ * Move 3 right and 1 up from the last position
+ * ```
+ * "DMMD\x06\x01"
+ * ```
+ *
+ * Replaces kMsgDMouseMove.  The last position is the one from the
+ * most recent kMsgCEnter, kMsgDMouseMove or kMsgDMouseMoveDelta,
+ * whether or not the secondary acted on it, so both sides must track
+ * it for every message.  Small moves take 2 bytes instead of 4.
+ *
+ * @see kMsgDMouseMove
+ * @since Protocol version 1.9
+ */
+extern const char *const kMsgDMouseMoveDelta;
+
+/**
+ * @brief Compact relative mouse movement (v1.9+)
+ *
+ * **Message Code**: `"DMRV"`
+ * **Direction**: Primary → Secondary
+ * **Format**: `"DMRV%v%v"`
+ * **Parameters**:
+ * - `$1`: X delta (zig-zag varint)
+ * - `$2`: Y delta (zig-zag varint)
+ *
+ * Same as kMsgDMouseRelMove with variable length deltas.
+ *
+ * @see kMsgDMouseRelMove
+ * @since Protocol version 1.9
+ */
+extern const char *const kMsgDMouseRelMoveCompact;
+
+/**
+ * @brief Compact mouse wheel scroll event (v1.9+)
+ *
+ * **Message Code**: `"DMWV"`
+ * **Direction**: Primary → Secondary
+ * **Format**: `"DMWV%v%v"`
+ * **Parameters**:
+ * - `$1`: X delta (zig-zag varint)
+ * - `$2`: Y delta (zig-zag varint)
+ *
+ * Same as kMsgDMouseWheel with variable length deltas; one tick
+ * (+120) takes 2 bytes and no horizontal scroll takes 1.
+ *
+ * @see kMsgDMouseWheel
+ * @since Protocol version 1.9
+ */
+extern const char *const kMsgDMouseWheelCompact;
+
+/**
+ * @brief Mouse movement catching up with the motion channel (v1.9+)
+ *
+ * **Message Code**: `"DMMS"`
+ * **Direction**: Primary → Secondary
+ * **Format**: `"DMMS%4i%2i%2i"`
+ * **Parameters**:
+ * - `$1`: Sequence (4 bytes) - Of the last motion sent on the channel
+ * - `$2`: X coordinate (2 bytes, signed) - Absolute position
+ * - `$3`: Y coordinate (2 bytes, signed) - Absolute position
+ *
+ * Moves the mouse like kMsgDMouseMove, and the secondary drops any
+ * motion datagram up to the sequence that is still on its way.  Sent
+ * before any other input, or kMsgCLeave, that follows absolute motion
+ * on the motion channel.
+ *
+ * @see kMsgDMotionChannel
+ * @since Protocol version 1.9
+ */
+extern const char *const kMsgDMouseMoveSync;
+
 /** @} */ // end of protocol_mouse group
 
 /**
@@ -904,12 +1219,71 @@ extern const char *const kMsgDMouseWheel1_0;
  * - `1`: First chunk of multi-chunk transfer
  * - `2`: Middle chunk
  * - `3`: Final chunk
- *
- * @see kMsgCClipboard
+ * - `4`: First chunk of a resumable transfer (v1.9+, negotiated)
+ *
+ * **Resumable transfers (v1.9+)**:
+ * Once both sides have sent kMsgDClipboardResume, a transfer may start
+ * with mark `4` instead of `1`.  Its data is the total size, the
+ * transfer id and the offset of the first data chunk, as decimal numbers
+ * separated by spaces.  The transfer id is a 64-bit hash of the whole
+ * clipboard data: FNV-1a over little endian 8-byte words, with the high
+ * 32 bits of the hash xored into the low after each word, then FNV-1a
+ * over the remaining bytes; zero is replaced by one.  The receiver of a
+ * resumed transfer checks it against what it has assembled at the final
+ * chunk.  A non-zero offset continues a transfer
+ * the receiver reported holding with kMsgDClipboardResume; the data up
+ * to the offset is not sent again.
+ *
+ * @see kMsgCClipboard, kMsgDClipboardResume
  * @since Protocol version 1.0
  */
 extern const char *const kMsgDClipboard;
 
+/**
+ * @brief Clipboard data message, written from a buffer
+ *
+ * The same message as kMsgDClipboard.  Its format takes the data as a
+ * length and a pointer (`%S`) instead of a std::string, so a chunk is
+ * written without being copied into a string first.  Only for writing.
+ *
+ * @see kMsgDClipboard
+ * @since Protocol version 1.0
+ */
+extern const char *const kMsgDClipboardBytes;
+
+/**
+ * @brief Partly received clipboard transfer
+ *
+ * **Message Code**: `"DCLR"`
+ * **Direction**: Primary ↔ Secondary
+ * **Format**: `"DCLR%1i%4i%4i%4i"`
+ * **Parameters**:
+ * - `$1`: Clipboard identifier (1 byte)
+ * - `$2$3`: Transfer id, as high then low 4-byte halves, or 0 if none
+ * - `$4`: Bytes of the transfer's data held (4 bytes)
+ *
+ * Tells the sender how much of an interrupted resumable transfer the
+ * receiver kept from an earlier connection.  If the clipboard still has
+ * the same data when it is next sent, the sender resumes the transfer
+ * from that offset.  One is sent for each clipboard, with a zero
+ * transfer id for clipboards with nothing kept.
+ *
+ * **Negotiation**:
+ * - The server advertises support with @ref kOptionClipboardResume in
+ *   kMsgDSetOptions
+ * - A client that supports it replies with kMsgDClipboardResume for
+ *   each clipboard
+ * - The server answers with its own kMsgDClipboardResume for each
+ *   clipboard
+ *
+ * Each side only sends resumable transfers once it has received the
+ * other's messages; peers that don't negotiate get ordinary transfers.
+ *
+ * @see kMsgDClipboard
+ * @since Protocol version 1.9
+ */
+extern const char *const kMsgDClipboardResume;
+
 /** @} */ // end of protocol_clipboard group
 
 /**
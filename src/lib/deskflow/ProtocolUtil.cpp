@@ -56,6 +56,30 @@ template <typename T> void writeVectorInt(const std::vector<T> *VectorData, std:
   }
 }
 
+uint32_t zigZag(int32_t Value)
+{
+  return (static_cast<uint32_t>(Value) << 1U) ^ static_cast<uint32_t>(Value >> 31);
+}
+
+uint32_t varintLength(uint32_t Value)
+{
+  uint32_t Length = 1;
+  while (Value >= 0x80U) {
+    Value >>= 7U;
+    ++Length;
+  }
+  return Length;
+}
+
+void writeVarint(uint32_t Value, std::vector<uint8_t> &Buffer)
+{
+  while (Value >= 0x80U) {
+    Buffer.push_back(static_cast<uint8_t>((Value & 0x7fU) | 0x80U));
+    Value >>= 7U;
+  }
+  Buffer.push_back(static_cast<uint8_t>(Value));
+}
+
 void writeString(const std::string *StringData, std::vector<uint8_t> &Buffer)
 {
   const uint32_t len = (StringData != nullptr) ? (uint32_t)StringData->size() : 0;
@@ -82,6 +106,16 @@ void ProtocolUtil::writef(deskflow::IStream *stream, const char *fmt, ...)
   va_end(args);
 }
 
+void ProtocolUtil::appendf(std::vector<uint8_t> &buffer, const char *fmt, ...)
+{
+  assert(fmt != nullptr);
+
+  va_list args;
+  va_start(args, fmt);
+  writef(buffer, fmt, args);
+  va_end(args);
+}
+
 bool ProtocolUtil::readf(deskflow::IStream *stream, const char *fmt, ...)
 {
   bool result = false;
@@ -164,6 +198,12 @@ void ProtocolUtil::vreadf(deskflow::IStream *stream, const char *fmt, va_list ar
         break;
       }
 
+      case 'v': {
+        assert(len == 0);
+        *va_arg(args, int32_t *) = readVarint(stream);
+        break;
+      }
+
       case 'I': {
         void *destination = va_arg(args, void *);
         switch (len) {
@@ -267,6 +307,11 @@ uint32_t ProtocolUtil::getLength(const char *fmt, va_list args)
         len = (uint32_t)(va_arg(args, std::string *))->size() + 4;
         break;
 
+      case 'v':
+        assert(len == 0);
+        len = varintLength(zigZag(va_arg(args, int32_t)));
+        break;
+
       case 'S':
         assert(len == 0);
         len = va_arg(args, uint32_t) + 4;
@@ -344,6 +389,11 @@ void ProtocolUtil::writef(std::vector<uint8_t> &buffer, const char *fmt, va_list
         break;
       }
 
+      case 'v':
+        assert(len == 0);
+        writeVarint(zigZag(va_arg(args, int32_t)), buffer);
+        break;
+
       case 'S': {
         assert(len == 0);
         const uint32_t len = va_arg(args, uint32_t);
@@ -477,6 +527,26 @@ uint32_t ProtocolUtil::read4BytesInt(deskflow::IStream *stream)
   return Result;
 }
 
+int32_t ProtocolUtil::readVarint(deskflow::IStream *stream)
+{
+  // a 32 bit value never needs more than 5 groups of 7 bits
+  const int MaxLength = 5;
+
+  uint32_t Value = 0;
+  for (int i = 0; i < MaxLength; ++i) {
+    const uint8_t Byte = read1ByteInt(stream);
+    Value |= static_cast<uint32_t>(Byte & 0x7fU) << (7 * i);
+    if ((Byte & 0x80U) == 0) {
+      const auto Result = static_cast<int32_t>((Value >> 1U) ^ (~(Value & 1U) + 1U));
+      LOG_VERBOSE("readf: read varint: %d", Result);
+      return Result;
+    }
+  }
+
+  LOG_ERR("readVarint: varint is longer than %d bytes", MaxLength);
+  throw BadClientException("Too long varint received");
+}
+
 void ProtocolUtil::readVector1ByteInt(deskflow::IStream *stream, std::vector<uint8_t> &destination)
 {
   auto size = readVectorSize(stream);
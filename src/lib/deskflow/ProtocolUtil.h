@@ -43,9 +43,17 @@ public:
   - \%4I  -- converts std::vector<uint32_t>* to 4 byte integers in NBO
   - \%s   -- converts std::string* to stream of bytes
   - \%S   -- converts integer N and const uint8_t* to stream of N bytes
+  - \%v   -- converts integer argument to a 1 to 5 byte zig-zag varint
   */
   static void writef(deskflow::IStream *, const char *fmt, ...);
 
+  //! Append formatted data
+  /*!
+  Like writef() but appends the formatted data to \p buffer instead of
+  writing it to a stream.
+  */
+  static void appendf(std::vector<uint8_t> &buffer, const char *fmt, ...);
+
   //! Read formatted data
   /*!
   Read formatted binary data from a buffer.  This performs the
@@ -61,6 +69,7 @@ public:
   - \%2I  -- reads NBO 2 byte integers;  arg is std::vector<uint16_t>*
   - \%4I  -- reads NBO 4 byte integers;  arg is std::vector<uint32_t>*
   - \%s   -- reads bytes;  argument must be a std::string*, \b not a char*
+  - \%v   -- reads a zig-zag varint;  arg is int32_t*
   */
   static bool readf(deskflow::IStream *, const char *fmt, ...);
 
@@ -79,6 +88,7 @@ private:
   static uint8_t read1ByteInt(deskflow::IStream *stream);
   static uint16_t read2BytesInt(deskflow::IStream *stream);
   static uint32_t read4BytesInt(deskflow::IStream *stream);
+  static int32_t readVarint(deskflow::IStream *stream);
 
   /**
    * @brief Handles a Vector of integers
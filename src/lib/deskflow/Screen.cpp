@@ -8,6 +8,7 @@
 #include "deskflow/Screen.h"
 #include "base/IEventQueue.h"
 #include "base/Log.h"
+#include "common/SettingsSnapshot.h"
 #include "deskflow/IPlatformScreen.h"
 
 #include <QProcess>
@@ -149,8 +150,8 @@ void Screen::enter(KeyModifierMask toggleMask)
     enterSecondary(toggleMask);
   }
 
-  if (Settings::value(Settings::Core::EnableEnterCommand).toBool()) {
-    const auto commandLine = Settings::value(Settings::Core::ScreenEnterCommand).toString();
+  if (const auto settings = SettingsSnapshot::current(); settings->core.enableEnterCommand) {
+    const auto &commandLine = settings->core.screenEnterCommand;
     LOG_DEBUG("running screen enter command: %s", qPrintable(commandLine));
     if (!runScreenCommand(commandLine))
       LOG_ERR("failed to run screen enter command");
@@ -176,8 +177,8 @@ bool Screen::leave()
   }
 
   m_screen->leave();
-  if (Settings::value(Settings::Core::EnableExitCommand).toBool()) {
-    const auto commandLine = Settings::value(Settings::Core::ScreenExitCommand).toString();
+  if (const auto settings = SettingsSnapshot::current(); settings->core.enableExitCommand) {
+    const auto &commandLine = settings->core.screenExitCommand;
     LOG_DEBUG("running screen exit command: %s", qPrintable(commandLine));
     if (!runScreenCommand(commandLine))
       LOG_ERR("failed to run screen exit command");
@@ -11,9 +11,11 @@
 #include "arch/Arch.h"
 #include "base/IEventQueue.h"
 #include "base/Log.h"
+#include "base/Stopwatch.h"
 #include "common/ExitCodes.h"
 #include "common/PlatformInfo.h"
 #include "common/Settings.h"
+#include "common/SettingsSnapshot.h"
 #include "deskflow/App.h"
 #include "deskflow/ProtocolTypes.h"
 #include "deskflow/Screen.h"
@@ -24,12 +26,18 @@
 #include "net/TCPSocketFactory.h"
 #include "server/ClientListener.h"
 #include "server/ClientProxy.h"
+#include "server/CompiledConfig.h"
 #include "server/Config.h"
+#include "server/ConfigDiff.h"
 #include "server/PrimaryClient.h"
 #include "server/Server.h"
 
 // must be before screen header includes
+#include <QFile>
 #include <QFileInfo>
+#include <QSaveFile>
+
+#include "platform/SyntheticScreen.h"
 
 #if defined(Q_OS_WIN)
 #include "platform/MSWindowsScreen.h"
@@ -47,7 +55,7 @@
 #include "platform/OSXScreen.h"
 #endif
 
-#include <fstream>
+#include <sstream>
 
 using namespace deskflow::server;
 
@@ -57,16 +65,16 @@ using namespace deskflow::server;
 
 ServerApp::ServerApp(IEventQueue *events, const QString &processName) : App(events, processName)
 {
-  m_name = Settings::value(Settings::Core::ComputerName).toString().toStdString();
+  m_name = SettingsSnapshot::current()->core.computerName.toStdString();
   // do nothing
 }
 
 void ServerApp::parseArgs()
 {
-  if (const auto address = Settings::value(Settings::Core::Interface).toString(); !address.isEmpty()) {
-    *m_deskflowAddress = NetworkAddress(address.toStdString(), Settings::value(Settings::Core::Port).toInt());
+  if (const auto address = SettingsSnapshot::current()->core.interfaceAddress; !address.isEmpty()) {
+    *m_deskflowAddress = NetworkAddress(address.toStdString(), SettingsSnapshot::current()->core.port);
   } else {
-    *m_deskflowAddress = NetworkAddress(Settings::value(Settings::Core::Port).toInt());
+    *m_deskflowAddress = NetworkAddress(SettingsSnapshot::current()->core.port);
   }
 
   try {
@@ -86,12 +94,22 @@ void ServerApp::reloadSignalHandler(Arch::ThreadSignal, void *)
 void ServerApp::reloadConfig()
 {
   LOG_DEBUG("reload configuration");
-  if (loadConfig(Settings::serverConfigFile())) {
-    if (m_server != nullptr) {
-      m_server->setConfig(*m_config);
-    }
-    LOG_INFO("reloaded configuration");
+  SettingsSnapshot::reload();
+
+  // read into a new config and apply only what differs from the old one,
+  // so clients whose screens are still configured stay connected
+  Stopwatch stopwatch;
+  Config config(getEvents());
+  if (!readConfig(Settings::serverConfigFile(), config)) {
+    return;
   }
+
+  const ConfigDiff diff(*m_config, config);
+  *m_config = config;
+  if (m_server != nullptr) {
+    m_server->setConfig(*m_config, &diff);
+  }
+  LOG_INFO("reloaded configuration in %.1f ms: %s", stopwatch.getTime() * 1000.0, diff.summary().c_str());
 }
 
 void ServerApp::loadConfig()
@@ -109,21 +127,34 @@ void ServerApp::loadConfig()
 }
 
 bool ServerApp::loadConfig(const QString &filename)
+{
+  return readConfig(filename, *m_config);
+}
+
+bool ServerApp::readConfig(const QString &filename, Config &config)
 {
   const auto path = filename.toStdString();
   try {
     // load configuration
     LOG_DEBUG("opening configuration \"%s\"", path.c_str());
-#if defined(Q_OS_WIN)
-    std::ifstream configStream(filename.toStdWString());
-#else
-    std::ifstream configStream(path);
-#endif
-    if (!configStream.is_open()) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
       LOG_ERR("cannot open configuration \"%s\"", path.c_str());
       return false;
     }
-    configStream >> *m_config;
+
+    // a compiled config is read where it lies, anything else is text
+    if (const auto *data = file.map(0, file.size()); data != nullptr) {
+      const std::string_view view(reinterpret_cast<const char *>(data), static_cast<size_t>(file.size()));
+      if (CompiledConfig::isCompiled(view)) {
+        CompiledConfig::read(view, config);
+        LOG_DEBUG("compiled configuration read successfully");
+        return true;
+      }
+    }
+
+    std::istringstream configStream(file.readAll().toStdString());
+    configStream >> config;
     LOG_DEBUG("configuration read successfully");
     return true;
   } catch (ServerConfigReadException &e) {
@@ -133,6 +164,27 @@ bool ServerApp::loadConfig(const QString &filename)
   return false;
 }
 
+bool ServerApp::compileConfig(const QString &source, const QString &destination)
+{
+  Config config(nullptr);
+  if (!readConfig(source, config)) {
+    return false;
+  }
+
+  const auto data = CompiledConfig::write(config);
+  QSaveFile file(destination);
+  if (!file.open(QIODevice::WriteOnly) || file.write(data.data(), static_cast<qint64>(data.size())) < 0 ||
+      !file.commit()) {
+    LOG_ERR("cannot write compiled configuration \"%s\"", qPrintable(destination));
+    return false;
+  }
+
+  LOG_INFO(
+      "compiled configuration \"%s\" to \"%s\", %zu bytes", qPrintable(source), qPrintable(destination), data.size()
+  );
+  return true;
+}
+
 void ServerApp::forceReconnect()
 {
   if (m_server != nullptr) {
@@ -389,9 +441,14 @@ bool ServerApp::startServer()
 
 deskflow::Screen *ServerApp::createScreen()
 {
+  if (const auto spec = SettingsSnapshot::current()->core.syntheticScreen; !spec.isEmpty()) {
+    const auto options = deskflow::SyntheticScreen::Options::parse(spec);
+    return new deskflow::Screen(new deskflow::SyntheticScreen(true, getEvents(), options), getEvents());
+  }
+
 #if defined(Q_OS_WIN)
   return new deskflow::Screen(
-      new MSWindowsScreen(true, Settings::value(Settings::Core::UseHooks).toBool(), getEvents()), getEvents()
+      new MSWindowsScreen(true, SettingsSnapshot::current()->core.useHooks, getEvents()), getEvents()
   );
 #elif defined(Q_OS_MAC)
   return new deskflow::Screen(new OSXScreen(getEvents(), true), getEvents());
@@ -407,7 +464,7 @@ deskflow::Screen *ServerApp::createScreen()
 #if WINAPI_XWINDOWS
   LOG_INFO("using legacy x windows screen");
   return new deskflow::Screen(
-      new XWindowsScreen(qPrintable(Settings::value(Settings::Core::Display).toString()), true, getEvents()),
+      new XWindowsScreen(qPrintable(SettingsSnapshot::current()->core.display), true, getEvents()),
       getEvents()
   );
 #endif
@@ -442,8 +499,8 @@ ClientListener *ServerApp::openClientListener(const NetworkAddress &address)
 {
   using enum SecurityLevel;
   auto securityLevel = PlainText;
-  if (Settings::value(Settings::Security::TlsEnabled).toBool()) {
-    if (Settings::value(Settings::Security::CheckPeers).toBool()) {
+  if (SettingsSnapshot::current()->security.tlsEnabled) {
+    if (SettingsSnapshot::current()->security.checkPeers) {
       securityLevel = PeerAuth;
     } else {
       securityLevel = Encrypted;
@@ -480,7 +537,7 @@ void ServerApp::handleScreenSwitched() const
 
 std::unique_ptr<ISocketFactory> ServerApp::getSocketFactory() const
 {
-  return std::make_unique<TCPSocketFactory>(getEvents(), getSocketMultiplexer());
+  return std::make_unique<TCPSocketFactory>(getEvents(), getSocketMultiplexer(), m_clientMultiplexers.get());
 }
 
 NetworkAddress ServerApp::getAddress(const NetworkAddress &address) const
@@ -494,6 +551,14 @@ int ServerApp::mainLoop()
   // on unix because threads evaporate across a fork().
   setSocketMultiplexer(std::make_unique<SocketMultiplexer>());
 
+  // spread client sockets over their own multiplexers, so one busy or
+  // slow client doesn't delay i/o for the rest.  one thread is no better
+  // than sharing the listener's.
+  if (const auto threads = SocketMultiplexerPool::sizeFor(SettingsSnapshot::current()->server.ioThreads); threads > 1) {
+    m_clientMultiplexers = std::make_unique<SocketMultiplexerPool>(threads);
+  }
+  LOG_DEBUG("client i/o on %zu thread(s)", m_clientMultiplexers ? m_clientMultiplexers->size() : size_t{1});
+
   // if configuration has no screens then add this system
   // as the default
   if (m_config->begin() == m_config->end()) {
@@ -543,6 +608,19 @@ int ServerApp::mainLoop()
     resetServer();
   });
 
+  // input from the screen is dispatched on this thread ahead of other
+  // events.  real-time scheduling keeps other processes from delaying it.
+  // note that it applies to the whole event loop, so clipboard transfers
+  // and config reloads also run ahead of every normal thread and can
+  // starve them on a machine with few cores
+  if (SettingsSnapshot::current()->server.realtimeInput) {
+    if (ARCH->setCurrentThreadRealtime()) {
+      LOG_INFO("using real-time scheduling for the server event loop, including input");
+    } else {
+      LOG_WARN("real-time scheduling for input is not permitted");
+    }
+  }
+
   // run event loop.  if startServer() failed we're supposed to retry
   // later.  the timer installed by startServer() will take care of
   // that.
@@ -553,6 +631,7 @@ int ServerApp::mainLoop()
   getEvents()->removeHandler(EventTypes::ServerAppForceReconnect, getEvents()->getSystemTarget());
   getEvents()->removeHandler(EventTypes::ServerAppReloadConfig, getEvents()->getSystemTarget());
   cleanupServer();
+  m_clientMultiplexers.reset();
   LOG_INFO("stopped server");
 
   return exitCode;
@@ -12,6 +12,7 @@
 #include "arch/IArchMultithread.h"
 #include "deskflow/App.h"
 #include "net/NetworkAddress.h"
+#include "net/SocketMultiplexerPool.h"
 #include "server/Config.h"
 
 #include <memory>
@@ -101,10 +102,14 @@ public:
     return (ServerApp &)App::instance();
   }
 
+  //! Write the configuration in \c source to \c destination in compiled form
+  static bool compileConfig(const QString &source, const QString &destination);
+
 private:
   void handleScreenSwitched() const;
   std::unique_ptr<ISocketFactory> getSocketFactory() const;
   NetworkAddress getAddress(const NetworkAddress &address) const;
+  static bool readConfig(const QString &filename, deskflow::server::Config &config);
 
   bool m_suspended = false;
   Server *m_server = nullptr;
@@ -116,4 +121,5 @@ private:
   NetworkAddress *m_deskflowAddress = nullptr;
   std::string m_name;
   std::shared_ptr<deskflow::server::Config> m_config;
+  std::unique_ptr<SocketMultiplexerPool> m_clientMultiplexers;
 };
@@ -10,44 +10,90 @@
 #include "base/IEventQueue.h"
 #include "base/Log.h"
 #include "deskflow/ClipboardChunk.h"
+#include "deskflow/ClipboardPartials.h"
 
-static const size_t g_chunkSize = 512 * 1024; // 512kb
+#include <algorithm>
+
+// the metadata is included so each chunk fills a 512kb pool buffer exactly
+static const size_t g_chunkSize = 512 * 1024 - s_clipboardChunkMetaSize;
+
+StreamChunker::StreamChunker(IEventQueue *events, void *eventTarget) : m_events(events), m_eventTarget(eventTarget)
+{
+  // do nothing
+}
 
 void StreamChunker::sendClipboard(
-    const std::string_view &data, size_t size, ClipboardID id, uint32_t sequence, IEventQueue *events, void *eventTarget
+    std::shared_ptr<const Clipboard::Snapshot> snapshot, ClipboardID id, uint32_t sequence,
+    ClipboardResumePoint *resume
 )
 {
-  // send first message (data size)
-  std::string dataSize = QString::number(size).toStdString();
-  ClipboardChunk *sizeMessage = ClipboardChunk::start(id, sequence, dataSize);
-
-  events->addEvent(Event(EventTypes::ClipboardSending, eventTarget, sizeMessage));
-
-  // send clipboard chunk with a fixed size
-  size_t sentLength = 0;
-  size_t chunkSize = g_chunkSize;
-
-  while (true) {
-    // make sure we don't read too much from the mock data.
-    if (sentLength + chunkSize > size) {
-      chunkSize = size - sentLength;
+  const auto &data = snapshot->m_data;
+  Transfer transfer;
+  transfer.m_id = id;
+  transfer.m_sequence = sequence;
+  if (resume != nullptr) {
+    // skip what the receiver kept if it's of the same data
+    transfer.m_resumable = true;
+    transfer.m_transferId = snapshot->m_transferId;
+    if (resume->transferId == transfer.m_transferId && resume->offset <= data.size()) {
+      transfer.m_offset = resume->offset;
+      LOG_DEBUG("resuming clipboard transfer at %zu of %zu", transfer.m_offset, data.size());
     }
+    *resume = {};
+  }
+  transfer.m_snapshot = std::move(snapshot);
 
-    std::string chunk(data.substr(sentLength, chunkSize).data(), chunkSize);
-    ClipboardChunk *dataChunk = ClipboardChunk::data(id, sequence, chunk);
-
-    events->addEvent(Event(EventTypes::ClipboardSending, eventTarget, dataChunk));
+  m_transfers.push_back(std::move(transfer));
+  queueChunks();
+}
 
-    sentLength += chunkSize;
-    if (sentLength == size) {
-      break;
-    }
+void StreamChunker::sent()
+{
+  if (m_inFlight > 0) {
+    --m_inFlight;
   }
+  queueChunks();
+}
 
-  // send last message
-  ClipboardChunk *end = ClipboardChunk::end(id, sequence);
+bool StreamChunker::isSending() const
+{
+  return !m_transfers.empty() || m_inFlight > 0;
+}
 
-  events->addEvent(Event(EventTypes::ClipboardSending, eventTarget, end));
+void StreamChunker::queueChunks()
+{
+  while (m_inFlight < kChunksInFlight && !m_transfers.empty()) {
+    auto &transfer = m_transfers.front();
+    const auto &data = transfer.m_snapshot->m_data;
+    const auto size = data.size();
+
+    ClipboardChunk *chunk = nullptr;
+    if (!transfer.m_started) {
+      // first message (data size)
+      transfer.m_started = true;
+      if (transfer.m_resumable) {
+        chunk = ClipboardChunk::resume(
+            transfer.m_id, transfer.m_sequence, size, transfer.m_transferId, transfer.m_offset
+        );
+      } else {
+        chunk = ClipboardChunk::start(transfer.m_id, transfer.m_sequence, QString::number(size).toStdString());
+      }
+    } else if (transfer.m_offset < size || !transfer.m_sentData) {
+      // a chunk with a fixed size, the last one may be shorter or empty
+      transfer.m_sentData = true;
+      const auto chunkSize = std::min(g_chunkSize, size - transfer.m_offset);
+      chunk = ClipboardChunk::data(
+          transfer.m_id, transfer.m_sequence, std::string_view(data).substr(transfer.m_offset, chunkSize)
+      );
+      transfer.m_offset += chunkSize;
+    } else {
+      // last message
+      chunk = ClipboardChunk::end(transfer.m_id, transfer.m_sequence);
+      LOG_DEBUG("sent clipboard size=%zu", size);
+      m_transfers.pop_front();
+    }
 
-  LOG_DEBUG("sent clipboard size=%d", sentLength);
+    m_events->addEvent(Event(EventTypes::ClipboardSending, m_eventTarget, chunk));
+    ++m_inFlight;
+  }
 }
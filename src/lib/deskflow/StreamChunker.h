@@ -6,17 +6,84 @@
 
 #pragma once
 
+#include "deskflow/Clipboard.h"
 #include "deskflow/ClipboardTypes.h"
 
-#include <string_view>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
 
 class IEventQueue;
+struct ClipboardResumePoint;
 
+//! Splits clipboard data into chunks to send
+/*!
+Queues the chunks of a transfer as ClipboardSending events for the event
+target, which writes each one and then calls sent().  Only a few chunks
+are queued at a time and the next is made as one is written, so sending
+a large clipboard needs a few chunk buffers rather than one for every
+chunk.  Transfers queued while one is being sent follow it in order.
+*/
 class StreamChunker
 {
 public:
-  static void sendClipboard(
-      const std::string_view &data, size_t size, ClipboardID id, uint32_t sequence, IEventQueue *events,
-      void *eventTarget
+  //! Most chunks queued and not yet written
+  static constexpr size_t kChunksInFlight = 4;
+
+  StreamChunker(IEventQueue *events, void *eventTarget);
+  StreamChunker(const StreamChunker &) = delete;
+  StreamChunker &operator=(const StreamChunker &) = delete;
+
+  //! @name manipulators
+  //@{
+
+  //! Send clipboard data
+  /*!
+  Sends the data of \p snapshot, keeping it until its last chunk is
+  queued.  If \p resume is given the receiver supports resumable
+  transfers, and the snapshot's transfer id is sent with the data.  The
+  transfer starts from the offset in \p resume if it is for the same
+  data, then \p resume is cleared.
+  */
+  void sendClipboard(
+      std::shared_ptr<const Clipboard::Snapshot> snapshot, ClipboardID id, uint32_t sequence,
+      ClipboardResumePoint *resume = nullptr
   );
+
+  //! A chunk was written
+  /*!
+  Called by the event target after writing each chunk, queues the next.
+  */
+  void sent();
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Test for chunks still to send
+  bool isSending() const;
+
+  //@}
+
+private:
+  struct Transfer
+  {
+    std::shared_ptr<const Clipboard::Snapshot> m_snapshot;
+    ClipboardID m_id = 0;
+    uint32_t m_sequence = 0;
+    bool m_resumable = false;
+    uint64_t m_transferId = 0;
+    size_t m_offset = 0;
+    bool m_started = false;
+    bool m_sentData = false;
+  };
+
+  void queueChunks();
+
+  IEventQueue *m_events;
+  void *m_eventTarget;
+  std::deque<Transfer> m_transfers;
+  size_t m_inFlight = 0;
 };
@@ -8,8 +8,11 @@
 
 #include "base/Log.h"
 #include "common/Constants.h"
+#include "common/SettingsSnapshot.h"
+#include "deskflow/ConnectionStats.h"
 
 #include <QLocalSocket>
+#include <QTimer>
 
 namespace deskflow::core::ipc {
 
@@ -19,6 +22,13 @@ CoreIpcServer::CoreIpcServer(QObject *parent) : IpcServer(parent, kCoreIpcName,
 {
   assert(s_instance == nullptr);
   s_instance = this;
+
+  // optionally dump connection stats to the log, interval is in seconds
+  if (const auto interval = SettingsSnapshot::current()->log.statsInterval; interval > 0) {
+    m_statsTimer = new QTimer(this);
+    connect(m_statsTimer, &QTimer::timeout, this, &CoreIpcServer::logStats);
+    m_statsTimer->start(interval * 1000);
+  }
 }
 
 CoreIpcServer &CoreIpcServer::instance()
@@ -37,7 +47,25 @@ void CoreIpcServer::processCommand(QLocalSocket *clientSocket, const QString &co
     Q_EMIT stopProcessRequested();
     return;
   }
+  if (command == QStringLiteral("stats")) {
+    LOG_DEBUG("core ipc server got stats message");
+    const auto report = QString::fromStdString(ConnectionStats::report());
+    writeToClientSocket(clientSocket, QStringLiteral("stats=%1").arg(report));
+    return;
+  }
+  if (command == QStringLiteral("reload")) {
+    LOG_DEBUG("core ipc server got reload message");
+    SettingsSnapshot::reload();
+    writeToClientSocket(clientSocket, QStringLiteral("ok"));
+    Q_EMIT reloadRequested();
+    return;
+  }
   LOG_WARN("core ipc server got unknown command: %s", command.toUtf8().constData());
 }
 
+void CoreIpcServer::logStats() const
+{
+  LOG_INFO("connection stats: %s", ConnectionStats::report().c_str());
+}
+
 } // namespace deskflow::core::ipc
@@ -12,6 +12,7 @@
 #include <QSet>
 
 class QLocalSocket;
+class QTimer;
 
 namespace deskflow::core::ipc {
 
@@ -24,8 +25,15 @@ public:
 
   static CoreIpcServer &instance();
 
+Q_SIGNALS:
+  //! Settings were reloaded, the server config should be too
+  void reloadRequested();
+
 private:
   void processCommand(QLocalSocket *clientSocket, const QString &command, const QStringList &parts) override;
+  void logStats() const;
+
+  QTimer *m_statsTimer = nullptr;
 };
 
 } // namespace deskflow::core::ipc
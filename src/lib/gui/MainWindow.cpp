@@ -611,7 +611,7 @@ void MainWindow::serverConnectionConfigureClient(const QString &clientName)
   m_serverConfigDialogVisible = true;
   ServerConfigDialog dialog(this, m_serverConfig);
   if (dialog.addClient(clientName) && dialog.exec() == QDialog::Accepted) {
-    m_coreProcess.restart();
+    m_coreProcess.reloadConfig();
   }
   m_serverConfigDialogVisible = false;
 }
@@ -1087,7 +1087,7 @@ void MainWindow::showConfigureServer(const QString &message)
   ServerConfigDialog dialog(this, serverConfig());
   dialog.message(message);
   if ((dialog.exec() == QDialog::Accepted) && m_coreProcess.isStarted()) {
-    m_coreProcess.restart();
+    m_coreProcess.reloadConfig();
   }
 }
 
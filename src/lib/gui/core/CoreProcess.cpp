@@ -515,6 +515,40 @@ void CoreProcess::restart()
   start();
 }
 
+void CoreProcess::reloadConfig()
+{
+  // only a running server can apply a new config without restarting
+  if (m_mode != Settings::CoreMode::Server || !isStarted()) {
+    restart();
+    return;
+  }
+
+  if (const auto [hasNeededPermissions, configFilename] = persistServerConfig(); !hasNeededPermissions) {
+    qWarning().noquote() << "core cannot read server config, restarting:" << configFilename;
+    restart();
+    return;
+  }
+
+  qInfo("asking core to reload server config");
+  auto *client = new ipc::CoreIpcClient(this);
+  connect(client, &ipc::CoreIpcClient::connected, this, [client] { client->sendReload(); });
+  connect(client, &ipc::CoreIpcClient::commandReceived, this, [client](const QString &command) {
+    if (command == QStringLiteral("ok")) {
+      qDebug("core reloaded server config");
+      client->deleteLater();
+    }
+  });
+
+  auto fallback = [this, client] {
+    qWarning("could not ask core to reload server config, restarting");
+    client->deleteLater();
+    restart();
+  };
+  connect(client, &ipc::CoreIpcClient::versionMismatch, this, fallback);
+  connect(client, &ipc::CoreIpcClient::connectionFailed, this, fallback);
+  client->connectToServer();
+}
+
 void CoreProcess::cleanup()
 {
   qInfo("cleaning up core process");
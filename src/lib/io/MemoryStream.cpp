@@ -0,0 +1,69 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "io/MemoryStream.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace deskflow {
+
+MemoryStream::MemoryStream(std::string_view data) : m_data(data)
+{
+  // do nothing
+}
+
+void MemoryStream::close()
+{
+  m_data = {};
+}
+
+uint32_t MemoryStream::read(void *buffer, uint32_t n)
+{
+  n = static_cast<uint32_t>(std::min<size_t>(n, m_data.size()));
+  if (buffer != nullptr && n != 0) {
+    std::memcpy(buffer, m_data.data(), n);
+  }
+  m_data.remove_prefix(n);
+  return n;
+}
+
+void MemoryStream::write(const void *, uint32_t)
+{
+  // discard
+}
+
+void MemoryStream::flush()
+{
+  // do nothing
+}
+
+void MemoryStream::shutdownInput()
+{
+  m_data = {};
+}
+
+void MemoryStream::shutdownOutput()
+{
+  // do nothing
+}
+
+void *MemoryStream::getEventTarget() const
+{
+  return const_cast<MemoryStream *>(this);
+}
+
+bool MemoryStream::isReady() const
+{
+  return !m_data.empty();
+}
+
+uint32_t MemoryStream::getSize() const
+{
+  return static_cast<uint32_t>(m_data.size());
+}
+
+} // namespace deskflow
@@ -0,0 +1,43 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "io/IStream.h"
+
+#include <string_view>
+
+namespace deskflow {
+
+//! Read-only stream over memory
+/*!
+Reads from a block of memory that the caller owns and must keep alive
+for the life of the stream.  Writes are discarded and no events are
+ever sent, so code that parses messages from a stream can parse them
+from a buffer too.
+*/
+class MemoryStream : public IStream
+{
+public:
+  explicit MemoryStream(std::string_view data);
+  ~MemoryStream() override = default;
+
+  // IStream overrides
+  void close() override;
+  uint32_t read(void *buffer, uint32_t n) override;
+  void write(const void *buffer, uint32_t n) override;
+  void flush() override;
+  void shutdownInput() override;
+  void shutdownOutput() override;
+  void *getEventTarget() const override;
+  bool isReady() const override;
+  uint32_t getSize() const override;
+
+private:
+  std::string_view m_data;
+};
+
+} // namespace deskflow
@@ -7,7 +7,9 @@
 
 #include "io/StreamBuffer.h"
 
+#include <algorithm>
 #include <assert.h>
+#include <cstring>
 
 //
 // StreamBuffer
@@ -40,6 +42,28 @@ const void *StreamBuffer::peek(uint32_t n)
   return static_cast<const void *>(&(head->begin()[m_headUsed]));
 }
 
+uint32_t StreamBuffer::read(void *data, uint32_t n)
+{
+  n = std::min(n, m_size);
+
+  // copy chunk by chunk rather than consolidating like peek() does
+  if (data != nullptr) {
+    auto *out = static_cast<uint8_t *>(data);
+    uint32_t left = n;
+    uint32_t offset = m_headUsed;
+    for (auto scan = m_chunks.begin(); left > 0; ++scan) {
+      const uint32_t count = std::min(left, (uint32_t)scan->size() - offset);
+      memcpy(out, scan->data() + offset, count);
+      out += count;
+      left -= count;
+      offset = 0;
+    }
+  }
+
+  pop(n);
+  return n;
+}
+
 void StreamBuffer::pop(uint32_t n)
 {
   // discard all chunks if n is greater than or equal to m_size
@@ -32,6 +32,14 @@ public:
   */
   const void *peek(uint32_t n);
 
+  //! Read data from buffer
+  /*!
+  Copies up to \c n bytes into \c data, straight out of the chunks they
+  are stored in, and discards them.  If \c data is nullptr then the
+  bytes are just discarded.  Returns the number of bytes read.
+  */
+  uint32_t read(void *data, uint32_t n);
+
   //! Discard data
   /*!
   Discards the next \c n bytes.  If \c n >= getSize() then the buffer
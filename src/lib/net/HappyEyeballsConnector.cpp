@@ -0,0 +1,186 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "net/HappyEyeballsConnector.h"
+
+#include "arch/Arch.h"
+#include "base/BaseException.h"
+#include "base/IEventQueue.h"
+#include "base/Log.h"
+#include "net/IDataSocket.h"
+
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <map>
+
+//
+// HappyEyeballsConnector
+//
+
+HappyEyeballsConnector::HappyEyeballsConnector(
+    IEventQueue *events, SocketFactory factory, EventTypes connectedEvent, double attemptDelay
+)
+    : m_events(events),
+      m_factory(std::move(factory)),
+      m_connectedEvent(connectedEvent),
+      m_attemptDelay(attemptDelay)
+{
+  assert(m_events != nullptr);
+  assert(m_factory);
+}
+
+HappyEyeballsConnector::~HappyEyeballsConnector()
+{
+  cleanupTimer();
+  while (!m_attempts.empty()) {
+    closeAttempt(m_attempts.back());
+  }
+}
+
+void HappyEyeballsConnector::connect(
+    std::vector<NetworkAddress> candidates, ConnectedHandler connected, FailedHandler failed
+)
+{
+  assert(m_candidates.empty());
+
+  m_candidates = std::move(candidates);
+  m_connected = std::move(connected);
+  m_failed = std::move(failed);
+  startAttempt();
+}
+
+std::vector<NetworkAddress> HappyEyeballsConnector::interleave(const std::vector<NetworkAddress> &addresses)
+{
+  // split by family, keeping resolver order within each family and the
+  // families in order of first appearance
+  std::vector<IArchNetwork::AddressFamily> order;
+  std::map<IArchNetwork::AddressFamily, std::deque<const NetworkAddress *>> families;
+  for (const auto &address : addresses) {
+    const auto family = ARCH->getAddrFamily(address.getAddress());
+    auto &queue = families[family];
+    if (queue.empty() && std::ranges::find(order, family) == order.end()) {
+      order.push_back(family);
+    }
+    queue.push_back(&address);
+  }
+
+  std::vector<NetworkAddress> sorted;
+  sorted.reserve(addresses.size());
+  while (sorted.size() < addresses.size()) {
+    for (const auto family : order) {
+      if (auto &queue = families[family]; !queue.empty()) {
+        sorted.push_back(*queue.front());
+        queue.pop_front();
+      }
+    }
+  }
+  return sorted;
+}
+
+void HappyEyeballsConnector::startAttempt()
+{
+  cleanupTimer();
+
+  while (m_next < m_candidates.size()) {
+    const NetworkAddress &address = m_candidates[m_next++];
+    IDataSocket *socket = nullptr;
+    try {
+      socket = m_factory(address);
+      m_attempts.push_back(socket);
+
+      void *target = socket->getEventTarget();
+      m_events->addHandler(m_connectedEvent, target, [this, socket, address](const auto &) {
+        handleConnected(socket, address);
+      });
+      m_events->addHandler(EventTypes::DataSocketConnectionFailed, target, [this, socket](const auto &e) {
+        handleFailed(socket, e);
+      });
+
+      LOG_DEBUG("trying %s port %d", ARCH->addrToString(address.getAddress()).c_str(), address.getPort());
+      socket->connect(address);
+    } catch (BaseException &e) {
+      LOG_DEBUG("cannot connect to %s: %s", ARCH->addrToString(address.getAddress()).c_str(), e.what());
+      m_lastError = e.what();
+      if (socket != nullptr) {
+        closeAttempt(socket);
+      }
+      continue;
+    }
+
+    // give this attempt a head start before racing the next one
+    if (m_next < m_candidates.size()) {
+      m_timer = m_events->newOneShotTimer(m_attemptDelay, nullptr);
+      m_events->addHandler(EventTypes::Timer, m_timer, [this](const auto &) { startAttempt(); });
+    }
+    return;
+  }
+
+  if (m_attempts.empty()) {
+    finish();
+  }
+}
+
+void HappyEyeballsConnector::handleConnected(IDataSocket *socket, const NetworkAddress &address)
+{
+  // hand over the winner and close everything else
+  LOG_DEBUG("connected, abandoning %zu other attempts", m_attempts.size() - 1);
+  m_events->removeHandler(m_connectedEvent, socket->getEventTarget());
+  m_events->removeHandler(EventTypes::DataSocketConnectionFailed, socket->getEventTarget());
+  std::erase(m_attempts, socket);
+
+  cleanupTimer();
+  while (!m_attempts.empty()) {
+    closeAttempt(m_attempts.back());
+  }
+
+  // the callback may delete us, so it must be the last thing we do
+  auto connected = std::move(m_connected);
+  connected(socket, address);
+}
+
+void HappyEyeballsConnector::handleFailed(IDataSocket *socket, const Event &event)
+{
+  auto *info = static_cast<IDataSocket::ConnectionFailedInfo *>(event.getData());
+  m_lastError = info->m_what;
+  delete info;
+
+  closeAttempt(socket);
+
+  // don't wait out the delay when we already know this one is no good
+  if (m_next < m_candidates.size()) {
+    startAttempt();
+  } else if (m_attempts.empty()) {
+    finish();
+  }
+}
+
+void HappyEyeballsConnector::closeAttempt(IDataSocket *socket)
+{
+  m_events->removeHandler(m_connectedEvent, socket->getEventTarget());
+  m_events->removeHandler(EventTypes::DataSocketConnectionFailed, socket->getEventTarget());
+  std::erase(m_attempts, socket);
+  delete socket;
+}
+
+void HappyEyeballsConnector::finish()
+{
+  cleanupTimer();
+
+  // the callback may delete us, so it must be the last thing we do
+  auto failed = std::move(m_failed);
+  const auto error = m_lastError.empty() ? std::string{"no addresses to connect to"} : m_lastError;
+  failed(error);
+}
+
+void HappyEyeballsConnector::cleanupTimer()
+{
+  if (m_timer != nullptr) {
+    m_events->removeHandler(EventTypes::Timer, m_timer);
+    m_events->deleteTimer(m_timer);
+    m_timer = nullptr;
+  }
+}
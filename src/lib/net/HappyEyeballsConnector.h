@@ -0,0 +1,109 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "base/Event.h"
+#include "net/NetworkAddress.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+class EventQueueTimer;
+class IDataSocket;
+class IEventQueue;
+
+//! Parallel connection to several addresses
+/*!
+Connects to the first reachable address of a host, in the manner of
+RFC 8305 ("happy eyeballs").  Attempts start one after another, each
+\c attemptDelay after the previous one or as soon as it fails, and run
+in parallel.  The first to connect wins and the rest are closed, so a
+stale or unreachable address only costs the delay instead of a whole
+connection timeout.
+
+Everything happens on the event thread.  The connector has no timeout
+of its own;  the owner should delete it to give up.
+*/
+class HappyEyeballsConnector
+{
+public:
+  //! Create an unconnected socket for an address, throws on failure
+  using SocketFactory = std::function<IDataSocket *(const NetworkAddress &)>;
+  //! Called with the connected socket, which the callee adopts, and its address
+  using ConnectedHandler = std::function<void(IDataSocket *, const NetworkAddress &)>;
+  //! Called with the last error when every attempt has failed
+  using FailedHandler = std::function<void(const std::string &)>;
+
+  //! Delay between starting attempts, in seconds (RFC 8305 recommends 250ms)
+  static constexpr double kAttemptDelay = 0.25;
+
+  /*!
+  An attempt has succeeded when its socket sends \p connectedEvent,
+  which should be \c DataSocketSecureConnected for secure sockets so the
+  race includes the TLS handshake.
+  */
+  HappyEyeballsConnector(
+      IEventQueue *events, SocketFactory factory, EventTypes connectedEvent = EventTypes::DataSocketConnected,
+      double attemptDelay = kAttemptDelay
+  );
+  HappyEyeballsConnector(HappyEyeballsConnector const &) = delete;
+  HappyEyeballsConnector(HappyEyeballsConnector &&) = delete;
+  ~HappyEyeballsConnector();
+
+  HappyEyeballsConnector &operator=(HappyEyeballsConnector const &) = delete;
+  HappyEyeballsConnector &operator=(HappyEyeballsConnector &&) = delete;
+
+  //! @name manipulators
+  //@{
+
+  //! Start connecting
+  /*!
+  Tries \p candidates in order, which should already be sorted with
+  \c interleave().  Exactly one of \p connected or \p failed is called
+  unless the connector is deleted first;  \p failed is called before
+  this returns if no attempt could even be started.  The connector may
+  be deleted from either callback.
+  */
+  void connect(std::vector<NetworkAddress> candidates, ConnectedHandler connected, FailedHandler failed);
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Order addresses for connecting
+  /*!
+  Returns \p addresses with the address families alternating, starting
+  with the family of the first address and otherwise keeping the order
+  of the resolver, so that a broken IPv6 or IPv4 path can't hold up all
+  of the first attempts.
+  */
+  static std::vector<NetworkAddress> interleave(const std::vector<NetworkAddress> &addresses);
+
+  //@}
+
+private:
+  void startAttempt();
+  void handleConnected(IDataSocket *socket, const NetworkAddress &address);
+  void handleFailed(IDataSocket *socket, const Event &event);
+  void closeAttempt(IDataSocket *socket);
+  void finish();
+  void cleanupTimer();
+
+  IEventQueue *m_events;
+  SocketFactory m_factory;
+  EventTypes m_connectedEvent;
+  double m_attemptDelay;
+
+  std::vector<NetworkAddress> m_candidates;
+  size_t m_next = 0;
+  std::vector<IDataSocket *> m_attempts;
+  EventQueueTimer *m_timer = nullptr;
+  std::string m_lastError;
+  ConnectedHandler m_connected;
+  FailedHandler m_failed;
+};
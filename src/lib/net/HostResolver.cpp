@@ -0,0 +1,131 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "net/HostResolver.h"
+
+#include "base/BaseException.h"
+#include "base/IEventQueue.h"
+#include "base/Log.h"
+
+namespace {
+
+std::string cacheKey(const NetworkAddress &address)
+{
+  return address.getHostname() + ":" + std::to_string(address.getPort());
+}
+
+} // namespace
+
+//
+// HostResolver
+//
+
+HostResolver::HostResolver(IEventQueue *events, Lookup lookup, std::chrono::steady_clock::duration cacheTime)
+    : m_events(events),
+      m_lookup(std::move(lookup)),
+      m_cacheTime(cacheTime)
+{
+  if (!m_lookup) {
+    m_lookup = [](const NetworkAddress &address) { return address.resolveAll(); };
+  }
+  m_thread = std::thread([this] { run(); }); // NOSONAR - No jthread on Windows
+}
+
+HostResolver::~HostResolver()
+{
+  {
+    std::scoped_lock lock{m_mutex};
+    m_stopping = true;
+  }
+  m_wake.notify_one();
+  m_thread.join();
+}
+
+uint64_t HostResolver::resolve(const NetworkAddress &address, void *target)
+{
+  const auto key = cacheKey(address);
+
+  std::scoped_lock lock{m_mutex};
+  const Request request{++m_nextId, target};
+
+  if (auto entry = m_cache.find(key); entry != m_cache.end()) {
+    if (Clock::now() < entry->second.m_expires) {
+      LOG_VERBOSE("using cached addresses for %s", key.c_str());
+      post(request, entry->second.m_addresses, {});
+      return request.m_id;
+    }
+    m_cache.erase(entry);
+  }
+
+  auto &waiters = m_waiters[key];
+  waiters.push_back(request);
+  if (waiters.size() == 1) {
+    m_queue.push_back(address);
+    m_wake.notify_one();
+  }
+  return request.m_id;
+}
+
+void HostResolver::clear()
+{
+  std::scoped_lock lock{m_mutex};
+  m_cache.clear();
+  ++m_generation;
+}
+
+void HostResolver::run()
+{
+  std::unique_lock lock{m_mutex};
+  for (;;) {
+    m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+    if (m_stopping) {
+      return;
+    }
+
+    const NetworkAddress address = m_queue.front();
+    m_queue.pop_front();
+    const auto generation = m_generation;
+
+    // look up without the lock so the event thread can keep queueing
+    lock.unlock();
+    std::vector<NetworkAddress> addresses;
+    std::string error;
+    try {
+      LOG_DEBUG("resolving %s", address.getHostname().c_str());
+      addresses = m_lookup(address);
+    } catch (BaseException &e) {
+      error = e.what();
+    }
+    if (addresses.empty() && error.empty()) {
+      error = "cannot resolve " + address.getHostname();
+    }
+    lock.lock();
+
+    const auto key = cacheKey(address);
+    if (!addresses.empty() && generation == m_generation) {
+      m_cache[key] = {addresses, Clock::now() + m_cacheTime};
+    }
+
+    auto waiters = m_waiters.extract(key);
+    if (m_stopping || waiters.empty()) {
+      continue;
+    }
+    for (const auto &request : waiters.mapped()) {
+      post(request, addresses, error);
+    }
+  }
+}
+
+void HostResolver::post(
+    const Request &request, const std::vector<NetworkAddress> &addresses, const std::string &error
+) const
+{
+  auto *result = new Result;
+  result->m_id = request.m_id;
+  result->m_addresses = addresses;
+  result->m_error = error;
+  m_events->addEvent(Event(EventTypes::HostResolved, request.m_target, result));
+}
@@ -0,0 +1,125 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "base/Event.h"
+#include "net/NetworkAddress.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class IEventQueue;
+
+//! Asynchronous host name resolver
+/*!
+Looks up host names on a background thread so the event thread never
+blocks in the system resolver, and delivers the addresses as a
+\c EventTypes::HostResolved event to the target given to \c resolve().
+Lookups run one at a time and the thread is joined on destruction.
+
+Successful lookups are cached for a fixed time.  The system resolver
+doesn't report record TTLs, so this is kept short;  the cache only has
+to spare the retries a reconnecting client makes.  Failures are never
+cached.  Requests for a name that is already being looked up share the
+one lookup.
+*/
+class HostResolver
+{
+public:
+  //! Blocking lookup used by the background thread
+  using Lookup = std::function<std::vector<NetworkAddress>(const NetworkAddress &)>;
+
+  //! Lookup result
+  class Result : public EventData
+  {
+  public:
+    //! Request id returned by \c resolve()
+    uint64_t m_id = 0;
+    //! Resolved addresses in resolver order, empty on failure
+    std::vector<NetworkAddress> m_addresses;
+    //! Reason the lookup failed
+    std::string m_error;
+  };
+
+  //! How long successful lookups are cached
+  static constexpr std::chrono::seconds kCacheTime{30};
+
+  /*!
+  Uses \c NetworkAddress::resolveAll() unless another \p lookup is given.
+  */
+  explicit HostResolver(
+      IEventQueue *events, Lookup lookup = {}, std::chrono::steady_clock::duration cacheTime = kCacheTime
+  );
+  HostResolver(HostResolver const &) = delete;
+  HostResolver(HostResolver &&) = delete;
+  ~HostResolver();
+
+  HostResolver &operator=(HostResolver const &) = delete;
+  HostResolver &operator=(HostResolver &&) = delete;
+
+  //! @name manipulators
+  //@{
+
+  //! Start a lookup
+  /*!
+  Resolves the hostname of \p address and sends the result, with the
+  port of \p address, to \p target.  A cached result is still sent as
+  an event rather than returned.  Returns an id that's copied into the
+  result so callers can disregard stale lookups.
+  */
+  uint64_t resolve(const NetworkAddress &address, void *target);
+
+  //! Forget cached results
+  /*!
+  Call this when the network may have changed, for example on resume.
+  Lookups already in progress still deliver their result but don't
+  refill the cache.
+  */
+  void clear();
+
+  //@}
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Request
+  {
+    uint64_t m_id;
+    void *m_target;
+  };
+
+  struct CacheEntry
+  {
+    std::vector<NetworkAddress> m_addresses;
+    Clock::time_point m_expires;
+  };
+
+  void run();
+  void post(const Request &request, const std::vector<NetworkAddress> &addresses, const std::string &error) const;
+
+  IEventQueue *m_events;
+  Lookup m_lookup;
+  Clock::duration m_cacheTime;
+
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  bool m_stopping = false;
+  uint64_t m_nextId = 0;
+  uint64_t m_generation = 0;
+  std::map<std::string, CacheEntry> m_cache;
+  std::map<std::string, std::vector<Request>> m_waiters;
+  std::deque<NetworkAddress> m_queue;
+  std::thread m_thread; // NOSONAR - No jthread on Windows
+};
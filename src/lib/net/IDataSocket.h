@@ -47,6 +47,17 @@ public:
   */
   virtual void connect(const NetworkAddress &) = 0;
 
+  //! Enable packet framing
+  /*!
+  Switch the stream to packets: every write is sent with a 4-byte big
+  endian length prefix, and reads only return data once the whole packet
+  has arrived, never reading past the end of it.  The prefix is parsed in
+  place on the input buffer.  A packet longer than \p maxPacketSize sends
+  a format error event, as does input shutting down part way through a
+  packet.  Passing 0 turns framing off.
+  */
+  virtual void setFramed(uint32_t maxPacketSize) = 0;
+
   //@}
 
   // ISocket overrides
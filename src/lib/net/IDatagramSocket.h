@@ -0,0 +1,70 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "net/ISocket.h"
+
+#include <cstdint>
+
+//! Datagram socket interface
+/*!
+This interface defines the methods common to all network sockets that
+send and receive unreliable datagrams.  Datagrams may be lost,
+duplicated or reordered and nothing here tries to hide that.
+
+The socket sends \c StreamInputReady when a datagram arrives, and then
+no more until \c receive() has returned 0, so the owner must read until
+nothing is left.
+*/
+class IDatagramSocket : public ISocket
+{
+public:
+  //! @name manipulators
+  //@{
+
+  //! Connect to a peer
+  /*!
+  Sends to \p address from now on and only receives from it.  This
+  doesn't exchange any packets so it never blocks.
+  */
+  virtual void connect(const NetworkAddress &address) = 0;
+
+  //! Connect to the last sender
+  /*!
+  Like \c connect() but for the sender of the datagram \c receive() last
+  returned, for sockets that learn their peer from its first datagram.
+  Does nothing if nothing was received yet.
+  */
+  virtual void connectToSender() = 0;
+
+  //! Send a datagram
+  /*!
+  Sends \p size bytes from \p data to the connected peer as one
+  datagram.  Returns false if it was dropped, which is not an error.
+  */
+  virtual bool send(const void *data, uint32_t size) = 0;
+
+  //! Receive a datagram
+  /*!
+  Copies the next datagram into \p buffer, truncated to \p size bytes,
+  and returns its size.  Returns 0 if nothing is queued.
+  */
+  virtual uint32_t receive(void *buffer, uint32_t size) = 0;
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Get local port
+  /*!
+  Returns the port the socket is bound to, which is the one the system
+  picked when bound to port 0, or 0 if not bound.
+  */
+  virtual int getPort() const = 0;
+
+  //@}
+};
@@ -12,6 +12,7 @@
 #include "net/SecurityLevel.h"
 
 class IDataSocket;
+class IDatagramSocket;
 class IListenSocket;
 
 //! Socket factory
@@ -38,5 +39,10 @@ public:
       SecurityLevel securityLevel = SecurityLevel::PlainText
   ) const = 0;
 
+  //! Create datagram socket
+  virtual IDatagramSocket *createDatagram(
+      IArchNetwork::AddressFamily family = IArchNetwork::AddressFamily::INet
+  ) const = 0;
+
   //@}
 };
@@ -112,47 +112,46 @@ NetworkAddress &NetworkAddress::operator=(const NetworkAddress &addr)
   return *this;
 }
 
+NetworkAddress::NetworkAddress(const NetworkAddress &host, ArchNetAddress adopted)
+    : m_address(adopted),
+      m_hostname(host.m_hostname),
+      m_port(host.m_port)
+{
+  ARCH->setAddrPort(m_address, m_port);
+}
+
 size_t NetworkAddress::resolve(size_t index)
 {
-  size_t resolvedAddressesCount = 0;
   // discard previous address
   if (m_address != nullptr) {
     ARCH->closeAddr(m_address);
     m_address = nullptr;
   }
 
+  const auto addresses = resolveAll();
+  const auto &address = addresses[std::min(index, addresses.size() - 1)];
+  m_address = ARCH->copyAddr(address.m_address);
+  return addresses.size();
+}
+
+std::vector<NetworkAddress> NetworkAddress::resolveAll() const
+{
+  std::vector<NetworkAddress> resolved;
   try {
     if (m_hostname.empty()) {
-      m_address = ARCH->newAnyAddr(IArchNetwork::AddressFamily::INet);
-      resolvedAddressesCount = 1;
+      resolved.push_back(NetworkAddress(*this, ARCH->newAnyAddr(IArchNetwork::AddressFamily::INet)));
     } else {
-      std::vector<ArchNetAddress> ipAddresses;
-      {
-        auto addresses = ARCH->nameToAddr(m_hostname);
-        for (auto address : addresses) {
-          if (ARCH->getAddrFamily(address) != IArchNetwork::AddressFamily::Unknown) {
-            ipAddresses.emplace_back(address);
-          } else {
-            ARCH->closeAddr(address);
-          }
+      for (auto address : ARCH->nameToAddr(m_hostname)) {
+        if (ARCH->getAddrFamily(address) != IArchNetwork::AddressFamily::Unknown) {
+          resolved.push_back(NetworkAddress(*this, address));
+        } else {
+          ARCH->closeAddr(address);
         }
       }
 
-      resolvedAddressesCount = ipAddresses.size();
-      if (resolvedAddressesCount <= 0) {
+      if (resolved.empty()) {
         throw ArchNetworkNameUnknownException("Hostname lookup failed");
       }
-      if (index < resolvedAddressesCount - 1) {
-        m_address = ipAddresses[index];
-      } else {
-        m_address = ipAddresses[resolvedAddressesCount - 1];
-      }
-
-      for (auto address : ipAddresses) {
-        if (m_address != address) {
-          ARCH->closeAddr(address);
-        }
-      }
     }
   } catch (ArchNetworkNameUnknownException &) {
     throw SocketAddressException(SocketAddressException::SocketError::NotFound, m_hostname, m_port);
@@ -164,10 +163,7 @@ size_t NetworkAddress::resolve(size_t index)
     throw SocketAddressException(SocketAddressException::SocketError::Unknown, m_hostname, m_port);
   }
 
-  // set port in address
-  ARCH->setAddrPort(m_address, m_port);
-
-  return resolvedAddressesCount;
+  return resolved;
 }
 
 bool NetworkAddress::operator==(const NetworkAddress &addr) const
@@ -9,6 +9,8 @@
 
 #include "arch/IArchNetwork.h"
 
+#include <vector>
+
 //! Network address type
 /*!
 This class represents a network address.
@@ -63,6 +65,15 @@ public:
   //! @name accessors
   //@{
 
+  //! Resolve all addresses
+  /*!
+  Resolves the hostname and returns one address for each usable result,
+  in the order the system resolver returned them, each with this port.
+  This address is not changed.  Throws SocketAddressException like
+  \c resolve.  This blocks for as long as the lookup takes.
+  */
+  std::vector<NetworkAddress> resolveAll() const;
+
   //! Check address equality
   /*!
   Returns true if this address is equal to \p address.
@@ -98,6 +109,8 @@ public:
   //@}
 
 private:
+  NetworkAddress(const NetworkAddress &host, ArchNetAddress adopted);
+
   void checkPort() const;
 
 private:
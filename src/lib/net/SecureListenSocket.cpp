@@ -10,7 +10,7 @@
 #include "SecureSocket.h"
 #include "arch/Arch.h"
 #include "arch/ArchException.h"
-#include "common/Settings.h"
+#include "common/SettingsSnapshot.h"
 #include "net/SocketMultiplexer.h"
 
 //
@@ -19,9 +19,9 @@
 
 SecureListenSocket::SecureListenSocket(
     IEventQueue *events, SocketMultiplexer *socketMultiplexer, IArchNetwork::AddressFamily family,
-    SecurityLevel securityLevel
+    SecurityLevel securityLevel, SocketMultiplexerPool *acceptPool
 )
-    : TCPListenSocket(events, socketMultiplexer, family),
+    : TCPListenSocket(events, socketMultiplexer, family, acceptPool),
       m_securityLevel{securityLevel}
 
 {
@@ -33,14 +33,14 @@ std::unique_ptr<IDataSocket> SecureListenSocket::accept()
   std::unique_ptr<SecureSocket> secureSocket;
   try {
     secureSocket = std::make_unique<SecureSocket>(
-        events(), socketMultiplexer(), ARCH->acceptSocket(socket(), nullptr), m_securityLevel
+        events(), acceptMultiplexer(), ARCH->acceptSocket(socket(), nullptr), m_securityLevel
     );
     secureSocket->initSsl(true);
 
     setListeningJob();
 
     // default location of the TLS cert file in users dir
-    if (!secureSocket->loadCertificate(Settings::value(Settings::Security::Certificate).toString())) {
+    if (!secureSocket->loadCertificate(SettingsSnapshot::current()->security.certificate)) {
       return nullptr;
     }
 
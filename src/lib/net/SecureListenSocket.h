@@ -12,6 +12,7 @@
 
 class IEventQueue;
 class SocketMultiplexer;
+class SocketMultiplexerPool;
 class IDataSocket;
 
 class SecureListenSocket : public TCPListenSocket
@@ -19,7 +20,7 @@ class SecureListenSocket : public TCPListenSocket
 public:
   SecureListenSocket(
       IEventQueue *events, SocketMultiplexer *socketMultiplexer, IArchNetwork::AddressFamily family,
-      SecurityLevel securityLevel = SecurityLevel::PlainText
+      SecurityLevel securityLevel = SecurityLevel::PlainText, SocketMultiplexerPool *acceptPool = nullptr
   );
 
   // IListenSocket overrides
@@ -12,6 +12,7 @@
 #include "base/IEventQueue.h"
 #include "base/Log.h"
 #include "common/Settings.h"
+#include "common/SettingsSnapshot.h"
 #include "deskflow/ipc/CoreIpc.h"
 #include "mt/Lock.h"
 #include "net/FingerprintDatabase.h"
@@ -29,8 +30,6 @@
 //
 // SecureSocket
 //
-static const std::size_t s_maxInputBufferSize = 1024 * 1024;
-
 static const float s_retryDelay = 0.01f;
 
 struct Ssl
@@ -136,13 +135,11 @@ TCPSocket::JobResult SecureSocket::doRead()
   }
 
   if (bytesRead > 0) {
-    bool wasEmpty = (m_inputBuffer.getSize() == 0);
+    bool wasReady = isInputReady();
 
     // slurp up as much as possible
     do {
-      m_inputBuffer.write(buffer, bytesRead);
-
-      if (m_inputBuffer.getSize() > s_maxInputBufferSize) {
+      if (!bufferInput(buffer, bytesRead)) {
         break;
       }
 
@@ -152,15 +149,15 @@ TCPSocket::JobResult SecureSocket::doRead()
       }
     } while (bytesRead > 0 || status > 0);
 
-    // send input ready if input buffer was empty
-    if (wasEmpty) {
+    // send input ready if there was nothing to read before
+    if (!wasReady && isInputReady()) {
       sendEvent(EventTypes::StreamInputReady);
     }
   } else {
     // remote write end of stream hungup.  our input side
     // has therefore shutdown but don't flush our buffer
     // since there's still data to be read.
-    sendEvent(EventTypes::StreamInputShutdown);
+    sendInputShutdown();
     if (!isWritable() && m_inputBuffer.getSize() == 0) {
       sendEvent(EventTypes::SocketDisconnected);
       setConnected(false);
@@ -176,6 +173,11 @@ TCPSocket::JobResult SecureSocket::doWrite()
 {
   using enum JobResult;
 
+  if (m_kernelSend) {
+    // the kernel encrypts, so write straight from the output buffer
+    return TCPSocket::doWrite();
+  }
+
   // write data
   int bufferSize = 0;
   int bytesWrote = 0;
@@ -360,6 +362,12 @@ void SecureSocket::initContext(bool server)
     SslLogger::logError();
   }
 
+  if (SettingsSnapshot::current()->security.kernelTls) {
+    // OpenSSL silently keeps the user space record layer if the kernel or
+    // the negotiated cipher doesn't support offload
+    SSL_CTX_set_options(m_ssl->m_context, SSL_OP_ENABLE_KTLS);
+  }
+
   if (m_securityLevel == SecurityLevel::PeerAuth) {
     // We want to ask for peer certificate, but not verify it. If we don't ask for peer
     // certificate, e.g. client won't send it.
@@ -383,6 +391,7 @@ void SecureSocket::freeSSL()
   std::scoped_lock ssl_lock{ssl_mutex_};
 
   isFatal(true);
+  m_kernelSend = false;
   // take socket from multiplexer ASAP otherwise the race condition
   // could cause events to get called on a dead object. TCPSocket
   // will do this, too, but the double-call is harmless
@@ -439,6 +448,7 @@ int SecureSocket::secureAccept(int socket)
     LOG_INFO("accepted secure socket");
     SslLogger::logSecureCipherInfo(m_ssl->m_ssl);
     SslLogger::logSecureConnectInfo(m_ssl->m_ssl);
+    checkKernelTls();
     return 1;
   }
 
@@ -456,7 +466,7 @@ int SecureSocket::secureAccept(int socket)
 
 int SecureSocket::secureConnect(int socket)
 {
-  if (!loadCertificate(Settings::value(Settings::Security::Certificate).toString())) {
+  if (!loadCertificate(SettingsSnapshot::current()->security.certificate)) {
     LOG_ERR("could not load client certificates");
     disconnect();
     return -1;
@@ -507,6 +517,7 @@ int SecureSocket::secureConnect(int socket)
   LOG_VERBOSE("connected secure socket");
   SslLogger::logSecureCipherInfo(m_ssl->m_ssl);
   SslLogger::logSecureConnectInfo(m_ssl->m_ssl);
+  checkKernelTls();
   return 1;
 }
 
@@ -530,6 +541,21 @@ bool SecureSocket::showCertificate() const
   return true;
 }
 
+void SecureSocket::checkKernelTls()
+{
+  // SSL_read still handles the receive side, since only OpenSSL knows what
+  // to do with post-handshake records such as session tickets, but with
+  // kernel offload it no longer decrypts in user space
+  m_kernelSend = BIO_get_ktls_send(SSL_get_wbio(m_ssl->m_ssl));
+  const bool kernelRecv = BIO_get_ktls_recv(SSL_get_rbio(m_ssl->m_ssl));
+
+  if (m_kernelSend || kernelRecv) {
+    LOG_DEBUG("kernel tls offload, send=%d receive=%d", m_kernelSend, kernelRecv);
+  } else if (SettingsSnapshot::current()->security.kernelTls) {
+    LOG_DEBUG("kernel tls offload not available, using openssl");
+  }
+}
+
 void SecureSocket::checkResult(int status, int &retry)
 {
   // ssl errors are a little quirky. the "want" errors are normal and
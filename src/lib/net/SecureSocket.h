@@ -24,6 +24,11 @@ struct Ssl;
 //! Secure socket
 /*!
 A secure socket using SSL.
+
+When the \c security/kernelTls setting is on and both OpenSSL and the kernel
+support it, the record layer is handed to the kernel (kTLS) after the
+handshake. Outgoing data then takes the plain TCPSocket write path and
+incoming records are decrypted by the kernel rather than in user space.
 */
 class SecureSocket : public TCPSocket
 {
@@ -76,6 +81,7 @@ private:
   int secureAccept(int s);
   int secureConnect(int s);
   bool showCertificate() const;
+  void checkKernelTls();
   void checkResult(int n, int &retry);
   void disconnect();
   bool verifyCertFingerprint(const QString &FingerprintDatabasePath) const;
@@ -95,6 +101,10 @@ private:
   std::unique_ptr<Ssl> m_ssl;
   bool m_secureReady = false;
   bool m_fatal = false;
+
+  // set once OpenSSL has installed the send keys in the kernel, so plain
+  // writes on the socket are encrypted without going through SSL_write
+  bool m_kernelSend = false;
   SecurityLevel m_securityLevel = SecurityLevel::Encrypted;
 
   bool m_writeRetry = false;
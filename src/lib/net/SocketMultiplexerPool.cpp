@@ -0,0 +1,52 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "net/SocketMultiplexerPool.h"
+
+#include "net/SocketMultiplexer.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace {
+
+// the event queue thread is busy with the same traffic, so the pool
+// only gets part of the machine
+const size_t kMaxAutoSize = 4;
+
+} // namespace
+
+//
+// SocketMultiplexerPool
+//
+
+SocketMultiplexerPool::SocketMultiplexerPool(size_t size)
+{
+  m_multiplexers.resize(std::max<size_t>(size, 1));
+  for (auto &multiplexer : m_multiplexers) {
+    multiplexer = std::make_unique<SocketMultiplexer>();
+  }
+}
+
+SocketMultiplexerPool::~SocketMultiplexerPool() = default;
+
+SocketMultiplexer *SocketMultiplexerPool::next()
+{
+  return m_multiplexers[m_next.fetch_add(1, std::memory_order_relaxed) % m_multiplexers.size()].get();
+}
+
+size_t SocketMultiplexerPool::size() const
+{
+  return m_multiplexers.size();
+}
+
+size_t SocketMultiplexerPool::sizeFor(int requested)
+{
+  if (requested > 0) {
+    return static_cast<size_t>(requested);
+  }
+  return std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, kMaxAutoSize);
+}
@@ -0,0 +1,60 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class SocketMultiplexer;
+
+//! Pool of socket multiplexers
+/*!
+Owns a number of socket multiplexers, each with its own service thread,
+and hands them out in turn.  Accepted sockets are spread over the pool
+so reading, writing and TLS for one busy or slow peer don't hold up
+the others.  Every socket still reports to the one event queue, where
+protocol messages are decoded and encoded.
+*/
+class SocketMultiplexerPool
+{
+public:
+  //! Create a pool of \c size multiplexers, at least one
+  explicit SocketMultiplexerPool(size_t size);
+  SocketMultiplexerPool(SocketMultiplexerPool const &) = delete;
+  SocketMultiplexerPool(SocketMultiplexerPool &&) = delete;
+  ~SocketMultiplexerPool();
+
+  SocketMultiplexerPool &operator=(SocketMultiplexerPool const &) = delete;
+  SocketMultiplexerPool &operator=(SocketMultiplexerPool &&) = delete;
+
+  //! @name manipulators
+  //@{
+
+  //! Get the next multiplexer, round robin
+  SocketMultiplexer *next();
+
+  //@}
+  //! @name accessors
+  //@{
+
+  //! Get the number of multiplexers
+  size_t size() const;
+
+  //! Get a pool size for this machine
+  /*!
+  Returns \c requested if it is positive, otherwise a size picked from
+  the number of cores.
+  */
+  static size_t sizeFor(int requested);
+
+  //@}
+
+private:
+  std::vector<std::unique_ptr<SocketMultiplexer>> m_multiplexers;
+  std::atomic<size_t> m_next = 0;
+};
@@ -15,6 +15,7 @@
 #include "net/NetworkAddress.h"
 #include "net/SocketException.h"
 #include "net/SocketMultiplexer.h"
+#include "net/SocketMultiplexerPool.h"
 #include "net/TCPSocket.h"
 #include "net/TSocketMultiplexerMethodJob.h"
 
@@ -23,10 +24,12 @@
 //
 
 TCPListenSocket::TCPListenSocket(
-    IEventQueue *events, SocketMultiplexer *socketMultiplexer, IArchNetwork::AddressFamily family
+    IEventQueue *events, SocketMultiplexer *socketMultiplexer, IArchNetwork::AddressFamily family,
+    SocketMultiplexerPool *acceptPool
 )
     : m_events(events),
-      m_socketMultiplexer(socketMultiplexer)
+      m_socketMultiplexer(socketMultiplexer),
+      m_acceptPool(acceptPool)
 {
   try {
     m_socket = ARCH->newSocket(family, IArchNetwork::SocketType::Stream);
@@ -99,7 +102,7 @@ std::unique_ptr<IDataSocket> TCPListenSocket::accept()
 {
   std::unique_ptr<IDataSocket> socket;
   try {
-    socket = std::make_unique<TCPSocket>(m_events, m_socketMultiplexer, ARCH->acceptSocket(m_socket, nullptr));
+    socket = std::make_unique<TCPSocket>(m_events, acceptMultiplexer(), ARCH->acceptSocket(m_socket, nullptr));
     setListeningJob();
     return socket;
   } catch (ArchNetworkException &) {
@@ -115,6 +118,11 @@ std::unique_ptr<IDataSocket> TCPListenSocket::accept()
   }
 }
 
+SocketMultiplexer *TCPListenSocket::acceptMultiplexer() const
+{
+  return m_acceptPool != nullptr ? m_acceptPool->next() : m_socketMultiplexer;
+}
+
 void TCPListenSocket::setListeningJob()
 {
   m_socketMultiplexer->addSocket(
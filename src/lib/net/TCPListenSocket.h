@@ -15,15 +15,20 @@
 class ISocketMultiplexerJob;
 class IEventQueue;
 class SocketMultiplexer;
+class SocketMultiplexerPool;
 
 //! TCP listen socket
 /*!
-A listen socket using TCP.
+A listen socket using TCP.  Accepted sockets are serviced by the
+listen socket's multiplexer, or spread over \c acceptPool if given.
 */
 class TCPListenSocket : public IListenSocket
 {
 public:
-  TCPListenSocket(IEventQueue *events, SocketMultiplexer *socketMultiplexer, IArchNetwork::AddressFamily family);
+  TCPListenSocket(
+      IEventQueue *events, SocketMultiplexer *socketMultiplexer, IArchNetwork::AddressFamily family,
+      SocketMultiplexerPool *acceptPool = nullptr
+  );
   TCPListenSocket(TCPListenSocket const &) = delete;
   TCPListenSocket(TCPListenSocket &&) = delete;
   ~TCPListenSocket() override;
@@ -59,9 +64,13 @@ protected:
     return m_socketMultiplexer;
   }
 
+  //! Get the multiplexer for the next accepted socket
+  SocketMultiplexer *acceptMultiplexer() const;
+
 private:
   ArchSocket m_socket;
   IEventQueue *m_events;
   SocketMultiplexer *m_socketMultiplexer;
+  SocketMultiplexerPool *m_acceptPool;
   std::mutex m_mutex;
 };
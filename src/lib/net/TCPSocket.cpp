@@ -17,6 +17,7 @@
 #include "net/SocketMultiplexer.h"
 #include "net/TSocketMultiplexerMethodJob.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 
@@ -116,19 +117,33 @@ void *TCPSocket::getEventTarget() const
 
 uint32_t TCPSocket::read(void *buffer, uint32_t n)
 {
+  using enum EventTypes;
+
   // copy data directly from our input buffer
   Lock lock(&m_mutex);
-  if (uint32_t size = m_inputBuffer.getSize(); n > size) {
-    n = size;
+  if (m_maxPacketSize != 0) {
+    // nothing until the whole packet is here, and never past its end
+    if (!isInputReady()) {
+      return 0;
+    }
+    n = std::min(n, m_packetSize);
   }
-  if (buffer != nullptr && n != 0) {
-    memcpy(buffer, m_inputBuffer.peek(n), n);
+  n = m_inputBuffer.read(buffer, n);
+
+  if (m_maxPacketSize != 0) {
+    m_packetSize -= n;
+    readPacketSize();
+
+    // report the input shutdown held back until the last packet was read
+    if (m_inputShutdownPending && !isInputReady()) {
+      m_inputShutdownPending = false;
+      sendInputShutdown();
+    }
   }
-  m_inputBuffer.pop(n);
 
   // if no more data and we cannot read or write then send disconnected
   if (n > 0 && m_inputBuffer.getSize() == 0 && !m_readable && !m_writable) {
-    sendEvent(EventTypes::SocketDisconnected);
+    sendEvent(SocketDisconnected);
     m_connected = false;
   }
 
@@ -147,13 +162,19 @@ void TCPSocket::write(const void *buffer, uint32_t n)
       return;
     }
 
-    // ignore empty writes
-    if (n == 0) {
+    // ignore empty writes, unless they're empty packets
+    if (n == 0 && m_maxPacketSize == 0) {
       return;
     }
 
     // copy data to the output buffer
     wasEmpty = (m_outputBuffer.getSize() == 0);
+    if (m_maxPacketSize != 0) {
+      const uint8_t length[4] = {
+          (uint8_t)((n >> 24) & 0xff), (uint8_t)((n >> 16) & 0xff), (uint8_t)((n >> 8) & 0xff), (uint8_t)(n & 0xff)
+      };
+      m_outputBuffer.write(length, sizeof(length));
+    }
     m_outputBuffer.write(buffer, n);
 
     // there's data to write
@@ -229,7 +250,7 @@ void TCPSocket::shutdownOutput()
 bool TCPSocket::isReady() const
 {
   Lock lock(&m_mutex);
-  return (m_inputBuffer.getSize() > 0);
+  return isInputReady();
 }
 
 bool TCPSocket::isFatal() const
@@ -242,6 +263,9 @@ bool TCPSocket::isFatal() const
 uint32_t TCPSocket::getSize() const
 {
   Lock lock(&m_mutex);
+  if (m_maxPacketSize != 0) {
+    return isInputReady() ? m_packetSize : 0;
+  }
   return m_inputBuffer.getSize();
 }
 
@@ -271,6 +295,17 @@ void TCPSocket::connect(const NetworkAddress &addr)
   setJob(newJob());
 }
 
+void TCPSocket::setFramed(uint32_t maxPacketSize)
+{
+  Lock lock(&m_mutex);
+  m_maxPacketSize = maxPacketSize;
+  m_packetSize = 0;
+  m_inputShutdownPending = false;
+
+  // anything already buffered starts on a packet boundary
+  readPacketSize();
+}
+
 void TCPSocket::init()
 {
   // default state
@@ -307,28 +342,26 @@ TCPSocket::JobResult TCPSocket::doRead()
   bytesRead = ARCH->readSocket(m_socket, buffer, sizeof(buffer));
 
   if (bytesRead > 0) {
-    bool wasEmpty = (m_inputBuffer.getSize() == 0);
+    bool wasReady = isInputReady();
 
     // slurp up as much as possible
     do {
-      m_inputBuffer.write(buffer, static_cast<uint32_t>(bytesRead));
-
-      if (m_inputBuffer.getSize() > s_maxInputBufferSize) {
+      if (!bufferInput(buffer, static_cast<uint32_t>(bytesRead))) {
         break;
       }
 
       bytesRead = ARCH->readSocket(m_socket, buffer, sizeof(buffer));
     } while (bytesRead > 0);
 
-    // send input ready if input buffer was empty
-    if (wasEmpty) {
+    // send input ready if there was nothing to read before
+    if (!wasReady && isInputReady()) {
       sendEvent(EventTypes::StreamInputReady);
     }
   } else {
     // remote write end of stream hungup.  our input side
     // has therefore shutdown but don't flush our buffer
     // since there's still data to be read.
-    sendEvent(EventTypes::StreamInputShutdown);
+    sendInputShutdown();
     if (!m_writable && m_inputBuffer.getSize() == 0) {
       sendEvent(EventTypes::SocketDisconnected);
       m_connected = false;
@@ -405,6 +438,25 @@ void TCPSocket::sendEvent(EventTypes type)
   m_events->addEvent(Event(type, getEventTarget()));
 }
 
+void TCPSocket::sendInputShutdown()
+{
+  // note -- m_mutex must be locked on entry
+
+  if (m_maxPacketSize != 0 && m_inputBuffer.getSize() != 0) {
+    if (isInputReady()) {
+      // whole packets are still buffered, report it once they're read
+      m_inputShutdownPending = true;
+      return;
+    }
+
+    // the rest of the packet will never arrive
+    sendEvent(EventTypes::StreamInputFormatError);
+    m_inputBuffer.pop(m_inputBuffer.getSize());
+    m_packetSize = 0;
+  }
+  sendEvent(EventTypes::StreamInputShutdown);
+}
+
 void TCPSocket::discardWrittenData(int bytesWrote)
 {
   m_outputBuffer.pop(bytesWrote);
@@ -415,6 +467,52 @@ void TCPSocket::discardWrittenData(int bytesWrote)
   }
 }
 
+bool TCPSocket::bufferInput(const void *data, uint32_t n)
+{
+  // note -- m_mutex must be locked on entry
+
+  m_inputBuffer.write(data, n);
+
+  // parse lengths as they arrive rather than waiting for the whole packet,
+  // which may be huge in case of a malicious or erroneous peer
+  if (!readPacketSize()) {
+    return false;
+  }
+  return m_inputBuffer.getSize() <= s_maxInputBufferSize;
+}
+
+bool TCPSocket::isInputReady() const
+{
+  // note -- m_mutex must be locked on entry
+
+  if (m_maxPacketSize == 0) {
+    return m_inputBuffer.getSize() > 0;
+  }
+  return m_packetSize != 0 && m_packetSize <= m_maxPacketSize && m_inputBuffer.getSize() >= m_packetSize;
+}
+
+bool TCPSocket::readPacketSize()
+{
+  // note -- m_mutex must be locked on entry
+
+  if (m_maxPacketSize == 0) {
+    return true;
+  }
+
+  // skips over empty packets too
+  while (m_packetSize == 0 && m_inputBuffer.getSize() >= 4) {
+    uint8_t length[4];
+    m_inputBuffer.read(length, sizeof(length));
+    m_packetSize =
+        ((uint32_t)length[0] << 24) | ((uint32_t)length[1] << 16) | ((uint32_t)length[2] << 8) | (uint32_t)length[3];
+    if (m_packetSize > m_maxPacketSize) {
+      sendEvent(EventTypes::StreamInputFormatError);
+      return false;
+    }
+  }
+  return m_packetSize <= m_maxPacketSize;
+}
+
 void TCPSocket::onConnected()
 {
   m_connected = true;
@@ -425,6 +523,8 @@ void TCPSocket::onConnected()
 void TCPSocket::onInputShutdown()
 {
   m_inputBuffer.pop(m_inputBuffer.getSize());
+  m_packetSize = 0;
+  m_inputShutdownPending = false;
   m_readable = false;
 }
 
@@ -56,6 +56,7 @@ public:
 
   // IDataSocket overrides
   void connect(const NetworkAddress &) override;
+  void setFramed(uint32_t maxPacketSize) override;
 
   virtual ISocketMultiplexerJob *newJob();
 
@@ -122,7 +123,10 @@ protected:
   }
 
   void sendEvent(EventTypes);
+  void sendInputShutdown();
   void discardWrittenData(int bytesWrote);
+  bool bufferInput(const void *data, uint32_t n);
+  bool isInputReady() const;
 
   StreamBuffer m_inputBuffer;
   StreamBuffer m_outputBuffer;
@@ -135,6 +139,7 @@ private:
   void onInputShutdown();
   void onOutputShutdown();
   void onDisconnected();
+  bool readPacketSize();
 
   ISocketMultiplexerJob *serviceConnecting(ISocketMultiplexerJob *, bool, bool, bool);
   ISocketMultiplexerJob *serviceConnected(ISocketMultiplexerJob *, bool, bool, bool);
@@ -147,4 +152,10 @@ private:
   IEventQueue *m_events;
   CondVar<bool> m_flushed;
   SocketMultiplexer *m_socketMultiplexer;
+
+  // packet framing, off while m_maxPacketSize is 0.  m_packetSize is what's
+  // left of the current packet, or 0 if its length hasn't arrived yet.
+  uint32_t m_maxPacketSize = 0;
+  uint32_t m_packetSize = 0;
+  bool m_inputShutdownPending = false;
 };
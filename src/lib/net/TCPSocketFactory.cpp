@@ -11,14 +11,18 @@
 #include "net/SecureSocket.h"
 #include "net/TCPListenSocket.h"
 #include "net/TCPSocket.h"
+#include "net/UDPSocket.h"
 
 //
 // TCPSocketFactory
 //
 
-TCPSocketFactory::TCPSocketFactory(IEventQueue *events, SocketMultiplexer *socketMultiplexer)
+TCPSocketFactory::TCPSocketFactory(
+    IEventQueue *events, SocketMultiplexer *socketMultiplexer, SocketMultiplexerPool *acceptPool
+)
     : m_events(events),
-      m_socketMultiplexer(socketMultiplexer)
+      m_socketMultiplexer(socketMultiplexer),
+      m_acceptPool(acceptPool)
 {
   // do nothing
 }
@@ -38,10 +42,15 @@ IListenSocket *TCPSocketFactory::createListen(IArchNetwork::AddressFamily family
 {
   IListenSocket *socket = nullptr;
   if (securityLevel != SecurityLevel::PlainText) {
-    socket = new SecureListenSocket(m_events, m_socketMultiplexer, family, securityLevel);
+    socket = new SecureListenSocket(m_events, m_socketMultiplexer, family, securityLevel, m_acceptPool);
   } else {
-    socket = new TCPListenSocket(m_events, m_socketMultiplexer, family);
+    socket = new TCPListenSocket(m_events, m_socketMultiplexer, family, m_acceptPool);
   }
 
   return socket;
 }
+
+IDatagramSocket *TCPSocketFactory::createDatagram(IArchNetwork::AddressFamily family) const
+{
+  return new UDPSocket(m_events, m_socketMultiplexer, family);
+}
@@ -13,12 +13,20 @@
 
 class IEventQueue;
 class SocketMultiplexer;
+class SocketMultiplexerPool;
 
 //! Socket factory for TCP sockets
+/*!
+Also creates the UDP sockets that go alongside them.  Sockets accepted
+by listen sockets from this factory are spread over \c acceptPool if
+given, otherwise they share \c socketMultiplexer.
+*/
 class TCPSocketFactory : public ISocketFactory
 {
 public:
-  TCPSocketFactory(IEventQueue *events, SocketMultiplexer *socketMultiplexer);
+  TCPSocketFactory(
+      IEventQueue *events, SocketMultiplexer *socketMultiplexer, SocketMultiplexerPool *acceptPool = nullptr
+  );
   ~TCPSocketFactory() override = default;
 
   // ISocketFactory overrides
@@ -30,8 +38,12 @@ public:
       IArchNetwork::AddressFamily family = IArchNetwork::AddressFamily::INet,
       SecurityLevel securityLevel = SecurityLevel::PlainText
   ) const override;
+  IDatagramSocket *createDatagram(
+      IArchNetwork::AddressFamily family = IArchNetwork::AddressFamily::INet
+  ) const override;
 
 private:
   IEventQueue *m_events;
   SocketMultiplexer *m_socketMultiplexer;
+  SocketMultiplexerPool *m_acceptPool;
 };
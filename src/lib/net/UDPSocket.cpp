@@ -0,0 +1,194 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "net/UDPSocket.h"
+
+#include "arch/Arch.h"
+#include "arch/ArchException.h"
+#include "base/IEventQueue.h"
+#include "base/Log.h"
+#include "io/IOException.h"
+#include "net/NetworkAddress.h"
+#include "net/SocketException.h"
+#include "net/SocketMultiplexer.h"
+#include "net/TSocketMultiplexerMethodJob.h"
+
+//
+// UDPSocket
+//
+
+UDPSocket::UDPSocket(IEventQueue *events, SocketMultiplexer *socketMultiplexer, IArchNetwork::AddressFamily family)
+    : m_events(events),
+      m_socketMultiplexer(socketMultiplexer)
+{
+  try {
+    m_socket = ARCH->newSocket(family, IArchNetwork::SocketType::DataGram);
+  } catch (ArchNetworkException &e) {
+    throw SocketCreateException(e.what());
+  }
+}
+
+UDPSocket::~UDPSocket()
+{
+  try {
+    if (m_socket != nullptr) {
+      m_socketMultiplexer->removeSocket(this);
+      ARCH->closeSocket(m_socket);
+    }
+  } catch (...) {
+    // ignore
+    LOG_WARN("error while closing UDP socket");
+  }
+  if (m_sender != nullptr) {
+    ARCH->closeAddr(m_sender);
+  }
+}
+
+void UDPSocket::bind(const NetworkAddress &addr)
+{
+  LOG_DEBUG("binding datagram socket to address: %s:%d", addr.getHostname().c_str(), addr.getPort());
+  try {
+    std::scoped_lock lock{m_mutex};
+    ARCH->bindSocket(m_socket, addr.getAddress());
+    setReadingJob();
+  } catch (ArchNetworkAddressInUseException &e) {
+    throw SocketAddressInUseException(e.what());
+  } catch (ArchNetworkException &e) {
+    throw SocketBindException(e.what());
+  }
+}
+
+void UDPSocket::close()
+{
+  std::scoped_lock lock{m_mutex};
+  if (m_socket == nullptr) {
+    throw IOClosedException();
+  }
+  try {
+    m_socketMultiplexer->removeSocket(this);
+    ARCH->closeSocket(m_socket);
+    m_socket = nullptr;
+  } catch (ArchNetworkException &e) {
+    throw SocketIOCloseException(e.what());
+  }
+}
+
+void *UDPSocket::getEventTarget() const
+{
+  return const_cast<void *>(static_cast<const void *>(this));
+}
+
+void UDPSocket::connect(const NetworkAddress &addr)
+{
+  try {
+    std::scoped_lock lock{m_mutex};
+    // a datagram socket connects at once, binding to any port if not bound
+    ARCH->connectSocket(m_socket, addr.getAddress());
+    setReadingJob();
+  } catch (ArchNetworkException &e) {
+    throw SocketConnectException(e.what());
+  }
+}
+
+void UDPSocket::connectToSender()
+{
+  std::scoped_lock lock{m_mutex};
+  if (m_sender == nullptr) {
+    return;
+  }
+  try {
+    ARCH->connectSocket(m_socket, m_sender);
+  } catch (ArchNetworkException &e) {
+    throw SocketConnectException(e.what());
+  }
+}
+
+bool UDPSocket::send(const void *data, uint32_t size)
+{
+  std::scoped_lock lock{m_mutex};
+  if (m_socket == nullptr) {
+    return false;
+  }
+  try {
+    return ARCH->writeSocket(m_socket, data, size) == size;
+  } catch (ArchNetworkException &e) {
+    // usually the error from an earlier datagram the peer refused
+    LOG_DEBUG("datagram not sent: %s", e.what());
+    return false;
+  }
+}
+
+uint32_t UDPSocket::receive(void *buffer, uint32_t size)
+{
+  std::scoped_lock lock{m_mutex};
+  if (m_socket == nullptr) {
+    return 0;
+  }
+
+  for (;;) {
+    ArchNetAddress sender = nullptr;
+    size_t n = 0;
+    try {
+      n = ARCH->readFromSocket(m_socket, buffer, size, &sender);
+    } catch (ArchNetworkException &e) {
+      // errors reported for something sent earlier are cleared by reading
+      // them, so poll again for anything that is still queued
+      LOG_DEBUG("datagram not received: %s", e.what());
+      setReadingJob();
+      return 0;
+    }
+
+    if (sender == nullptr) {
+      // drained, wait for the next one
+      setReadingJob();
+      return 0;
+    }
+
+    if (m_sender != nullptr) {
+      ARCH->closeAddr(m_sender);
+    }
+    m_sender = sender;
+
+    // an empty datagram can't be told apart from none, so skip it
+    if (n != 0) {
+      return static_cast<uint32_t>(n);
+    }
+  }
+}
+
+int UDPSocket::getPort() const
+{
+  std::scoped_lock lock{m_mutex};
+  if (m_socket == nullptr) {
+    return 0;
+  }
+  try {
+    ArchNetAddress addr = ARCH->getSocketAddr(m_socket);
+    const int port = ARCH->getAddrPort(addr);
+    ARCH->closeAddr(addr);
+    return port;
+  } catch (ArchNetworkException &) {
+    return 0;
+  }
+}
+
+void UDPSocket::setReadingJob()
+{
+  m_socketMultiplexer->addSocket(
+      this, new TSocketMultiplexerMethodJob<UDPSocket>(this, &UDPSocket::serviceReading, m_socket, true, false)
+  );
+}
+
+ISocketMultiplexerJob *UDPSocket::serviceReading(ISocketMultiplexerJob *job, bool read, bool, bool error)
+{
+  // an error is read like a datagram, so both mean there's something to
+  // read.  stop polling until the owner has read everything.
+  if (read || error) {
+    m_events->addEvent(Event(EventTypes::StreamInputReady, this));
+    return nullptr;
+  }
+  return job;
+}
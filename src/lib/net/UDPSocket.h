@@ -0,0 +1,55 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "arch/IArchNetwork.h"
+#include "net/IDatagramSocket.h"
+
+#include <mutex>
+
+class ISocketMultiplexerJob;
+class IEventQueue;
+class SocketMultiplexer;
+
+//! UDP socket
+/*!
+A datagram socket using UDP.
+*/
+class UDPSocket : public IDatagramSocket
+{
+public:
+  UDPSocket(IEventQueue *events, SocketMultiplexer *socketMultiplexer, IArchNetwork::AddressFamily family);
+  UDPSocket(UDPSocket const &) = delete;
+  UDPSocket(UDPSocket &&) = delete;
+  ~UDPSocket() override;
+
+  UDPSocket &operator=(UDPSocket const &) = delete;
+  UDPSocket &operator=(UDPSocket &&) = delete;
+
+  // ISocket overrides
+  void bind(const NetworkAddress &) override;
+  void close() override;
+  void *getEventTarget() const override;
+
+  // IDatagramSocket overrides
+  void connect(const NetworkAddress &) override;
+  void connectToSender() override;
+  bool send(const void *data, uint32_t size) override;
+  uint32_t receive(void *buffer, uint32_t size) override;
+  int getPort() const override;
+
+  ISocketMultiplexerJob *serviceReading(ISocketMultiplexerJob *, bool, bool, bool);
+
+private:
+  void setReadingJob();
+
+  ArchSocket m_socket;
+  ArchNetAddress m_sender = nullptr;
+  IEventQueue *m_events;
+  SocketMultiplexer *m_socketMultiplexer;
+  mutable std::mutex m_mutex;
+};
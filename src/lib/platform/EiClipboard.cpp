@@ -7,6 +7,8 @@
 #include "platform/EiClipboard.h"
 #include "base/Log.h"
 
+#include <utility>
+
 namespace deskflow {
 
 EiClipboard::EiClipboard(ClipboardID id) : m_id(id)
@@ -39,7 +41,7 @@ bool EiClipboard::empty()
   return true;
 }
 
-void EiClipboard::add(Format format, const std::string &data)
+void EiClipboard::add(Format format, std::string data)
 {
   std::scoped_lock lock{m_mutex};
   if (!m_open) {
@@ -53,7 +55,7 @@ void EiClipboard::add(Format format, const std::string &data)
   }
 
   const auto formatID = static_cast<int>(format);
-  m_data[formatID] = data;
+  m_data[formatID] = std::move(data);
   m_added[formatID] = true;
 }
 
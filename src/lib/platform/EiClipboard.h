@@ -32,7 +32,7 @@ public:
   //! @name IClipboard overrides
   //@{
   bool empty() override;
-  void add(Format, const std::string &data) override;
+  void add(Format, std::string data) override;
   bool open(Time) const override;
   void close() const override;
   Time getTime() const override;
@@ -9,7 +9,7 @@
 #include "platform/EiKeyState.h"
 
 #include "base/Log.h"
-#include "common/Settings.h"
+#include "common/SettingsSnapshot.h"
 #include "deskflow/AppUtil.h"
 #include "platform/XDGKeyUtil.h"
 
@@ -21,7 +21,7 @@ namespace deskflow {
 
 EiKeyState::EiKeyState(EiScreen *screen, IEventQueue *events)
     : KeyState(
-          events, AppUtil::instance().getKeyboardLayoutList(), Settings::value(Settings::Client::LanguageSync).toBool()
+          events, AppUtil::instance().getKeyboardLayoutList(), SettingsSnapshot::current()->client.languageSync
       ),
       m_screen{screen}
 {
@@ -11,7 +11,7 @@
 #include "base/IEventQueue.h"
 #include "base/Log.h"
 #include "common/Constants.h"
-#include "common/Settings.h"
+#include "common/SettingsSnapshot.h"
 #include "deskflow/App.h"
 #include "deskflow/IScreen.h"
 #include "deskflow/OptionTypes.h"
@@ -79,7 +79,7 @@ EiScreen::EiScreen(bool isPrimary, IEventQueue *events, bool usePortal)
   }
 
   // disable sleep if the flag is set
-  if (Settings::value(Settings::Core::PreventSleep).toBool()) {
+  if (SettingsSnapshot::current()->core.preventSleep) {
     m_powerManager.disableSleep();
   }
 }
@@ -395,7 +395,7 @@ void EiScreen::ensureEmulating() const
   }
 
   cancelIdleEmulationTimer();
-  if (Settings::value(Settings::Core::PreventSleep).toBool())
+  if (SettingsSnapshot::current()->core.preventSleep)
     return;
 
   m_idleEmulationTimer = m_events->newOneShotTimer(s_idleEmulationTimeout, nullptr);
@@ -82,7 +82,7 @@ bool MSWindowsClipboard::empty()
   return true;
 }
 
-void MSWindowsClipboard::add(Format format, const std::string &data)
+void MSWindowsClipboard::add(Format format, std::string data)
 {
   // exit early if there is no data to prevent spurious "failed to convert clipboard data" errors
   if (data.empty()) {
@@ -75,7 +75,7 @@ bool OSXClipboard::synchronize()
   return false;
 }
 
-void OSXClipboard::add(Format format, const std::string &data)
+void OSXClipboard::add(Format format, std::string data)
 {
   if (m_pboard == nullptr)
     return;
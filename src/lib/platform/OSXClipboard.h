@@ -27,7 +27,7 @@ public:
 
   // IClipboard overrides
   bool empty() override;
-  void add(Format, const std::string &data) override;
+  void add(Format, std::string data) override;
   bool open(Time) const override;
   void close() const override;
   Time getTime() const override;
@@ -17,7 +17,7 @@
 #include "base/TMethodJob.h"
 #include "client/Client.h"
 #include "common/ExitCodes.h"
-#include "common/Settings.h"
+#include "common/SettingsSnapshot.h"
 #include "deskflow/ClientApp.h"
 #include "deskflow/Clipboard.h"
 #include "deskflow/DisplayInvalidException.h"
@@ -124,7 +124,7 @@ OSXScreen::OSXScreen(IEventQueue *events, bool isPrimary, bool enableLangSync)
     m_screensaver = new OSXScreenSaver(m_events, getEventTarget());
     m_keyState = new OSXKeyState(m_events, AppUtil::instance().getKeyboardLayoutList(), enableLangSync);
 
-    if (Settings::value(Settings::Core::PreventSleep).toBool()) {
+    if (SettingsSnapshot::current()->core.preventSleep) {
       m_powerManager.disableSleep();
     }
 
@@ -0,0 +1,89 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "platform/SyntheticKeyState.h"
+
+namespace deskflow {
+
+namespace {
+
+// buttons are arbitrary but kept clear of zero, which means no button
+const KeyButton kFirstButton = 8;
+const KeyButton kShiftButton = 7;
+
+} // namespace
+
+SyntheticKeyState::SyntheticKeyState(IEventQueue *events) : KeyState(events, {"us"}, false)
+{
+  // do nothing
+}
+
+bool SyntheticKeyState::fakeCtrlAltDel()
+{
+  // pass keys through unchanged
+  return false;
+}
+
+KeyModifierMask SyntheticKeyState::pollActiveModifiers() const
+{
+  return 0;
+}
+
+std::int32_t SyntheticKeyState::pollActiveGroup() const
+{
+  return 0;
+}
+
+void SyntheticKeyState::pollPressedKeys(KeyButtonSet &) const
+{
+  // nothing is ever really pressed
+}
+
+void SyntheticKeyState::getKeyMap(KeyMap &keyMap)
+{
+  KeyMap::KeyItem item;
+  item.m_id = kKeyShift_L;
+  item.m_button = kShiftButton;
+  item.m_generates = KeyModifierShift;
+  keyMap.addKeyEntry(item);
+  item.m_generates = 0;
+
+  // printable ascii, one button per character with shift for capitals
+  KeyButton button = kFirstButton;
+  for (KeyID id = 0x20; id < 0x7f; ++id) {
+    if (id >= 'A' && id <= 'Z') {
+      continue;
+    }
+    item.m_id = id;
+    item.m_button = button;
+    item.m_required = 0;
+    item.m_sensitive = KeyModifierShift;
+    keyMap.addKeyEntry(item);
+
+    if (id >= 'a' && id <= 'z') {
+      item.m_id = id - 'a' + 'A';
+      item.m_required = KeyModifierShift;
+      keyMap.addKeyEntry(item);
+    }
+    ++button;
+  }
+
+  const KeyID others[] = {kKeyReturn, kKeyBackSpace, kKeyTab, kKeyEscape, kKeyLeft, kKeyRight, kKeyUp, kKeyDown};
+  item.m_required = 0;
+  item.m_sensitive = 0;
+  for (const auto id : others) {
+    item.m_id = id;
+    item.m_button = button++;
+    keyMap.addKeyEntry(item);
+  }
+}
+
+void SyntheticKeyState::fakeKey(const Keystroke &)
+{
+  // there is no display to send the key to
+}
+
+} // namespace deskflow
@@ -0,0 +1,36 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "deskflow/KeyState.h"
+
+namespace deskflow {
+
+//! Key state for SyntheticScreen
+/*!
+Has a fixed US layout and synthesizes nothing; faked keys only update the
+tracked key state.
+*/
+class SyntheticKeyState : public KeyState
+{
+public:
+  explicit SyntheticKeyState(IEventQueue *events);
+  ~SyntheticKeyState() override = default;
+
+  // IKeyState overrides
+  bool fakeCtrlAltDel() override;
+  KeyModifierMask pollActiveModifiers() const override;
+  std::int32_t pollActiveGroup() const override;
+  void pollPressedKeys(KeyButtonSet &pressedKeys) const override;
+
+protected:
+  // KeyState overrides
+  void getKeyMap(KeyMap &keyMap) override;
+  void fakeKey(const Keystroke &keystroke) override;
+};
+
+} // namespace deskflow
@@ -0,0 +1,503 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "platform/SyntheticScreen.h"
+
+#include "base/IEventQueue.h"
+#include "base/Log.h"
+#include "platform/SyntheticKeyState.h"
+
+#include <QFile>
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+
+namespace deskflow {
+
+namespace {
+
+// moves are tagged with their y coordinate less this, leaving room for
+// the server to clamp the cursor without confusing the tags
+const std::int32_t kTop = 32;
+const std::int32_t kMaxMoveTags = 1000;
+
+// pixels per generated move
+const std::int32_t kFlickStep = 8;
+
+// how often input is generated and the log written, in seconds
+const double kGenerateInterval = 0.001;
+const double kFlushInterval = 1.0;
+
+// don't try to catch up on more than this many events of a kind at once,
+// e.g. after the process was suspended
+const std::uint64_t kMaxBurst = 50;
+
+const auto kClipboardPrefix = std::string("deskflow-load ");
+
+std::uint64_t nanoseconds(std::chrono::steady_clock::duration duration)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+// skips events that are too far behind, returns the first one to send
+std::uint64_t skipBacklog(std::uint64_t due, std::uint64_t sent)
+{
+  return due > sent + kMaxBurst ? due - kMaxBurst : sent;
+}
+
+} // namespace
+
+SyntheticScreen::Options SyntheticScreen::Options::parse(const QString &spec)
+{
+  Options options;
+  for (const auto &pair : spec.split(QLatin1Char(','), Qt::SkipEmptyParts)) {
+    const auto name = pair.section(QLatin1Char('='), 0, 0).trimmed();
+    const auto value = pair.section(QLatin1Char('='), 1).trimmed();
+    bool ok = true;
+    if (name == QLatin1String("flick")) {
+      options.flickRate = value.toDouble(&ok);
+    } else if (name == QLatin1String("typing")) {
+      options.typingRate = value.toDouble(&ok);
+    } else if (name == QLatin1String("clipboard")) {
+      options.clipboardSize = value.toLongLong(&ok);
+    } else if (name == QLatin1String("interval")) {
+      options.clipboardInterval = value.toDouble(&ok);
+    } else if (name == QLatin1String("delay")) {
+      options.delay = value.toDouble(&ok);
+    } else if (name == QLatin1String("duration")) {
+      options.duration = value.toDouble(&ok);
+    } else if (name == QLatin1String("screens")) {
+      options.screens = value.toInt(&ok);
+    } else if (name == QLatin1String("width")) {
+      options.width = value.toInt(&ok);
+    } else if (name == QLatin1String("height")) {
+      options.height = value.toInt(&ok);
+    } else if (name == QLatin1String("log")) {
+      options.logFile = value;
+    } else {
+      ok = false;
+    }
+
+    if (!ok) {
+      LOG_WARN("ignoring synthetic screen option: %s", qPrintable(pair));
+    }
+  }
+
+  options.screens = std::max(options.screens, 1);
+  options.width = std::max(options.width, 4 * kFlickStep);
+  options.height = std::max(options.height, 2 * kTop + 1);
+  options.clipboardInterval = std::max(options.clipboardInterval, kGenerateInterval);
+  return options;
+}
+
+SyntheticScreen::SyntheticScreen(bool isPrimary, IEventQueue *events, const Options &options)
+    : PlatformScreen{events},
+      m_isPrimary{isPrimary},
+      m_events{events},
+      m_options{options},
+      m_isOnScreen{isPrimary}
+{
+  m_keyState = new SyntheticKeyState(events);
+  m_cursorX = m_options.width / 2;
+  m_cursorY = m_options.height / 2;
+  LOG_INFO("using synthetic screen %dx%d", m_options.width, m_options.height);
+}
+
+SyntheticScreen::~SyntheticScreen()
+{
+  disable();
+  delete m_keyState;
+}
+
+void *SyntheticScreen::getEventTarget() const
+{
+  return const_cast<void *>(static_cast<const void *>(this));
+}
+
+bool SyntheticScreen::getClipboard(ClipboardID, IClipboard *clipboard) const
+{
+  return IClipboard::copy(clipboard, &m_clipboard);
+}
+
+void SyntheticScreen::getShape(std::int32_t &x, std::int32_t &y, std::int32_t &width, std::int32_t &height) const
+{
+  x = 0;
+  y = 0;
+  width = m_options.width;
+  height = m_options.height;
+}
+
+void SyntheticScreen::getCursorPos(std::int32_t &x, std::int32_t &y) const
+{
+  x = m_cursorX;
+  y = m_cursorY;
+}
+
+void SyntheticScreen::reconfigure(std::uint32_t activeSides)
+{
+  m_activeSides = activeSides;
+}
+
+std::uint32_t SyntheticScreen::activeSides()
+{
+  return m_activeSides;
+}
+
+void SyntheticScreen::warpCursor(std::int32_t x, std::int32_t y)
+{
+  m_cursorX = x;
+  m_cursorY = y;
+}
+
+std::uint32_t SyntheticScreen::registerHotKey(KeyID, KeyModifierMask)
+{
+  // hot keys are never pressed
+  return 0;
+}
+
+void SyntheticScreen::unregisterHotKey(std::uint32_t)
+{
+  // do nothing
+}
+
+void SyntheticScreen::fakeInputBegin()
+{
+  // do nothing
+}
+
+void SyntheticScreen::fakeInputEnd()
+{
+  // do nothing
+}
+
+std::int32_t SyntheticScreen::getJumpZoneSize() const
+{
+  return 1;
+}
+
+bool SyntheticScreen::isAnyMouseButtonDown(std::uint32_t &buttonID) const
+{
+  buttonID = kButtonNone;
+  return false;
+}
+
+void SyntheticScreen::getCursorCenter(std::int32_t &x, std::int32_t &y) const
+{
+  x = m_options.width / 2;
+  y = m_options.height / 2;
+}
+
+void SyntheticScreen::fakeMouseButton(ButtonID, bool)
+{
+  // do nothing
+}
+
+void SyntheticScreen::fakeMouseMove(std::int32_t x, std::int32_t y)
+{
+  m_cursorX = x;
+  m_cursorY = y;
+
+  // the position given before enter() wasn't a move
+  if (m_isOnScreen && y >= kTop) {
+    record("move", y - kTop);
+  }
+}
+
+void SyntheticScreen::fakeMouseRelativeMove(std::int32_t, std::int32_t) const
+{
+  // relative moves can't be tagged
+}
+
+void SyntheticScreen::fakeMouseWheel(ScrollDelta) const
+{
+  // do nothing
+}
+
+void SyntheticScreen::fakeKeyDown(KeyID id, KeyModifierMask mask, KeyButton button, const std::string &lang)
+{
+  record("key", button);
+  PlatformScreen::fakeKeyDown(id, mask, button, lang);
+}
+
+void SyntheticScreen::enable()
+{
+  if (!m_options.logFile.isEmpty() && m_flushTimer == nullptr) {
+    m_flushTimer = m_events->newTimer(kFlushInterval, nullptr);
+    m_events->addHandler(EventTypes::Timer, m_flushTimer, [this](const auto &) { flushLog(); });
+  }
+
+  if (m_isPrimary && m_generateTimer == nullptr) {
+    LOG_INFO(
+        "generating input in %.1fs: %.0f moves/s, %.0f keys/s, %lld byte clipboard every %.1fs", m_options.delay,
+        m_options.flickRate, m_options.typingRate, static_cast<long long>(m_options.clipboardSize),
+        m_options.clipboardInterval
+    );
+    const auto delay = std::chrono::duration<double>(m_options.delay);
+    m_start = Clock::now() + std::chrono::duration_cast<Clock::duration>(delay);
+    m_generateTimer = m_events->newTimer(kGenerateInterval, nullptr);
+    m_events->addHandler(EventTypes::Timer, m_generateTimer, [this](const auto &) { generate(); });
+  }
+}
+
+void SyntheticScreen::disable()
+{
+  for (auto *timer : {m_generateTimer, m_flushTimer}) {
+    if (timer != nullptr) {
+      m_events->removeHandler(EventTypes::Timer, timer);
+      m_events->deleteTimer(timer);
+    }
+  }
+  m_generateTimer = nullptr;
+  m_flushTimer = nullptr;
+  flushLog();
+}
+
+void SyntheticScreen::enter()
+{
+  m_isOnScreen = true;
+}
+
+bool SyntheticScreen::canLeave()
+{
+  return true;
+}
+
+void SyntheticScreen::leave()
+{
+  m_isOnScreen = false;
+}
+
+bool SyntheticScreen::setClipboard(ClipboardID, const IClipboard *clipboard)
+{
+  // grabbing the clipboard is all there is to do without data
+  if (clipboard == nullptr) {
+    return true;
+  }
+
+  if (!IClipboard::copy(&m_clipboard, clipboard)) {
+    return false;
+  }
+
+  std::string text;
+  if (m_clipboard.open(0)) {
+    if (m_clipboard.has(IClipboard::Format::Text)) {
+      text = m_clipboard.get(IClipboard::Format::Text);
+    }
+    m_clipboard.close();
+  }
+  if (text.starts_with(kClipboardPrefix)) {
+    record("clipboard", std::strtoull(text.c_str() + kClipboardPrefix.size(), nullptr, 10));
+  }
+  return true;
+}
+
+void SyntheticScreen::checkClipboards()
+{
+  // the clipboard only changes when generated
+}
+
+void SyntheticScreen::openScreensaver(bool)
+{
+  // do nothing
+}
+
+void SyntheticScreen::closeScreensaver()
+{
+  // do nothing
+}
+
+void SyntheticScreen::screensaver(bool)
+{
+  // do nothing
+}
+
+void SyntheticScreen::resetOptions()
+{
+  // do nothing
+}
+
+void SyntheticScreen::setOptions(const OptionsList &)
+{
+  // do nothing
+}
+
+void SyntheticScreen::setSequenceNumber(std::uint32_t seqNum)
+{
+  m_sequenceNumber = seqNum;
+}
+
+bool SyntheticScreen::isPrimary() const
+{
+  return m_isPrimary;
+}
+
+void SyntheticScreen::handleSystemEvent(const Event &)
+{
+  // there is no system to hear from
+}
+
+void SyntheticScreen::updateButtons()
+{
+  // do nothing
+}
+
+IKeyState *SyntheticScreen::getKeyState() const
+{
+  return m_keyState;
+}
+
+std::string SyntheticScreen::getSecureInputApp() const
+{
+  return {};
+}
+
+void SyntheticScreen::sendEvent(EventTypes type, void *data)
+{
+  m_events->addEvent(Event(type, getEventTarget(), data));
+}
+
+void SyntheticScreen::generate()
+{
+  const auto now = Clock::now();
+  if (now < m_start) {
+    return;
+  }
+
+  const auto seconds = std::chrono::duration<double>(now - m_start).count();
+  if (m_options.duration > 0 && seconds > m_options.duration) {
+    LOG_INFO(
+        "generated %llu moves, %llu keys and %llu clipboards", static_cast<unsigned long long>(m_moves),
+        static_cast<unsigned long long>(m_keys), static_cast<unsigned long long>(m_clipboards)
+    );
+    m_events->removeHandler(EventTypes::Timer, m_generateTimer);
+    m_events->deleteTimer(m_generateTimer);
+    m_generateTimer = nullptr;
+    flushLog();
+    return;
+  }
+
+  const auto moves = static_cast<std::uint64_t>(seconds * m_options.flickRate);
+  for (m_moves = skipBacklog(moves, m_moves); m_moves < moves;) {
+    sendMove();
+  }
+
+  const auto keys = static_cast<std::uint64_t>(seconds * m_options.typingRate);
+  for (m_keys = skipBacklog(keys, m_keys); m_keys < keys;) {
+    sendKey();
+  }
+
+  if (m_options.clipboardSize > 0) {
+    const auto clipboards = static_cast<std::uint64_t>(seconds / m_options.clipboardInterval);
+    for (m_clipboards = skipBacklog(clipboards, m_clipboards); m_clipboards < clipboards;) {
+      sendClipboard();
+    }
+  }
+}
+
+void SyntheticScreen::sendMove()
+{
+  const auto window = std::min(kMaxMoveTags, m_options.height - 2 * kTop);
+  const auto tag = static_cast<std::int32_t>(m_moves++ % window);
+  const auto y = kTop + tag;
+
+  if (m_isOnScreen) {
+    // go to the first secondary screen
+    m_cursorX = m_options.width - 1;
+    m_cursorY = y;
+    m_virtualX = m_options.width;
+    m_virtualY = y;
+    m_direction = 1;
+    sendEvent(EventTypes::PrimaryScreenMotionOnPrimary, MotionInfo::alloc(m_cursorX, m_cursorY));
+    return;
+  }
+
+  // sweep back and forth across the secondaries, well clear of the primary
+  const auto margin = m_options.width / 4;
+  if (m_virtualX >= (m_options.screens + 1) * m_options.width - margin) {
+    m_direction = -1;
+  } else if (m_virtualX <= m_options.width + margin) {
+    m_direction = 1;
+  }
+  const auto dx = m_direction * kFlickStep;
+  const auto dy = y - m_virtualY;
+  m_virtualX += dx;
+  m_virtualY = y;
+
+  record("move", tag);
+  sendEvent(EventTypes::PrimaryScreenMotionOnSecondary, MotionInfo::alloc(dx, dy));
+}
+
+void SyntheticScreen::sendKey()
+{
+  const auto count = m_keys++;
+  if (m_isOnScreen) {
+    return;
+  }
+
+  const auto id = static_cast<KeyID>('a' + count % 26);
+  const auto button = static_cast<KeyButton>(1 + count % (s_numButtons - 1));
+  record("key", button);
+  m_keyState->sendKeyEvent(getEventTarget(), true, false, id, 0, 1, button);
+  m_keyState->sendKeyEvent(getEventTarget(), false, false, id, 0, 1, button);
+}
+
+void SyntheticScreen::sendClipboard()
+{
+  const auto count = m_clipboards++;
+  if (m_isOnScreen) {
+    return;
+  }
+
+  auto text = kClipboardPrefix + std::to_string(count) + "\n";
+  text.resize(std::max(text.size(), static_cast<size_t>(m_options.clipboardSize)), 'x');
+  m_clipboard.open(0);
+  m_clipboard.empty();
+  m_clipboard.add(IClipboard::Format::Text, text);
+  m_clipboard.close();
+
+  auto *info = static_cast<ClipboardInfo *>(malloc(sizeof(ClipboardInfo)));
+  info->m_id = kClipboardClipboard;
+  info->m_sequenceNumber = m_sequenceNumber;
+  record("clipboard", count);
+  sendEvent(EventTypes::ClipboardGrabbed, info);
+}
+
+void SyntheticScreen::record(const char *kind, std::uint64_t tag)
+{
+  if (m_options.logFile.isEmpty()) {
+    return;
+  }
+
+  m_log += kind;
+  m_log += ' ';
+  m_log += std::to_string(tag);
+  m_log += ' ';
+  m_log += std::to_string(nanoseconds(Clock::now().time_since_epoch()));
+  m_log += '\n';
+}
+
+void SyntheticScreen::flushLog()
+{
+  if (m_options.logFile.isEmpty()) {
+    return;
+  }
+
+  // process time on posix, wall time on windows
+  const auto cpu = static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+  m_log += "cpu " + std::to_string(static_cast<std::uint64_t>(cpu * 1e9)) + "\n";
+
+  QFile file(m_options.logFile);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+    LOG_WARN("unable to write synthetic screen log: %s", qPrintable(file.errorString()));
+    m_log.clear();
+    return;
+  }
+  file.write(m_log.data(), static_cast<qint64>(m_log.size()));
+  m_log.clear();
+}
+
+} // namespace deskflow
@@ -0,0 +1,158 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "deskflow/Clipboard.h"
+#include "deskflow/PlatformScreen.h"
+
+#include <QString>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+class EventQueueTimer;
+
+namespace deskflow {
+
+class SyntheticKeyState;
+
+//! Screen with generated input, for load testing
+/*!
+Needs no display server.  As a primary it generates input at fixed rates:
+pointer flicks across the secondary screens, typing and clipboard
+changes.  As a secondary it records the input it is asked to fake.
+
+Both write what they sent or received to a log, one event per line as
+\c "<kind> <tag> <nanoseconds>" where \c kind is \c move, \c key or
+\c clipboard, \c tag identifies the event and the time is from the
+steady clock.  A \c "cpu <nanoseconds>" line gives the CPU time used so
+far.  Matching the tags in the primary's log with those in a
+secondary's gives the latency of each event.
+
+Moves are tagged by their y coordinate, so this relies on absolute
+moves being sent to the secondary, the default.
+*/
+class SyntheticScreen : public PlatformScreen
+{
+public:
+  //! Generated input, parsed from Settings::Core::SyntheticScreen
+  struct Options
+  {
+    double flickRate = 1000;      //!< Pointer moves per second
+    double typingRate = 20;       //!< Key presses per second
+    qsizetype clipboardSize = 0;  //!< Bytes per clipboard change, 0 for none
+    double clipboardInterval = 2; //!< Seconds between clipboard changes
+    double delay = 2;             //!< Seconds before generating input
+    double duration = 0;          //!< Seconds of input, 0 for no limit
+    int screens = 1;              //!< Secondary screens right of the primary
+    std::int32_t width = 1920;    //!< Screen width
+    std::int32_t height = 1080;   //!< Screen height
+    QString logFile;              //!< Event log, none if empty
+
+    //! Parse a spec
+    /*!
+    Reads comma separated \c name=value pairs, e.g.
+    \c "flick=1000,typing=20,clipboard=4194304,log=/tmp/server.log".
+    The names are \c flick, \c typing, \c clipboard, \c interval,
+    \c delay, \c duration, \c screens, \c width, \c height and \c log.
+    */
+    static Options parse(const QString &spec);
+  };
+
+  SyntheticScreen(bool isPrimary, IEventQueue *events, const Options &options);
+  ~SyntheticScreen() override;
+
+  // IScreen overrides
+  void *getEventTarget() const final;
+  bool getClipboard(ClipboardID id, IClipboard *) const override;
+  void getShape(std::int32_t &x, std::int32_t &y, std::int32_t &width, std::int32_t &height) const override;
+  void getCursorPos(std::int32_t &x, std::int32_t &y) const override;
+
+  // IPrimaryScreen overrides
+  void reconfigure(std::uint32_t activeSides) override;
+  std::uint32_t activeSides() override;
+  void warpCursor(std::int32_t x, std::int32_t y) override;
+  std::uint32_t registerHotKey(KeyID key, KeyModifierMask mask) override;
+  void unregisterHotKey(std::uint32_t id) override;
+  void fakeInputBegin() override;
+  void fakeInputEnd() override;
+  std::int32_t getJumpZoneSize() const override;
+  bool isAnyMouseButtonDown(std::uint32_t &buttonID) const override;
+  void getCursorCenter(std::int32_t &x, std::int32_t &y) const override;
+
+  // ISecondaryScreen overrides
+  void fakeMouseButton(ButtonID id, bool press) override;
+  void fakeMouseMove(std::int32_t x, std::int32_t y) override;
+  void fakeMouseRelativeMove(std::int32_t dx, std::int32_t dy) const override;
+  void fakeMouseWheel(ScrollDelta delta) const override;
+
+  // IKeyState overrides
+  void fakeKeyDown(KeyID id, KeyModifierMask mask, KeyButton button, const std::string &lang) override;
+
+  // IPlatformScreen overrides
+  void enable() override;
+  void disable() override;
+  void enter() override;
+  bool canLeave() override;
+  void leave() override;
+  bool setClipboard(ClipboardID, const IClipboard *) override;
+  void checkClipboards() override;
+  void openScreensaver(bool notify) override;
+  void closeScreensaver() override;
+  void screensaver(bool activate) override;
+  void resetOptions() override;
+  void setOptions(const OptionsList &options) override;
+  void setSequenceNumber(std::uint32_t) override;
+  bool isPrimary() const override;
+
+protected:
+  // IPlatformScreen overrides
+  void handleSystemEvent(const Event &event) override;
+  void updateButtons() override;
+  IKeyState *getKeyState() const override;
+  std::string getSecureInputApp() const override;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  void sendEvent(EventTypes type, void *data);
+  void generate();
+  void sendMove();
+  void sendKey();
+  void sendClipboard();
+  void record(const char *kind, std::uint64_t tag);
+  void flushLog();
+
+  bool m_isPrimary;
+  IEventQueue *m_events;
+  Options m_options;
+  SyntheticKeyState *m_keyState = nullptr;
+  EventQueueTimer *m_generateTimer = nullptr;
+  EventQueueTimer *m_flushTimer = nullptr;
+
+  bool m_isOnScreen;
+  std::uint32_t m_activeSides = 0;
+  std::uint32_t m_sequenceNumber = 0;
+  std::int32_t m_cursorX = 0;
+  std::int32_t m_cursorY = 0;
+
+  // primary: where the cursor is across the secondary screens, which
+  // way it's going and how much input has been sent since m_start
+  std::int32_t m_virtualX = 0;
+  std::int32_t m_virtualY = 0;
+  std::int32_t m_direction = 1;
+  Clock::time_point m_start;
+  std::uint64_t m_moves = 0;
+  std::uint64_t m_keys = 0;
+  std::uint64_t m_clipboards = 0;
+
+  Clipboard m_clipboard;
+  std::string m_log;
+};
+
+} // namespace deskflow
@@ -26,6 +26,7 @@
 #include <format>
 #endif
 
+#include <utility>
 #include <vector>
 
 //
@@ -78,6 +79,7 @@ XWindowsClipboard::XWindowsClipboard(Display *display, Window window, ClipboardI
 XWindowsClipboard::~XWindowsClipboard()
 {
   std::scoped_lock lock{m_mutex};
+  cancelFetch();
   clearReplies();
   clearConverters();
 }
@@ -91,6 +93,7 @@ void XWindowsClipboard::lost(Time time)
     m_timeLost = time;
     clearCache();
   }
+  cancelFetch();
 }
 
 void XWindowsClipboard::addRequest(Window owner, Window requestor, Atom target, ::Time time, Atom property)
@@ -142,6 +145,7 @@ bool XWindowsClipboard::addSimpleRequest(Window requestor, Atom target, ::Time t
 
   // handle targets
   std::string data;
+  SharedData shared;
   Atom type = None;
   int format = 0;
   if (target == m_atomTargets) {
@@ -154,7 +158,13 @@ bool XWindowsClipboard::addSimpleRequest(Window requestor, Atom target, ::Time t
       const auto clipboardFormat = static_cast<int>(converter->getFormat());
       if (m_added[clipboardFormat]) {
         try {
-          data = converter->fromIClipboard(m_data[clipboardFormat]);
+          // send data that needs no conversion straight from the
+          // clipboard, which may be a mapping of a received transfer
+          if (converter->isIdentity()) {
+            shared = m_data[clipboardFormat];
+          } else {
+            data = converter->fromIClipboard(std::string(m_data[clipboardFormat].data));
+          }
           format = converter->getDataSize();
           type = converter->getAtom();
         } catch (...) {
@@ -168,7 +178,10 @@ bool XWindowsClipboard::addSimpleRequest(Window requestor, Atom target, ::Time t
   if (type != None) {
     // success
     LOG_VERBOSE("clipboard request added");
-    insertReply(new Reply(requestor, target, time, property, data, type, format));
+    if (shared.owner == nullptr) {
+      shared = share(std::move(data));
+    }
+    insertReply(new Reply(requestor, target, time, property, std::move(shared), type, format));
     return true;
   } else {
     // failure
@@ -241,6 +254,9 @@ bool XWindowsClipboard::empty()
 
   LOG_DEBUG("empty clipboard %d", m_id);
 
+  // whatever was being fetched is about to be replaced
+  cancelFetch();
+
   // assert ownership of clipboard
   XSetSelectionOwner(m_display, m_selection, m_window, m_time);
   if (XGetSelectionOwner(m_display, m_selection) != m_window) {
@@ -267,7 +283,7 @@ bool XWindowsClipboard::empty()
   return true;
 }
 
-void XWindowsClipboard::add(Format format, const std::string &data)
+void XWindowsClipboard::add(Format format, std::string data)
 {
   std::scoped_lock lock{m_mutex};
   assert(m_open);
@@ -276,12 +292,25 @@ void XWindowsClipboard::add(Format format, const std::string &data)
   LOG_DEBUG("add %d bytes to clipboard %d format: %d", data.size(), m_id, format);
 
   const auto formatID = static_cast<int>(format);
-  m_data[formatID] = data;
+  m_data[formatID] = share(std::move(data));
   m_added[formatID] = true;
 
   // FIXME -- set motif clipboard item?
 }
 
+void XWindowsClipboard::addShared(Format format, SharedData data)
+{
+  std::scoped_lock lock{m_mutex};
+  assert(m_open);
+  assert(m_owner);
+
+  LOG_DEBUG("add %d shared bytes to clipboard %d format: %d", data.data.size(), m_id, format);
+
+  const auto formatID = static_cast<int>(format);
+  m_data[formatID] = std::move(data);
+  m_added[formatID] = true;
+}
+
 bool XWindowsClipboard::open(Time time) const
 {
   std::scoped_lock lock{m_mutex};
@@ -357,6 +386,15 @@ std::string XWindowsClipboard::get(Format format) const
   std::scoped_lock lock{m_mutex};
   assert(m_open);
 
+  fillCache();
+  return std::string(m_data[static_cast<int>(format)].data);
+}
+
+IClipboard::SharedData XWindowsClipboard::getShared(Format format) const
+{
+  std::scoped_lock lock{m_mutex};
+  assert(m_open);
+
   fillCache();
   return m_data[static_cast<int>(format)];
 }
@@ -399,13 +437,18 @@ void XWindowsClipboard::checkCache() const
   }
   m_checkCache = false;
 
+  // the ICCCM cache is kept current by fetch(), asking the owner here
+  // would block until it replied.
+  if (!m_motif) {
+    if (m_timeOwned == 0) {
+      m_timeOwned = m_time;
+    }
+    return;
+  }
+
   // get the time the clipboard ownership was taken by the current
   // owner.
-  if (m_motif) {
-    m_timeOwned = motifGetTime();
-  } else {
-    m_timeOwned = icccmGetTime();
-  }
+  m_timeOwned = motifGetTime();
 
   // if we can't get the time then use the time passed to us
   if (m_timeOwned == 0) {
@@ -428,7 +471,7 @@ void XWindowsClipboard::doClearCache()
   m_checkCache = false;
   m_cached = false;
   for (int32_t index = 0; index < static_cast<int>(Format::TotalFormats); ++index) {
-    m_data[index] = "";
+    m_data[index] = {};
     m_added[index] = false;
   }
 }
@@ -437,91 +480,200 @@ void XWindowsClipboard::fillCache() const
 {
   // get the selection data if not already cached
   checkCache();
-  if (!m_cached) {
+  if (!m_cached && m_motif) {
     const_cast<XWindowsClipboard *>(this)->doFillCache();
   }
 }
 
 void XWindowsClipboard::doFillCache()
 {
-  if (m_motif) {
-    motifFillCache();
-  } else {
-    icccmFillCache();
-  }
+  motifFillCache();
   m_checkCache = false;
   m_cached = true;
   m_cacheTime = m_timeOwned;
 }
 
-void XWindowsClipboard::icccmFillCache()
+void XWindowsClipboard::fetch(::Time time)
 {
-  LOG_DEBUG("icccm fill clipboard %d", m_id);
+  std::scoped_lock lock{m_mutex};
+  cancelFetch();
+  if (m_owner) {
+    return;
+  }
 
-  // see if we can get the list of available formats from the selection.
-  // if not then use a default list of formats.  note that some clipboard
-  // owners are broken and report TARGETS as the type of the TARGETS data
-  // instead of the correct type ATOM;  allow either.
-  const Atom atomTargets = m_atomTargets;
-  Atom target;
-  std::string data;
-  if (!icccmGetSelection(atomTargets, &target, &data) || (target != m_atomAtom && target != m_atomTargets)) {
-    LOG_VERBOSE("selection doesn't support TARGETS");
-    data = "";
-    XWindowsUtil::appendAtomData(data, XA_STRING);
+  LOG_DEBUG("fetch clipboard %d", m_id);
+
+  // replies arrive as property changes on our window.  the event mask
+  // is left alone afterwards as the other clipboard may be fetching.
+  if (!m_fetchSelected) {
+    XWindowAttributes attr;
+    XGetWindowAttributes(m_display, m_window, &attr);
+    XSelectInput(m_display, m_window, attr.your_event_mask | PropertyChangeMask);
+    m_fetchSelected = true;
   }
 
-  XWindowsUtil::convertAtomProperty(data);
-  auto targets = static_cast<const Atom *>(static_cast<const void *>(data.data()));
-  const uint32_t numTargets = data.size() / sizeof(Atom);
-  LOG_DEBUG("  available targets: %s", XWindowsUtil::atomsToString(m_display, targets, numTargets).c_str());
+  // one property for the timestamp and each converter, per clipboard as
+  // both share our window, in the set this retrieval's turn uses.
+  m_fetchGeneration = (m_fetchGeneration + 1) % 2;
+  auto &properties = m_fetchProperties[m_fetchGeneration];
+  if (properties.empty()) {
+    for (std::size_t i = 0; i <= m_converters.size(); ++i) {
+      const auto name = "CLIP_TEMPORARY_" + std::to_string(m_id) + "_" + std::to_string(m_fetchGeneration) + "_" +
+                        std::to_string(i);
+      properties.push_back(XInternAtom(m_display, name.c_str(), False));
+    }
+  }
 
-  // try each converter in order (because they're in order of
-  // preference).
-  for (ConverterList::const_iterator index = m_converters.begin(); index != m_converters.end(); ++index) {
-    const IXWindowsClipboardConverter *converter = *index;
-    const auto formatID = static_cast<int>(converter->getFormat());
+  m_fetchTime = time;
+  m_fetchPhase = FetchPhase::Timestamp;
+  m_fetches.push_back(std::make_unique<CICCCMGetClipboard>(m_window, m_fetchTime, properties[0]));
+  m_fetches.back()->request(m_display, m_selection, m_atomTimestamp);
+  XFlush(m_display);
+}
 
-    // skip already handled targets
-    if (m_added[formatID]) {
-      continue;
+XWindowsClipboard::FetchStatus XWindowsClipboard::processFetchEvent(const XEvent *xevent)
+{
+  std::scoped_lock lock{m_mutex};
+  if (m_fetchPhase == FetchPhase::Idle) {
+    return FetchStatus::Ignored;
+  }
+
+  bool processed = false;
+  for (const auto &request : m_fetches) {
+    if (request->processEvent(m_display, xevent)) {
+      LOGC(request->error(), (CLOG_WARN "icccm violation by clipboard owner"));
+      processed = true;
+      break;
     }
+  }
+  if (!processed) {
+    return FetchStatus::Ignored;
+  }
+  return continueFetch();
+}
 
-    // see if atom is in target list
-    Atom target = None;
-    // XXX -- just ask for the converter's target to see if it's
-    // available rather than checking TARGETS.  i've seen clipboard
-    // owners that don't report all the targets they support.
-    target = converter->getAtom();
-    /*
-    for (uint32_t i = 0; i < numTargets; ++i) {
-        if (converter->getAtom() == targets[i]) {
-            target = targets[i];
-            break;
-        }
+XWindowsClipboard::FetchStatus XWindowsClipboard::expireFetch()
+{
+  std::scoped_lock lock{m_mutex};
+  if (m_fetchPhase == FetchPhase::Idle) {
+    return FetchStatus::Ignored;
+  }
+
+  for (const auto &request : m_fetches) {
+    request->expire();
+  }
+  return continueFetch();
+}
+
+bool XWindowsClipboard::isFetching() const
+{
+  std::scoped_lock lock{m_mutex};
+  return m_fetchPhase != FetchPhase::Idle;
+}
+
+XWindowsClipboard::FetchStatus XWindowsClipboard::continueFetch()
+{
+  if (!std::ranges::all_of(m_fetches, [](const auto &request) { return request->isDone(); })) {
+    return FetchStatus::Pending;
+  }
+
+  if (m_fetchPhase == FetchPhase::Targets) {
+    return finishFetch();
+  }
+
+  // get the time the clipboard ownership was taken by the current
+  // owner, if we can't then use the time we fetched at
+  m_fetchTimeOwned = 0;
+  if (const auto &request = m_fetches.front(); request->succeeded() && request->getActualTarget() == m_atomInteger) {
+    const std::string data = request->takeData();
+    if (data.size() >= sizeof(Time)) {
+      m_fetchTimeOwned = *static_cast<const Time *>(static_cast<const void *>(data.data()));
+      LOG_VERBOSE("got ICCCM time %d", m_fetchTimeOwned);
     }
-    */
-    if (target == None) {
+  }
+  if (m_fetchTimeOwned == 0) {
+    LOG_VERBOSE("can't get ICCCM time");
+    m_fetchTimeOwned = m_fetchTime;
+  }
+
+  // nothing to do if the cache is from the same owner
+  if (m_cached && m_fetchTimeOwned == m_cacheTime) {
+    LOG_DEBUG("clipboard %d unchanged", m_id);
+    cancelFetch();
+    return FetchStatus::Unchanged;
+  }
+
+  fetchTargets();
+  return FetchStatus::Pending;
+}
+
+void XWindowsClipboard::fetchTargets()
+{
+  // ask for every converter's target at once.  we don't check TARGETS
+  // first as i've seen clipboard owners that don't report all the
+  // targets they support.
+  m_fetchPhase = FetchPhase::Targets;
+  m_fetches.clear();
+  const auto &properties = m_fetchProperties[m_fetchGeneration];
+  for (std::size_t i = 0; i < m_converters.size(); ++i) {
+    m_fetches.push_back(std::make_unique<CICCCMGetClipboard>(m_window, m_fetchTime, properties[i + 1]));
+    m_fetches.back()->request(m_display, m_selection, m_converters[i]->getAtom());
+  }
+  XFlush(m_display);
+}
+
+XWindowsClipboard::FetchStatus XWindowsClipboard::finishFetch()
+{
+  LOG_DEBUG("icccm fill clipboard %d", m_id);
+
+  // take the data of the first converter that got any for each format,
+  // they're in order of preference.
+  bool added[static_cast<int>(Format::TotalFormats)] = {};
+  std::string data[static_cast<int>(Format::TotalFormats)];
+  for (std::size_t i = 0; i < m_converters.size(); ++i) {
+    const IXWindowsClipboardConverter *converter = m_converters[i];
+    const auto formatID = static_cast<int>(converter->getFormat());
+    CICCCMGetClipboard &request = *m_fetches[i];
+    if (added[formatID]) {
       continue;
     }
-
-    // get the data
-    Atom actualTarget;
-    std::string targetData;
-    if (!icccmGetSelection(target, &actualTarget, &targetData)) {
-      LOG_VERBOSE("  no data for target %s", XWindowsUtil::atomToString(m_display, target).c_str());
+    if (!request.succeeded()) {
+      LOG_VERBOSE("  no data for target %s", XWindowsUtil::atomToString(m_display, converter->getAtom()).c_str());
       continue;
     }
 
-    // add to clipboard and note we've done it
-    m_data[formatID] = converter->toIClipboard(targetData);
-    m_added[formatID] = true;
+    const std::string targetData = request.takeData();
+    data[formatID] = converter->toIClipboard(targetData);
+    added[formatID] = true;
     LOG(
         (CLOG_DEBUG "added format %d for target %s (%u %s)", formatID,
-         XWindowsUtil::atomToString(m_display, target).c_str(), targetData.size(),
+         XWindowsUtil::atomToString(m_display, converter->getAtom()).c_str(), targetData.size(),
          targetData.size() == 1 ? "byte" : "bytes")
     );
   }
+  cancelFetch();
+
+  bool changed = false;
+  for (int32_t index = 0; index < static_cast<int>(Format::TotalFormats); ++index) {
+    if (added[index] != m_added[index] || data[index] != m_data[index].data) {
+      m_data[index] = share(std::move(data[index]));
+      m_added[index] = added[index];
+      changed = true;
+    }
+  }
+  m_cached = true;
+  m_cacheTime = m_fetchTimeOwned;
+  m_timeOwned = m_fetchTimeOwned;
+  return changed ? FetchStatus::Changed : FetchStatus::Unchanged;
+}
+
+void XWindowsClipboard::cancelFetch()
+{
+  // replies to abandoned requests are left for the screen to clean up.
+  // they're for another time and properties so the next retrieval
+  // doesn't take them.
+  m_fetchPhase = FetchPhase::Idle;
+  m_fetches.clear();
 }
 
 bool XWindowsClipboard::icccmGetSelection(Atom target, Atom *actualTarget, std::string *data) const
@@ -739,7 +891,7 @@ void XWindowsClipboard::motifFillCache()
     }
 
     // add to clipboard and note we've done it
-    m_data[formatID] = converter->toIClipboard(targetData);
+    m_data[formatID] = share(converter->toIClipboard(targetData));
     m_added[formatID] = true;
     LOG_DEBUG("added format %d for target %s", format, XWindowsUtil::atomToString(m_display, target).c_str());
   }
@@ -815,7 +967,7 @@ bool XWindowsClipboard::insertMultipleReply(Window requestor, ::Time time, Atom
   }
 
   // add reply for MULTIPLE request
-  insertReply(new Reply(requestor, m_atomMultiple, time, property, std::string(), None, 32));
+  insertReply(new Reply(requestor, m_atomMultiple, time, property, share(std::string()), None, 32));
 
   return true;
 }
@@ -936,11 +1088,11 @@ bool XWindowsClipboard::sendReply(Reply *reply)
     // send using INCR if already sending incrementally or if reply
     // is too large, otherwise just send it.
     const uint32_t maxRequestSize = 3 * XMaxRequestSize(m_display);
-    const bool useINCR = (reply->m_data.size() > maxRequestSize);
+    const bool useINCR = (reply->m_data.data.size() > maxRequestSize);
 
     // send INCR reply if incremental and we haven't replied yet
     if (useINCR && !reply->m_replied) {
-      uint32_t size = reply->m_data.size();
+      uint32_t size = reply->m_data.data.size();
       if (!XWindowsUtil::setWindowProperty(
               m_display, reply->m_requestor, reply->m_property, &size, 4, m_atomINCR, 32
           )) {
@@ -951,13 +1103,13 @@ bool XWindowsClipboard::sendReply(Reply *reply)
     // send more INCR reply or entire non-incremental reply
     else {
       // how much more data should we send?
-      uint32_t size = reply->m_data.size() - reply->m_ptr;
+      uint32_t size = reply->m_data.data.size() - reply->m_ptr;
       if (size > maxRequestSize)
         size = maxRequestSize;
 
       // send it
       if (!XWindowsUtil::setWindowProperty(
-              m_display, reply->m_requestor, reply->m_property, reply->m_data.data() + reply->m_ptr, size,
+              m_display, reply->m_requestor, reply->m_property, reply->m_data.data.data() + reply->m_ptr, size,
               reply->m_type, reply->m_format
           )) {
         failed = true;
@@ -1174,13 +1326,8 @@ XWindowsClipboard::CICCCMGetClipboard::CICCCMGetClipboard(Window requestor, Time
 {
 }
 
-bool XWindowsClipboard::CICCCMGetClipboard::readClipboard(
-    Display *display, Atom selection, Atom target, Atom *actualTarget, std::string *data
-)
+void XWindowsClipboard::CICCCMGetClipboard::request(Display *display, Atom selection, Atom target)
 {
-  assert(actualTarget != nullptr);
-  assert(data != nullptr);
-
   LOG((
       CLOG_VERBOSE "request selection=%s, target=%s, window=%x", XWindowsUtil::atomToString(display, selection).c_str(),
       XWindowsUtil::atomToString(display, target).c_str(), m_requestor
@@ -1188,52 +1335,63 @@ bool XWindowsClipboard::CICCCMGetClipboard::readClipboard(
 
   m_atomNone = XInternAtom(display, "NONE", False);
   m_atomIncr = XInternAtom(display, "INCR", False);
-
-  // save output pointers
-  m_actualTarget = actualTarget;
-  m_data = data;
+  m_selection = selection;
+  m_target = target;
 
   // assume failure
-  *m_actualTarget = None;
-  *m_data = "";
+  m_actualTarget = None;
+  m_data = "";
 
   // delete target property
   XDeleteProperty(display, m_requestor, m_property);
 
+  // request data conversion
+  XConvertSelection(display, selection, target, m_property, m_requestor, m_time);
+  m_progress.reset();
+}
+
+void XWindowsClipboard::CICCCMGetClipboard::expire()
+{
+  // we use a timeout so we don't get locked up by badly behaved
+  // selection owners
+  static const double s_timeout = 0.25; // FIXME -- is this too short?
+  if (!isDone() && m_progress.getTime() >= s_timeout) {
+    LOG_VERBOSE("request for target %x timed out", m_target);
+    m_failed = true;
+  }
+}
+
+bool XWindowsClipboard::CICCCMGetClipboard::readClipboard(
+    Display *display, Atom selection, Atom target, Atom *actualTarget, std::string *data
+)
+{
+  assert(actualTarget != nullptr);
+  assert(data != nullptr);
+
   // select window for property changes
   XWindowAttributes attr;
   XGetWindowAttributes(display, m_requestor, &attr);
   XSelectInput(display, m_requestor, attr.your_event_mask | PropertyChangeMask);
 
-  // request data conversion
-  XConvertSelection(display, selection, target, m_property, m_requestor, m_time);
+  request(display, selection, target);
 
   // synchronize with server before we start following timeout countdown
   XSync(display, False);
+  m_progress.reset();
 
   // Xlib inexplicably omits the ability to wait for an event with
   // a timeout.  (it's inexplicable because there's no portable way
   // to do it.)  we'll poll until we have what we're looking for or
-  // a timeout expires.  we use a timeout so we don't get locked up
-  // by badly behaved selection owners.
+  // the request expires.
   XEvent xevent;
   std::vector<XEvent> events;
-  Stopwatch timeout(false);             // timer not stopped, not triggered
-  static const double s_timeout = 0.25; // FIXME -- is this too short?
   bool noWait = false;
-  while (!m_done && !m_failed) {
-    // fail if timeout has expired
-    if (timeout.getTime() >= s_timeout) {
-      m_failed = true;
-      break;
-    }
-
+  while (!isDone()) {
     // process events if any otherwise sleep
     if (noWait || XPending(display) > 0) {
-      while (!m_done && !m_failed && (noWait || XPending(display) > 0)) {
-        // fail if timeout has expired
-        if (timeout.getTime() >= s_timeout) {
-          m_failed = true;
+      while (!isDone() && (noWait || XPending(display) > 0)) {
+        expire();
+        if (isDone()) {
           break;
         }
 
@@ -1242,9 +1400,6 @@ bool XWindowsClipboard::CICCCMGetClipboard::readClipboard(
           // not processed so save it
           events.push_back(xevent);
         } else {
-          // reset timer since we've made some progress
-          timeout.reset();
-
           // don't sleep anymore, just block waiting for events.
           // we're assuming here that the clipboard owner will
           // complete the protocol correctly.  if we continue to
@@ -1254,6 +1409,7 @@ bool XWindowsClipboard::CICCCMGetClipboard::readClipboard(
       }
     } else {
       Arch::sleep(0.01);
+      expire();
     }
   }
 
@@ -1266,12 +1422,19 @@ bool XWindowsClipboard::CICCCMGetClipboard::readClipboard(
   XSelectInput(display, m_requestor, attr.your_event_mask);
 
   // return success or failure
-  LOG_VERBOSE("request %s after %fs", m_failed ? "failed" : "succeeded", timeout.getTime());
+  LOG_VERBOSE("request %s", m_failed ? "failed" : "succeeded");
+  *actualTarget = m_actualTarget;
+  *data = std::move(m_data);
   return !m_failed;
 }
 
 bool XWindowsClipboard::CICCCMGetClipboard::processEvent(Display *display, const XEvent *xevent)
 {
+  // nothing more to do once the conversion is over
+  if (isDone()) {
+    return false;
+  }
+
   // process event
   switch (xevent->type) {
   case DestroyNotify:
@@ -1284,7 +1447,11 @@ bool XWindowsClipboard::CICCCMGetClipboard::processEvent(Display *display, const
     return false;
 
   case SelectionNotify:
-    if (xevent->xselection.requestor == m_requestor) {
+    // the reply must be to this request.  an earlier request on the same
+    // property, like one that was abandoned or asked for another target,
+    // is answered for its own time and target.
+    if (xevent->xselection.requestor == m_requestor && xevent->xselection.selection == m_selection &&
+        xevent->xselection.target == m_target && xevent->xselection.time == m_time) {
       // done if we can't convert
       if (xevent->xselection.property == None || xevent->xselection.property == m_atomNone) {
         m_done = true;
@@ -1320,10 +1487,13 @@ bool XWindowsClipboard::CICCCMGetClipboard::processEvent(Display *display, const
     return false;
   }
 
+  // we've made some progress
+  m_progress.reset();
+
   // get the data from the property
   Atom target;
-  const std::string::size_type oldSize = m_data->size();
-  if (!XWindowsUtil::getWindowProperty(display, m_requestor, m_property, m_data, &target, nullptr, True)) {
+  const std::string::size_type oldSize = m_data.size();
+  if (!XWindowsUtil::getWindowProperty(display, m_requestor, m_property, &m_data, &target, nullptr, True)) {
     // unable to read property
     m_failed = true;
     return true;
@@ -1333,14 +1503,14 @@ bool XWindowsClipboard::CICCCMGetClipboard::processEvent(Display *display, const
   // selection owner is busted.  if the INCR property has no size
   // then the selection owner is busted.
   if (target == m_atomIncr) {
-    if (m_incr || m_data->size() == oldSize) {
+    if (m_incr || m_data.size() == oldSize) {
       m_failed = true;
       m_error = true;
     } else {
       m_incr = true;
 
       // discard INCR data
-      *m_data = "";
+      m_data = "";
     }
   }
 
@@ -1349,12 +1519,12 @@ bool XWindowsClipboard::CICCCMGetClipboard::processEvent(Display *display, const
     // if first incremental chunk then save target
     if (oldSize == 0) {
       LOG_VERBOSE("  INCR first chunk, target %s", XWindowsUtil::atomToString(display, target).c_str());
-      *m_actualTarget = target;
+      m_actualTarget = target;
     }
 
     // secondary chunks must have the same target
     else {
-      if (target != *m_actualTarget) {
+      if (target != m_actualTarget) {
         LOG_WARN("  INCR target mismatch");
         m_failed = true;
         m_error = true;
@@ -1362,8 +1532,8 @@ bool XWindowsClipboard::CICCCMGetClipboard::processEvent(Display *display, const
     }
 
     // note if this is the final chunk
-    if (m_data->size() == oldSize) {
-      LOG_VERBOSE("  INCR final chunk: %d bytes total", m_data->size());
+    if (m_data.size() == oldSize) {
+      LOG_VERBOSE("  INCR final chunk: %d bytes total", m_data.size());
       m_done = true;
     }
   }
@@ -1371,12 +1541,12 @@ bool XWindowsClipboard::CICCCMGetClipboard::processEvent(Display *display, const
   // not incremental;  save the target.
   else {
     LOG_VERBOSE("  target %s", XWindowsUtil::atomToString(display, target).c_str());
-    *m_actualTarget = target;
+    m_actualTarget = target;
     m_done = true;
   }
 
   // this event has been processed
-  LOGC(!m_incr, (CLOG_VERBOSE "  got data, %d bytes", m_data->size()));
+  LOGC(!m_incr, (CLOG_VERBOSE "  got data, %d bytes", m_data.size()));
   return true;
 }
 
@@ -1396,13 +1566,13 @@ XWindowsClipboard::Reply::Reply(Window requestor, Atom target, ::Time time)
 }
 
 XWindowsClipboard::Reply::Reply(
-    Window requestor, Atom target, ::Time time, Atom property, const std::string &data, Atom type, int format
+    Window requestor, Atom target, ::Time time, Atom property, SharedData data, Atom type, int format
 )
     : m_requestor(requestor),
       m_target(target),
       m_time(time),
       m_property(property),
-      m_data(data),
+      m_data(std::move(data)),
       m_type(type),
       m_format(format)
 {
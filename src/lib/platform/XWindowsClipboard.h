@@ -1,6 +1,6 @@
 /*
  * Deskflow -- mouse and keyboard sharing utility
- * SPDX-FileCopyrightText: (C) 2025 Deskflow Developers
+ * SPDX-FileCopyrightText: (C) 2025 - 2026 Deskflow Developers
  * SPDX-FileCopyrightText: (C) 2012 - 2016 Synergy App Ltd
  * SPDX-FileCopyrightText: (C) 2002 Chris Schoeneman
  * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "base/Stopwatch.h"
 #include "deskflow/ClipboardTypes.h"
 #include "deskflow/IClipboard.h"
 
@@ -15,6 +16,7 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -38,6 +40,15 @@ public:
   XWindowsClipboard &operator=(XWindowsClipboard const &) = delete;
   XWindowsClipboard &operator=(XWindowsClipboard &&) = delete;
 
+  //! Progress of a selection retrieval
+  enum class FetchStatus
+  {
+    Ignored,   //!< Event isn't part of a retrieval
+    Pending,   //!< Retrieval is waiting for more replies
+    Unchanged, //!< Retrieval finished, the cached data was current
+    Changed    //!< Retrieval finished with new data
+  };
+
   //! Notify clipboard was lost
   /*!
   Tells clipboard it lost ownership at the given time.
@@ -66,6 +77,38 @@ public:
   */
   bool destroyRequest(Window requestor);
 
+  //! Start retrieving the selection
+  /*!
+  Asks the selection owner for the time it took the selection and,
+  unless that matches the cached data, for every target we can convert,
+  all at once and without waiting for the replies.  The replies are
+  passed to processFetchEvent() as they arrive.  Any retrieval already
+  in progress is abandoned and late replies to it are ignored.  Does
+  nothing if we own the selection.
+  */
+  void fetch(::Time time);
+
+  //! Continue retrieving the selection
+  /*!
+  Continues a retrieval started by fetch() with a \c SelectionNotify or
+  \c PropertyNotify event.  Returns FetchStatus::Ignored if the event
+  isn't part of a retrieval.
+  */
+  FetchStatus processFetchEvent(const XEvent *xevent);
+
+  //! Expire stalled selection retrieval
+  /*!
+  Fails the requests of a retrieval that haven't progressed for a while,
+  in case the selection owner never replies.
+  */
+  FetchStatus expireFetch();
+
+  //! Check for selection retrieval
+  /*!
+  Returns true iff a retrieval started by fetch() hasn't finished.
+  */
+  bool isFetching() const;
+
   //! Get window
   /*!
   Returns the clipboard's window (passed the c'tor).
@@ -81,12 +124,14 @@ public:
 
   // IClipboard overrides
   bool empty() override;
-  void add(Format, const std::string &data) override;
+  void add(Format, std::string data) override;
   bool open(Time) const override;
   void close() const override;
   Time getTime() const override;
   bool has(Format) const override;
   std::string get(Format) const override;
+  void addShared(Format, SharedData data) override;
+  SharedData getShared(Format) const override;
 
 private:
   // remove all converters from our list
@@ -116,34 +161,55 @@ private:
   void clearCache() const;
   void doClearCache();
 
-  // cache all formats of the selection
+  // cache all formats of the selection.  only needed for motif, the
+  // ICCCM cache is filled by fetch().
   void fillCache() const;
   void doFillCache();
 
+  // start the next phase of a retrieval or finish it once every request
+  // of the current phase is done
+  FetchStatus continueFetch();
+  void fetchTargets();
+  FetchStatus finishFetch();
+  void cancelFetch();
+
 protected:
   //
   // helper classes
   //
 
-  // read an ICCCM conforming selection
+  // read an ICCCM conforming selection.  the conversion is driven by
+  // the events passed to processEvent() so any number may be in flight
+  // at once, as long as each uses its own property.
   class CICCCMGetClipboard
   {
   public:
     CICCCMGetClipboard(Window requestor, Time time, Atom property);
     ~CICCCMGetClipboard() = default;
 
-    // convert the given selection to the given type.  returns
-    // true iff the conversion was successful or the conversion
-    // cannot be performed (in which case *actualTarget == None).
-    bool readClipboard(Display *display, Atom selection, Atom target, Atom *actualTarget, std::string *data);
+    // ask the selection owner to convert the given selection to the
+    // given type.  the requestor must be selected for property changes.
+    void request(Display *display, Atom selection, Atom target);
 
-  private:
+    // continue the conversion.  returns true iff the event was part of
+    // it.
     bool processEvent(Display *display, const XEvent *event);
 
+    // fail the conversion if it hasn't progressed within the timeout
+    void expire();
+
+    // convert the given selection to the given type, waiting for the
+    // owner to reply.  returns true iff the conversion was successful or
+    // the conversion cannot be performed (in which case *actualTarget
+    // == None).
+    bool readClipboard(Display *display, Atom selection, Atom target, Atom *actualTarget, std::string *data);
+
   private:
     Window m_requestor;
     Time m_time;
     Atom m_property;
+    Atom m_selection = None;
+    Atom m_target = None;
     bool m_incr = false;
     bool m_failed = false;
     bool m_done = false;
@@ -155,12 +221,15 @@ protected:
     // true iff we've received the selection notify
     bool m_reading = false;
 
+    // time since the conversion last progressed
+    Stopwatch m_progress;
+
     // the converted selection data
-    std::string *m_data = nullptr;
+    std::string m_data;
 
     // the actual type of the data.  if this is None then the
     // selection owner cannot convert to the requested type.
-    Atom *m_actualTarget = nullptr;
+    Atom m_actualTarget = None;
 
     // true iff the selection owner didn't follow ICCCM conventions
     bool m_error = false;
@@ -170,6 +239,26 @@ protected:
     {
       return m_error;
     }
+
+    // true iff the conversion succeeded or failed
+    bool isDone() const
+    {
+      return m_done || m_failed;
+    }
+
+    // true iff the conversion produced data, which may be taken once
+    bool succeeded() const
+    {
+      return m_done && !m_failed && m_actualTarget != None;
+    }
+    Atom getActualTarget() const
+    {
+      return m_actualTarget;
+    }
+    std::string takeData()
+    {
+      return std::move(m_data);
+    }
   };
 
   // Motif structure IDs
@@ -225,7 +314,7 @@ protected:
   {
   public:
     Reply(Window, Atom target, ::Time);
-    Reply(Window, Atom target, ::Time, Atom property, const std::string &data, Atom type, int format);
+    Reply(Window, Atom target, ::Time, Atom property, SharedData data, Atom type, int format);
 
   public:
     // information about the request
@@ -240,8 +329,9 @@ protected:
     // true iff the reply has sent its last message
     bool m_done = false;
 
-    // the data to send and its type and format
-    std::string m_data;
+    // the data to send and its type and format.  the data may be
+    // shared with the clipboard, which then doesn't copy it per request.
+    SharedData m_data;
     Atom m_type;
     int m_format;
 
@@ -253,7 +343,6 @@ protected:
   using ReplyEventMask = std::map<Window, long>;
 
   // ICCCM interoperability methods
-  void icccmFillCache();
   bool icccmGetSelection(Atom target, Atom *actualTarget, std::string *data) const;
   Time icccmGetTime() const;
 
@@ -302,7 +391,25 @@ private:
   bool m_cached;
   Time m_cacheTime;
   bool m_added[static_cast<int>(IClipboard::Format::TotalFormats)];
-  std::string m_data[static_cast<int>(IClipboard::Format::TotalFormats)];
+  SharedData m_data[static_cast<int>(IClipboard::Format::TotalFormats)];
+
+  // selection retrieval.  the timestamp is asked for first, then one
+  // request per converter, each on its own property.  retrievals take
+  // turns with two sets of properties so replies to an abandoned one
+  // don't land where the next one is reading.
+  enum class FetchPhase
+  {
+    Idle,
+    Timestamp,
+    Targets
+  };
+  FetchPhase m_fetchPhase = FetchPhase::Idle;
+  ::Time m_fetchTime = 0;
+  Time m_fetchTimeOwned = 0;
+  std::vector<std::unique_ptr<CICCCMGetClipboard>> m_fetches;
+  std::vector<Atom> m_fetchProperties[2];
+  std::size_t m_fetchGeneration = 0;
+  bool m_fetchSelected = false;
 
   // conversion request replies
   ReplyMap m_replies;
@@ -367,6 +474,16 @@ public:
   */
   virtual std::string fromIClipboard(const std::string &) const = 0;
 
+  //! Check for identity conversion
+  /*!
+  Return true iff fromIClipboard() returns its input unchanged, so the
+  clipboard data can be sent as it is without converting it.
+  */
+  virtual bool isIdentity() const
+  {
+    return false;
+  }
+
   //! Convert to IClipboard format
   /*!
   Convert from the X selection format to the IClipboard format
@@ -39,6 +39,11 @@ std::string XWindowsClipboardHTMLConverter::fromIClipboard(const std::string &da
   return data;
 }
 
+bool XWindowsClipboardHTMLConverter::isIdentity() const
+{
+  return true;
+}
+
 std::string XWindowsClipboardHTMLConverter::toIClipboard(const std::string &data) const
 {
   if (Unicode::isUTF8(data)) {
@@ -45,6 +45,11 @@ std::string XWindowsClipboardUTF8Converter::fromIClipboard(const std::string &da
   return data;
 }
 
+bool XWindowsClipboardUTF8Converter::isIdentity() const
+{
+  return true;
+}
+
 std::string XWindowsClipboardUTF8Converter::toIClipboard(const std::string &data) const
 {
   // https://bugzilla.mozilla.org/show_bug.cgi?id=1547595
@@ -24,6 +24,7 @@ public:
   Atom getAtom() const override;
   int getDataSize() const override;
   std::string fromIClipboard(const std::string &) const override;
+  bool isIdentity() const override;
   std::string toIClipboard(const std::string &) const override;
 
 private:
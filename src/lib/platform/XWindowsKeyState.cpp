@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
  */
 
+#include <QCryptographicHash>
 #include <QString>
 #ifndef __APPLE__
 #include <QDBusConnection>
@@ -12,11 +13,12 @@
 #include <QDBusPendingReply>
 #endif
 
-#include "common/Settings.h" // Must Include before XWindowsKeyState due to its use of Xorg headers
+#include "common/SettingsSnapshot.h" // Must Include before XWindowsKeyState due to its use of Xorg headers
 
 #include "platform/XWindowsKeyState.h"
 
 #include "base/Log.h"
+#include "common/VersionInfo.h"
 #include "deskflow/AppUtil.h"
 #include "platform/XDGKeyUtil.h"
 
@@ -24,7 +26,9 @@
 #include <X11/Xutil.h>
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <map>
+#include <optional>
 #define XK_MISCELLANY
 #define XK_XKB_KEYS
 #include <X11/keysymdef.h>
@@ -34,9 +38,24 @@
 
 static const size_t ModifiersFromXDefaultSize = 32;
 
+// bump when the maps built from an XKB description change
+static const uint32_t KeyMapCacheVersion = 1;
+
+// reads a count and that many records of wordsEach words, nothing if
+// there aren't enough words
+static std::optional<std::span<const uint32_t>> readRecords(std::span<const uint32_t> &words, size_t wordsEach)
+{
+  if (words.empty() || words.front() > (words.size() - 1) / wordsEach) {
+    return std::nullopt;
+  }
+  const auto records = words.subspan(1, words.front() * wordsEach);
+  words = words.subspan(1 + records.size());
+  return records;
+}
+
 XWindowsKeyState::XWindowsKeyState(Display *display, bool useXKB, IEventQueue *events)
     : KeyState(
-          events, AppUtil::instance().getKeyboardLayoutList(), Settings::value(Settings::Client::LanguageSync).toBool()
+          events, AppUtil::instance().getKeyboardLayoutList(), SettingsSnapshot::current()->client.languageSync
       ),
       m_display(display),
       m_modifierFromX(ModifiersFromXDefaultSize)
@@ -47,7 +66,7 @@ XWindowsKeyState::XWindowsKeyState(Display *display, bool useXKB, IEventQueue *e
 XWindowsKeyState::XWindowsKeyState(Display *display, bool useXKB, IEventQueue *events, deskflow::KeyMap &keyMap)
     : KeyState(
           events, keyMap, AppUtil::instance().getKeyboardLayoutList(),
-          Settings::value(Settings::Client::LanguageSync).toBool()
+          SettingsSnapshot::current()->client.languageSync
       ),
       m_display(display),
       m_modifierFromX(ModifiersFromXDefaultSize)
@@ -213,7 +232,21 @@ void XWindowsKeyState::getKeyMap(deskflow::KeyMap &keyMap)
 #if HAVE_XKB_EXTENSION
   if (m_xkb != nullptr) {
     if (XkbGetUpdatedMap(m_display, XkbKeyActionsMask | XkbKeyBehaviorsMask | XkbAllClientInfoMask, m_xkb) == Success) {
+      // without modifiers the map is built from the last good ones (see
+      // the VMware hack) so it doesn't depend on the description alone
+      if (!hasModifiersXKB()) {
+        updateKeysymMapXKB(keyMap);
+        return;
+      }
+
+      const auto fingerprint = fingerprintXKB();
+      if (m_keyMapCache.load(fingerprint, [this, &keyMap](auto words) { return readKeyMapXKB(keyMap, words); })) {
+        return;
+      }
       updateKeysymMapXKB(keyMap);
+      std::vector<uint32_t> words;
+      writeKeyMapXKB(keyMap, words);
+      m_keyMapCache.store(fingerprint, words);
       return;
     }
   }
@@ -818,6 +851,124 @@ bool XWindowsKeyState::hasModifiersXKB() const
   return false;
 }
 
+QByteArray XWindowsKeyState::fingerprintXKB() const
+{
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+#if HAVE_XKB_EXTENSION
+  const auto addData = [&hash](const void *data, size_t size) {
+    hash.addData(QByteArrayView(static_cast<const char *>(data), static_cast<qsizetype>(size)));
+  };
+  const auto addWord = [&addData](uint32_t word) { addData(&word, sizeof(word)); };
+
+  // another build may translate keysyms differently
+  addData(kVersion, strlen(kVersion) + 1);
+  addData(kVersionGitSha, strlen(kVersionGitSha) + 1);
+  addWord(KeyMapCacheVersion);
+
+  // everything updateKeysymMapXKB() reads
+  const XkbClientMapPtr map = m_xkb->map;
+  const XkbServerMapPtr server = m_xkb->server;
+  addWord(m_xkb->min_key_code);
+  addWord(m_xkb->max_key_code);
+  addWord(map->num_types);
+  for (int i = 0; i < map->num_types; ++i) {
+    const XkbKeyTypeRec &type = map->types[i];
+    addWord(type.mods.mask);
+    addWord(type.num_levels);
+    addWord(type.map_count);
+    for (int j = 0; j < type.map_count; ++j) {
+      addWord(type.map[j].active);
+      addWord(type.map[j].level);
+      addWord(type.map[j].mods.mask);
+      addWord(type.preserve != nullptr ? type.preserve[j].mask : 0);
+    }
+  }
+  for (int i = m_xkb->min_key_code; i <= m_xkb->max_key_code; ++i) {
+    const XkbSymMapRec &symMap = map->key_sym_map[i];
+    addData(symMap.kt_index, sizeof(symMap.kt_index));
+    addWord(symMap.group_info);
+    addWord(symMap.width);
+    addWord(symMap.offset);
+    addWord(map->modmap[i]);
+    addWord(server->behaviors[i].type);
+    addWord(server->behaviors[i].data);
+    addWord(server->key_acts[i]);
+  }
+  addWord(map->num_syms);
+  addData(map->syms, map->num_syms * sizeof(KeySym));
+  addWord(server->num_acts);
+  addData(server->acts, server->num_acts * sizeof(XkbAction));
+#endif
+  return hash.result();
+}
+
+void XWindowsKeyState::writeKeyMapXKB(const deskflow::KeyMap &keyMap, std::vector<uint32_t> &words) const
+{
+  keyMap.write(words);
+
+  words.push_back(static_cast<uint32_t>(m_modifierFromX.size()));
+  words.insert(words.end(), m_modifierFromX.begin(), m_modifierFromX.end());
+
+  words.push_back(static_cast<uint32_t>(m_modifierToX.size()));
+  for (const auto &[mask, xMask] : m_modifierToX) {
+    words.insert(words.end(), {mask, xMask});
+  }
+
+  words.push_back(static_cast<uint32_t>(m_keyCodeFromKey.size()));
+  for (const auto &[id, keycode] : m_keyCodeFromKey) {
+    words.insert(words.end(), {id, keycode});
+  }
+
+  words.push_back(static_cast<uint32_t>(m_lastGoodXKBModifiers.size()));
+  for (const auto &[key, info] : m_lastGoodXKBModifiers) {
+    words.insert(words.end(), {key, info.m_level, info.m_mask, info.m_lock});
+  }
+}
+
+bool XWindowsKeyState::readKeyMapXKB(deskflow::KeyMap &keyMap, std::span<const uint32_t> words)
+{
+  deskflow::KeyMap newKeyMap;
+  if (!newKeyMap.read(words)) {
+    return false;
+  }
+  const auto modifierFromX = readRecords(words, 1);
+  const auto modifierToX = modifierFromX ? readRecords(words, 2) : std::nullopt;
+  const auto keyCodeFromKey = modifierToX ? readRecords(words, 2) : std::nullopt;
+  const auto lastGoodModifiers = keyCodeFromKey ? readRecords(words, 4) : std::nullopt;
+  if (!lastGoodModifiers || !words.empty()) {
+    return false;
+  }
+
+  KeyModifierToXMask newModifierToX;
+  for (size_t i = 0; i < modifierToX->size(); i += 2) {
+    newModifierToX[(*modifierToX)[i]] = (*modifierToX)[i + 1];
+  }
+
+  KeyToKeyCodeMap newKeyCodeFromKey;
+  for (size_t i = 0; i < keyCodeFromKey->size(); i += 2) {
+    if ((*keyCodeFromKey)[i + 1] > 0xff) {
+      return false;
+    }
+    newKeyCodeFromKey.emplace((*keyCodeFromKey)[i], static_cast<KeyCode>((*keyCodeFromKey)[i + 1]));
+  }
+
+  XKBModifierMap newLastGoodModifiers;
+  for (size_t i = 0; i < lastGoodModifiers->size(); i += 4) {
+    const auto *record = &(*lastGoodModifiers)[i];
+    if (record[1] > 0xff || record[3] > 1) {
+      return false;
+    }
+    newLastGoodModifiers[record[0]] = {static_cast<unsigned char>(record[1]), record[2], record[3] != 0};
+  }
+
+  keyMap.swap(newKeyMap);
+  m_modifierFromX.assign(modifierFromX->begin(), modifierFromX->end());
+  m_modifierToX.swap(newModifierToX);
+  m_keyCodeFromKey.swap(newKeyCodeFromKey);
+  m_lastGoodXKBModifiers.swap(newLastGoodModifiers);
+  return true;
+}
+
 int XWindowsKeyState::getEffectiveGroup(KeyCode keycode, int group) const
 {
   (void)keycode;
@@ -7,10 +7,12 @@
 
 #pragma once
 
+#include "deskflow/KeyMapCache.h"
 #include "deskflow/KeyState.h"
 #include "platform/XWindowsConfig.h"
 
 #include <map>
+#include <span>
 #include <vector>
 
 #include <X11/Xlib.h>
@@ -103,6 +105,9 @@ private:
   void updateKeysymMap(deskflow::KeyMap &);
   void updateKeysymMapXKB(deskflow::KeyMap &);
   bool hasModifiersXKB() const;
+  QByteArray fingerprintXKB() const;
+  void writeKeyMapXKB(const deskflow::KeyMap &, std::vector<uint32_t> &words) const;
+  bool readKeyMapXKB(deskflow::KeyMap &, std::span<const uint32_t> words);
   int getEffectiveGroup(KeyCode, int group) const;
   uint32_t getGroupFromState(unsigned int state) const;
 
@@ -148,6 +153,9 @@ private:
   // map KeyID to all keycodes that can synthesize that KeyID
   KeyToKeyCodeMap m_keyCodeFromKey;
 
+  // maps built from earlier XKB descriptions
+  deskflow::KeyMapCache m_keyMapCache;
+
   // autorepeat state
   XKeyboardState m_keyboardState;
 };
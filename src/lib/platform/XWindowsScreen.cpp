@@ -6,7 +6,7 @@
  * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
  */
 
-#include "common/Settings.h" // must include first
+#include "common/SettingsSnapshot.h" // must include first
 
 #include "platform/XWindowsScreen.h"
 
@@ -135,7 +135,7 @@ XWindowsScreen::XWindowsScreen(const char *displayName, bool isPrimary, IEventQu
   }
 
   // disable sleep if the flag is set
-  if (Settings::value(Settings::Core::PreventSleep).toBool()) {
+  if (SettingsSnapshot::current()->core.preventSleep) {
     m_powerManager.disableSleep();
   }
 
@@ -160,6 +160,10 @@ XWindowsScreen::~XWindowsScreen()
 
   m_events->adoptBuffer(nullptr);
   m_events->removeHandler(EventTypes::System, m_events->getSystemTarget());
+  if (m_fetchTimer != nullptr) {
+    m_events->removeHandler(EventTypes::Timer, m_fetchTimer);
+    m_events->deleteTimer(m_fetchTimer);
+  }
   for (auto clipboard : m_clipboard) {
     delete clipboard;
   }
@@ -448,6 +452,13 @@ bool XWindowsScreen::getClipboard(ClipboardID id, IClipboard *clipboard) const
   // get the actual time.  ICCCM does not allow CurrentTime.
   Time timestamp = XWindowsUtil::getCurrentTime(m_display, m_clipboard[id]->getWindow());
 
+  // the selection may have changed hands without us noticing so check
+  // it in the background.  meanwhile copy what we have, if that turns
+  // out to be stale ClipboardChanged is sent when the new data arrives.
+  if (!m_clipboard[id]->isFetching()) {
+    const_cast<XWindowsScreen *>(this)->fetchClipboard(id, timestamp);
+  }
+
   // copy the clipboard
   return Clipboard::copy(clipboard, m_clipboard[id], timestamp);
 }
@@ -1217,15 +1228,23 @@ void XWindowsScreen::handleSystemEvent(const Event &event)
     if (id != kClipboardEnd) {
       m_clipboard[id]->lost(xevent->xselectionclear.time);
       sendClipboardEvent(EventTypes::ClipboardGrabbed, id);
+
+      // start getting the new owner's data now so it's likely to be
+      // cached by the time it's asked for
+      fetchClipboard(id, xevent->xselectionclear.time);
       return;
     }
   } break;
 
   case SelectionNotify:
-    // notification of selection transferred.  we shouldn't
-    // get this here because we handle them in the selection
-    // retrieval methods.  we'll just delete the property
-    // with the data (satisfying the usual ICCCM protocol).
+    // notification of selection transferred
+    if (processClipboardFetch(xevent)) {
+      return;
+    }
+
+    // otherwise it's a reply to a retrieval that was abandoned.
+    // we'll just delete the property with the data (satisfying
+    // the usual ICCCM protocol).
     if (xevent->xselection.property != None) {
       XDeleteProperty(m_display, xevent->xselection.requestor, xevent->xselection.property);
     }
@@ -1244,9 +1263,12 @@ void XWindowsScreen::handleSystemEvent(const Event &event)
   } break;
 
   case PropertyNotify:
-    // property delete may be part of a selection conversion
+    // property delete may be part of a selection conversion,
+    // a new value part of a selection retrieval
     if (xevent->xproperty.state == PropertyDelete) {
       processClipboardRequest(xevent->xproperty.window, xevent->xproperty.time, xevent->xproperty.atom);
+    } else if (processClipboardFetch(xevent)) {
+      return;
     }
     break;
 
@@ -1603,6 +1625,67 @@ void XWindowsScreen::destroyClipboardRequest(Window requestor) const
   }
 }
 
+void XWindowsScreen::fetchClipboard(ClipboardID id, Time time)
+{
+  m_clipboard[id]->fetch(time);
+  updateFetchTimer();
+}
+
+bool XWindowsScreen::processClipboardFetch(const XEvent *xevent)
+{
+  using enum XWindowsClipboard::FetchStatus;
+
+  // check every clipboard until one recognizes the event
+  for (ClipboardID id = 0; id < kClipboardEnd; ++id) {
+    if (m_clipboard[id] == nullptr) {
+      continue;
+    }
+    if (const auto status = m_clipboard[id]->processFetchEvent(xevent); status != Ignored) {
+      onClipboardFetched(id, status == Changed);
+      return true;
+    }
+  }
+  return false;
+}
+
+void XWindowsScreen::onClipboardFetched(ClipboardID id, bool changed)
+{
+  if (changed) {
+    LOG_DEBUG("clipboard %d fetched", id);
+    sendClipboardEvent(EventTypes::ClipboardChanged, id);
+  }
+  updateFetchTimer();
+}
+
+void XWindowsScreen::updateFetchTimer()
+{
+  const bool fetching =
+      std::ranges::any_of(m_clipboard, [](const auto *clipboard) { return clipboard && clipboard->isFetching(); });
+  if (fetching && m_fetchTimer == nullptr) {
+    m_fetchTimer = m_events->newTimer(0.05, nullptr);
+    m_events->addHandler(EventTypes::Timer, m_fetchTimer, [this](const auto &) { handleFetchTimer(); });
+  } else if (!fetching && m_fetchTimer != nullptr) {
+    m_events->removeHandler(EventTypes::Timer, m_fetchTimer);
+    m_events->deleteTimer(m_fetchTimer);
+    m_fetchTimer = nullptr;
+  }
+}
+
+void XWindowsScreen::handleFetchTimer()
+{
+  using enum XWindowsClipboard::FetchStatus;
+
+  for (ClipboardID id = 0; id < kClipboardEnd; ++id) {
+    if (m_clipboard[id] == nullptr) {
+      continue;
+    }
+    if (const auto status = m_clipboard[id]->expireFetch(); status != Ignored && status != Pending) {
+      onClipboardFetched(id, status == Changed);
+    }
+  }
+  updateFetchTimer();
+}
+
 void XWindowsScreen::onError()
 {
   // prevent further access to the X display
@@ -20,6 +20,7 @@
 
 #include <X11/Xlib.h>
 
+class EventQueueTimer;
 class XWindowsClipboard;
 class XWindowsKeyState;
 class XWindowsScreenSaver;
@@ -101,6 +102,19 @@ private:
   // terminate a selection request
   void destroyClipboardRequest(Window window) const;
 
+  // retrieve a selection in the background.  when new data arrives
+  // a ClipboardChanged event is sent.
+  void fetchClipboard(ClipboardID id, Time time);
+
+  // continue retrieving a selection.  returns true iff the event was
+  // part of a retrieval.
+  bool processClipboardFetch(const XEvent *xevent);
+  void onClipboardFetched(ClipboardID id, bool changed);
+
+  // expire stalled selection retrievals while any are in progress
+  void updateFetchTimer();
+  void handleFetchTimer();
+
   // X I/O error handler
   void onError();
   static int ioErrorHandler(Display *);
@@ -207,6 +221,7 @@ private:
   // clipboards
   XWindowsClipboard *m_clipboard[kClipboardEnd];
   uint32_t m_sequenceNumber = 0;
+  EventQueueTimer *m_fetchTimer = nullptr;
 
   // screen saver stuff
   XWindowsScreenSaver *m_screensaver = nullptr;
@@ -9,6 +9,7 @@
 
 #include "deskflow/IClient.h"
 
+class ConnectionStats;
 namespace deskflow {
 class IStream;
 }
@@ -32,6 +33,16 @@ public:
   */
   void setJumpCursorPos(int32_t x, int32_t y);
 
+  //! Send input capture time
+  /*!
+  Tell the client when the next input event was captured on the primary,
+  as a LatencyHistogram::now() timestamp, if the client asked for it.
+  */
+  virtual void sendInputTime(uint64_t)
+  {
+    // do nothing
+  }
+
   //@}
   //! @name accessors
   //@{
@@ -51,6 +62,16 @@ public:
     return false;
   }
 
+  //! Get telemetry
+  /*!
+  Returns the stats for the connection to the client, or \c nullptr if
+  there is no connection (e.g. for the primary screen).
+  */
+  virtual ConnectionStats *getStats()
+  {
+    return nullptr;
+  }
+
   //@}
 
   // IScreen
@@ -12,8 +12,10 @@
 #include "arch/Arch.h"
 #include "base/IEventQueue.h"
 #include "base/Log.h"
+#include "common/SettingsSnapshot.h"
 #include "deskflow/PacketStreamFilter.h"
 #include "net/IDataSocket.h"
+#include "net/IDatagramSocket.h"
 #include "net/IListenSocket.h"
 #include "net/ISocketFactory.h"
 #include "net/SocketException.h"
@@ -161,8 +163,22 @@ void ClientListener::handleClientAccepted(IDataSocket *socket)
   deskflow::IStream *stream = new PacketStreamFilter(m_events, socket, false);
   assert(m_server != nullptr);
 
+  // offer a motion channel on the interface we listen on
+  MotionChannel::SocketFactory motionSockets;
+  if (SettingsSnapshot::current()->server.motionChannel) {
+    motionSockets = [this](int port) {
+      std::unique_ptr<IDatagramSocket> socket(
+          m_socketFactory->createDatagram(ARCH->getAddrFamily(m_address.getAddress()))
+      );
+      NetworkAddress address(m_address.getHostname(), port);
+      address.resolve();
+      socket->bind(address);
+      return socket.release();
+    };
+  }
+
   // create proxy for unknown client
-  auto *client = new ClientProxyUnknown(stream, 30.0, m_server, m_events);
+  auto *client = new ClientProxyUnknown(stream, 30.0, m_server, m_events, motionSockets);
 
   m_newClients.insert(client);
 
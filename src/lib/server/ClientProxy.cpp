@@ -8,6 +8,7 @@
 #include "server/ClientProxy.h"
 
 #include "base/Log.h"
+#include "deskflow/PacketStreamFilter.h"
 #include "deskflow/ProtocolUtil.h"
 #include "io/IStream.h"
 
@@ -15,9 +16,14 @@
 // ClientProxy
 //
 
-ClientProxy::ClientProxy(const std::string &name, deskflow::IStream *stream) : BaseClientProxy(name), m_stream(stream)
+ClientProxy::ClientProxy(const std::string &name, deskflow::IStream *stream)
+    : BaseClientProxy(name),
+      m_stream(stream),
+      m_stats(name)
 {
-  // do nothing
+  if (auto *filter = dynamic_cast<PacketStreamFilter *>(m_stream); filter != nullptr) {
+    filter->setStats(&m_stats);
+  }
 }
 
 ClientProxy::~ClientProxy()
@@ -25,20 +31,31 @@ ClientProxy::~ClientProxy()
   delete m_stream;
 }
 
-void ClientProxy::close(const char *msg) const
+void ClientProxy::close(const char *msg)
 {
   LOG_VERBOSE("send close \"%s\" to \"%s\"", msg, getName().c_str());
+  flushInput();
   ProtocolUtil::writef(getStream(), msg);
 
   // force the close to be sent before we return
   getStream()->flush();
 }
 
+void ClientProxy::flushInput()
+{
+  // do nothing
+}
+
 deskflow::IStream *ClientProxy::getStream() const
 {
   return m_stream;
 }
 
+ConnectionStats *ClientProxy::getStats()
+{
+  return &m_stats;
+}
+
 void *ClientProxy::getEventTarget() const
 {
   return static_cast<IScreen *>(const_cast<ClientProxy *>(this));
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include "deskflow/ConnectionStats.h"
 #include "server/BaseClientProxy.h"
 
 namespace deskflow {
@@ -35,7 +36,7 @@ public:
   /*!
   Ask the client to disconnect, using \p msg as the reason.
   */
-  void close(const char *msg) const;
+  void close(const char *msg);
 
   //@}
   //! @name accessors
@@ -47,6 +48,8 @@ public:
   */
   deskflow::IStream *getStream() const override;
 
+  ConnectionStats *getStats() override;
+
   //@}
 
   // IScreen
@@ -76,6 +79,16 @@ public:
   void fileChunkSending(uint8_t mark, char *data, size_t dataSize) override = 0;
   void secureInputNotification(const std::string &app) const override = 0;
 
+protected:
+  //! Send held back input
+  /*!
+  Called before writing a message that must reach the client after the
+  input already sent.  Overridden by proxies that hold input back to
+  batch it.
+  */
+  virtual void flushInput();
+
 private:
   deskflow::IStream *m_stream;
+  ConnectionStats m_stats;
 };
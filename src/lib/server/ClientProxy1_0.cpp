@@ -226,12 +226,14 @@ void ClientProxy1_0::getCursorPos(int32_t &x, int32_t &y) const
 void ClientProxy1_0::enter(int32_t xAbs, int32_t yAbs, uint32_t seqNum, KeyModifierMask mask, bool)
 {
   LOG_VERBOSE("send enter to \"%s\", %d,%d %d %04x", getName().c_str(), xAbs, yAbs, seqNum, mask);
+  flushInput();
   ProtocolUtil::writef(getStream(), kMsgCEnter, xAbs, yAbs, seqNum, mask);
 }
 
 bool ClientProxy1_0::leave()
 {
   LOG_VERBOSE("send leave to \"%s\"", getName().c_str());
+  flushInput();
   ProtocolUtil::writef(getStream(), kMsgCLeave);
 
   // we can never prevent the user from leaving
@@ -246,6 +248,7 @@ void ClientProxy1_0::setClipboard(ClipboardID id, const IClipboard *clipboard)
 void ClientProxy1_0::grabClipboard(ClipboardID id)
 {
   LOG_DEBUG("send grab clipboard %d to \"%s\"", id, getName().c_str());
+  flushInput();
   ProtocolUtil::writef(getStream(), kMsgCClipboard, id, 0);
 
   // this clipboard is now dirty
@@ -260,37 +263,37 @@ void ClientProxy1_0::setClipboardDirty(ClipboardID id, bool dirty)
 void ClientProxy1_0::keyDown(KeyID key, KeyModifierMask mask, KeyButton, const std::string &)
 {
   LOG_VERBOSE("send key down to \"%s\" id=%d, mask=0x%04x", getName().c_str(), key, mask);
-  ProtocolUtil::writef(getStream(), kMsgDKeyDown1_0, key, mask);
+  writeInput(kMsgDKeyDown1_0, key, mask);
 }
 
 void ClientProxy1_0::keyRepeat(KeyID key, KeyModifierMask mask, int32_t count, KeyButton, const std::string &)
 {
   LOG_VERBOSE("send key repeat to \"%s\" id=%d, mask=0x%04x, count=%d", getName().c_str(), key, mask, count);
-  ProtocolUtil::writef(getStream(), kMsgDKeyRepeat1_0, key, mask, count);
+  writeInput(kMsgDKeyRepeat1_0, key, mask, count);
 }
 
 void ClientProxy1_0::keyUp(KeyID key, KeyModifierMask mask, KeyButton)
 {
   LOG_VERBOSE("send key up to \"%s\" id=%d, mask=0x%04x", getName().c_str(), key, mask);
-  ProtocolUtil::writef(getStream(), kMsgDKeyUp1_0, key, mask);
+  writeInput(kMsgDKeyUp1_0, key, mask);
 }
 
 void ClientProxy1_0::mouseDown(ButtonID button)
 {
   LOG_VERBOSE("send mouse down to \"%s\" id=%d", getName().c_str(), button);
-  ProtocolUtil::writef(getStream(), kMsgDMouseDown, button);
+  writeInput(kMsgDMouseDown, button);
 }
 
 void ClientProxy1_0::mouseUp(ButtonID button)
 {
   LOG_VERBOSE("send mouse up to \"%s\" id=%d", getName().c_str(), button);
-  ProtocolUtil::writef(getStream(), kMsgDMouseUp, button);
+  writeInput(kMsgDMouseUp, button);
 }
 
 void ClientProxy1_0::mouseMove(int32_t xAbs, int32_t yAbs)
 {
   LOG_VERBOSE("send mouse move to \"%s\" %d,%d", getName().c_str(), xAbs, yAbs);
-  ProtocolUtil::writef(getStream(), kMsgDMouseMove, xAbs, yAbs);
+  writeInput(kMsgDMouseMove, xAbs, yAbs);
 }
 
 void ClientProxy1_0::mouseRelativeMove(int32_t, int32_t)
@@ -302,7 +305,12 @@ void ClientProxy1_0::mouseWheel(int32_t, int32_t yDelta)
 {
   // clients prior to 1.3 only support the y axis
   LOG_VERBOSE("send mouse wheel to \"%s\" %+d", getName().c_str(), yDelta);
-  ProtocolUtil::writef(getStream(), kMsgDMouseWheel1_0, yDelta);
+  writeInput(kMsgDMouseWheel1_0, yDelta);
+}
+
+void ClientProxy1_0::sendInput(const std::vector<uint8_t> &message)
+{
+  getStream()->write(message.data(), static_cast<uint32_t>(message.size()));
 }
 
 void ClientProxy1_0::sendDragInfo(uint32_t, const char *, size_t)
@@ -333,12 +341,14 @@ void ClientProxy1_0::secureInputNotification(const std::string &) const
 void ClientProxy1_0::screensaver(bool on)
 {
   LOG_VERBOSE("send screen saver to \"%s\" on=%d", getName().c_str(), on ? 1 : 0);
+  flushInput();
   ProtocolUtil::writef(getStream(), kMsgCScreenSaver, on ? 1 : 0);
 }
 
 void ClientProxy1_0::resetOptions()
 {
   LOG_VERBOSE("send reset options to \"%s\"", getName().c_str());
+  flushInput();
   ProtocolUtil::writef(getStream(), kMsgCResetOptions);
 
   // reset heart rate and death
@@ -355,6 +365,7 @@ void ClientProxy1_0::setOptions(const OptionsList &options)
     return;
   }
 
+  flushInput();
   ProtocolUtil::writef(getStream(), kMsgDSetOptions, &options);
 
   // check options
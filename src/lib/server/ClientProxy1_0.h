@@ -10,8 +10,11 @@
 
 #include "deskflow/Clipboard.h"
 #include "deskflow/ProtocolTypes.h"
+#include "deskflow/ProtocolUtil.h"
 #include "server/ClientProxy.h"
 
+#include <vector>
+
 class Event;
 class EventQueueTimer;
 class IEventQueue;
@@ -66,6 +69,25 @@ protected:
   virtual void removeHeartbeatTimer();
   virtual bool recvClipboard();
 
+  //! Send an input event
+  /*!
+  Formats the message as ProtocolUtil::writef() does and passes it to
+  sendInput().
+  */
+  template <typename... Args> void writeInput(const char *fmt, Args... args)
+  {
+    std::vector<uint8_t> message;
+    ProtocolUtil::appendf(message, fmt, args...);
+    sendInput(message);
+  }
+
+  //! Send a formatted input event
+  /*!
+  Writes \p message to the stream.  Overridden by proxies that can
+  batch input.
+  */
+  virtual void sendInput(const std::vector<uint8_t> &message);
+
 private:
   void disconnect();
   void removeHandlers();
@@ -23,7 +23,7 @@ ClientProxy1_1::ClientProxy1_1(const std::string &name, deskflow::IStream *strea
 void ClientProxy1_1::keyDown(KeyID key, KeyModifierMask mask, KeyButton button, const std::string &)
 {
   LOG_VERBOSE("send key down to \"%s\" id=%d, mask=0x%04x, button=0x%04x", getName().c_str(), key, mask, button);
-  ProtocolUtil::writef(getStream(), kMsgDKeyDown, key, mask, button);
+  writeInput(kMsgDKeyDown, key, mask, button);
 }
 
 void ClientProxy1_1::keyRepeat(
@@ -35,11 +35,11 @@ void ClientProxy1_1::keyRepeat(
                     "button=0x%04x, lang=\"%s\"",
        getName().c_str(), key, mask, count, button, lang.c_str())
   );
-  ProtocolUtil::writef(getStream(), kMsgDKeyRepeat, key, mask, count, button, &lang);
+  writeInput(kMsgDKeyRepeat, key, mask, count, button, &lang);
 }
 
 void ClientProxy1_1::keyUp(KeyID key, KeyModifierMask mask, KeyButton button)
 {
   LOG_VERBOSE("send key up to \"%s\" id=%d, mask=0x%04x, button=0x%04x", getName().c_str(), key, mask, button);
-  ProtocolUtil::writef(getStream(), kMsgDKeyUp, key, mask, button);
+  writeInput(kMsgDKeyUp, key, mask, button);
 }
@@ -9,7 +9,10 @@
 #include "server/ClientProxy1_3.h"
 
 #include "base/IEventQueue.h"
+#include "base/LatencyHistogram.h"
 #include "base/Log.h"
+#include "deskflow/ConnectionStats.h"
+#include "deskflow/OptionTypes.h"
 #include "deskflow/ProtocolUtil.h"
 
 #include <cstring>
@@ -29,12 +32,63 @@ ClientProxy1_3::~ClientProxy1_3()
 {
   // cannot do this in superclass or our override wouldn't get called
   removeHeartbeatTimer();
+
+  // input batched just before leaving or disconnecting still goes out
+  flushInput();
+}
+
+void ClientProxy1_3::setOptions(const OptionsList &options)
+{
+  // advertise timestamped keep-alives and input batches, clients that
+  // don't know the options ignore them
+  OptionsList withExtensions(options);
+  withExtensions.push_back(kOptionKeepAliveTimestamps);
+  withExtensions.push_back(1);
+  withExtensions.push_back(kOptionInputBatch);
+  withExtensions.push_back(1);
+  ClientProxy1_2::setOptions(withExtensions);
+}
+
+void ClientProxy1_3::sendInputTime(uint64_t captureTime)
+{
+  if (m_inputBatching) {
+    // the batch records it with the next event
+    m_inputTime = captureTime;
+  } else if (m_keepAliveTimestamps && captureTime != 0) {
+    // sampled, so motion doesn't cost two messages per event
+    if (m_inputTimeCountdown > 0) {
+      --m_inputTimeCountdown;
+      return;
+    }
+    m_inputTimeCountdown = kInputTimeInterval - 1;
+    ProtocolUtil::writef(
+        getStream(), kMsgDInputTime, static_cast<uint32_t>(captureTime >> 32), static_cast<uint32_t>(captureTime)
+    );
+  }
 }
 
 void ClientProxy1_3::mouseWheel(int32_t xDelta, int32_t yDelta)
 {
   LOG_VERBOSE("send mouse wheel to \"%s\" %+d,%+d", getName().c_str(), xDelta, yDelta);
-  ProtocolUtil::writef(getStream(), kMsgDMouseWheel, xDelta, yDelta);
+  writeInput(kMsgDMouseWheel, xDelta, yDelta);
+}
+
+void ClientProxy1_3::sendInput(const std::vector<uint8_t> &message)
+{
+  if (!m_inputBatching) {
+    ClientProxy1_2::sendInput(message);
+    return;
+  }
+
+  m_inputBatch.add(m_inputTime != 0 ? m_inputTime : LatencyHistogram::now(), message);
+  m_inputTime = 0;
+
+  if (m_inputBatch.getSize() >= kInputBatchSize) {
+    flushInput();
+  } else if (m_inputBatchTimer == nullptr) {
+    m_inputBatchTimer = m_events->newOneShotTimer(kInputBatchDelay, nullptr);
+    m_events->addHandler(EventTypes::Timer, m_inputBatchTimer, [this](const auto &) { flushInput(); });
+  }
 }
 
 bool ClientProxy1_3::parseMessage(const uint8_t *code)
@@ -44,6 +98,10 @@ bool ClientProxy1_3::parseMessage(const uint8_t *code)
     // reset alarm
     resetHeartbeatTimer();
     return true;
+  } else if (memcmp(code, kMsgCKeepAliveTime, 4) == 0) {
+    return recvKeepAliveTime();
+  } else if (memcmp(code, kMsgDInputBatch, 4) == 0) {
+    return recvInputBatch();
   } else {
     return ClientProxy1_2::parseMessage(code);
   }
@@ -95,4 +153,89 @@ void ClientProxy1_3::removeHeartbeatTimer()
 void ClientProxy1_3::keepAlive()
 {
   ProtocolUtil::writef(getStream(), kMsgCKeepAlive);
+
+  if (m_keepAliveTimestamps) {
+    const uint64_t now = LatencyHistogram::now();
+    ProtocolUtil::writef(
+        getStream(), kMsgCKeepAliveTime, static_cast<uint32_t>(now >> 32), static_cast<uint32_t>(now), 0, 0, 0, 0
+    );
+  }
+}
+
+bool ClientProxy1_3::recvKeepAliveTime()
+{
+  const uint64_t now = LatencyHistogram::now();
+
+  uint32_t originateHi;
+  uint32_t originateLo;
+  uint32_t receiveHi;
+  uint32_t receiveLo;
+  uint32_t transmitHi;
+  uint32_t transmitLo;
+  if (!ProtocolUtil::readf(
+          getStream(), kMsgCKeepAliveTime + 4, &originateHi, &originateLo, &receiveHi, &receiveLo, &transmitHi,
+          &transmitLo
+      )) {
+    return false;
+  }
+
+  const auto originate = static_cast<int64_t>((uint64_t{originateHi} << 32) | originateLo);
+  const auto receive = static_cast<int64_t>((uint64_t{receiveHi} << 32) | receiveLo);
+  const auto transmit = static_cast<int64_t>((uint64_t{transmitHi} << 32) | transmitLo);
+
+  if (receive == 0 && transmit == 0) {
+    // a request, so the client understands timestamps too
+    if (!m_keepAliveTimestamps) {
+      LOG_DEBUG("client \"%s\" supports timestamped keep alives", getName().c_str());
+      m_keepAliveTimestamps = true;
+    }
+
+    const uint64_t reply = LatencyHistogram::now();
+    ProtocolUtil::writef(
+        getStream(), kMsgCKeepAliveTime, originateHi, originateLo, static_cast<uint32_t>(now >> 32),
+        static_cast<uint32_t>(now), static_cast<uint32_t>(reply >> 32), static_cast<uint32_t>(reply)
+    );
+    return true;
+  }
+
+  // a reply to one of our requests
+  m_clock.addSample(originate, receive, transmit, static_cast<int64_t>(now));
+  getStats()->setClock(m_clock.rtt(), m_clock.offset());
+  LOG_VERBOSE(
+      "client \"%s\" rtt=%.3fms offset=%.3fms", getName().c_str(), static_cast<double>(m_clock.rtt()) / 1.0e6,
+      static_cast<double>(m_clock.offset()) / 1.0e6
+  );
+  return true;
+}
+
+bool ClientProxy1_3::recvInputBatch()
+{
+  uint32_t baseHi;
+  uint32_t baseLo;
+  std::string records;
+  if (!ProtocolUtil::readf(getStream(), kMsgDInputBatch + 4, &baseHi, &baseLo, &records)) {
+    return false;
+  }
+
+  // clients only ever send an empty batch, to say they understand them
+  if (!records.empty()) {
+    return false;
+  }
+
+  if (!m_inputBatching) {
+    LOG_DEBUG("client \"%s\" supports input batches", getName().c_str());
+    m_inputBatching = true;
+  }
+  return true;
+}
+
+void ClientProxy1_3::flushInput()
+{
+  if (m_inputBatchTimer != nullptr) {
+    m_events->removeHandler(EventTypes::Timer, m_inputBatchTimer);
+    m_events->deleteTimer(m_inputBatchTimer);
+    m_inputBatchTimer = nullptr;
+  }
+
+  m_inputBatch.send(getStream());
 }
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "deskflow/ClockOffsetEstimator.h"
+#include "deskflow/InputBatch.h"
 #include "server/ClientProxy1_2.h"
 
 //! Proxy for client implementing protocol version 1.3
@@ -23,10 +25,15 @@ public:
   ClientProxy1_3 &operator=(ClientProxy1_3 &&) = delete;
 
   // IClient overrides
+  void setOptions(const OptionsList &options) override;
   void mouseWheel(int32_t xDelta, int32_t yDelta) override;
 
+  // BaseClientProxy overrides
+  void sendInputTime(uint64_t captureTime) override;
+
 protected:
   // ClientProxy overrides
+  void flushInput() override;
   bool parseMessage(const uint8_t *code) override;
   void resetHeartbeatRate() override;
   void setHeartbeatRate(double rate, double alarm) override;
@@ -35,8 +42,21 @@ protected:
   void removeHeartbeatTimer() override;
   virtual void keepAlive();
 
+  // ClientProxy1_0 overrides
+  void sendInput(const std::vector<uint8_t> &message) override;
+
 private:
+  bool recvKeepAliveTime();
+  bool recvInputBatch();
+
   double m_keepAliveRate = kKeepAliveRate;
   EventQueueTimer *m_keepAliveTimer = nullptr;
   IEventQueue *m_events = nullptr;
+  bool m_keepAliveTimestamps = false;
+  ClockOffsetEstimator m_clock;
+  bool m_inputBatching = false;
+  uint64_t m_inputTime = 0;
+  uint32_t m_inputTimeCountdown = 0;
+  InputBatch m_inputBatch;
+  EventQueueTimer *m_inputBatchTimer = nullptr;
 };
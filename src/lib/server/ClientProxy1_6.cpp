@@ -8,27 +8,48 @@
 
 #include "base/Log.h"
 #include "deskflow/ClipboardChunk.h"
+#include "deskflow/OptionTypes.h"
+#include "deskflow/ProtocolTypes.h"
 #include "deskflow/ProtocolUtil.h"
-#include "deskflow/StreamChunker.h"
 #include "io/IStream.h"
 #include "server/Server.h"
 
+#include <cstring>
+
 //
 // ClientProxy1_6
 //
 
 ClientProxy1_6::ClientProxy1_6(const std::string &name, deskflow::IStream *stream, Server *server, IEventQueue *events)
     : ClientProxy1_5(name, stream, server, events),
-      m_events(events)
+      m_events(events),
+      m_clipboardChunker(events, this)
 {
   m_events->addHandler(EventTypes::ClipboardSending, this, [this](const auto &e) {
+    flushInput();
     ClipboardChunk::send(getStream(), e.getDataObject());
+    m_clipboardChunker.sent();
   });
 }
 
 ClientProxy1_6::~ClientProxy1_6()
 {
   m_events->removeHandler(EventTypes::ClipboardSending, this);
+
+  // a resumable transfer cut short can carry on if the client comes back
+  if (m_clipboardChunkState.active && m_clipboardChunkState.transferId != 0) {
+    m_server->getClipboardPartials(getName()).keep(m_clipboardChunkState, std::move(m_clipboardDataCached));
+  }
+}
+
+void ClientProxy1_6::setOptions(const OptionsList &options)
+{
+  // advertise resumable clipboard transfers, clients that don't know the
+  // option ignore it
+  OptionsList withResume(options);
+  withResume.push_back(kOptionClipboardResume);
+  withResume.push_back(1);
+  ClientProxy1_5::setOptions(withResume);
 }
 
 void ClientProxy1_6::setClipboard(ClipboardID id, const IClipboard *clipboard)
@@ -39,12 +60,12 @@ void ClientProxy1_6::setClipboard(ClipboardID id, const IClipboard *clipboard)
     m_clipboard[id].m_dirty = false;
     Clipboard::copy(&m_clipboard[id].m_clipboard, clipboard);
 
-    std::string data = m_clipboard[id].m_clipboard.marshall();
-
-    size_t size = data.size();
+    // sends the server's snapshot rather than marshalling the clipboard
+    // again for each client
+    const auto snapshot = Clipboard::snapshotOf(clipboard);
     LOG_DEBUG("sending clipboard %d to \"%s\"", id, getName().c_str());
 
-    StreamChunker::sendClipboard(data, size, id, 0, m_events, this);
+    m_clipboardChunker.sendClipboard(snapshot, id, 0, m_clipboardResume ? &m_clipboardResumePoints[id] : nullptr);
   }
 }
 
@@ -55,7 +76,8 @@ bool ClientProxy1_6::recvClipboard()
   uint32_t seq;
 
   auto r = ClipboardChunk::assemble(
-      getStream(), m_clipboardDataCached, id, seq, m_clipboardChunkState, m_server->getMaximumClipboardSizeBytes()
+      getStream(), m_clipboardDataCached, id, seq, m_clipboardChunkState, m_server->getMaximumClipboardSizeBytes(),
+      &m_server->getClipboardPartials(getName())
   );
 
   if (r == TransferState::Started) {
@@ -67,10 +89,9 @@ bool ClientProxy1_6::recvClipboard()
          m_clipboardDataCached.size())
     );
     // save clipboard
-    m_clipboard[id].m_clipboard.unmarshall(m_clipboardDataCached, 0);
+    m_clipboard[id].m_clipboard.unmarshall(m_clipboardDataCached.view(), 0);
     m_clipboard[id].m_sequenceNumber = seq;
     m_clipboardDataCached.clear();
-    m_clipboardDataCached.shrink_to_fit();
 
     // notify
     auto *info = new ClipboardInfo;
@@ -83,3 +104,29 @@ bool ClientProxy1_6::recvClipboard()
 
   return true;
 }
+
+bool ClientProxy1_6::parseMessage(const uint8_t *code)
+{
+  if (memcmp(code, kMsgDClipboardResume, 4) == 0) {
+    return recvClipboardResume();
+  }
+  return ClientProxy1_5::parseMessage(code);
+}
+
+bool ClientProxy1_6::recvClipboardResume()
+{
+  ClipboardID id;
+  ClipboardResumePoint point;
+  if (!ClipboardPartials::readOffset(getStream(), id, point)) {
+    return false;
+  }
+  m_clipboardResumePoints[id] = point;
+
+  // answer with what we kept from the client
+  if (!m_clipboardResume) {
+    LOG_DEBUG("client \"%s\" supports resumable clipboard transfers", getName().c_str());
+    m_clipboardResume = true;
+    m_server->getClipboardPartials(getName()).sendOffsets(getStream());
+  }
+  return true;
+}
@@ -7,8 +7,12 @@
 #pragma once
 
 #include "deskflow/ClipboardChunk.h"
+#include "deskflow/ClipboardBuffer.h"
+#include "deskflow/ClipboardPartials.h"
+#include "deskflow/StreamChunker.h"
 #include "server/ClientProxy1_5.h"
 
+#include <array>
 #include <string>
 
 class Server;
@@ -21,11 +25,22 @@ public:
   ClientProxy1_6(const std::string &name, deskflow::IStream *adoptedStream, Server *server, IEventQueue *events);
   ~ClientProxy1_6() override;
 
+  void setOptions(const OptionsList &options) override;
   void setClipboard(ClipboardID id, const IClipboard *clipboard) override;
   bool recvClipboard() override;
 
+protected:
+  bool parseMessage(const uint8_t *code) override;
+
 private:
+  bool recvClipboardResume();
+
   IEventQueue *m_events;
-  std::string m_clipboardDataCached;
+  StreamChunker m_clipboardChunker;
+  ClipboardBuffer m_clipboardDataCached;
   ClipboardChunkAssemblyState m_clipboardChunkState;
+
+  // set once the client has said it supports resumable transfers
+  bool m_clipboardResume = false;
+  std::array<ClipboardResumePoint, kClipboardEnd> m_clipboardResumePoints;
 };
@@ -18,9 +18,10 @@ ClientProxy1_8::ClientProxy1_8(
   synchronizeLanguages();
 }
 
-void ClientProxy1_8::synchronizeLanguages() const
+void ClientProxy1_8::synchronizeLanguages()
 {
   deskflow::KeyboardLayoutManager layoutManager;
+  m_languages = layoutManager.getLocalLayouts();
   auto localLayouts = layoutManager.getSerializedLocalLayouts();
   if (!localLayouts.empty()) {
     LOG_VERBOSE("send server languages to the client: %s", localLayouts.c_str());
@@ -36,5 +37,5 @@ void ClientProxy1_8::keyDown(KeyID key, KeyModifierMask mask, KeyButton button,
       (CLOG_VERBOSE "send key down to \"%s\" id=%d, mask=0x%04x, button=0x%04x, layout=%s", getName().c_str(), key,
        mask, button, language.c_str())
   );
-  ProtocolUtil::writef(getStream(), kMsgDKeyDownLang, key, mask, button, &language);
+  writeInput(kMsgDKeyDownLang, key, mask, button, &language);
 }
@@ -8,6 +8,9 @@
 
 #include "server/ClientProxy1_7.h"
 
+#include <string>
+#include <vector>
+
 class ClientProxy1_8 : public ClientProxy1_7
 {
 public:
@@ -16,6 +19,10 @@ public:
 
   void keyDown(KeyID, KeyModifierMask, KeyButton, const std::string &) override;
 
+protected:
+  //! Languages sent to the client, in order
+  std::vector<std::string> m_languages;
+
 private:
-  void synchronizeLanguages() const;
+  void synchronizeLanguages();
 };
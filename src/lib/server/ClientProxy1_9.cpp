@@ -0,0 +1,200 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "server/ClientProxy1_9.h"
+
+#include "base/Log.h"
+#include "deskflow/OptionTypes.h"
+#include "deskflow/ProtocolUtil.h"
+#include "net/IDatagramSocket.h"
+
+#include <algorithm>
+#include <cstring>
+
+//
+// ClientProxy1_9
+//
+
+ClientProxy1_9::ClientProxy1_9(
+    const std::string &name, deskflow::IStream *adoptedStream, Server *server, IEventQueue *events,
+    IDatagramSocket *adoptedMotionSocket
+)
+    : ClientProxy1_8(name, adoptedStream, server, events),
+      m_events(events),
+      m_motionSocket(adoptedMotionSocket)
+{
+  // do nothing
+}
+
+ClientProxy1_9::~ClientProxy1_9() = default;
+
+void ClientProxy1_9::setOptions(const OptionsList &options)
+{
+  // only offered until the client opens it
+  if (m_motionSocket == nullptr) {
+    ClientProxy1_8::setOptions(options);
+    return;
+  }
+
+  OptionsList withChannel(options);
+  withChannel.push_back(kOptionMotionChannel);
+  withChannel.push_back(static_cast<OptionValue>(m_motionSocket->getPort()));
+  ClientProxy1_8::setOptions(withChannel);
+}
+
+void ClientProxy1_9::enter(int32_t xAbs, int32_t yAbs, uint32_t seqNum, KeyModifierMask mask, bool forScreensaver)
+{
+  // motion after this is relative to where we entered
+  m_xMouse = xAbs;
+  m_yMouse = yAbs;
+  ClientProxy1_8::enter(xAbs, yAbs, seqNum, mask, forScreensaver);
+}
+
+void ClientProxy1_9::keyDown(KeyID key, KeyModifierMask mask, KeyButton button, const std::string &language)
+{
+  const int index = languageIndex(language);
+  if (index < 0) {
+    ClientProxy1_8::keyDown(key, mask, button, language);
+    return;
+  }
+
+  LOG_VERBOSE(
+      "send key down to \"%s\" id=%d, mask=0x%04x, button=0x%04x, layout=%s", getName().c_str(), key, mask, button,
+      language.c_str()
+  );
+  writeInput(kMsgDKeyDownLangId, key, mask, button, index);
+}
+
+void ClientProxy1_9::mouseMove(int32_t xAbs, int32_t yAbs)
+{
+  LOG_VERBOSE("send mouse move to \"%s\" %d,%d", getName().c_str(), xAbs, yAbs);
+  if (isMotionChannelReady() && m_motionChannel->sendMove(xAbs, yAbs)) {
+    m_motionSequence = m_motionChannel->getSequence();
+    m_motionUnsynced = true;
+  } else {
+    writeInput(kMsgDMouseMoveDelta, xAbs - m_xMouse, yAbs - m_yMouse);
+  }
+  m_xMouse = xAbs;
+  m_yMouse = yAbs;
+}
+
+void ClientProxy1_9::mouseRelativeMove(int32_t xRel, int32_t yRel)
+{
+  LOG_VERBOSE("send mouse relative move to \"%s\" %d,%d", getName().c_str(), xRel, yRel);
+  if (!isMotionChannelReady() || !m_motionChannel->sendRelativeMove(xRel, yRel)) {
+    writeInput(kMsgDMouseRelMoveCompact, xRel, yRel);
+  }
+}
+
+void ClientProxy1_9::mouseWheel(int32_t xDelta, int32_t yDelta)
+{
+  LOG_VERBOSE("send mouse wheel to \"%s\" %+d,%+d", getName().c_str(), xDelta, yDelta);
+  writeInput(kMsgDMouseWheelCompact, xDelta, yDelta);
+}
+
+bool ClientProxy1_9::leave()
+{
+  // motion still on its way mustn't land after the leave
+  syncMotion();
+  return ClientProxy1_8::leave();
+}
+
+bool ClientProxy1_9::parseMessage(const uint8_t *code)
+{
+  if (memcmp(code, kMsgDMotionChannel, 4) == 0) {
+    return recvMotionChannel();
+  } else if (memcmp(code, kMsgCMotionChannelReady, 4) == 0) {
+    if (m_motionChannel == nullptr) {
+      return false;
+    }
+    LOG_DEBUG("sending motion to \"%s\" on the motion channel", getName().c_str());
+    m_motionReady = true;
+    return true;
+  } else {
+    return ClientProxy1_8::parseMessage(code);
+  }
+}
+
+void ClientProxy1_9::sendInput(const std::vector<uint8_t> &message)
+{
+  syncMotion();
+  ClientProxy1_8::sendInput(message);
+}
+
+int ClientProxy1_9::languageIndex(const std::string &language) const
+{
+  // the client splits the list into two letter codes, so an index only
+  // means the same thing to both sides if every code is two letters
+  if (language.empty() || m_languages.size() > 0xff ||
+      !std::ranges::all_of(m_languages, [](const std::string &code) { return code.size() == 2; })) {
+    return -1;
+  }
+
+  const auto it = std::ranges::find(m_languages, language);
+  if (it == m_languages.end()) {
+    return -1;
+  }
+  return static_cast<int>(it - m_languages.begin());
+}
+
+bool ClientProxy1_9::recvMotionChannel()
+{
+  std::string key;
+  if (!ProtocolUtil::readf(getStream(), kMsgDMotionChannel + 4, &key) || key.size() != MotionChannel::kKeySize) {
+    return false;
+  }
+
+  if (m_motionSocket == nullptr) {
+    // we didn't offer one or it's already open, only one per connection
+    LOG_DEBUG("ignoring motion channel from \"%s\"", getName().c_str());
+    return true;
+  }
+
+  LOG_DEBUG("waiting for \"%s\" on motion channel port %d", getName().c_str(), m_motionSocket->getPort());
+  m_motionChannel = std::make_unique<MotionChannel>(m_events, m_motionSocket.release(), key);
+  m_motionChannel->accept();
+  return true;
+}
+
+bool ClientProxy1_9::isMotionChannelUp()
+{
+  if (!m_motionReady) {
+    return false;
+  }
+  if (m_motionChannel->isAlive()) {
+    return true;
+  }
+
+  // the client stopped greeting us, it's TCP from now on
+  LOG_INFO("motion channel to \"%s\" timed out, sending motion on TCP", getName().c_str());
+  m_motionReady = false;
+  m_motionChannel.reset();
+  return false;
+}
+
+bool ClientProxy1_9::isMotionChannelReady()
+{
+  if (!isMotionChannelUp()) {
+    return false;
+  }
+
+  // the datagram goes at once, so input batched before it has to as well
+  // or the client would apply it at the new position
+  flushInput();
+  return true;
+}
+
+void ClientProxy1_9::syncMotion()
+{
+  if (!m_motionUnsynced) {
+    return;
+  }
+
+  // clear first, writing goes through sendInput() again.  the channel may
+  // be gone by now, which is when the client needs this the most
+  m_motionUnsynced = false;
+  writeInput(kMsgDMouseMoveSync, m_motionSequence, m_xMouse, m_yMouse);
+}
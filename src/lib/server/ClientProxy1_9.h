@@ -0,0 +1,79 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "deskflow/MotionChannel.h"
+#include "server/ClientProxy1_8.h"
+
+#include <memory>
+
+//! Proxy for client implementing protocol version 1.9
+/*!
+Sends motion and wheel as zig-zag varints, with absolute motion relative
+to the last position sent, and key presses with the index of their
+language in the list sent at connection instead of its code.
+
+Pointer motion goes on a \c MotionChannel when the client opens one.
+*/
+class ClientProxy1_9 : public ClientProxy1_8
+{
+public:
+  /*!
+  Offers the client a motion channel on \p adoptedMotionSocket, which
+  must be bound, unless it's nullptr.
+  */
+  ClientProxy1_9(
+      const std::string &name, deskflow::IStream *adoptedStream, Server *server, IEventQueue *events,
+      IDatagramSocket *adoptedMotionSocket = nullptr
+  );
+  ClientProxy1_9(ClientProxy1_9 const &) = delete;
+  ClientProxy1_9(ClientProxy1_9 &&) = delete;
+  ~ClientProxy1_9() override;
+
+  ClientProxy1_9 &operator=(ClientProxy1_9 const &) = delete;
+  ClientProxy1_9 &operator=(ClientProxy1_9 &&) = delete;
+
+  // IClient overrides
+  void setOptions(const OptionsList &options) override;
+  void enter(int32_t xAbs, int32_t yAbs, uint32_t seqNum, KeyModifierMask mask, bool forScreensaver) override;
+  void keyDown(KeyID, KeyModifierMask, KeyButton, const std::string &) override;
+  void mouseMove(int32_t xAbs, int32_t yAbs) override;
+  void mouseRelativeMove(int32_t xRel, int32_t yRel) override;
+  void mouseWheel(int32_t xDelta, int32_t yDelta) override;
+  bool leave() override;
+
+protected:
+  // ClientProxy overrides
+  bool parseMessage(const uint8_t *code) override;
+
+  // ClientProxy1_0 overrides
+  void sendInput(const std::vector<uint8_t> &message) override;
+
+private:
+  // index of a language in the list the client has, or -1
+  int languageIndex(const std::string &language) const;
+
+  bool recvMotionChannel();
+
+  // true if motion can go on the channel, drops the channel if it died
+  bool isMotionChannelUp();
+
+  // like isMotionChannelUp(), and sends any batched input first
+  bool isMotionChannelReady();
+
+  // tell the client where motion on the channel left the pointer
+  void syncMotion();
+
+  int32_t m_xMouse = 0;
+  int32_t m_yMouse = 0;
+  IEventQueue *m_events;
+  std::unique_ptr<IDatagramSocket> m_motionSocket;
+  std::unique_ptr<MotionChannel> m_motionChannel;
+  bool m_motionReady = false;
+  bool m_motionUnsynced = false;
+  uint32_t m_motionSequence = 0;
+};
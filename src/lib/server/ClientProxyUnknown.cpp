@@ -8,6 +8,7 @@
 
 #include "server/ClientProxyUnknown.h"
 
+#include "base/BaseException.h"
 #include "base/IEventQueue.h"
 #include "base/Log.h"
 #include "deskflow/DeskflowException.h"
@@ -23,16 +24,21 @@
 #include "server/ClientProxy1_6.h"
 #include "server/ClientProxy1_7.h"
 #include "server/ClientProxy1_8.h"
+#include "server/ClientProxy1_9.h"
 #include "server/Server.h"
 
 //
 // ClientProxyUnknown
 //
 
-ClientProxyUnknown::ClientProxyUnknown(deskflow::IStream *stream, double timeout, Server *server, IEventQueue *events)
+ClientProxyUnknown::ClientProxyUnknown(
+    deskflow::IStream *stream, double timeout, Server *server, IEventQueue *events,
+    const MotionChannel::SocketFactory &motionSockets
+)
     : m_stream(stream),
       m_server(server),
-      m_events(events)
+      m_events(events),
+      m_motionSockets(motionSockets)
 {
   assert(m_server != nullptr);
 
@@ -177,6 +183,10 @@ void ClientProxyUnknown::initProxy(const std::string &name, int major, int minor
       m_proxy = new ClientProxy1_8(name, m_stream, m_server, m_events);
       break;
 
+    case 9:
+      m_proxy = new ClientProxy1_9(name, m_stream, m_server, m_events, newMotionSocket());
+      break;
+
     default:
       break;
     }
@@ -260,3 +270,18 @@ void ClientProxyUnknown::handleDisconnect()
   LOG_INFO("new client disconnected");
   sendFailure();
 }
+
+IDatagramSocket *ClientProxyUnknown::newMotionSocket() const
+{
+  if (!m_motionSockets) {
+    return nullptr;
+  }
+
+  // without a channel motion just stays on TCP
+  try {
+    return m_motionSockets(0);
+  } catch (BaseException &e) {
+    LOG_WARN("can't offer motion channel: %s", e.what());
+    return nullptr;
+  }
+}
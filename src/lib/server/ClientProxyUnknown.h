@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "deskflow/MotionChannel.h"
+
 #include <string>
 
 class ClientProxy;
@@ -21,7 +23,14 @@ class IEventQueue;
 class ClientProxyUnknown
 {
 public:
-  ClientProxyUnknown(deskflow::IStream *stream, double timeout, Server *server, IEventQueue *events);
+  /*!
+  \p motionSockets makes the socket for a motion channel offered to
+  clients that support one, or is empty not to offer any.
+  */
+  ClientProxyUnknown(
+      deskflow::IStream *stream, double timeout, Server *server, IEventQueue *events,
+      const MotionChannel::SocketFactory &motionSockets = {}
+  );
   ClientProxyUnknown(ClientProxyUnknown const &) = delete;
   ClientProxyUnknown(ClientProxyUnknown &&) = delete;
   ~ClientProxyUnknown();
@@ -60,6 +69,7 @@ private:
   void handleWriteError();
   void handleTimeout();
   void handleDisconnect();
+  IDatagramSocket *newMotionSocket() const;
 
 private:
   deskflow::IStream *m_stream = nullptr;
@@ -68,4 +78,5 @@ private:
   bool m_ready = false;
   Server *m_server = nullptr;
   IEventQueue *m_events = nullptr;
+  MotionChannel::SocketFactory m_motionSockets;
 };
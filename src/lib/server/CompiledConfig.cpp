@@ -0,0 +1,486 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "server/CompiledConfig.h"
+
+#include "base/Log.h"
+#include "net/SocketException.h"
+#include "server/Config.h"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+namespace deskflow::server {
+
+namespace {
+
+const char kMagic[] = {'D', 'F', 'C', 'C'};
+const uint32_t kVersion = 1;
+
+// magic, version, payload size and checksum
+const size_t kHeaderSize = sizeof(kMagic) + 3 * sizeof(uint32_t);
+
+enum class ConditionType : uint8_t
+{
+  None,
+  Keystroke,
+  MouseButton,
+  ScreenConnected
+};
+
+enum class ActionType : uint8_t
+{
+  LockCursorToScreen,
+  RestartServer,
+  SwitchToScreen,
+  SwitchInDirection,
+  SwitchToNextScreen,
+  KeyboardBroadcast,
+  Keystroke,
+  MouseButton
+};
+
+// FNV-1a, enough to catch a truncated or damaged file
+uint32_t checksum(std::string_view data)
+{
+  uint32_t hash = 2166136261u;
+  for (const auto c : data) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+  }
+  return hash;
+}
+
+class Writer
+{
+public:
+  void u8(uint8_t value)
+  {
+    m_data.push_back(static_cast<char>(value));
+  }
+
+  void u32(uint32_t value)
+  {
+    for (int shift = 0; shift < 32; shift += 8) {
+      m_data.push_back(static_cast<char>((value >> shift) & 0xff));
+    }
+  }
+
+  void i32(int32_t value)
+  {
+    u32(static_cast<uint32_t>(value));
+  }
+
+  void f32(float value)
+  {
+    u32(std::bit_cast<uint32_t>(value));
+  }
+
+  void str(std::string_view value)
+  {
+    u32(static_cast<uint32_t>(value.size()));
+    m_data.append(value);
+  }
+
+  std::string &data()
+  {
+    return m_data;
+  }
+
+private:
+  std::string m_data;
+};
+
+class Reader
+{
+public:
+  explicit Reader(std::string_view data) : m_data(data)
+  {
+    // do nothing
+  }
+
+  uint8_t u8()
+  {
+    return static_cast<uint8_t>(take(1)[0]);
+  }
+
+  uint32_t u32()
+  {
+    const auto bytes = take(4);
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; --i) {
+      value = (value << 8) | static_cast<uint8_t>(bytes[i]);
+    }
+    return value;
+  }
+
+  int32_t i32()
+  {
+    return static_cast<int32_t>(u32());
+  }
+
+  float f32()
+  {
+    return std::bit_cast<float>(u32());
+  }
+
+  std::string str()
+  {
+    const auto size = u32();
+    return std::string(take(size));
+  }
+
+  Direction direction()
+  {
+    const auto value = u8();
+    if (value < static_cast<uint8_t>(Direction::FirstDirection) ||
+        value > static_cast<uint8_t>(Direction::LastDirection)) {
+      throw ServerConfigReadException("compiled config has an invalid direction");
+    }
+    return static_cast<Direction>(value);
+  }
+
+  Config::Interval interval()
+  {
+    const auto start = f32();
+    const auto end = f32();
+    if (!(start >= 0.0f && end <= 1.0f && start < end)) {
+      throw ServerConfigReadException("compiled config has an invalid interval");
+    }
+    return {start, end};
+  }
+
+  bool atEnd() const
+  {
+    return m_data.empty();
+  }
+
+private:
+  std::string_view take(size_t size)
+  {
+    if (size > m_data.size()) {
+      throw ServerConfigReadException("compiled config is truncated");
+    }
+    const auto bytes = m_data.substr(0, size);
+    m_data.remove_prefix(size);
+    return bytes;
+  }
+
+  std::string_view m_data;
+};
+
+void writeOptions(Writer &out, const Config::ScreenOptions &options)
+{
+  out.u32(static_cast<uint32_t>(options.size()));
+  for (const auto &[id, value] : options) {
+    out.u32(id);
+    out.i32(value);
+  }
+}
+
+void readOptions(Reader &in, Config::ScreenOptions &options)
+{
+  for (auto count = in.u32(); count > 0; --count) {
+    const auto id = in.u32();
+    options.insert_or_assign(options.end(), id, in.i32());
+  }
+}
+
+bool writeCondition(Writer &out, const InputFilter::Condition *condition)
+{
+  using enum ConditionType;
+  if (condition == nullptr) {
+    out.u8(static_cast<uint8_t>(None));
+  } else if (auto *keystroke = dynamic_cast<const InputFilter::KeystrokeCondition *>(condition)) {
+    out.u8(static_cast<uint8_t>(Keystroke));
+    out.u32(keystroke->getKey());
+    out.u32(keystroke->getMask());
+  } else if (auto *button = dynamic_cast<const InputFilter::MouseButtonCondition *>(condition)) {
+    out.u8(static_cast<uint8_t>(MouseButton));
+    out.u8(button->getButton());
+    out.u32(button->getMask());
+  } else if (auto *connected = dynamic_cast<const InputFilter::ScreenConnectedCondition *>(condition)) {
+    out.u8(static_cast<uint8_t>(ScreenConnected));
+    out.str(connected->getScreen());
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool writeAction(Writer &out, const InputFilter::Action &action)
+{
+  using enum ActionType;
+  if (auto *lock = dynamic_cast<const InputFilter::LockCursorToScreenAction *>(&action)) {
+    out.u8(static_cast<uint8_t>(LockCursorToScreen));
+    out.u8(static_cast<uint8_t>(lock->getMode()));
+  } else if (auto *restart = dynamic_cast<const InputFilter::RestartServer *>(&action)) {
+    out.u8(static_cast<uint8_t>(RestartServer));
+    out.u8(static_cast<uint8_t>(restart->getMode()));
+  } else if (auto *switchTo = dynamic_cast<const InputFilter::SwitchToScreenAction *>(&action)) {
+    out.u8(static_cast<uint8_t>(SwitchToScreen));
+    out.str(switchTo->getScreen());
+  } else if (auto *switchIn = dynamic_cast<const InputFilter::SwitchInDirectionAction *>(&action)) {
+    out.u8(static_cast<uint8_t>(SwitchInDirection));
+    out.u8(static_cast<uint8_t>(switchIn->getDirection()));
+  } else if (dynamic_cast<const InputFilter::SwitchToNextScreenAction *>(&action) != nullptr) {
+    out.u8(static_cast<uint8_t>(SwitchToNextScreen));
+  } else if (auto *broadcast = dynamic_cast<const InputFilter::KeyboardBroadcastAction *>(&action)) {
+    out.u8(static_cast<uint8_t>(KeyboardBroadcast));
+    out.u8(static_cast<uint8_t>(broadcast->getMode()));
+    out.str(IKeyState::KeyInfo::join(broadcast->getScreens()));
+  } else if (auto *keystroke = dynamic_cast<const InputFilter::KeystrokeAction *>(&action)) {
+    const auto *info = keystroke->getInfo();
+    out.u8(static_cast<uint8_t>(Keystroke));
+    out.u8(keystroke->isOnPress() ? 1 : 0);
+    out.u32(info->m_key);
+    out.u32(info->m_mask);
+    out.u32(info->m_button);
+    out.i32(info->m_count);
+    out.str(info->m_screens);
+  } else if (auto *button = dynamic_cast<const InputFilter::MouseButtonAction *>(&action)) {
+    out.u8(static_cast<uint8_t>(MouseButton));
+    out.u8(button->isOnPress() ? 1 : 0);
+    out.u8(button->getInfo().m_button);
+    out.u32(button->getInfo().m_mask);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+InputFilter::Condition *readCondition(Reader &in, IEventQueue *events)
+{
+  using enum ConditionType;
+  switch (static_cast<ConditionType>(in.u8())) {
+  case None:
+    return nullptr;
+
+  case Keystroke: {
+    const auto key = in.u32();
+    return new InputFilter::KeystrokeCondition(events, key, in.u32());
+  }
+
+  case MouseButton: {
+    const auto button = in.u8();
+    return new InputFilter::MouseButtonCondition(events, button, in.u32());
+  }
+
+  case ScreenConnected:
+    return new InputFilter::ScreenConnectedCondition(events, in.str());
+  }
+  throw ServerConfigReadException("compiled config has an unknown condition");
+}
+
+InputFilter::Action *readAction(Reader &in, IEventQueue *events, bool &locksToScreen)
+{
+  using enum ActionType;
+  switch (static_cast<ActionType>(in.u8())) {
+  case LockCursorToScreen: {
+    const auto mode = in.u8();
+    if (mode > InputFilter::LockCursorToScreenAction::kToggle) {
+      break;
+    }
+    if (mode != InputFilter::LockCursorToScreenAction::kOff) {
+      locksToScreen = true;
+    }
+    return new InputFilter::LockCursorToScreenAction(
+        events, static_cast<InputFilter::LockCursorToScreenAction::Mode>(mode)
+    );
+  }
+
+  case RestartServer:
+    if (in.u8() != InputFilter::RestartServer::restart) {
+      break;
+    }
+    return new InputFilter::RestartServer(InputFilter::RestartServer::restart);
+
+  case SwitchToScreen:
+    return new InputFilter::SwitchToScreenAction(events, in.str());
+
+  case SwitchInDirection:
+    return new InputFilter::SwitchInDirectionAction(events, in.direction());
+
+  case SwitchToNextScreen:
+    return new InputFilter::SwitchToNextScreenAction(events);
+
+  case KeyboardBroadcast: {
+    const auto mode = in.u8();
+    if (mode > InputFilter::KeyboardBroadcastAction::kToggle) {
+      break;
+    }
+    std::set<std::string> screens;
+    IKeyState::KeyInfo::split(in.str().c_str(), screens);
+    return new InputFilter::KeyboardBroadcastAction(
+        events, static_cast<InputFilter::KeyboardBroadcastAction::Mode>(mode), screens
+    );
+  }
+
+  case Keystroke: {
+    const bool press = in.u8() != 0;
+    const auto key = in.u32();
+    const auto mask = in.u32();
+    const auto button = static_cast<KeyButton>(in.u32());
+    const auto count = in.i32();
+    auto *info = IKeyState::KeyInfo::alloc(key, mask, button, count);
+    info->m_screens = in.str();
+    return new InputFilter::KeystrokeAction(events, info, press);
+  }
+
+  case MouseButton: {
+    const bool press = in.u8() != 0;
+    const auto button = in.u8();
+    return new InputFilter::MouseButtonAction(events, IPlatformScreen::ButtonInfo(button, in.u32()), press);
+  }
+  }
+  throw ServerConfigReadException("compiled config has an unknown action");
+}
+
+void writeRules(Writer &out, const InputFilter &filter)
+{
+  // rules that can't be written are left out, so count them first
+  std::vector<std::string> rules;
+  for (uint32_t i = 0; i < filter.getNumRules(); ++i) {
+    const auto &rule = filter.getRule(i);
+    Writer ruleOut;
+    bool written = writeCondition(ruleOut, rule.getCondition());
+    for (const bool onActivation : {true, false}) {
+      ruleOut.u32(rule.getNumActions(onActivation));
+      for (uint32_t j = 0; written && j < rule.getNumActions(onActivation); ++j) {
+        written = writeAction(ruleOut, rule.getAction(onActivation, j));
+      }
+    }
+    if (written) {
+      rules.push_back(std::move(ruleOut.data()));
+    } else {
+      LOG_WARN("hot key cannot be compiled, skipping: %s", rule.format().c_str());
+    }
+  }
+
+  out.u32(static_cast<uint32_t>(rules.size()));
+  for (const auto &rule : rules) {
+    out.data().append(rule);
+  }
+}
+
+} // namespace
+
+std::string CompiledConfig::write(const Config &config)
+{
+  Writer out;
+
+  out.u32(static_cast<uint32_t>(config.m_map.size()));
+  for (const auto &[name, cell] : config.m_map) {
+    out.str(name);
+    writeOptions(out, cell.m_options);
+
+    out.u32(static_cast<uint32_t>(std::distance(cell.begin(), cell.end())));
+    for (const auto &[srcEdge, dstEdge] : cell) {
+      out.u8(static_cast<uint8_t>(srcEdge.getSide()));
+      out.f32(srcEdge.getInterval().first);
+      out.f32(srcEdge.getInterval().second);
+      out.str(dstEdge.getName());
+      out.f32(dstEdge.getInterval().first);
+      out.f32(dstEdge.getInterval().second);
+    }
+  }
+
+  out.u32(static_cast<uint32_t>(config.m_nameToCanonicalName.size()));
+  for (const auto &[name, canonicalName] : config.m_nameToCanonicalName) {
+    out.str(name);
+    out.str(canonicalName);
+  }
+
+  out.str(config.m_deskflowAddress.getHostname());
+  out.i32(config.m_deskflowAddress.getPort());
+  out.u8(config.m_deskflowAddress.isValid() ? 1 : 0);
+
+  writeOptions(out, config.m_globalOptions);
+  writeRules(out, config.m_inputFilter);
+
+  const auto &payload = out.data();
+  Writer header;
+  header.data().append(kMagic, sizeof(kMagic));
+  header.u32(kVersion);
+  header.u32(static_cast<uint32_t>(payload.size()));
+  header.u32(checksum(payload));
+  return header.data() + payload;
+}
+
+bool CompiledConfig::isCompiled(std::string_view data)
+{
+  return data.size() >= sizeof(kMagic) && std::memcmp(data.data(), kMagic, sizeof(kMagic)) == 0;
+}
+
+void CompiledConfig::read(std::string_view data, Config &config)
+{
+  if (!isCompiled(data) || data.size() < kHeaderSize) {
+    throw ServerConfigReadException("not a compiled config");
+  }
+
+  Reader header(data.substr(sizeof(kMagic), kHeaderSize - sizeof(kMagic)));
+  if (header.u32() != kVersion) {
+    throw ServerConfigReadException("compiled config is from another version, compile it again");
+  }
+  const auto payload = data.substr(kHeaderSize);
+  if (header.u32() != payload.size() || header.u32() != checksum(payload)) {
+    throw ServerConfigReadException("compiled config is damaged");
+  }
+
+  // everything was validated when it was compiled, so fill in the
+  // maps directly, in order, instead of through addScreen() etc.
+  Config tmp(config.m_events);
+  Reader in(payload);
+
+  for (auto screens = in.u32(); screens > 0; --screens) {
+    auto &cell = tmp.m_map.try_emplace(tmp.m_map.end(), in.str())->second;
+    readOptions(in, cell.m_options);
+
+    for (auto links = in.u32(); links > 0; --links) {
+      const auto side = in.direction();
+      const auto srcInterval = in.interval();
+      const auto dstName = in.str();
+      const auto dstInterval = in.interval();
+      cell.add(Config::CellEdge(side, srcInterval), Config::CellEdge(dstName, side, dstInterval));
+    }
+  }
+
+  for (auto names = in.u32(); names > 0; --names) {
+    auto name = in.str();
+    tmp.m_nameToCanonicalName.try_emplace(tmp.m_nameToCanonicalName.end(), std::move(name), in.str());
+  }
+
+  const auto hostname = in.str();
+  const auto port = in.i32();
+  if (in.u8() != 0) {
+    tmp.m_deskflowAddress = hostname.empty() ? NetworkAddress(port) : NetworkAddress(hostname, port);
+    try {
+      tmp.m_deskflowAddress.resolve();
+    } catch (SocketAddressException &e) {
+      throw ServerConfigReadException(std::string("invalid address argument ") + e.what());
+    }
+  }
+
+  readOptions(in, tmp.m_globalOptions);
+
+  for (auto rules = in.u32(); rules > 0; --rules) {
+    InputFilter::Rule rule(readCondition(in, tmp.m_events));
+    for (const bool onActivation : {true, false}) {
+      for (auto actions = in.u32(); actions > 0; --actions) {
+        rule.adoptAction(readAction(in, tmp.m_events, tmp.m_hasLockToScreenAction), onActivation);
+      }
+    }
+    tmp.m_inputFilter.addFilterRule(rule);
+  }
+
+  if (!in.atEnd()) {
+    throw ServerConfigReadException("compiled config has trailing data");
+  }
+
+  config = tmp;
+}
+
+} // namespace deskflow::server
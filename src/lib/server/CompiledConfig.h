@@ -0,0 +1,54 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace deskflow::server {
+
+class Config;
+
+//! Binary server configuration
+/*!
+A compact form of a Config that has already been read and validated:
+screens, aliases, links, options, the listen address and the hot key
+rules.  Reading it skips the text parser entirely, which matters for
+large generated configurations.  The data is read in place, so it can
+come straight from a memory mapped file.
+
+A compiled configuration is a snapshot.  Options and aliases that the
+text parser takes from the settings are included as they were when it
+was compiled, so it must be compiled again after changing those.
+
+The layout is a header of a magic number, a format version, the payload
+size and a checksum of the payload, followed by the payload.  All
+integers are little endian.
+*/
+class CompiledConfig
+{
+public:
+  //! Compile a configuration
+  static std::string write(const Config &config);
+
+  //! Test for a compiled configuration
+  /*!
+  Returns true if \c data starts with the magic number, whether or not
+  the rest of it is valid.
+  */
+  static bool isCompiled(std::string_view data);
+
+  //! Read a compiled configuration
+  /*!
+  Replaces \c config with the configuration in \c data.  Throws
+  ServerConfigReadException if \c data is truncated, corrupt or from
+  another version, and \c config is unchanged.
+  */
+  static void read(std::string_view data, Config &config);
+};
+
+} // namespace deskflow::server
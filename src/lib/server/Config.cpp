@@ -9,6 +9,8 @@
 #include "server/Config.h"
 
 #include "base/IEventQueue.h"
+#include "common/Settings.h"
+#include "common/SettingsSnapshot.h"
 #include "deskflow/KeyMap.h"
 #include "deskflow/KeyTypes.h"
 #include "deskflow/OptionTypes.h"
@@ -452,29 +454,31 @@ void Config::readSection(ConfigReadContext &s)
 
 void Config::readSectionOptions(ConfigReadContext &s)
 {
-  if (Settings::value(Settings::Server::EnableHeatbeat).toBool()) {
-    addOption("", kOptionHeartbeat, Settings::value(Settings::Server::Heartbeat).toInt());
+  const auto settings = SettingsSnapshot::current();
+
+  if (settings->server.enableHeartbeat) {
+    addOption("", kOptionHeartbeat, settings->server.heartbeat);
   }
 
-  if (Settings::value(Settings::Server::EnableSwitchDelay).toBool()) {
-    addOption("", kOptionScreenSwitchDelay, Settings::value(Settings::Server::SwitchDelay).toInt());
+  if (settings->server.enableSwitchDelay) {
+    addOption("", kOptionScreenSwitchDelay, settings->server.switchDelay);
   }
 
-  if (Settings::value(Settings::Server::EnableSwitchDoubleTap).toBool()) {
-    addOption("", kOptionScreenSwitchTwoTap, Settings::value(Settings::Server::SwitchDoubleTap).toInt());
+  if (settings->server.enableSwitchDoubleTap) {
+    addOption("", kOptionScreenSwitchTwoTap, settings->server.switchDoubleTap);
   }
 
-  addOption("", kOptionDefaultLockToScreenState, Settings::value(Settings::Server::DefaultLockToComputerState).toInt());
-  addOption("", kOptionDisableLockToScreen, Settings::value(Settings::Server::DisableLockToComputer).toInt());
-  addOption("", kOptionRelativeMouseMoves, Settings::value(Settings::Server::RelativeMouseMoves).toInt());
-  addOption("", kOptionWin32KeepForeground, Settings::value(Settings::Server::Win32KeepForeground).toInt());
-  addOption("", kOptionClipboardSharing, Settings::value(Settings::Server::EnableClipboard).toBool());
-  addOption("", kOptionClipboardSharingSize, Settings::value(Settings::Server::ClipboardSize).toUInt() * 1024);
+  addOption("", kOptionDefaultLockToScreenState, settings->server.defaultLockToComputerState);
+  addOption("", kOptionDisableLockToScreen, settings->server.disableLockToComputer);
+  addOption("", kOptionRelativeMouseMoves, settings->server.relativeMouseMoves);
+  addOption("", kOptionWin32KeepForeground, settings->server.win32KeepForeground);
+  addOption("", kOptionClipboardSharing, settings->server.enableClipboard);
+  addOption("", kOptionClipboardSharingSize, settings->server.clipboardSize * 1024);
 
-  if (const auto address = Settings::value(Settings::Core::Interface).toString(); !address.isEmpty()) {
-    m_deskflowAddress = NetworkAddress(address.toStdString(), Settings::value(Settings::Core::Port).toInt());
+  if (const auto &address = settings->core.interfaceAddress; !address.isEmpty()) {
+    m_deskflowAddress = NetworkAddress(address.toStdString(), settings->core.port);
   } else {
-    m_deskflowAddress = NetworkAddress(Settings::value(Settings::Core::Port).toInt());
+    m_deskflowAddress = NetworkAddress(settings->core.port);
   }
   try {
     m_deskflowAddress.resolve();
@@ -1834,6 +1838,11 @@ ServerConfigReadException::ServerConfigReadException(
   // do nothing
 }
 
+ServerConfigReadException::ServerConfigReadException(const std::string &error) : m_error(error)
+{
+  // do nothing
+}
+
 QString ServerConfigReadException::getWhat() const throw()
 {
   return format("ServerConfigReadException", "read error: %{1}", m_error.c_str());
@@ -412,6 +412,8 @@ private:
   static std::string getOptionValue(OptionID, OptionValue);
 
 private:
+  friend class CompiledConfig;
+
   CellMap m_map;
   NameMap m_nameToCanonicalName;
   NetworkAddress m_deskflowAddress;
@@ -478,6 +480,7 @@ class ServerConfigReadException : public BaseException
 public:
   ServerConfigReadException(const ConfigReadContext &context, const std::string &);
   ServerConfigReadException(const ConfigReadContext &context, const char *errorFmt, const std::string &arg);
+  explicit ServerConfigReadException(const std::string &error);
   ~ServerConfigReadException() throw() override = default;
 
 protected:
@@ -0,0 +1,126 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "server/ConfigDiff.h"
+
+#include "server/Config.h"
+
+#include <format>
+
+using deskflow::string::CaselessCmp;
+
+namespace deskflow::server {
+
+namespace {
+
+bool sameLinks(const Config &oldConfig, const Config &newConfig, const std::string &name)
+{
+  auto oldLink = oldConfig.beginNeighbor(name);
+  auto newLink = newConfig.beginNeighbor(name);
+  const auto oldEnd = oldConfig.endNeighbor(name);
+  const auto newEnd = newConfig.endNeighbor(name);
+  for (; oldLink != oldEnd && newLink != newEnd; ++oldLink, ++newLink) {
+    // edges compare side and interval only, so compare the destination too
+    if (oldLink->first != newLink->first || oldLink->second != newLink->second ||
+        !CaselessCmp::equal(oldLink->second.getName(), newLink->second.getName())) {
+      return false;
+    }
+  }
+  return oldLink == oldEnd && newLink == newEnd;
+}
+
+bool sameAliases(const Config &oldConfig, const Config &newConfig)
+{
+  auto oldName = oldConfig.beginAll();
+  auto newName = newConfig.beginAll();
+  for (; oldName != oldConfig.endAll() && newName != newConfig.endAll(); ++oldName, ++newName) {
+    if (!CaselessCmp::equal(oldName->first, newName->first) || !CaselessCmp::equal(oldName->second, newName->second)) {
+      return false;
+    }
+  }
+  return oldName == oldConfig.endAll() && newName == newConfig.endAll();
+}
+
+} // namespace
+
+ConfigDiff::ConfigDiff(const Config &oldConfig, const Config &newConfig)
+{
+  for (const auto &name : oldConfig) {
+    if (!newConfig.isCanonicalName(name)) {
+      m_removed.insert(name);
+      continue;
+    }
+    if (!sameLinks(oldConfig, newConfig, name)) {
+      m_relinked.insert(name);
+    }
+    if (*oldConfig.getOptions(name) != *newConfig.getOptions(name)) {
+      m_reoptioned.insert(name);
+    }
+  }
+
+  for (const auto &name : newConfig) {
+    if (!oldConfig.isCanonicalName(name)) {
+      m_added.insert(name);
+    }
+  }
+
+  m_aliasesChanged = !sameAliases(oldConfig, newConfig);
+  m_globalOptionsChanged = *oldConfig.getOptions("") != *newConfig.getOptions("");
+}
+
+bool ConfigDiff::isEmpty() const
+{
+  return !linksChanged() && m_reoptioned.empty() && !m_globalOptionsChanged;
+}
+
+const ConfigDiff::ScreenSet &ConfigDiff::removedScreens() const
+{
+  return m_removed;
+}
+
+const ConfigDiff::ScreenSet &ConfigDiff::addedScreens() const
+{
+  return m_added;
+}
+
+const ConfigDiff::ScreenSet &ConfigDiff::relinkedScreens() const
+{
+  return m_relinked;
+}
+
+const ConfigDiff::ScreenSet &ConfigDiff::reoptionedScreens() const
+{
+  return m_reoptioned;
+}
+
+bool ConfigDiff::linksChanged() const
+{
+  return !m_removed.empty() || !m_added.empty() || !m_relinked.empty() || m_aliasesChanged;
+}
+
+bool ConfigDiff::globalOptionsChanged() const
+{
+  return m_globalOptionsChanged;
+}
+
+bool ConfigDiff::optionsChanged(const std::string &name) const
+{
+  return m_globalOptionsChanged || m_reoptioned.contains(name) || m_added.contains(name);
+}
+
+std::string ConfigDiff::summary() const
+{
+  if (isEmpty()) {
+    return "no changes";
+  }
+  return std::format(
+      "{} screens added, {} removed, {} relinked, {} with new options{}{}", m_added.size(), m_removed.size(),
+      m_relinked.size(), m_reoptioned.size(), m_aliasesChanged ? ", aliases changed" : "",
+      m_globalOptionsChanged ? ", global options changed" : ""
+  );
+}
+
+} // namespace deskflow::server
@@ -0,0 +1,88 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "base/String.h"
+
+#include <set>
+#include <string>
+
+namespace deskflow::server {
+
+class Config;
+
+//! Differences between two server configurations
+/*!
+Compares the screens, aliases, links and options of two configurations
+so a running server can apply only what changed: the neighbor graph is
+only rebuilt if links changed, options are only sent to the screens
+whose options changed and only clients for removed screens are
+disconnected.
+
+Hot keys and the listen address are not compared.  The input filter is
+replaced on every reload and a new address needs a restart.
+*/
+class ConfigDiff
+{
+public:
+  using ScreenSet = std::set<std::string, deskflow::string::CaselessCmp>;
+
+  ConfigDiff(const Config &oldConfig, const Config &newConfig);
+
+  //! @name accessors
+  //@{
+
+  //! Test for no changes
+  bool isEmpty() const;
+
+  //! Get screens in the old configuration but not in the new one
+  /*!
+  A screen whose canonical name changed is both removed and added.
+  */
+  const ScreenSet &removedScreens() const;
+
+  //! Get screens in the new configuration but not in the old one
+  const ScreenSet &addedScreens() const;
+
+  //! Get screens in both configurations whose links changed
+  const ScreenSet &relinkedScreens() const;
+
+  //! Get screens in both configurations whose own options changed
+  const ScreenSet &reoptionedScreens() const;
+
+  //! Test for a change to the adjacency of screens
+  /*!
+  Returns true if screens were added or removed, links changed or
+  aliases changed.
+  */
+  bool linksChanged() const;
+
+  //! Test for a change to the global options
+  bool globalOptionsChanged() const;
+
+  //! Test for a change to the options sent to a screen
+  /*!
+  Returns true if the global options changed or the options for the
+  canonical screen \c name changed or were added.
+  */
+  bool optionsChanged(const std::string &name) const;
+
+  //! Get a one line summary, for the log
+  std::string summary() const;
+
+  //@}
+
+private:
+  ScreenSet m_removed;
+  ScreenSet m_added;
+  ScreenSet m_relinked;
+  ScreenSet m_reoptioned;
+  bool m_aliasesChanged = false;
+  bool m_globalOptionsChanged = false;
+};
+
+} // namespace deskflow::server
@@ -174,6 +174,11 @@ InputFilter::ScreenConnectedCondition::ScreenConnectedCondition(IEventQueue *eve
   // do nothing
 }
 
+std::string InputFilter::ScreenConnectedCondition::getScreen() const
+{
+  return m_screen;
+}
+
 InputFilter::Condition *InputFilter::ScreenConnectedCondition::clone() const
 {
   return new ScreenConnectedCondition(m_events, m_screen);
@@ -804,6 +809,11 @@ InputFilter::Rule &InputFilter::getRule(uint32_t index)
   return m_ruleList[index];
 }
 
+const InputFilter::Rule &InputFilter::getRule(uint32_t index) const
+{
+  return m_ruleList[index];
+}
+
 void InputFilter::setPrimaryClient(PrimaryClient *client)
 {
   if (m_primaryClient == client) {
@@ -101,6 +101,8 @@ public:
     ScreenConnectedCondition(IEventQueue *events, const std::string &screen);
     ~ScreenConnectedCondition() override = default;
 
+    std::string getScreen() const;
+
     // Condition overrides
     Condition *clone() const override;
     std::string format() const override;
@@ -383,6 +385,7 @@ public:
 
   // get rule by index
   Rule &getRule(uint32_t index);
+  const Rule &getRule(uint32_t index) const;
 
   // enable event filtering using the given primary client.  disable
   // if client is nullptr.
@@ -0,0 +1,124 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "server/NeighborGraph.h"
+
+#include "base/String.h"
+#include "server/Config.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace deskflow::server {
+
+NeighborGraph::NeighborGraph(const Config &config, const ClientMap &clients)
+{
+  // give every canonical screen name a slot
+  std::map<std::string, uint32_t, deskflow::string::CaselessCmp> slots;
+  for (const auto &name : config) {
+    slots.try_emplace(name, static_cast<uint32_t>(slots.size()));
+  }
+  m_slots.resize(slots.size());
+
+  // copy the links of each screen into per-direction interval tables.
+  // links are stored ordered by side then interval start so each table
+  // is already sorted by m_srcStart.
+  for (const auto &[name, slot] : slots) {
+    for (auto link = config.beginNeighbor(name); link != config.endNeighbor(name); ++link) {
+      const auto &[srcEdge, dstEdge] = *link;
+      auto dst = slots.find(config.getCanonicalName(dstEdge.getName()));
+      if (dst == slots.end()) {
+        continue;
+      }
+
+      const auto from = srcEdge.getInterval();
+      const auto to = dstEdge.getInterval();
+      auto &links = m_slots[slot].m_links[dirIndex(srcEdge.getSide())];
+      links.push_back({from.first, from.second, to.first, to.second, dst->second});
+    }
+  }
+
+  // resolve connected clients
+  for (const auto &[name, client] : clients) {
+    if (auto slot = slots.find(name); slot != slots.end()) {
+      m_slots[slot->second].m_client = client;
+      m_clientSlots.try_emplace(client, slot->second);
+    }
+  }
+}
+
+NeighborGraph::Neighbor NeighborGraph::getNeighbor(const BaseClientProxy *src, Direction dir, float position) const
+{
+  uint32_t slot = findSlot(src);
+  if (slot == kNoSlot) {
+    return {};
+  }
+
+  // follow links until we land on a connected screen.  each hop moves to
+  // a different slot so a path can't be longer than the number of slots;
+  // the bound also stops us spinning on a cycle of unconnected screens.
+  for (size_t hops = 0; hops < m_slots.size(); ++hops) {
+    const Link *link = findLink(slot, dir, position);
+    if (link == nullptr) {
+      return {};
+    }
+
+    const float t = (position - link->m_srcStart) / (link->m_srcEnd - link->m_srcStart);
+    position = t * (link->m_dstEnd - link->m_dstStart) + link->m_dstStart;
+    slot = link->m_dst;
+
+    if (BaseClientProxy *client = m_slots[slot].m_client; client != nullptr) {
+      return {client, position};
+    }
+  }
+
+  return {};
+}
+
+bool NeighborGraph::hasNeighbor(const BaseClientProxy *src, Direction dir, float position) const
+{
+  const uint32_t slot = findSlot(src);
+  return slot != kNoSlot && findLink(slot, dir, position) != nullptr;
+}
+
+bool NeighborGraph::hasAnyNeighbor(const BaseClientProxy *src, Direction dir) const
+{
+  const uint32_t slot = findSlot(src);
+  return slot != kNoSlot && !m_slots[slot].m_links[dirIndex(dir)].empty();
+}
+
+uint32_t NeighborGraph::findSlot(const BaseClientProxy *client) const
+{
+  auto index = m_clientSlots.find(client);
+  return index == m_clientSlots.end() ? kNoSlot : index->second;
+}
+
+const NeighborGraph::Link *NeighborGraph::findLink(uint32_t slot, Direction dir, float position) const
+{
+  const LinkTable &links = m_slots[slot].m_links[dirIndex(dir)];
+
+  // find the last link starting at or before position, then check that
+  // position is inside its half-open interval.
+  auto i = std::upper_bound(links.begin(), links.end(), position, [](float pos, const Link &link) {
+    return pos < link.m_srcStart;
+  });
+  if (i == links.begin()) {
+    return nullptr;
+  }
+  --i;
+  if (position >= i->m_srcStart && position < i->m_srcEnd) {
+    return &*i;
+  }
+  return nullptr;
+}
+
+size_t NeighborGraph::dirIndex(Direction dir)
+{
+  assert(dir >= Direction::FirstDirection && dir <= Direction::LastDirection);
+  return static_cast<size_t>(dir) - static_cast<size_t>(Direction::FirstDirection);
+}
+
+} // namespace deskflow::server
@@ -0,0 +1,107 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "base/DirectionTypes.h"
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class BaseClientProxy;
+
+namespace deskflow::server {
+
+class Config;
+
+//! Precomputed screen adjacency
+/*!
+An immutable snapshot of the links in a Config, indexed by screen slot
+and direction, with the connected client proxy for each slot already
+resolved.  Looking up a neighbor costs one hash lookup for the source
+client and a short search of the interval table for that edge, no
+matter how many screens or aliases the configuration has.
+
+The graph must be rebuilt whenever the configuration or the set of
+connected clients changes.
+*/
+class NeighborGraph
+{
+public:
+  //! Connected clients indexed by canonical screen name
+  using ClientMap = std::map<std::string, BaseClientProxy *>;
+
+  //! Result of a neighbor lookup
+  struct Neighbor
+  {
+    BaseClientProxy *m_client = nullptr;
+    float m_position = 0.0f;
+  };
+
+  NeighborGraph() = default;
+  NeighborGraph(const Config &config, const ClientMap &clients);
+
+  //! @name accessors
+  //@{
+
+  //! Get connected neighbor
+  /*!
+  Returns the nearest connected client in direction \p dir of \p src at
+  \p position, skipping screens that are configured but not connected.
+  The position on the neighbor is returned in the result.  The client is
+  \c nullptr if there is no connected neighbor.
+  */
+  Neighbor getNeighbor(const BaseClientProxy *src, Direction dir, float position) const;
+
+  //! Check for neighbor at position
+  /*!
+  Returns \c true if \p src has a configured neighbor (connected or not)
+  in direction \p dir at \p position.
+  */
+  bool hasNeighbor(const BaseClientProxy *src, Direction dir, float position) const;
+
+  //! Check for neighbor along edge
+  /*!
+  Returns \c true if \p src has a configured neighbor (connected or not)
+  anywhere along the edge in direction \p dir.
+  */
+  bool hasAnyNeighbor(const BaseClientProxy *src, Direction dir) const;
+
+  //@}
+
+private:
+  static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+  struct Link
+  {
+    float m_srcStart;
+    float m_srcEnd;
+    float m_dstStart;
+    float m_dstEnd;
+    uint32_t m_dst;
+  };
+
+  using LinkTable = std::vector<Link>;
+
+  struct Slot
+  {
+    BaseClientProxy *m_client = nullptr;
+    std::array<LinkTable, static_cast<size_t>(Direction::NumDirections)> m_links;
+  };
+
+  uint32_t findSlot(const BaseClientProxy *) const;
+  const Link *findLink(uint32_t slot, Direction dir, float position) const;
+  static size_t dirIndex(Direction dir);
+
+  std::vector<Slot> m_slots;
+  std::unordered_map<const BaseClientProxy *, uint32_t> m_clientSlots;
+};
+
+} // namespace deskflow::server
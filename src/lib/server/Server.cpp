@@ -10,6 +10,7 @@
 
 #include "base/IEventQueue.h"
 #include "base/Log.h"
+#include "common/SettingsSnapshot.h"
 #include "deskflow/AppUtil.h"
 #include "deskflow/DeskflowException.h"
 #include "deskflow/IPlatformScreen.h"
@@ -63,7 +64,7 @@ Server::Server(ServerConfig &config, PrimaryClient *primaryClient, deskflow::Scr
       clipboard.m_clipboard.empty();
       clipboard.m_clipboard.close();
     }
-    clipboard.m_clipboardData = clipboard.m_clipboard.marshall();
+    clipboard.m_clipboardSnapshot = clipboard.m_clipboard.snapshot();
   }
 
   // install event handlers
@@ -188,7 +189,12 @@ size_t Server::getMaximumClipboardSizeBytes() const
   return m_maximumClipboardSize * 1024;
 }
 
-bool Server::setConfig(const ServerConfig &config)
+ClipboardPartials &Server::getClipboardPartials(const std::string &name)
+{
+  return m_clipboardPartials[name];
+}
+
+bool Server::setConfig(const ServerConfig &config, const deskflow::server::ConfigDiff *diff)
 {
   // refuse configuration if it doesn't include the primary screen
   if (!config.isScreen(m_primaryClient->getName())) {
@@ -197,10 +203,18 @@ bool Server::setConfig(const ServerConfig &config)
 
   // close clients that are connected but being dropped from the
   // configuration.
-  closeClients(config);
+  if (diff == nullptr || !diff->removedScreens().empty()) {
+    closeClients(config);
+  }
 
   // cut over
-  processOptions();
+  if (diff == nullptr || diff->linksChanged()) {
+    updateNeighborGraph();
+  }
+  if (diff == nullptr || diff->globalOptionsChanged()) {
+    processOptions();
+  }
+  m_protocol = SettingsSnapshot::current()->server.protocol;
 
   // add ScrollLock as a hotkey to lock to the screen.  this was a
   // built-in feature in earlier releases and is now supported via
@@ -208,7 +222,8 @@ bool Server::setConfig(const ServerConfig &config)
   // registered ScrollLock for something else then that will win but
   // we will unfortunately generate a warning.  if the user has
   // configured a LockCursorToScreenAction then we don't add
-  // ScrollLock as a hotkey.
+  // ScrollLock as a hotkey.  the input filter is replaced whenever
+  // the configuration is, so this is needed even if nothing changed.
   if (!m_disableLockToScreen && !m_config->hasLockToScreenAction()) {
     IPlatformScreen::KeyInfo *key = IPlatformScreen::KeyInfo::alloc(kKeyScrollLock, 0, 0, 0);
     InputFilter::Rule rule(new InputFilter::KeystrokeCondition(m_events, key));
@@ -217,12 +232,16 @@ bool Server::setConfig(const ServerConfig &config)
   }
 
   // tell primary screen about reconfiguration
-  m_primaryClient->reconfigure(getActivePrimarySides());
+  if (diff == nullptr || diff->linksChanged()) {
+    m_primaryClient->reconfigure(getActivePrimarySides());
+  }
 
-  // tell all (connected) clients about current options
+  // tell (connected) clients about their options, if they changed
   for (ClientList::const_iterator index = m_clients.begin(); index != m_clients.end(); ++index) {
     BaseClientProxy *client = index->second;
-    sendOptions(client);
+    if (diff == nullptr || diff->optionsChanged(index->first)) {
+      sendOptions(client);
+    }
   }
 
   return true;
@@ -481,8 +500,8 @@ void Server::switchScreen(BaseClientProxy *dst, int32_t x, int32_t y, bool forSc
     if (m_enableClipboard) {
       // send the clipboard data to new active screen
       for (ClipboardID id = 0; id < kClipboardEnd; ++id) {
-        // Hackity hackity hack
-        if (m_clipboards[id].m_clipboard.marshall().size() > (m_maximumClipboardSize * 1024)) {
+        // the size is cached, the clipboard is only marshalled when it changes
+        if (m_clipboards[id].m_clipboard.snapshot()->m_data.size() > (m_maximumClipboardSize * 1024)) {
           continue;
         }
         m_active->setClipboard(id, &m_clipboards[id].m_clipboard);
@@ -564,7 +583,7 @@ bool Server::hasAnyNeighbor(const BaseClientProxy *client, Direction dir) const
 {
   assert(client != nullptr);
 
-  return m_config->hasNeighbor(getName(client), dir);
+  return m_neighborGraph.hasAnyNeighbor(client, dir);
 }
 
 BaseClientProxy *Server::getNeighbor(const BaseClientProxy *src, Direction dir, int32_t &x, int32_t &y) const
@@ -573,43 +592,22 @@ BaseClientProxy *Server::getNeighbor(const BaseClientProxy *src, Direction dir,
 
   assert(src != nullptr);
 
-  // get source screen name
-  std::string srcName = getName(src);
-  assert(!srcName.empty());
-  LOG_VERBOSE("find neighbor on %s of \"%s\"", Config::dirName(dir), srcName.c_str());
-
-  // convert position to fraction
-  float t = mapToFraction(src, dir, x, y);
-
-  // search for the closest neighbor that exists in direction dir
-  float tTmp;
-  for (;;) {
-    std::string dstName(m_config->getNeighbor(srcName, dir, t, &tTmp));
-
-    // if nothing in that direction then return nullptr. if the
-    // destination is the source then we can make no more
-    // progress in this direction.  since we haven't found a
-    // connected neighbor we return nullptr.
-    if (dstName.empty()) {
-      LOG_VERBOSE("no neighbor on %s of \"%s\"", Config::dirName(dir), srcName.c_str());
-      return nullptr;
-    }
-
-    // look up neighbor cell.  if the screen is connected and
-    // ready then we can stop.
-    if (ClientList::const_iterator index = m_clients.find(dstName); index != m_clients.end()) {
-      LOG_VERBOSE("\"%s\" is on %s of \"%s\" at %f", dstName.c_str(), Config::dirName(dir), srcName.c_str(), t);
-      mapToPixel(index->second, dir, tTmp, x, y);
-      return index->second;
-    }
-
-    // skip over unconnected screen
-    LOG_VERBOSE("ignored \"%s\" on %s of \"%s\"", dstName.c_str(), Config::dirName(dir), srcName.c_str());
-    srcName = dstName;
-
-    // use position on skipped screen
-    t = tTmp;
+  // convert position to fraction and find the closest connected
+  // neighbor in direction dir, skipping over unconnected screens
+  const float t = mapToFraction(src, dir, x, y);
+  LOG_VERBOSE("find neighbor on %s of \"%s\"", Config::dirName(dir), getName(src).c_str());
+  const auto neighbor = m_neighborGraph.getNeighbor(src, dir, t);
+  if (neighbor.m_client == nullptr) {
+    LOG_VERBOSE("no neighbor on %s of \"%s\"", Config::dirName(dir), getName(src).c_str());
+    return nullptr;
   }
+
+  LOG_VERBOSE(
+      "\"%s\" is on %s of \"%s\" at %f", getName(neighbor.m_client).c_str(), Config::dirName(dir),
+      getName(src).c_str(), t
+  );
+  mapToPixel(neighbor.m_client, dir, neighbor.m_position, x, y);
+  return neighbor.m_client;
 }
 
 BaseClientProxy *Server::mapToNeighbor(BaseClientProxy *src, Direction srcSide, int32_t &x, int32_t &y) const
@@ -728,7 +726,6 @@ void Server::avoidJumpZone(const BaseClientProxy *dst, Direction dir, int32_t &x
     return;
   }
 
-  const std::string dstName(getName(dst));
   int32_t dx;
   int32_t dy;
   int32_t dw;
@@ -743,22 +740,22 @@ void Server::avoidJumpZone(const BaseClientProxy *dst, Direction dir, int32_t &x
   switch (dir) {
     using enum Direction;
   case Left:
-    if (!m_config->getNeighbor(dstName, Right, t, nullptr).empty() && x > dx + dw - 1 - z)
+    if (m_neighborGraph.hasNeighbor(dst, Right, t) && x > dx + dw - 1 - z)
       x = dx + dw - 1 - z;
     break;
 
   case Right:
-    if (!m_config->getNeighbor(dstName, Left, t, nullptr).empty() && x < dx + z)
+    if (m_neighborGraph.hasNeighbor(dst, Left, t) && x < dx + z)
       x = dx + z;
     break;
 
   case Top:
-    if (!m_config->getNeighbor(dstName, Bottom, t, nullptr).empty() && y > dy + dh - 1 - z)
+    if (m_neighborGraph.hasNeighbor(dst, Bottom, t) && y > dy + dh - 1 - z)
       y = dy + dh - 1 - z;
     break;
 
   case Bottom:
-    if (!m_config->getNeighbor(dstName, Top, t, nullptr).empty() && y < dy + z)
+    if (m_neighborGraph.hasNeighbor(dst, Top, t) && y < dy + z)
       y = dy + z;
     break;
 
@@ -1114,7 +1111,6 @@ void Server::processOptions()
     stopRelativeMoves();
   }
   m_relativeMoves = newRelativeMoves;
-  m_protocol = Settings::networkProtocol();
 }
 
 void Server::handleShapeChanged(BaseClientProxy *client)
@@ -1180,7 +1176,7 @@ void Server::handleClipboardGrabbed(const Event &event, BaseClientProxy *grabber
     clipboard.m_clipboard.empty();
     clipboard.m_clipboard.close();
   }
-  clipboard.m_clipboardData = clipboard.m_clipboard.marshall();
+  clipboard.m_clipboardSnapshot = clipboard.m_clipboard.snapshot();
 
   // tell all other screens to take ownership of clipboard.  tell the
   // grabber that it's clipboard isn't dirty.
@@ -1244,19 +1240,42 @@ void Server::handleButtonUpEvent(const Event &event)
 void Server::handleMotionPrimaryEvent(const Event &event)
 {
   const auto *info = static_cast<IPlatformScreen::MotionInfo *>(event.getData());
+  // the stats of the screen the event is for, the event may switch screens
+  ConnectionStats *stats = m_active->getStats();
+  recordLatency(stats, ConnectionStats::Stage::Queue, info->m_captureTime);
+  m_active->sendInputTime(info->m_captureTime);
   onMouseMovePrimary(info->m_x, info->m_y);
+  recordLatency(stats, ConnectionStats::Stage::Send, info->m_captureTime);
 }
 
 void Server::handleMotionSecondaryEvent(const Event &event)
 {
   const auto *info = static_cast<IPlatformScreen::MotionInfo *>(event.getData());
+  // the stats of the screen the event is for, the event may switch screens
+  ConnectionStats *stats = m_active->getStats();
+  recordLatency(stats, ConnectionStats::Stage::Queue, info->m_captureTime);
+  m_active->sendInputTime(info->m_captureTime);
   onMouseMoveSecondary(info->m_x, info->m_y);
+  recordLatency(stats, ConnectionStats::Stage::Send, info->m_captureTime);
 }
 
 void Server::handleWheelEvent(const Event &event)
 {
   const auto *info = static_cast<IPlatformScreen::WheelInfo *>(event.getData());
+  // the stats of the screen the event is for, the event may switch screens
+  ConnectionStats *stats = m_active->getStats();
+  recordLatency(stats, ConnectionStats::Stage::Queue, info->m_captureTime);
+  m_active->sendInputTime(info->m_captureTime);
   onMouseWheel(info->m_xDelta, info->m_yDelta);
+  recordLatency(stats, ConnectionStats::Stage::Send, info->m_captureTime);
+}
+
+void Server::recordLatency(ConnectionStats *stats, ConnectionStats::Stage stage, uint64_t captureTime)
+{
+  // events on the primary screen itself aren't sent anywhere
+  if (stats != nullptr) {
+    stats->latency(stage).recordSince(captureTime);
+  }
 }
 
 void Server::handleSwitchWaitTimeout()
@@ -1439,21 +1458,21 @@ void Server::onClipboardChanged(const BaseClientProxy *sender, ClipboardID id, u
   // get data
   sender->getClipboard(id, &clipboard.m_clipboard);
 
-  std::string data = clipboard.m_clipboard.marshall();
-  if (data.size() > m_maximumClipboardSize * 1024) {
+  const auto snapshot = clipboard.m_clipboard.snapshot();
+  if (snapshot->m_data.size() > m_maximumClipboardSize * 1024) {
     LOG_WARN("not sending clipboard data, exceeds limit: %i KB", m_maximumClipboardSize);
     return;
   }
 
   // ignore if data hasn't changed
-  if (data == clipboard.m_clipboardData) {
+  if (snapshot->hasSameData(*clipboard.m_clipboardSnapshot)) {
     LOG_DEBUG("ignored screen \"%s\" update of clipboard %d (unchanged)", clipboard.m_clipboardOwner.c_str(), id);
     return;
   }
 
   // got new data
   LOG_INFO("screen \"%s\" updated clipboard %d", clipboard.m_clipboardOwner.c_str(), id);
-  clipboard.m_clipboardData = data;
+  clipboard.m_clipboardSnapshot = snapshot;
 
   // tell all clients except the sender that the clipboard is dirty
   for (ClientList::const_iterator index = m_clients.begin(); index != m_clients.end(); ++index) {
@@ -1893,6 +1912,7 @@ bool Server::addClient(BaseClientProxy *client)
   // add to list
   m_clientSet.insert(client);
   m_clients.try_emplace(name, client);
+  updateNeighborGraph();
 
   // initialize client data
   int32_t x;
@@ -1923,10 +1943,16 @@ bool Server::removeClient(BaseClientProxy *client)
   // remove from list
   m_clients.erase(getName(client));
   m_clientSet.erase(i);
+  updateNeighborGraph();
 
   return true;
 }
 
+void Server::updateNeighborGraph()
+{
+  m_neighborGraph = NeighborGraph(*m_config, m_clients);
+}
+
 void Server::closeClient(BaseClientProxy *client, const char *msg)
 {
   assert(client != m_primaryClient);
@@ -12,10 +12,14 @@
 #include "base/Stopwatch.h"
 #include "common/NetworkProtocol.h"
 #include "deskflow/Clipboard.h"
+#include "deskflow/ClipboardPartials.h"
 #include "deskflow/ClipboardTypes.h"
+#include "deskflow/ConnectionStats.h"
 #include "deskflow/KeyTypes.h"
 #include "deskflow/MouseTypes.h"
 #include "server/Config.h"
+#include "server/ConfigDiff.h"
+#include "server/NeighborGraph.h"
 
 #include <climits>
 #include <map>
@@ -151,8 +155,13 @@ public:
   Change the server's configuration.  Returns true iff the new
   configuration was accepted (it must include the server's name).
   This will disconnect any clients no longer in the configuration.
+
+  If \c diff is given, from the configuration before it was changed to
+  \c config, only what changed is applied.  Clients keep their
+  connections unless their screen was removed and options are only
+  sent to the clients whose options changed.
   */
-  bool setConfig(const ServerConfig &);
+  bool setConfig(const ServerConfig &config, const deskflow::server::ConfigDiff *diff = nullptr);
 
   //! Add a client
   /*!
@@ -176,6 +185,13 @@ public:
     m_clientListener = p;
   }
 
+  //! Get the clipboard transfers partly received from a client
+  /*!
+  Kept across reconnects, so a transfer interrupted by the connection
+  to \p name dropping can resume when the client connects again.
+  */
+  ClipboardPartials &getClipboardPartials(const std::string &name);
+
   //@}
   //! @name accessors
   //@{
@@ -315,6 +331,7 @@ private:
   void handleMotionPrimaryEvent(const Event &event);
   void handleMotionSecondaryEvent(const Event &event);
   void handleWheelEvent(const Event &event);
+  void recordLatency(ConnectionStats *stats, ConnectionStats::Stage stage, uint64_t captureTime);
   void handleSwitchWaitTimeout();
   void handleClientDisconnected(BaseClientProxy *client);
   void handleClientCloseTimeout(BaseClientProxy *client);
@@ -342,6 +359,10 @@ private:
   // remove client from list and detach event handlers for client
   bool removeClient(BaseClientProxy *);
 
+  // rebuild the adjacency graph from the configuration and the
+  // connected clients
+  void updateNeighborGraph();
+
   // close a client
   void closeClient(BaseClientProxy *, const char *msg);
 
@@ -367,7 +388,7 @@ private:
 
   public:
     Clipboard m_clipboard;
-    std::string m_clipboardData;
+    std::shared_ptr<const Clipboard::Snapshot> m_clipboardSnapshot;
     std::string m_clipboardOwner;
     uint32_t m_clipboardSeqNum = 0;
   };
@@ -412,6 +433,10 @@ private:
   ClientList m_clients;
   ClientSet m_clientSet;
 
+  // links between connected clients, rebuilt whenever the
+  // configuration or the client list changes
+  deskflow::server::NeighborGraph m_neighborGraph;
+
   // all old connections that we're waiting to hangup
   using OldClients = std::map<BaseClientProxy *, EventQueueTimer *>;
   OldClients m_oldClients;
@@ -419,6 +444,9 @@ private:
   // clipboard cache
   ClipboardInfo m_clipboards[kClipboardEnd];
 
+  // interrupted clipboard transfers from clients, by client name
+  std::map<std::string, ClipboardPartials> m_clipboardPartials;
+
   // used in hello message sent to the client
   NetworkProtocol m_protocol = NetworkProtocol::Barrier;
 
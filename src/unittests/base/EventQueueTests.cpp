@@ -7,10 +7,12 @@
 #include "EventQueueTests.h"
 
 #include "base/EventQueue.h"
+#include "base/Stopwatch.h"
 
 #include <QTest>
 
 #include <memory>
+#include <vector>
 
 void EventQueueTests::initTestCase()
 {
@@ -55,4 +57,64 @@ void EventQueueTests::dispatchEvent_handlerRemovesItself_keepsHandlerAliveUntilR
   QVERIFY(handlerLifetimeObserver.expired());
 }
 
+void EventQueueTests::loop_inputOvertakesFlood()
+{
+  // enough queued work to be seen if input waits behind it
+  const int flood = 100000;
+
+  EventQueue events;
+  int dispatched = 0;
+  int inputPosition = -1;
+  Stopwatch stopwatch;
+  double inputLatency = 0.0;
+
+  events.addHandler(EventTypes::ServerAppReloadConfig, this, [this, &events, &stopwatch](const Event &) {
+    for (int i = 0; i < flood; ++i) {
+      events.addEvent(Event(EventTypes::ClientDisconnected, this));
+    }
+    stopwatch.reset();
+    events.addEvent(Event(EventTypes::PrimaryScreenMotionOnPrimary, this));
+  });
+  events.addHandler(EventTypes::ClientDisconnected, this, [&dispatched](const Event &) { ++dispatched; });
+  events.addHandler(EventTypes::PrimaryScreenMotionOnPrimary, this, [&](const Event &) {
+    inputPosition = dispatched;
+    inputLatency = stopwatch.getTime();
+    events.addEvent(Event(EventTypes::Quit));
+  });
+
+  events.addEvent(Event(EventTypes::ServerAppReloadConfig, this));
+  events.loop();
+  const double floodTime = stopwatch.getTime();
+
+  qInfo(
+      "input dispatched after %d of %d queued events, %.1f us, flood drained in %.1f ms", inputPosition, flood,
+      inputLatency * 1e6, floodTime * 1e3
+  );
+  QCOMPARE(inputPosition, 0);
+  QCOMPARE(dispatched, flood);
+}
+
+void EventQueueTests::loop_inputKeepsOrder()
+{
+  EventQueue events;
+  std::vector<EventTypes> order;
+  const auto record = [&order](const Event &event) { order.push_back(event.getType()); };
+  events.addHandler(EventTypes::KeyStateKeyDown, this, record);
+  events.addHandler(EventTypes::PrimaryScreenMotionOnPrimary, this, record);
+  events.addHandler(EventTypes::KeyStateKeyUp, this, [&](const Event &event) {
+    record(event);
+    events.addEvent(Event(EventTypes::Quit));
+  });
+
+  events.addEvent(Event(EventTypes::KeyStateKeyDown, this));
+  events.addEvent(Event(EventTypes::PrimaryScreenMotionOnPrimary, this));
+  events.addEvent(Event(EventTypes::KeyStateKeyUp, this));
+  events.loop();
+
+  const std::vector<EventTypes> expected{
+      EventTypes::KeyStateKeyDown, EventTypes::PrimaryScreenMotionOnPrimary, EventTypes::KeyStateKeyUp
+  };
+  QVERIFY(order == expected);
+}
+
 QTEST_MAIN(EventQueueTests)
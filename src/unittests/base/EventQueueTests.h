@@ -19,6 +19,8 @@ private Q_SLOTS:
   void dispatchEvent_noHandler_returnsFalse();
   void dispatchEvent_noTypeHandler_dispatchesUnknownHandler();
   void dispatchEvent_handlerRemovesItself_keepsHandlerAliveUntilReturn();
+  void loop_inputOvertakesFlood();
+  void loop_inputKeepsOrder();
 
 private:
   Arch m_arch;
@@ -0,0 +1,93 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "LatencyHistogramTests.h"
+
+#include "base/LatencyHistogram.h"
+
+#include <cstdint>
+
+void LatencyHistogramTests::empty()
+{
+  LatencyHistogram histogram;
+
+  QCOMPARE(histogram.count(), uint64_t{0});
+  QCOMPARE(histogram.max(), uint64_t{0});
+  QCOMPARE(histogram.valueAtPercentile(50.0), uint64_t{0});
+}
+
+void LatencyHistogramTests::smallValuesExact()
+{
+  LatencyHistogram histogram;
+  for (uint64_t i = 0; i < 16; ++i) {
+    histogram.record(i);
+  }
+
+  QCOMPARE(histogram.count(), uint64_t{16});
+  QCOMPARE(histogram.valueAtPercentile(0.0), uint64_t{0});
+  QCOMPARE(histogram.valueAtPercentile(50.0), uint64_t{7});
+  QCOMPARE(histogram.valueAtPercentile(100.0), uint64_t{15});
+}
+
+void LatencyHistogramTests::percentiles()
+{
+  LatencyHistogram histogram;
+  for (uint64_t i = 0; i < 99; ++i) {
+    histogram.record(1000);
+  }
+  histogram.record(1000000);
+
+  QCOMPARE(histogram.count(), uint64_t{100});
+  QVERIFY(histogram.valueAtPercentile(50.0) >= 1000);
+  QVERIFY(histogram.valueAtPercentile(99.0) < 1100);
+  QCOMPARE(histogram.valueAtPercentile(100.0), uint64_t{1000000});
+}
+
+void LatencyHistogramTests::relativeError()
+{
+  // every value must be reported within 1/16 of what was recorded
+  for (uint64_t value = 17; value < 100000000; value = value * 3 + 1) {
+    LatencyHistogram histogram;
+    histogram.record(value);
+    histogram.record(value + 1);
+
+    const auto reported = histogram.valueAtPercentile(50.0);
+    QVERIFY(reported >= value);
+    QVERIFY(reported - value <= value / 16);
+  }
+}
+
+void LatencyHistogramTests::maxValue()
+{
+  LatencyHistogram histogram;
+  histogram.record(UINT64_MAX);
+  histogram.record(5);
+
+  QCOMPARE(histogram.max(), UINT64_MAX);
+  QCOMPARE(histogram.valueAtPercentile(100.0), UINT64_MAX);
+}
+
+void LatencyHistogramTests::recordSinceZero()
+{
+  LatencyHistogram histogram;
+  histogram.recordSince(0);
+  QCOMPARE(histogram.count(), uint64_t{0});
+
+  histogram.recordSince(LatencyHistogram::now());
+  QCOMPARE(histogram.count(), uint64_t{1});
+}
+
+void LatencyHistogramTests::reset()
+{
+  LatencyHistogram histogram;
+  histogram.record(42);
+  histogram.reset();
+
+  QCOMPARE(histogram.count(), uint64_t{0});
+  QCOMPARE(histogram.max(), uint64_t{0});
+}
+
+QTEST_MAIN(LatencyHistogramTests)
@@ -11,6 +11,7 @@
 #include <sstream>
 
 #define LEVEL_PRINT "%z\057"
+#define LEVEL_CRIT "%z\060"
 #define LEVEL_ERR "%z\061"
 #define LEVEL_INFO "%z\063"
 
@@ -120,4 +121,71 @@ void LogTests::printErrWithFileAndLine()
   QCOMPARE(string, "ERROR: test message test file:123");
 }
 
+void LogTests::printAsync()
+{
+  std::stringstream buffer;
+  std::streambuf *old = std::cout.rdbuf(buffer.rdbuf());
+
+  m_log.setAsync(true);
+  m_log.print("test file", 123, LEVEL_INFO "test %s", "async");
+  m_log.flush();
+  m_log.setAsync(false);
+
+  auto string = sanitizeBuffer(buffer);
+  std::cout.rdbuf(old);
+
+  QCOMPARE(string, "INFO: test async test file:123");
+  QCOMPARE(m_log.getDropped(), uint64_t{0});
+}
+
+void LogTests::printAsyncFatalIsOrdered()
+{
+  std::stringstream buffer;
+  std::streambuf *oldOut = std::cout.rdbuf(buffer.rdbuf());
+  std::streambuf *oldErr = std::cerr.rdbuf(buffer.rdbuf());
+
+  // fatal messages are written synchronously, after anything queued
+  m_log.setAsync(true);
+  m_log.print(nullptr, 0, LEVEL_INFO "first");
+  m_log.print(nullptr, 0, LEVEL_CRIT "second");
+
+  auto string = sanitizeBuffer(buffer);
+  m_log.setAsync(false);
+  std::cout.rdbuf(oldOut);
+  std::cerr.rdbuf(oldErr);
+
+  QCOMPARE(string, "INFO: first FATAL: second");
+}
+
+void LogTests::filteredArgsNotEvaluated()
+{
+  std::stringstream buffer;
+  std::streambuf *old = std::cout.rdbuf(buffer.rdbuf());
+
+  int evaluated = 0;
+  auto arg = [&evaluated] { return ++evaluated; };
+
+  QVERIFY(m_log.isEnabled(LogLevel::Level::Debug));
+  QVERIFY(!m_log.isEnabled(LogLevel::Level::Verbose));
+
+  LOG_VERBOSE("filtered %d", arg());
+  QCOMPARE(evaluated, 0);
+
+  LOG_DEBUG("shown %d", arg());
+  QCOMPARE(evaluated, 1);
+
+  std::cout.rdbuf(old);
+}
+
+void LogTests::benchmarkFilteredMotion()
+{
+  // the cost of a filtered log call on the mouse move path
+  int x = 0;
+  int y = 0;
+  QBENCHMARK {
+    LOG_VERBOSE("onMouseMovePrimary %d,%d", ++x, ++y);
+  }
+  QCOMPARE(x, 0);
+}
+
 QTEST_MAIN(LogTests)
@@ -21,6 +21,10 @@ private Q_SLOTS:
   void printLevelToHigh();
   void printInfoWithFileAndLine();
   void printErrWithFileAndLine();
+  void printAsync();
+  void printAsyncFatalIsOrdered();
+  void filteredArgsNotEvaluated();
+  void benchmarkFilteredMotion();
 
 private:
   Log m_log;
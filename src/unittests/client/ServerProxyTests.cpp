@@ -11,6 +11,7 @@
 #include "client/Client.h"
 #include "client/ServerProxy.h"
 #include "deskflow/AppUtil.h"
+#include "deskflow/DeskflowException.h"
 #include "deskflow/ProtocolTypes.h"
 #include "io/IStream.h"
 
@@ -248,8 +249,30 @@ public:
   {
     return parseHandshakeMessage(code) == ConnectionResult::Disconnect;
   }
+
+  bool parseMessageThrowsProtocolError(const uint8_t *code)
+  {
+    try {
+      parseMessage(code);
+    } catch (const BadClientException &) {
+      return true;
+    }
+    return false;
+  }
 };
 
+// a batch message without its code, as the parser sees it
+std::string inputBatch(const std::string &records)
+{
+  std::string message(8, '\0');
+  const auto n = static_cast<uint32_t>(records.size());
+  message += static_cast<char>(n >> 24);
+  message += static_cast<char>(n >> 16);
+  message += static_cast<char>(n >> 8);
+  message += static_cast<char>(n);
+  return message + records;
+}
+
 Client *undereferenceableClient()
 {
   // These paths must queue cleanup without calling through to Client.
@@ -332,4 +355,25 @@ void ServerProxyTests::parseHandshakeMessage_protocolError_queuesRefusalRequest(
   QCOMPARE(QString::fromUtf8(request->message()), QStringLiteral("server reported a protocol error"));
 }
 
+void ServerProxyTests::parseMessage_inputBatchWithOtherMessage_throws()
+{
+  RecordingEventQueue events;
+  FakeStream stream;
+  stream.push(inputBatch(std::string("\0CNOP", 5)));
+  TestServerProxy proxy(undereferenceableClient(), &stream, &events);
+
+  QVERIFY(proxy.parseMessageThrowsProtocolError(reinterpret_cast<const uint8_t *>(kMsgDInputBatch)));
+  QVERIFY(!stream.isReady());
+}
+
+void ServerProxyTests::parseMessage_truncatedInputBatch_throws()
+{
+  RecordingEventQueue events;
+  FakeStream stream;
+  stream.push(inputBatch(std::string("\x80", 1)));
+  TestServerProxy proxy(undereferenceableClient(), &stream, &events);
+
+  QVERIFY(proxy.parseMessageThrowsProtocolError(reinterpret_cast<const uint8_t *>(kMsgDInputBatch)));
+}
+
 QTEST_MAIN(ServerProxyTests)
@@ -101,4 +101,37 @@ void SettingsTests::checkCleanScreenName_LongName()
   QCOMPARE(Settings::value(Settings::Core::ComputerName).toString(), expected);
 }
 
+void SettingsTests::snapshot()
+{
+  Settings::setValue(Settings::Core::Port, 24801);
+  const auto before = SettingsSnapshot::current();
+  QCOMPARE(before->core.port, 24801);
+  QCOMPARE(before->core.computerName, Settings::value(Settings::Core::ComputerName).toString());
+
+  Settings::setValue(Settings::Core::Port, 24802);
+  const auto after = SettingsSnapshot::current();
+  QCOMPARE(after->core.port, 24802);
+
+  // snapshots already taken never change
+  QCOMPARE(before->core.port, 24801);
+
+  QCOMPARE(SettingsSnapshot::current(), after);
+  SettingsSnapshot::reload();
+  QVERIFY(SettingsSnapshot::current() != after);
+  QCOMPARE(SettingsSnapshot::current()->core.port, 24802);
+
+  Settings::setValue(Settings::Core::Port);
+}
+
+void SettingsTests::snapshotScrollScaleClamped()
+{
+  Settings::setValue(Settings::Client::YScrollScale, 100.0);
+  Settings::setValue(Settings::Client::XScrollScale, 0.0);
+  QCOMPARE(SettingsSnapshot::current()->client.yScrollScale, 10.0);
+  QCOMPARE(SettingsSnapshot::current()->client.xScrollScale, 0.1);
+
+  Settings::setValue(Settings::Client::YScrollScale);
+  Settings::setValue(Settings::Client::XScrollScale);
+}
+
 QTEST_MAIN(SettingsTests)
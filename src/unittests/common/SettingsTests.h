@@ -5,6 +5,7 @@
  */
 
 #include "common/Settings.h"
+#include "common/SettingsSnapshot.h"
 
 #include <QTest>
 
@@ -24,6 +25,8 @@ private Q_SLOTS:
   void checkValidSettings();
   void checkCleanScreenName();
   void checkCleanScreenName_LongName();
+  void snapshot();
+  void snapshotScrollScaleClamped();
 
 private:
   inline static const QString m_settingsPathTemp = QStringLiteral("tmp/test");
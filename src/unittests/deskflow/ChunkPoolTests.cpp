@@ -0,0 +1,96 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "ChunkPoolTests.h"
+
+#include "deskflow/ChunkPool.h"
+
+void ChunkPoolTests::classSize()
+{
+  QCOMPARE(ChunkPool::classSize(0), ChunkPool::kSmallestClass);
+  QCOMPARE(ChunkPool::classSize(7), ChunkPool::kSmallestClass);
+  QCOMPARE(ChunkPool::classSize(65), size_t{128});
+  QCOMPARE(ChunkPool::classSize(512 * 1024), size_t{512 * 1024});
+  QCOMPARE(ChunkPool::classSize(512 * 1024 + 1), ChunkPool::kLargestClass);
+  QCOMPARE(ChunkPool::classSize(ChunkPool::kLargestClass + 1), ChunkPool::kLargestClass + 1);
+}
+
+void ChunkPoolTests::reusesReleased()
+{
+  ChunkPool pool;
+
+  auto *first = pool.acquire(1000);
+  pool.release(first, 1000);
+  auto *second = pool.acquire(900);
+
+  QCOMPARE(second, first);
+  QCOMPARE(pool.stats().allocations, uint64_t{1});
+  QCOMPARE(pool.stats().reuses, uint64_t{1});
+  QCOMPARE(pool.stats().idleBytes, size_t{0});
+  pool.release(second, 900);
+  QCOMPARE(pool.stats().idleBytes, size_t{1024});
+}
+
+void ChunkPoolTests::keepsClassesApart()
+{
+  ChunkPool pool;
+
+  auto *small = pool.acquire(100);
+  pool.release(small, 100);
+  auto *large = pool.acquire(10000);
+
+  QVERIFY(large != small);
+  QCOMPARE(pool.stats().allocations, uint64_t{2});
+  QCOMPARE(pool.stats().reuses, uint64_t{0});
+  pool.release(large, 10000);
+}
+
+void ChunkPoolTests::discardsOverCapacity()
+{
+  ChunkPool pool;
+  pool.setCapacity(1024);
+
+  auto *first = pool.acquire(1024);
+  auto *second = pool.acquire(1024);
+  pool.release(first, 1024);
+  pool.release(second, 1024);
+
+  QCOMPARE(pool.stats().idleBytes, size_t{1024});
+  QCOMPARE(pool.stats().discards, uint64_t{1});
+}
+
+void ChunkPoolTests::setCapacityTrims()
+{
+  ChunkPool pool;
+
+  auto *small = pool.acquire(64);
+  auto *large = pool.acquire(4096);
+  pool.release(small, 64);
+  pool.release(large, 4096);
+  pool.setCapacity(1024);
+
+  // the largest go first
+  QCOMPARE(pool.stats().idleBytes, size_t{64});
+  QCOMPARE(pool.acquire(64), small);
+  pool.release(small, 64);
+
+  pool.setCapacity(0);
+  QCOMPARE(pool.stats().idleBytes, size_t{0});
+}
+
+void ChunkPoolTests::largeNotPooled()
+{
+  ChunkPool pool;
+  const auto size = ChunkPool::kLargestClass + 1;
+
+  pool.release(pool.acquire(size), size);
+  pool.release(pool.acquire(size), size);
+
+  QCOMPARE(pool.stats().allocations, uint64_t{2});
+  QCOMPARE(pool.stats().idleBytes, size_t{0});
+}
+
+QTEST_MAIN(ChunkPoolTests)
@@ -7,7 +7,9 @@
 
 #include "ClipboardChunksTests.h"
 
+#include "deskflow/ClipboardBuffer.h"
 #include "deskflow/ClipboardChunk.h"
+#include "deskflow/ClipboardPartials.h"
 #include "deskflow/ProtocolTypes.h"
 #include "deskflow/ProtocolUtil.h"
 #include "io/IStream.h"
@@ -159,6 +161,11 @@ std::string encodeClipboardMsg(ClipboardID id, uint32_t seq, uint8_t mark, const
   return stream.str();
 }
 
+std::string resumeHeader(size_t size, uint64_t transferId, size_t offset)
+{
+  return std::to_string(size) + " " + std::to_string(transferId) + " " + std::to_string(offset);
+}
+
 } // namespace
 
 void ClipboardChunksTests::initTestCase()
@@ -234,7 +241,7 @@ void ClipboardChunksTests::assembleAllowsDataAtExpectedSizeAndLimit()
   stream.push(encodeClipboardMsg(0, 7, ChunkType::DataChunk, "CD"));
   stream.push(encodeClipboardMsg(0, 7, ChunkType::DataEnd, ""));
 
-  std::string cached;
+  ClipboardBuffer cached;
   ClipboardID id = kClipboardEnd;
   uint32_t seq = 0;
   ClipboardChunkAssemblyState state;
@@ -244,7 +251,7 @@ void ClipboardChunksTests::assembleAllowsDataAtExpectedSizeAndLimit()
   QCOMPARE(ClipboardChunk::assemble(&stream, cached, id, seq, state, 4), TransferState::InProgress);
   QCOMPARE(ClipboardChunk::assemble(&stream, cached, id, seq, state, 4), TransferState::Finished);
 
-  QCOMPARE(cached, std::string("ABCD"));
+  QCOMPARE(cached.view(), std::string_view("ABCD"));
   QCOMPARE(id, static_cast<ClipboardID>(0));
   QCOMPARE(seq, static_cast<uint32_t>(7));
   QCOMPARE(ClipboardChunk::getExpectedSize(state), static_cast<size_t>(4));
@@ -257,7 +264,7 @@ void ClipboardChunksTests::assembleRejectsDataBeyondExpectedSize()
   stream.push(encodeClipboardMsg(0, 7, ChunkType::DataStart, "1"));
   stream.push(encodeClipboardMsg(0, 7, ChunkType::DataChunk, "AA"));
 
-  std::string cached;
+  ClipboardBuffer cached;
   ClipboardID id = kClipboardEnd;
   uint32_t seq = 0;
   ClipboardChunkAssemblyState state;
@@ -274,7 +281,7 @@ void ClipboardChunksTests::assembleRejectsExpectedSizeBeyondLimit()
   MemoryStream stream;
   stream.push(encodeClipboardMsg(0, 7, ChunkType::DataStart, "8"));
 
-  std::string cached;
+  ClipboardBuffer cached;
   ClipboardID id = kClipboardEnd;
   uint32_t seq = 0;
   ClipboardChunkAssemblyState state;
@@ -285,4 +292,157 @@ void ClipboardChunksTests::assembleRejectsExpectedSizeBeyondLimit()
   QVERIFY(!state.active);
 }
 
+void ClipboardChunksTests::transferIdIsPortable()
+{
+  // both ends must agree, so it can't be std::hash.  short data is FNV-1a
+  QCOMPARE(ClipboardChunk::transferIdOf(""), uint64_t{0xcbf29ce484222325});
+  QCOMPARE(ClipboardChunk::transferIdOf("a"), uint64_t{0xaf63dc4c8601ec8c});
+  QCOMPARE(ClipboardChunk::transferIdOf("0123456789"), uint64_t{0x37f6d35d8270152b});
+  QCOMPARE(ClipboardChunk::transferIdOf("deskflow rocks!!"), uint64_t{0x82526a3a904c5ce7});
+
+  // a change in the high byte of a word still changes the id
+  QVERIFY(ClipboardChunk::transferIdOf("0123456789") != ClipboardChunk::transferIdOf("0123456\x80" "89"));
+}
+
+void ClipboardChunksTests::assembleResumesKeptTransfer()
+{
+  const auto transferId = ClipboardChunk::transferIdOf("ABCD");
+  ClipboardPartials partials;
+  ClipboardBuffer cached;
+  ClipboardID id = kClipboardEnd;
+  uint32_t seq = 0;
+
+  // the connection drops after the first chunk
+  {
+    MemoryStream stream;
+    stream.push(encodeClipboardMsg(1, 7, ChunkType::DataResume, resumeHeader(4, transferId, 0)));
+    stream.push(encodeClipboardMsg(1, 7, ChunkType::DataChunk, "AB"));
+
+    ClipboardChunkAssemblyState state;
+    QCOMPARE(ClipboardChunk::assemble(&stream, cached, id, seq, state, 4, &partials), TransferState::Started);
+    QCOMPARE(ClipboardChunk::assemble(&stream, cached, id, seq, state, 4, &partials), TransferState::InProgress);
+    partials.keep(state, std::move(cached));
+  }
+
+  MemoryStream stream;
+  stream.push(encodeClipboardMsg(1, 7, ChunkType::DataResume, resumeHeader(4, transferId, 2)));
+  stream.push(encodeClipboardMsg(1, 7, ChunkType::DataChunk, "CD"));
+  stream.push(encodeClipboardMsg(1, 7, ChunkType::DataEnd, ""));
+
+  cached.clear();
+  ClipboardChunkAssemblyState state;
+  QCOMPARE(ClipboardChunk::assemble(&stream, cached, id, seq, state, 4, &partials), TransferState::Started);
+  QCOMPARE(cached.view(), std::string_view("AB"));
+  QCOMPARE(ClipboardChunk::assemble(&stream, cached, id, seq, state, 4, &partials), TransferState::InProgress);
+  QCOMPARE(ClipboardChunk::assemble(&stream, cached, id, seq, state, 4, &partials), TransferState::Finished);
+  QCOMPARE(cached.view(), std::string_view("ABCD"));
+  QCOMPARE(id, static_cast<ClipboardID>(1));
+
+  // taken, so it can't be resumed twice
+  ClipboardBuffer data;
+  QVERIFY(!partials.take(1, transferId, 2, data));
+}
+
+void ClipboardChunksTests::assembleRejectsResumeNotKept()
+{
+  MemoryStream stream;
+  stream.push(encodeClipboardMsg(0, 7, ChunkType::DataResume, resumeHeader(4, 1, 2)));
+
+  ClipboardBuffer cached;
+  ClipboardID id = kClipboardEnd;
+  uint32_t seq = 0;
+  ClipboardChunkAssemblyState state;
+  ClipboardPartials partials;
+
+  QCOMPARE(ClipboardChunk::assemble(&stream, cached, id, seq, state, 4, &partials), TransferState::Error);
+  QVERIFY(cached.empty());
+  QVERIFY(!state.active);
+}
+
+void ClipboardChunksTests::assembleRejectsMismatchedTransferId()
+{
+  // the kept half isn't of the data the transfer id is for
+  const auto transferId = ClipboardChunk::transferIdOf("XYCD");
+  ClipboardPartials partials;
+  ClipboardBuffer cached;
+  ClipboardID id = kClipboardEnd;
+  uint32_t seq = 0;
+
+  {
+    MemoryStream stream;
+    stream.push(encodeClipboardMsg(0, 7, ChunkType::DataResume, resumeHeader(4, transferId, 0)));
+    stream.push(encodeClipboardMsg(0, 7, ChunkType::DataChunk, "AB"));
+
+    ClipboardChunkAssemblyState state;
+    QCOMPARE(ClipboardChunk::assemble(&stream, cached, id, seq, state, 4, &partials), TransferState::Started);
+    QCOMPARE(ClipboardChunk::assemble(&stream, cached, id, seq, state, 4, &partials), TransferState::InProgress);
+    partials.keep(state, std::move(cached));
+  }
+
+  MemoryStream stream;
+  stream.push(encodeClipboardMsg(0, 7, ChunkType::DataResume, resumeHeader(4, transferId, 2)));
+  stream.push(encodeClipboardMsg(0, 7, ChunkType::DataChunk, "CD"));
+  stream.push(encodeClipboardMsg(0, 7, ChunkType::DataEnd, ""));
+
+  cached.clear();
+  ClipboardChunkAssemblyState state;
+  QCOMPARE(ClipboardChunk::assemble(&stream, cached, id, seq, state, 4, &partials), TransferState::Started);
+  QCOMPARE(ClipboardChunk::assemble(&stream, cached, id, seq, state, 4, &partials), TransferState::InProgress);
+  QCOMPARE(ClipboardChunk::assemble(&stream, cached, id, seq, state, 4, &partials), TransferState::Error);
+  QVERIFY(cached.empty());
+}
+
+void ClipboardChunksTests::partialsReportKeptOffsets()
+{
+  ClipboardChunkAssemblyState state;
+  state.active = true;
+  state.id = kClipboardSelection;
+  state.transferId = 0x123456789abcdef0;
+  ClipboardPartials partials;
+  ClipboardBuffer kept;
+  kept.append("ABC");
+  partials.keep(state, std::move(kept));
+
+  BufferWriteStream written;
+  partials.sendOffsets(&written);
+  MemoryStream stream;
+  stream.push(written.str());
+
+  for (ClipboardID expected = 0; expected < kClipboardEnd; ++expected) {
+    char code[4];
+    QCOMPARE(stream.read(code, 4), uint32_t{4});
+    QVERIFY(memcmp(code, kMsgDClipboardResume, 4) == 0);
+
+    ClipboardID id = kClipboardEnd;
+    ClipboardResumePoint point;
+    QVERIFY(ClipboardPartials::readOffset(&stream, id, point));
+    QCOMPARE(id, expected);
+    QCOMPARE(point.transferId, expected == kClipboardSelection ? state.transferId : 0);
+    QCOMPARE(point.offset, expected == kClipboardSelection ? uint32_t{3} : 0);
+  }
+}
+
+void ClipboardChunksTests::bufferSpillsToFile()
+{
+  ClipboardBuffer buffer(4);
+  buffer.append("AB");
+  buffer.reserve(4);
+  QVERIFY(!buffer.isSpilled());
+
+  buffer.reserve(8);
+  QVERIFY(buffer.isSpilled());
+  QCOMPARE(buffer.view(), std::string_view("AB"));
+
+  buffer.append("CDEF");
+  QCOMPARE(buffer.view(), std::string_view("ABCDEF"));
+
+  buffer.truncate(3);
+  buffer.append("X");
+  QCOMPARE(buffer.view(), std::string_view("ABCX"));
+
+  buffer.clear();
+  QVERIFY(!buffer.isSpilled());
+  QVERIFY(buffer.empty());
+}
+
 QTEST_MAIN(ClipboardChunksTests)
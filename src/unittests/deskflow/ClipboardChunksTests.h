@@ -20,6 +20,12 @@ private Q_SLOTS:
   void assembleAllowsDataAtExpectedSizeAndLimit();
   void assembleRejectsDataBeyondExpectedSize();
   void assembleRejectsExpectedSizeBeyondLimit();
+  void transferIdIsPortable();
+  void assembleResumesKeptTransfer();
+  void assembleRejectsResumeNotKept();
+  void assembleRejectsMismatchedTransferId();
+  void partialsReportKeptOffsets();
+  void bufferSpillsToFile();
 
 private:
   Log m_log;
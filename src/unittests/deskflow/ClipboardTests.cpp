@@ -9,6 +9,8 @@
 #include "ClipboardTests.h"
 
 #include "deskflow/Clipboard.h"
+#include "deskflow/ClipboardChunk.h"
+#include "deskflow/ClipboardView.h"
 
 void ClipboardTests::initTestCase()
 {
@@ -230,4 +232,131 @@ void ClipboardTests::equalClipboards()
   clipboard2.close();
 }
 
+void ClipboardTests::snapshotCached()
+{
+  Clipboard clipboard;
+  clipboard.open(0);
+  clipboard.add(IClipboard::Format::Text, kTestString1);
+  clipboard.close();
+
+  const auto snapshot = clipboard.snapshot();
+  QCOMPARE(snapshot->m_version, clipboard.version());
+  QCOMPARE(snapshot->m_data, IClipboard::marshall(&clipboard));
+  QCOMPARE(snapshot->m_transferId, ClipboardChunk::transferIdOf(snapshot->m_data));
+  QCOMPARE(clipboard.snapshot(), snapshot);
+
+  clipboard.open(0);
+  clipboard.add(IClipboard::Format::HTML, kTestString2);
+  clipboard.close();
+
+  const auto changed = clipboard.snapshot();
+  QVERIFY(changed != snapshot);
+  QVERIFY(changed->m_version > snapshot->m_version);
+  QCOMPARE(changed->m_data, IClipboard::marshall(&clipboard));
+  QCOMPARE(Clipboard::snapshotOf(&clipboard), changed);
+}
+
+void ClipboardTests::snapshotSameData()
+{
+  Clipboard clipboard1;
+  clipboard1.open(0);
+  clipboard1.add(IClipboard::Format::Text, kTestString1);
+  clipboard1.close();
+
+  Clipboard clipboard2;
+  Clipboard::copy(&clipboard2, &clipboard1);
+  QVERIFY(clipboard2.snapshot()->hasSameData(*clipboard1.snapshot()));
+
+  clipboard2.open(0);
+  clipboard2.empty();
+  clipboard2.add(IClipboard::Format::Text, kTestString2);
+  clipboard2.close();
+  QVERIFY(!clipboard2.snapshot()->hasSameData(*clipboard1.snapshot()));
+}
+
+void ClipboardTests::snapshotHashCollision()
+{
+  // a hash collision mustn't hide a change
+  const Clipboard::Snapshot snapshot1{1, "data 1", 42};
+  const Clipboard::Snapshot snapshot2{2, "data 2", 42};
+  QVERIFY(!snapshot1.hasSameData(snapshot2));
+}
+
+void ClipboardTests::viewReadsMarshalled()
+{
+  Clipboard source;
+  source.open(0);
+  source.add(IClipboard::Format::Text, kTestString1);
+  source.add(IClipboard::Format::HTML, kTestString2);
+  source.close();
+  const auto data = source.marshall();
+
+  const ClipboardView view(data, 5);
+  QVERIFY(view.open(0));
+  QCOMPARE(view.getTime(), 5);
+  QVERIFY(view.has(IClipboard::Format::Text));
+  QVERIFY(view.has(IClipboard::Format::HTML));
+  QVERIFY(!view.has(IClipboard::Format::Bitmap));
+  QCOMPARE(view.get(IClipboard::Format::Text), kTestString1);
+  QCOMPARE(view.get(IClipboard::Format::HTML), kTestString2);
+  view.close();
+}
+
+void ClipboardTests::viewCopy()
+{
+  Clipboard source;
+  source.open(0);
+  source.add(IClipboard::Format::Text, kTestString1);
+  source.close();
+  const auto data = source.marshall();
+
+  const ClipboardView view(data, 0);
+  Clipboard clipboard;
+  QVERIFY(Clipboard::copy(&clipboard, &view));
+  QCOMPARE(clipboard.marshall(), data);
+}
+
+void ClipboardTests::viewTruncated()
+{
+  Clipboard source;
+  source.open(0);
+  source.add(IClipboard::Format::Text, kTestString1);
+  source.add(IClipboard::Format::HTML, kTestString2);
+  source.close();
+  const auto data = source.marshall();
+
+  // the formats before the one cut short are kept
+  const ClipboardView view(std::string_view(data).substr(0, data.size() - 1), 0);
+  QCOMPARE(view.get(IClipboard::Format::Text), kTestString1);
+  QVERIFY(!view.has(IClipboard::Format::HTML));
+
+  const ClipboardView empty(std::string_view(data).substr(0, 2), 0);
+  QVERIFY(!empty.has(IClipboard::Format::Text));
+}
+
+void ClipboardTests::viewShared()
+{
+  Clipboard source;
+  source.open(0);
+  source.add(IClipboard::Format::Text, kTestString1);
+  source.close();
+  const auto data = std::make_shared<const std::string>(source.marshall());
+
+  // without an owner there is nothing to share
+  const ClipboardView unowned(*data, 0);
+  QVERIFY(unowned.getShared(IClipboard::Format::Text).owner == nullptr);
+
+  // with one the data is handed out in place
+  const ClipboardView view(*data, 0, data);
+  const auto shared = view.getShared(IClipboard::Format::Text);
+  QVERIFY(shared.owner == data);
+  QCOMPARE(std::string(shared.data), kTestString1);
+  QVERIFY(shared.data.data() >= data->data() && shared.data.data() < data->data() + data->size());
+
+  // clipboards that don't keep shared data copy it
+  Clipboard clipboard;
+  QVERIFY(Clipboard::copy(&clipboard, &view));
+  QCOMPARE(clipboard.marshall(), *data);
+}
+
 QTEST_MAIN(ClipboardTests)
@@ -24,6 +24,13 @@ private Q_SLOTS:
   void unMarshalLongerText();
   void unMarshalTextAndHtml();
   void equalClipboards();
+  void snapshotCached();
+  void snapshotSameData();
+  void snapshotHashCollision();
+  void viewReadsMarshalled();
+  void viewCopy();
+  void viewTruncated();
+  void viewShared();
 
 private:
   const std::string kTestString1 = "deskflow rocks";
@@ -0,0 +1,131 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "ClockOffsetEstimatorTests.h"
+
+#include "deskflow/ClockOffsetEstimator.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+constexpr int64_t kMillisecond = 1000000;
+
+// simulates one exchange with a peer whose clock reads localTime + offset,
+// and returns the local time the reply arrived
+int64_t exchange(
+    ClockOffsetEstimator &estimator, int64_t localTime, int64_t offset, int64_t requestDelay, int64_t replyDelay
+)
+{
+  const int64_t originate = localTime;
+  const int64_t receive = originate + requestDelay + offset;
+  const int64_t transmit = receive + 100000; // peer takes 0.1ms to reply
+  const int64_t destination = transmit - offset + replyDelay;
+  estimator.addSample(originate, receive, transmit, destination);
+  return destination;
+}
+
+} // namespace
+
+void ClockOffsetEstimatorTests::noSamples()
+{
+  ClockOffsetEstimator estimator;
+
+  QVERIFY(!estimator.isValid());
+  QCOMPARE(estimator.offset(), int64_t{0});
+  QCOMPARE(estimator.toLocal(1234), int64_t{1234});
+}
+
+void ClockOffsetEstimatorTests::symmetricDelay()
+{
+  ClockOffsetEstimator estimator;
+  const int64_t offset = 5000 * kMillisecond;
+
+  exchange(estimator, 1000 * kMillisecond, offset, 2 * kMillisecond, 2 * kMillisecond);
+
+  QVERIFY(estimator.isValid());
+  QCOMPARE(estimator.offset(), offset);
+  QCOMPARE(estimator.rtt(), 4 * kMillisecond);
+  QCOMPARE(estimator.toLocal(offset + 42), int64_t{42});
+}
+
+void ClockOffsetEstimatorTests::asymmetricDelayBounded()
+{
+  // with asymmetric legs the error is at most half the round trip
+  ClockOffsetEstimator estimator;
+  const int64_t offset = -3000 * kMillisecond;
+
+  exchange(estimator, 1000 * kMillisecond, offset, 1 * kMillisecond, 9 * kMillisecond);
+
+  QVERIFY(std::llabs(estimator.offset() - offset) <= estimator.rtt() / 2);
+}
+
+void ClockOffsetEstimatorTests::jitter()
+{
+  // queuing delays are only ever added, so the least delayed exchange in
+  // the window should win over the noisy ones
+  ClockOffsetEstimator estimator;
+  const int64_t offset = 123456 * kMillisecond;
+  std::mt19937 random(42);
+  std::exponential_distribution<double> queuing(1.0 / (20.0 * kMillisecond));
+
+  int64_t now = 1000 * kMillisecond;
+  for (int i = 0; i < 100; ++i) {
+    const auto requestDelay = kMillisecond + static_cast<int64_t>(queuing(random));
+    const auto replyDelay = kMillisecond + static_cast<int64_t>(queuing(random));
+    now = exchange(estimator, now, offset, requestDelay, replyDelay) + 3000 * kMillisecond;
+  }
+
+  QVERIFY(std::llabs(estimator.offset() - offset) < 5 * kMillisecond);
+  QVERIFY(estimator.rtt() > 2 * kMillisecond);
+}
+
+void ClockOffsetEstimatorTests::drift()
+{
+  // the peer clock runs 100ppm fast; the estimate must keep up rather
+  // than stick to an old sample
+  ClockOffsetEstimator estimator;
+  std::mt19937 random(7);
+  std::uniform_int_distribution<int64_t> jitter(0, kMillisecond);
+
+  int64_t now = 0;
+  int64_t offset = 0;
+  for (int i = 0; i < 1000; ++i) {
+    offset = now / 10000;
+    exchange(estimator, now, offset, kMillisecond + jitter(random), kMillisecond + jitter(random));
+    now += 3000 * kMillisecond;
+  }
+
+  // the window spans 8 exchanges, 24s of drift is 2.4ms
+  QVERIFY(std::llabs(estimator.offset() - offset) < 3 * kMillisecond);
+}
+
+void ClockOffsetEstimatorTests::rejectsNegativeRtt()
+{
+  ClockOffsetEstimator estimator;
+
+  // the peer claims to have held the request longer than the round trip
+  estimator.addSample(0, 0, 10 * kMillisecond, 5 * kMillisecond);
+
+  QVERIFY(!estimator.isValid());
+}
+
+void ClockOffsetEstimatorTests::reset()
+{
+  ClockOffsetEstimator estimator;
+  exchange(estimator, 0, kMillisecond, kMillisecond, kMillisecond);
+  QVERIFY(estimator.isValid());
+
+  estimator.reset();
+
+  QVERIFY(!estimator.isValid());
+  QCOMPARE(estimator.offset(), int64_t{0});
+  QCOMPARE(estimator.rtt(), int64_t{0});
+}
+
+QTEST_MAIN(ClockOffsetEstimatorTests)
@@ -0,0 +1,20 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include <QTest>
+
+class ClockOffsetEstimatorTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void noSamples();
+  void symmetricDelay();
+  void asymmetricDelayBounded();
+  void jitter();
+  void drift();
+  void rejectsNegativeRtt();
+  void reset();
+};
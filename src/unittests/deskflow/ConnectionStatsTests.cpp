@@ -0,0 +1,93 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "ConnectionStatsTests.h"
+
+#include "deskflow/ConnectionStats.h"
+
+#include <memory>
+
+namespace {
+
+bool contains(const std::string &json, const std::string &part)
+{
+  return json.find(part) != std::string::npos;
+}
+
+} // namespace
+
+void ConnectionStatsTests::empty()
+{
+  const ConnectionStats stats("screen");
+  const std::string expected =
+      R"({"name":"screen","sent":{"messages":0,"bytes":0},"received":{"messages":0,"bytes":0},)"
+      R"("clock":{"rtt":0,"offset":0},"latency":{)"
+      R"("queue":{"count":0,"p50":0,"p90":0,"p99":0,"max":0},)"
+      R"("send":{"count":0,"p50":0,"p90":0,"p99":0,"max":0},)"
+      R"("inject":{"count":0,"p50":0,"p90":0,"p99":0,"max":0},)"
+      R"("age":{"count":0,"p50":0,"p90":0,"p99":0,"max":0}}})";
+
+  QCOMPARE(stats.toJson(), expected);
+}
+
+void ConnectionStatsTests::counters()
+{
+  ConnectionStats stats("screen");
+  stats.messageSent(10);
+  stats.messageSent(20);
+  stats.messageReceived(7);
+
+  const auto json = stats.toJson();
+  QVERIFY(contains(json, R"("sent":{"messages":2,"bytes":30})"));
+  QVERIFY(contains(json, R"("received":{"messages":1,"bytes":7})"));
+}
+
+void ConnectionStatsTests::clock()
+{
+  // reported in microseconds
+  ConnectionStats stats("screen");
+  stats.setClock(2500000, -1000000);
+
+  QVERIFY(contains(stats.toJson(), R"("clock":{"rtt":2500,"offset":-1000})"));
+}
+
+void ConnectionStatsTests::latencyStages()
+{
+  ConnectionStats stats("screen");
+  stats.latency(ConnectionStats::Stage::Send).record(1000000);
+  stats.latency(ConnectionStats::Stage::Send).record(1000000);
+
+  QCOMPARE(stats.latency(ConnectionStats::Stage::Send).count(), uint64_t{2});
+  QCOMPARE(stats.latency(ConnectionStats::Stage::Queue).count(), uint64_t{0});
+
+  const auto json = stats.toJson();
+  QVERIFY(contains(json, R"("queue":{"count":0,)"));
+  QVERIFY(contains(json, R"("send":{"count":2,)"));
+}
+
+void ConnectionStatsTests::escapesName()
+{
+  const ConnectionStats stats("a \"b\"\\\n");
+
+  QVERIFY(contains(stats.toJson(), R"({"name":"a \"b\"\\\u000a",)"));
+}
+
+void ConnectionStatsTests::reportLiveConnections()
+{
+  QCOMPARE(ConnectionStats::report(), std::string("[]"));
+
+  auto first = std::make_unique<ConnectionStats>("first");
+  const ConnectionStats second("second");
+  const auto report = ConnectionStats::report();
+  QVERIFY(report.starts_with(R"([{"name":"first",)"));
+  QVERIFY(contains(report, R"(},{"name":"second",)"));
+  QVERIFY(report.ends_with("]"));
+
+  first.reset();
+  QVERIFY(ConnectionStats::report().starts_with(R"([{"name":"second",)"));
+}
+
+QTEST_MAIN(ConnectionStatsTests)
@@ -0,0 +1,19 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include <QTest>
+
+class ConnectionStatsTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void empty();
+  void counters();
+  void clock();
+  void latencyStages();
+  void escapesName();
+  void reportLiveConnections();
+};
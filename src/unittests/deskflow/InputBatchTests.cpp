@@ -0,0 +1,201 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "InputBatchTests.h"
+
+#include "deskflow/InputBatch.h"
+#include "deskflow/ProtocolTypes.h"
+#include "deskflow/ProtocolUtil.h"
+#include "io/MemoryStream.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+// keeps everything written to it
+class CaptureStream : public deskflow::IStream
+{
+public:
+  void close() override
+  {
+  }
+
+  uint32_t read(void *, uint32_t) override
+  {
+    return 0;
+  }
+
+  void write(const void *buffer, uint32_t n) override
+  {
+    m_written.append(static_cast<const char *>(buffer), n);
+  }
+
+  void flush() override
+  {
+  }
+
+  void shutdownInput() override
+  {
+  }
+
+  void shutdownOutput() override
+  {
+  }
+
+  void *getEventTarget() const override
+  {
+    return const_cast<CaptureStream *>(this);
+  }
+
+  bool isReady() const override
+  {
+    return false;
+  }
+
+  uint32_t getSize() const override
+  {
+    return 0;
+  }
+
+  std::string m_written;
+};
+
+std::vector<uint8_t> format(const char *fmt, int32_t x, int32_t y)
+{
+  std::vector<uint8_t> message;
+  ProtocolUtil::appendf(message, fmt, x, y);
+  return message;
+}
+
+// the records of a batch message, and its base time
+std::string records(const std::string &message, uint64_t &baseTime)
+{
+  deskflow::MemoryStream stream(message);
+  uint8_t code[4];
+  uint32_t baseHi = 0;
+  uint32_t baseLo = 0;
+  std::string result;
+  if (stream.read(code, 4) != 4 || memcmp(code, kMsgDInputBatch, 4) != 0 ||
+      !ProtocolUtil::readf(&stream, kMsgDInputBatch + 4, &baseHi, &baseLo, &result)) {
+    return {};
+  }
+  baseTime = (uint64_t{baseHi} << 32) | baseLo;
+  return result;
+}
+
+} // namespace
+
+void InputBatchTests::sendWritesRecords()
+{
+  InputBatch batch;
+  const uint64_t base = 0x123456789abcdefULL;
+  batch.add(base, format(kMsgDMouseMove, 1, 2));
+  batch.add(base + 200'000, format(kMsgDMouseRelMove, -3, 4));
+  QVERIFY(!batch.isEmpty());
+
+  CaptureStream stream;
+  batch.send(&stream);
+  QVERIFY(batch.isEmpty());
+
+  uint64_t time = 0;
+  const auto data = records(stream.m_written, time);
+  QCOMPARE(time, base);
+
+  deskflow::MemoryStream recordStream(data);
+  uint64_t delta = 1;
+  uint8_t code[4];
+  int16_t x = 0;
+  int16_t y = 0;
+
+  QVERIFY(InputBatch::readDelta(&recordStream, delta));
+  QCOMPARE(delta, uint64_t{0});
+  QCOMPARE(recordStream.read(code, 4), 4u);
+  QCOMPARE(memcmp(code, kMsgDMouseMove, 4), 0);
+  QVERIFY(ProtocolUtil::readf(&recordStream, kMsgDMouseMove + 4, &x, &y));
+  QCOMPARE(x, int16_t{1});
+  QCOMPARE(y, int16_t{2});
+
+  // 200us needs two varint bytes
+  QVERIFY(InputBatch::readDelta(&recordStream, delta));
+  QCOMPARE(delta, uint64_t{200});
+  QCOMPARE(recordStream.read(code, 4), 4u);
+  QCOMPARE(memcmp(code, kMsgDMouseRelMove, 4), 0);
+  QVERIFY(ProtocolUtil::readf(&recordStream, kMsgDMouseRelMove + 4, &x, &y));
+  QCOMPARE(x, int16_t{-3});
+  QCOMPARE(y, int16_t{4});
+
+  QVERIFY(!recordStream.isReady());
+  QCOMPARE(data.size(), size_t{1 + 8 + 2 + 8});
+}
+
+void InputBatchTests::sendEmptyWritesNothing()
+{
+  InputBatch batch;
+  CaptureStream stream;
+
+  batch.send(&stream);
+
+  QVERIFY(stream.m_written.empty());
+}
+
+void InputBatchTests::timeGoingBackwardsIsZero()
+{
+  InputBatch batch;
+  batch.add(5'000'000, format(kMsgDMouseMove, 0, 0));
+  batch.add(4'000'000, format(kMsgDMouseMove, 0, 0));
+  batch.add(5'001'500, format(kMsgDMouseMove, 0, 0));
+
+  CaptureStream stream;
+  batch.send(&stream);
+  uint64_t time = 0;
+  const auto data = records(stream.m_written, time);
+  deskflow::MemoryStream recordStream(data);
+
+  uint64_t delta = 0;
+  QVERIFY(InputBatch::readDelta(&recordStream, delta));
+  QCOMPARE(delta, uint64_t{0});
+  recordStream.read(nullptr, 8);
+  QVERIFY(InputBatch::readDelta(&recordStream, delta));
+  QCOMPARE(delta, uint64_t{0});
+  recordStream.read(nullptr, 8);
+  QVERIFY(InputBatch::readDelta(&recordStream, delta));
+  QCOMPARE(delta, uint64_t{1});
+}
+
+void InputBatchTests::readDeltaRejectsTruncated()
+{
+  deskflow::MemoryStream stream("\x80\x80");
+  uint64_t delta = 0;
+
+  QVERIFY(!InputBatch::readDelta(&stream, delta));
+}
+
+void InputBatchTests::readDeltaRejectsOverlong()
+{
+  const std::string data(11, '\x80');
+  deskflow::MemoryStream stream(data);
+  uint64_t delta = 0;
+
+  QVERIFY(!InputBatch::readDelta(&stream, delta));
+}
+
+void InputBatchTests::isBatchable()
+{
+  const auto code = [](const char *message) { return reinterpret_cast<const uint8_t *>(message); };
+
+  QVERIFY(InputBatch::isBatchable(code(kMsgDKeyDown)));
+  QVERIFY(InputBatch::isBatchable(code(kMsgDKeyDownLang)));
+  QVERIFY(InputBatch::isBatchable(code(kMsgDMouseWheel)));
+  QVERIFY(InputBatch::isBatchable(code(kMsgDMouseMoveDelta)));
+  QVERIFY(!InputBatch::isBatchable(code(kMsgDInputBatch)));
+  QVERIFY(!InputBatch::isBatchable(code(kMsgDInputTime)));
+  QVERIFY(!InputBatch::isBatchable(code(kMsgCEnter)));
+}
+
+QTEST_MAIN(InputBatchTests)
@@ -0,0 +1,26 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "base/Log.h"
+
+#include <QTest>
+
+class InputBatchTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void sendWritesRecords();
+  void sendEmptyWritesNothing();
+  void timeGoingBackwardsIsZero();
+  void readDeltaRejectsTruncated();
+  void readDeltaRejectsOverlong();
+  void isBatchable();
+
+private:
+  Log m_log;
+};
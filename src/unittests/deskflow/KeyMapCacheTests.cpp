@@ -0,0 +1,112 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "KeyMapCacheTests.h"
+
+#include "deskflow/KeyMapCache.h"
+
+#include <QDir>
+#include <QSaveFile>
+#include <QTemporaryDir>
+
+using deskflow::KeyMapCache;
+
+namespace {
+
+QByteArray fingerprintOf(char c)
+{
+  return QByteArray(KeyMapCache::kFingerprintSize, c);
+}
+
+QFileInfoList entriesIn(const QTemporaryDir &dir)
+{
+  return QDir(dir.path()).entryInfoList({QStringLiteral("*.keymap")}, QDir::Files, QDir::Time);
+}
+
+} // namespace
+
+void KeyMapCacheTests::load_missing_returnsFalse()
+{
+  QTemporaryDir dir;
+  KeyMapCache cache(dir.path());
+
+  bool called = false;
+  QVERIFY(!cache.load(fingerprintOf('a'), [&called](auto) { return called = true; }));
+  QVERIFY(!called);
+}
+
+void KeyMapCacheTests::store_load_roundTrip()
+{
+  QTemporaryDir dir;
+  KeyMapCache cache(dir.path());
+  const std::vector<uint32_t> stored = {1, 0xffffffff, 3};
+  cache.store(fingerprintOf('a'), stored);
+
+  std::vector<uint32_t> loaded;
+  QVERIFY(cache.load(fingerprintOf('a'), [&loaded](auto words) {
+    loaded.assign(words.begin(), words.end());
+    return true;
+  }));
+  QCOMPARE(loaded, stored);
+
+  // and again, the file is still there
+  QVERIFY(cache.load(fingerprintOf('a'), [](auto) { return true; }));
+}
+
+void KeyMapCacheTests::load_otherFingerprint_returnsFalse()
+{
+  QTemporaryDir dir;
+  KeyMapCache cache(dir.path());
+  cache.store(fingerprintOf('a'), std::vector<uint32_t>{1});
+
+  QVERIFY(!cache.load(fingerprintOf('b'), [](auto) { return true; }));
+  QVERIFY(!cache.load(QByteArray("short"), [](auto) { return true; }));
+}
+
+void KeyMapCacheTests::load_readerFails_removesFile()
+{
+  QTemporaryDir dir;
+  KeyMapCache cache(dir.path());
+  cache.store(fingerprintOf('a'), std::vector<uint32_t>{1});
+
+  QVERIFY(!cache.load(fingerprintOf('a'), [](auto) { return false; }));
+  QCOMPARE(entriesIn(dir).size(), 0);
+}
+
+void KeyMapCacheTests::load_corrupt_removesFile()
+{
+  QTemporaryDir dir;
+  KeyMapCache cache(dir.path());
+  cache.store(fingerprintOf('a'), std::vector<uint32_t>{1, 2, 3});
+  const auto entries = entriesIn(dir);
+  QCOMPARE(entries.size(), 1);
+
+  // a payload shorter than the header says
+  QSaveFile file(entries.at(0).absoluteFilePath());
+  QVERIFY(file.open(QIODevice::WriteOnly));
+  const uint32_t header[] = {0x4d4b4644, KeyMapCache::kFormatVersion, 3};
+  file.write(reinterpret_cast<const char *>(header), sizeof(header));
+  file.write(fingerprintOf('a'));
+  QVERIFY(file.commit());
+
+  bool called = false;
+  QVERIFY(!cache.load(fingerprintOf('a'), [&called](auto) { return called = true; }));
+  QVERIFY(!called);
+  QCOMPARE(entriesIn(dir).size(), 0);
+}
+
+void KeyMapCacheTests::store_prunesOldest()
+{
+  QTemporaryDir dir;
+  KeyMapCache cache(dir.path());
+  for (char c = 'a'; c < 'a' + KeyMapCache::kMaxEntries + 2; ++c) {
+    cache.store(fingerprintOf(c), std::vector<uint32_t>{1});
+  }
+
+  QCOMPARE(entriesIn(dir).size(), KeyMapCache::kMaxEntries);
+}
+
+QTEST_MAIN(KeyMapCacheTests)
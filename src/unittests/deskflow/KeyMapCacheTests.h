@@ -0,0 +1,26 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "base/Log.h"
+
+#include <QTest>
+
+class KeyMapCacheTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void load_missing_returnsFalse();
+  void store_load_roundTrip();
+  void load_otherFingerprint_returnsFalse();
+  void load_readerFails_removesFile();
+  void load_corrupt_removesFile();
+  void store_prunesOldest();
+
+private:
+  Log m_log;
+};
@@ -201,4 +201,105 @@ void KeyMapTests::parseKey_plusSymbol_parsesAsAsciiKey()
   QCOMPARE(key, static_cast<KeyID>('+'));
 }
 
+void KeyMapTests::write_read_roundTrip()
+{
+  KeyMap keyMap;
+  KeyMap::KeyItem item;
+  item.m_id = 'a';
+  item.m_button = 38;
+  item.m_client = 7;
+  keyMap.addKeyEntry(item);
+  item.m_id = 'A';
+  item.m_required = KeyModifierShift;
+  item.m_sensitive = KeyModifierShift | KeyModifierCapsLock;
+  keyMap.addKeyEntry(item);
+  item.m_id = kKeyShift_L;
+  item.m_group = 1;
+  item.m_button = 50;
+  item.m_required = 0;
+  item.m_sensitive = 0;
+  item.m_generates = KeyModifierShift;
+  keyMap.addKeyEntry(item);
+  item.m_id = kKeyCapsLock;
+  item.m_button = 66;
+  item.m_generates = KeyModifierCapsLock;
+  item.m_lock = true;
+  keyMap.addKeyEntry(item);
+  keyMap.finish();
+  const KeyID keys[] = {kKeyShift_L, kKeyCapsLock};
+  QVERIFY(keyMap.addKeyCombinationEntry('B', 1, keys, 2));
+  keyMap.addHalfDuplexButton(66);
+  keyMap.allowGroupSwitchDuringCompose();
+
+  std::vector<uint32_t> written;
+  keyMap.write(written);
+  written.push_back(0xdeadbeef);
+
+  KeyMap readMap;
+  std::span<const uint32_t> words(written);
+  QVERIFY(readMap.read(words));
+  QCOMPARE(words.size(), size_t{1});
+  QCOMPARE(words.front(), uint32_t{0xdeadbeef});
+  QVERIFY(readMap.m_keyIDMap == keyMap.m_keyIDMap);
+  QVERIFY(readMap.m_halfDuplex == keyMap.m_halfDuplex);
+  QVERIFY(readMap.m_composeAcrossGroups);
+
+  keyMap.finish();
+  readMap.finish();
+  QCOMPARE(readMap.getNumGroups(), 2);
+  QCOMPARE(readMap.m_modifierKeys.size(), keyMap.m_modifierKeys.size());
+  QVERIFY(readMap.isHalfDuplex(kKeyNone, 66));
+}
+
+void KeyMapTests::read_truncated_leavesMapAlone()
+{
+  KeyMap keyMap;
+  KeyMap::KeyItem item;
+  item.m_id = 'a';
+  item.m_button = 38;
+  keyMap.addKeyEntry(item);
+  keyMap.addHalfDuplexButton(66);
+  std::vector<uint32_t> written;
+  keyMap.write(written);
+
+  KeyMap readMap;
+  for (size_t size = 0; size < written.size(); ++size) {
+    std::span<const uint32_t> words(written.data(), size);
+    QVERIFY(!readMap.read(words));
+    QCOMPARE(words.size(), size);
+    QVERIFY(readMap.m_keyIDMap.empty());
+    QVERIFY(readMap.m_halfDuplex.empty());
+  }
+
+  // a button that doesn't fit a KeyButton
+  written[2] = 0x10000;
+  std::span<const uint32_t> words(written);
+  QVERIFY(!readMap.read(words));
+}
+
+void KeyMapTests::findKey_indexesAllKeyIDs()
+{
+  KeyMap keyMap;
+  KeyMap::KeyItem item;
+  item.m_id = 'a';
+  item.m_button = 38;
+  keyMap.addKeyEntry(item);
+  item.m_id = 0x1f600; // outside the basic multilingual plane
+  item.m_button = 39;
+  keyMap.addKeyEntry(item);
+  keyMap.finish();
+
+  // keys added after finish are found too
+  item.m_id = kKeyF1;
+  item.m_button = 67;
+  keyMap.addKeyEntry(item);
+
+  for (const auto &[id, groupTable] : keyMap.m_keyIDMap) {
+    QCOMPARE(keyMap.findKey(id), &groupTable);
+  }
+  QCOMPARE(keyMap.m_keyIDMap.size(), size_t{3});
+  QVERIFY(keyMap.findKey('b') == nullptr);
+  QVERIFY(keyMap.findKey(0x1f601) == nullptr);
+}
+
 QTEST_MAIN(KeyMapTests)
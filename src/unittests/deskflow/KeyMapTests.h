@@ -23,6 +23,9 @@ private Q_SLOTS:
   void mapkey();
   void parseModifiers_plusKey_keepsPlusAsKey();
   void parseKey_plusSymbol_parsesAsAsciiKey();
+  void write_read_roundTrip();
+  void read_truncated_leavesMapAlone();
+  void findKey_indexesAllKeyIDs();
 
 private:
   Log m_log;
@@ -0,0 +1,344 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "MotionChannelTests.h"
+
+#include "base/EventQueue.h"
+#include "base/Stopwatch.h"
+#include "deskflow/MotionChannel.h"
+#include "deskflow/ProtocolTypes.h"
+#include "net/IDatagramSocket.h"
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace {
+
+using Kind = MotionChannel::Kind;
+using Bytes = std::vector<uint8_t>;
+
+// in-memory datagram socket joined to a peer.  the loss injector sees
+// each datagram sent and can drop it or hold it back to be delivered
+// later in any order.
+class LossySocket : public IDatagramSocket
+{
+public:
+  enum class Fate
+  {
+    Deliver,
+    Drop,
+    Hold
+  };
+
+  using LossInjector = std::function<Fate(const Bytes &)>;
+
+  explicit LossySocket(IEventQueue *events) : m_events(events)
+  {
+    // do nothing
+  }
+
+  void setPeer(LossySocket *peer)
+  {
+    m_peer = peer;
+  }
+
+  void setLossInjector(LossInjector injector)
+  {
+    m_injector = std::move(injector);
+  }
+
+  // delivers the held datagrams in the order given by their indices
+  void release(const std::vector<size_t> &order)
+  {
+    for (const auto index : order) {
+      m_peer->deliver(m_held[index]);
+    }
+    m_held.clear();
+  }
+
+  // ISocket overrides
+  void bind(const NetworkAddress &) override
+  {
+    // do nothing
+  }
+
+  void close() override
+  {
+    // do nothing
+  }
+
+  void *getEventTarget() const override
+  {
+    return const_cast<void *>(static_cast<const void *>(this));
+  }
+
+  // IDatagramSocket overrides
+  void connect(const NetworkAddress &) override
+  {
+    // do nothing
+  }
+
+  void connectToSender() override
+  {
+    // do nothing
+  }
+
+  bool send(const void *data, uint32_t size) override
+  {
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    Bytes datagram(bytes, bytes + size);
+    switch (m_injector ? m_injector(datagram) : Fate::Deliver) {
+    case Fate::Deliver:
+      m_peer->deliver(datagram);
+      break;
+    case Fate::Hold:
+      m_held.push_back(datagram);
+      break;
+    case Fate::Drop:
+      break;
+    }
+    return true;
+  }
+
+  uint32_t receive(void *buffer, uint32_t size) override
+  {
+    if (m_queue.empty()) {
+      m_signalled = false;
+      return 0;
+    }
+    const auto datagram = m_queue.front();
+    m_queue.pop_front();
+    const auto n = std::min(size, static_cast<uint32_t>(datagram.size()));
+    std::copy_n(datagram.begin(), n, static_cast<uint8_t *>(buffer));
+    return static_cast<uint32_t>(datagram.size());
+  }
+
+  int getPort() const override
+  {
+    return 24800;
+  }
+
+private:
+  void deliver(const Bytes &datagram)
+  {
+    m_queue.push_back(datagram);
+    if (!m_signalled) {
+      m_signalled = true;
+      m_events->addEvent(Event(EventTypes::StreamInputReady, getEventTarget()));
+    }
+  }
+
+  IEventQueue *m_events;
+  LossySocket *m_peer = nullptr;
+  LossInjector m_injector;
+  std::deque<Bytes> m_queue;
+  std::vector<Bytes> m_held;
+  bool m_signalled = false;
+};
+
+// runs the event loop until done() or the timeout, returns done()
+bool runUntil(EventQueue &events, const std::function<bool()> &done, double timeout = 5.0)
+{
+  Stopwatch stopwatch;
+  EventQueueTimer *timer = events.newTimer(0.01, nullptr);
+  events.addHandler(EventTypes::Timer, timer, [&](const auto &) {
+    if (done() || stopwatch.getTime() > timeout) {
+      events.addEvent(Event(EventTypes::Quit));
+    }
+  });
+  events.loop();
+  events.removeHandler(EventTypes::Timer, timer);
+  events.deleteTimer(timer);
+  return done();
+}
+
+uint32_t sequenceOf(const std::string &key, const Bytes &bytes)
+{
+  MotionChannel::Datagram datagram;
+  return MotionChannel::open(key, bytes.data(), bytes.size(), datagram) ? datagram.m_sequence : 0;
+}
+
+bool isMotion(const std::string &key, const Bytes &bytes)
+{
+  MotionChannel::Datagram datagram;
+  return MotionChannel::open(key, bytes.data(), bytes.size(), datagram) &&
+         (datagram.m_kind == Kind::Move || datagram.m_kind == Kind::RelativeMove);
+}
+
+// a server and client channel on a pair of lossy sockets
+struct Loopback
+{
+  explicit Loopback(EventQueue &events, const std::string &serverKey, const std::string &clientKey)
+      : m_serverSocket(new LossySocket(&events)),
+        m_clientSocket(new LossySocket(&events)),
+        m_server(&events, m_serverSocket, serverKey),
+        m_client(&events, m_clientSocket, clientKey)
+  {
+    m_serverSocket->setPeer(m_clientSocket);
+    m_clientSocket->setPeer(m_serverSocket);
+  }
+
+  void greet()
+  {
+    m_server.accept();
+    m_client.greet(
+        [this] { m_ready = true; },
+        [this](const MotionChannel::Datagram &datagram) { m_used.push_back(datagram.m_sequence); },
+        [this] { m_failed = true; }
+    );
+  }
+
+  LossySocket *m_serverSocket;
+  LossySocket *m_clientSocket;
+  MotionChannel m_server;
+  MotionChannel m_client;
+  bool m_ready = false;
+  bool m_failed = false;
+  std::vector<uint32_t> m_used;
+};
+
+} // namespace
+
+void MotionChannelTests::initTestCase()
+{
+  m_arch.init();
+}
+
+void MotionChannelTests::seal_roundTrip()
+{
+  const auto key = MotionChannel::newKey();
+  QCOMPARE(key.size(), MotionChannel::kKeySize);
+
+  const MotionChannel::Datagram sent{Kind::Move, 0xfffffffe, -32768, 2147483647};
+  const auto bytes = MotionChannel::seal(key, sent);
+  QVERIFY(bytes.size() <= MotionChannel::kMaxSize);
+
+  MotionChannel::Datagram opened;
+  QVERIFY(MotionChannel::open(key, bytes.data(), bytes.size(), opened));
+  QCOMPARE(opened.m_kind, sent.m_kind);
+  QCOMPARE(opened.m_sequence, sent.m_sequence);
+  QCOMPARE(opened.m_x, sent.m_x);
+  QCOMPARE(opened.m_y, sent.m_y);
+}
+
+void MotionChannelTests::open_rejectsWrongKey()
+{
+  const auto bytes = MotionChannel::seal(MotionChannel::newKey(), {Kind::Move, 1, 10, 20});
+
+  MotionChannel::Datagram opened;
+  QVERIFY(!MotionChannel::open(MotionChannel::newKey(), bytes.data(), bytes.size(), opened));
+}
+
+void MotionChannelTests::open_rejectsTampered()
+{
+  const auto key = MotionChannel::newKey();
+  const auto bytes = MotionChannel::seal(key, {Kind::RelativeMove, 7, -3, 4});
+
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    auto tampered = bytes;
+    tampered[i] ^= 0x01;
+    MotionChannel::Datagram opened;
+    QVERIFY(!MotionChannel::open(key, tampered.data(), tampered.size(), opened));
+  }
+}
+
+void MotionChannelTests::open_rejectsBadSize()
+{
+  const auto key = MotionChannel::newKey();
+  auto bytes = MotionChannel::seal(key, {Kind::Hello, 0, 0, 0});
+  MotionChannel::Datagram opened;
+
+  QVERIFY(!MotionChannel::open(key, bytes.data(), MotionChannel::kTagSize, opened));
+  QVERIFY(!MotionChannel::open(key, bytes.data(), bytes.size() - 1, opened));
+
+  bytes.resize(MotionChannel::kMaxSize + 1);
+  QVERIFY(!MotionChannel::open(key, bytes.data(), bytes.size(), opened));
+}
+
+void MotionChannelTests::channel_dropsLateMotion()
+{
+  EventQueue events;
+  const auto key = MotionChannel::newKey();
+  Loopback loopback(events, key, key);
+  loopback.greet();
+  QVERIFY(runUntil(events, [&loopback] { return loopback.m_ready; }));
+  QVERIFY(loopback.m_server.isAlive());
+
+  // hold back the first four and deliver them reordered, then lose one
+  loopback.m_serverSocket->setLossInjector([&key](const Bytes &bytes) {
+    if (!isMotion(key, bytes)) {
+      return LossySocket::Fate::Deliver;
+    }
+    const auto sequence = sequenceOf(key, bytes);
+    if (sequence <= 4) {
+      return LossySocket::Fate::Hold;
+    }
+    return sequence == 5 ? LossySocket::Fate::Drop : LossySocket::Fate::Deliver;
+  });
+  for (int i = 1; i <= 4; ++i) {
+    QVERIFY(loopback.m_server.sendMove(i, i));
+  }
+  loopback.m_serverSocket->release({1, 0, 3, 2});
+  QVERIFY(loopback.m_server.sendMove(5, 5));
+  QVERIFY(loopback.m_server.sendRelativeMove(1, 1));
+
+  QVERIFY(runUntil(events, [&loopback] { return loopback.m_used.size() == 3; }));
+  QCOMPARE(loopback.m_used, (std::vector<uint32_t>{2, 4, 6}));
+  QCOMPARE(loopback.m_client.getDropped(), uint32_t{2});
+  QCOMPARE(loopback.m_client.getSequence(), uint32_t{6});
+}
+
+void MotionChannelTests::channel_syncDropsOlderMotion()
+{
+  EventQueue events;
+  const auto key = MotionChannel::newKey();
+  Loopback loopback(events, key, key);
+  loopback.greet();
+  QVERIFY(runUntil(events, [&loopback] { return loopback.m_ready; }));
+
+  // motion that arrives after the server moved on over TCP is stale
+  loopback.m_serverSocket->setLossInjector([&key](const Bytes &bytes) {
+    return isMotion(key, bytes) ? LossySocket::Fate::Hold : LossySocket::Fate::Deliver;
+  });
+  QVERIFY(loopback.m_server.sendMove(1, 1));
+  QVERIFY(loopback.m_server.sendMove(2, 2));
+  loopback.m_client.sync(loopback.m_server.getSequence());
+  loopback.m_serverSocket->release({0, 1});
+
+  QVERIFY(runUntil(events, [&loopback] { return loopback.m_client.getDropped() == 2; }));
+  QVERIFY(loopback.m_used.empty());
+}
+
+void MotionChannelTests::channel_ignoresWrongKey()
+{
+  EventQueue events;
+  Loopback loopback(events, MotionChannel::newKey(), MotionChannel::newKey());
+  loopback.greet();
+
+  QVERIFY(runUntil(events, [&loopback] { return loopback.m_server.getDropped() >= 2; }));
+  QVERIFY(!loopback.m_ready);
+  QVERIFY(!loopback.m_server.isAlive());
+  QVERIFY(!loopback.m_server.sendMove(1, 1));
+}
+
+void MotionChannelTests::channel_failsWithoutReply()
+{
+  EventQueue events;
+  const auto key = MotionChannel::newKey();
+  Loopback loopback(events, key, key);
+
+  // a firewall that drops every greeting
+  loopback.m_clientSocket->setLossInjector([](const Bytes &) { return LossySocket::Fate::Drop; });
+  loopback.greet();
+
+  QVERIFY(runUntil(events, [&loopback] { return loopback.m_failed; }, kMotionChannelTimeout + 2.0));
+  QVERIFY(!loopback.m_ready);
+  QVERIFY(!loopback.m_server.isAlive());
+}
+
+QTEST_MAIN(MotionChannelTests)
@@ -0,0 +1,31 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "arch/Arch.h"
+#include "base/Log.h"
+
+#include <QTest>
+
+class MotionChannelTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void initTestCase();
+  void seal_roundTrip();
+  void open_rejectsWrongKey();
+  void open_rejectsTampered();
+  void open_rejectsBadSize();
+  void channel_dropsLateMotion();
+  void channel_syncDropsOlderMotion();
+  void channel_ignoresWrongKey();
+  void channel_failsWithoutReply();
+
+private:
+  Arch m_arch;
+  Log m_log;
+};
@@ -0,0 +1,100 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "ProtocolUtilTests.h"
+
+#include "deskflow/DeskflowException.h"
+#include "deskflow/ProtocolTypes.h"
+#include "deskflow/ProtocolUtil.h"
+#include "io/MemoryStream.h"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string toString(const std::vector<uint8_t> &buffer)
+{
+  return {buffer.begin(), buffer.end()};
+}
+
+} // namespace
+
+void ProtocolUtilTests::initTestCase()
+{
+  m_log.setFilter(LogLevel::Level::Info);
+}
+
+void ProtocolUtilTests::varint_data()
+{
+  QTest::addColumn<int32_t>("value");
+  QTest::addColumn<int>("size");
+
+  QTest::newRow("zero") << 0 << 1;
+  QTest::newRow("one") << 1 << 1;
+  QTest::newRow("minus one") << -1 << 1;
+  QTest::newRow("largest 1 byte") << 63 << 1;
+  QTest::newRow("smallest 1 byte") << -64 << 1;
+  QTest::newRow("wheel tick") << 120 << 2;
+  QTest::newRow("minus wheel tick") << -120 << 2;
+  QTest::newRow("screen width") << 3840 << 2;
+  QTest::newRow("max") << std::numeric_limits<int32_t>::max() << 5;
+  QTest::newRow("min") << std::numeric_limits<int32_t>::min() << 5;
+}
+
+void ProtocolUtilTests::varint()
+{
+  QFETCH(int32_t, value);
+  QFETCH(int, size);
+
+  std::vector<uint8_t> buffer;
+  ProtocolUtil::appendf(buffer, "%v", value);
+  QCOMPARE(static_cast<int>(buffer.size()), size);
+
+  const auto data = toString(buffer);
+  deskflow::MemoryStream stream(data);
+  int32_t result = 0;
+  QVERIFY(ProtocolUtil::readf(&stream, "%v", &result));
+  QCOMPARE(result, value);
+  QVERIFY(!stream.isReady());
+}
+
+void ProtocolUtilTests::varintRejectsOverlong()
+{
+  const std::string data(6, '\x80');
+  deskflow::MemoryStream stream(data);
+  int32_t result = 0;
+
+  bool thrown = false;
+  try {
+    ProtocolUtil::readf(&stream, "%v", &result);
+  } catch (const BadClientException &) {
+    thrown = true;
+  }
+  QVERIFY(thrown);
+}
+
+void ProtocolUtilTests::compactMotionIsSmaller()
+{
+  std::vector<uint8_t> fixed;
+  std::vector<uint8_t> compact;
+
+  ProtocolUtil::appendf(fixed, kMsgDMouseMove, 400, 300);
+  ProtocolUtil::appendf(compact, kMsgDMouseMoveDelta, 3, -1);
+  QCOMPARE(fixed.size(), size_t{8});
+  QCOMPARE(compact.size(), size_t{6});
+
+  fixed.clear();
+  compact.clear();
+  ProtocolUtil::appendf(fixed, kMsgDMouseWheel, 0, 120);
+  ProtocolUtil::appendf(compact, kMsgDMouseWheelCompact, 0, 120);
+  QCOMPARE(fixed.size(), size_t{8});
+  QCOMPARE(compact.size(), size_t{7});
+}
+
+QTEST_MAIN(ProtocolUtilTests)
@@ -0,0 +1,192 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "HappyEyeballsConnectorTests.h"
+
+#include "base/BaseException.h"
+#include "base/EventQueue.h"
+#include "net/HappyEyeballsConnector.h"
+#include "net/IDataSocket.h"
+#include "net/SocketMultiplexer.h"
+#include "net/TCPListenSocket.h"
+#include "net/TCPSocketFactory.h"
+
+#include <QTest>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace {
+
+using enum IArchNetwork::AddressFamily;
+
+const int kFirstPort = 24900;
+const int kLastPort = 25000;
+
+NetworkAddress resolved(const std::string &host, int port)
+{
+  NetworkAddress address(host, port);
+  address.resolve();
+  return address;
+}
+
+// binds a loopback listener to the first free port in a small range
+int listenOnLoopback(TCPListenSocket &listener)
+{
+  for (int port = kFirstPort; port < kLastPort; ++port) {
+    try {
+      listener.bind(resolved("127.0.0.1", port));
+      return port;
+    } catch (BaseException &) {
+      // in use, try the next one
+    }
+  }
+  return 0;
+}
+
+// a loopback port that was listening a moment ago and now refuses
+int closedLoopbackPort(IEventQueue *events, SocketMultiplexer *multiplexer)
+{
+  TCPListenSocket listener(events, multiplexer, INet);
+  return listenOnLoopback(listener);
+}
+
+struct RaceResult
+{
+  std::unique_ptr<IDataSocket> m_winner;
+  std::string m_error;
+  bool m_finished = false;
+  double m_seconds = 0.0;
+};
+
+// runs a connection race on a real event loop until it finishes or
+// gives up after a few seconds
+RaceResult race(EventQueue &events, const TCPSocketFactory &factory, std::vector<NetworkAddress> candidates)
+{
+  RaceResult result;
+  const auto start = std::chrono::steady_clock::now();
+
+  auto quit = [&events, &result, start] {
+    result.m_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    events.addEvent(Event(EventTypes::Quit));
+  };
+
+  HappyEyeballsConnector connector(&events, [&factory](const NetworkAddress &address) {
+    return factory.create(ARCH->getAddrFamily(address.getAddress()));
+  });
+
+  EventQueueTimer *timeout = events.newOneShotTimer(5.0, nullptr);
+  events.addHandler(EventTypes::Timer, timeout, [quit](const auto &) { quit(); });
+
+  connector.connect(
+      std::move(candidates),
+      [&result, quit](IDataSocket *socket, const NetworkAddress &) {
+        result.m_winner.reset(socket);
+        result.m_finished = true;
+        quit();
+      },
+      [&result, quit](const std::string &error) {
+        result.m_error = error;
+        result.m_finished = true;
+        quit();
+      }
+  );
+  events.loop();
+
+  events.removeHandler(EventTypes::Timer, timeout);
+  events.deleteTimer(timeout);
+  return result;
+}
+
+} // namespace
+
+void HappyEyeballsConnectorTests::initTestCase()
+{
+  m_arch.init();
+}
+
+void HappyEyeballsConnectorTests::interleave_alternatesFamilies()
+{
+  const std::vector<NetworkAddress> addresses{
+      resolved("::1", 1), resolved("::1", 2), resolved("::1", 3), resolved("127.0.0.1", 4), resolved("127.0.0.1", 5)
+  };
+
+  const auto sorted = HappyEyeballsConnector::interleave(addresses);
+
+  QCOMPARE(sorted.size(), size_t{5});
+  QCOMPARE(sorted[0].getPort(), 1);
+  QCOMPARE(sorted[1].getPort(), 4);
+  QCOMPARE(sorted[2].getPort(), 2);
+  QCOMPARE(sorted[3].getPort(), 5);
+  QCOMPARE(sorted[4].getPort(), 3);
+}
+
+void HappyEyeballsConnectorTests::connect_refusedFallsThrough()
+{
+  EventQueue events;
+  SocketMultiplexer multiplexer;
+  TCPSocketFactory factory(&events, &multiplexer);
+  TCPListenSocket listener(&events, &multiplexer, INet);
+  const int port = listenOnLoopback(listener);
+  QVERIFY(port != 0);
+  const int refused = closedLoopbackPort(&events, &multiplexer);
+  QVERIFY(refused != 0);
+
+  auto result = race(events, factory, {resolved("127.0.0.1", refused), resolved("127.0.0.1", port)});
+
+  QVERIFY(result.m_finished);
+  QVERIFY(result.m_winner != nullptr);
+  QVERIFY(result.m_error.empty());
+}
+
+void HappyEyeballsConnectorTests::connect_unreachableDoesNotHoldUp()
+{
+  EventQueue events;
+  SocketMultiplexer multiplexer;
+  TCPSocketFactory factory(&events, &multiplexer);
+  TCPListenSocket listener(&events, &multiplexer, INet);
+  const int port = listenOnLoopback(listener);
+  QVERIFY(port != 0);
+
+  // a documentation address never answers, so without racing this would
+  // wait for the whole connection timeout
+  auto result = race(events, factory, {resolved("192.0.2.1", port), resolved("127.0.0.1", port)});
+
+  QVERIFY(result.m_finished);
+  QVERIFY(result.m_winner != nullptr);
+  QVERIFY(result.m_seconds < 2.0);
+}
+
+void HappyEyeballsConnectorTests::connect_allRefusedFails()
+{
+  EventQueue events;
+  SocketMultiplexer multiplexer;
+  TCPSocketFactory factory(&events, &multiplexer);
+  const int refused = closedLoopbackPort(&events, &multiplexer);
+  QVERIFY(refused != 0);
+
+  auto result = race(events, factory, {resolved("127.0.0.1", refused), resolved("127.0.0.1", refused)});
+
+  QVERIFY(result.m_finished);
+  QVERIFY(result.m_winner == nullptr);
+  QVERIFY(!result.m_error.empty());
+}
+
+void HappyEyeballsConnectorTests::connect_noCandidatesFails()
+{
+  EventQueue events;
+  SocketMultiplexer multiplexer;
+  TCPSocketFactory factory(&events, &multiplexer);
+
+  auto result = race(events, factory, {});
+
+  QVERIFY(result.m_finished);
+  QVERIFY(result.m_winner == nullptr);
+  QVERIFY(!result.m_error.empty());
+}
+
+QTEST_MAIN(HappyEyeballsConnectorTests)
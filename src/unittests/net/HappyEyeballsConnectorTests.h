@@ -0,0 +1,28 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "arch/Arch.h"
+#include "base/Log.h"
+
+#include <QObject>
+
+class HappyEyeballsConnectorTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void initTestCase();
+  void interleave_alternatesFamilies();
+  void connect_refusedFallsThrough();
+  void connect_unreachableDoesNotHoldUp();
+  void connect_allRefusedFails();
+  void connect_noCandidatesFails();
+
+private:
+  Arch m_arch;
+  Log m_log;
+};
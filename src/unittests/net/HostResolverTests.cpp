@@ -0,0 +1,269 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "HostResolverTests.h"
+
+#include "base/IEventQueue.h"
+#include "net/HostResolver.h"
+#include "net/SocketException.h"
+
+#include <QTest>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+// collects the events posted by the resolver thread
+class ResultQueue : public IEventQueue
+{
+public:
+  ~ResultQueue() override
+  {
+    for (const auto &event : m_events) {
+      Event::deleteData(event);
+    }
+  }
+
+  int loop() override
+  {
+    return 0;
+  }
+
+  void adoptBuffer(IEventQueueBuffer *) override
+  {
+  }
+
+  bool getEvent(Event &, double = -1.0) override
+  {
+    return false;
+  }
+
+  bool dispatchEvent(const Event &) override
+  {
+    return false;
+  }
+
+  void addEvent(Event &&event) override
+  {
+    {
+      std::scoped_lock lock{m_mutex};
+      m_events.emplace_back(std::move(event));
+    }
+    m_added.notify_all();
+  }
+
+  EventQueueTimer *newTimer(double, void *) override
+  {
+    return nullptr;
+  }
+
+  EventQueueTimer *newOneShotTimer(double, void *) override
+  {
+    return nullptr;
+  }
+
+  void deleteTimer(EventQueueTimer *) override
+  {
+  }
+
+  void addHandler(EventTypes, void *, const EventHandler &) override
+  {
+  }
+
+  void removeHandler(EventTypes, void *) override
+  {
+  }
+
+  void removeHandlers(void *) override
+  {
+  }
+
+  void waitForReady() const override
+  {
+  }
+
+  void *getSystemTarget() override
+  {
+    return this;
+  }
+
+  //! Wait for \p count results and return the last one
+  const HostResolver::Result *waitForResult(size_t count)
+  {
+    std::unique_lock lock{m_mutex};
+    if (!m_added.wait_for(lock, 5s, [this, count] { return m_events.size() >= count; })) {
+      return nullptr;
+    }
+    const auto &event = m_events[count - 1];
+    if (event.getType() != EventTypes::HostResolved) {
+      return nullptr;
+    }
+    return static_cast<const HostResolver::Result *>(event.getDataObject());
+  }
+
+  size_t size()
+  {
+    std::scoped_lock lock{m_mutex};
+    return m_events.size();
+  }
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_added;
+  std::vector<Event> m_events;
+};
+
+// answers every lookup with one address, optionally waiting for a signal
+class StubLookup
+{
+public:
+  std::vector<NetworkAddress> operator()(const NetworkAddress &address)
+  {
+    ++m_calls;
+    if (m_block) {
+      m_release.wait();
+    }
+    if (m_fail) {
+      throw SocketAddressException(SocketAddressException::SocketError::NotFound, address.getHostname(), 0);
+    }
+    return {NetworkAddress("192.0.2.1", address.getPort())};
+  }
+
+  std::atomic<int> m_calls = 0;
+  bool m_block = false;
+  bool m_fail = false;
+  std::promise<void> m_unblock;
+  std::shared_future<void> m_release = m_unblock.get_future().share();
+};
+
+HostResolver::Lookup lookupWith(StubLookup &stub)
+{
+  return [&stub](const NetworkAddress &address) { return stub(address); };
+}
+
+const NetworkAddress kServer("server.example", 24800);
+
+} // namespace
+
+void HostResolverTests::resolve_deliversAddresses()
+{
+  ResultQueue events;
+  StubLookup stub;
+  HostResolver resolver(&events, lookupWith(stub));
+
+  const auto id = resolver.resolve(kServer, this);
+
+  const auto *result = events.waitForResult(1);
+  QVERIFY(result != nullptr);
+  QCOMPARE(result->m_id, id);
+  QVERIFY(result->m_error.empty());
+  QCOMPARE(result->m_addresses.size(), size_t{1});
+  QCOMPARE(result->m_addresses[0].getPort(), 24800);
+}
+
+void HostResolverTests::resolve_doesNotBlockCaller()
+{
+  ResultQueue events;
+  StubLookup stub;
+  stub.m_block = true;
+  HostResolver resolver(&events, lookupWith(stub));
+
+  // returns while the lookup is still stuck in the resolver
+  resolver.resolve(kServer, this);
+  QCOMPARE(events.size(), size_t{0});
+
+  stub.m_unblock.set_value();
+  QVERIFY(events.waitForResult(1) != nullptr);
+}
+
+void HostResolverTests::resolve_usesCache()
+{
+  ResultQueue events;
+  StubLookup stub;
+  HostResolver resolver(&events, lookupWith(stub));
+
+  resolver.resolve(kServer, this);
+  QVERIFY(events.waitForResult(1) != nullptr);
+  const auto id = resolver.resolve(kServer, this);
+
+  const auto *result = events.waitForResult(2);
+  QVERIFY(result != nullptr);
+  QCOMPARE(result->m_id, id);
+  QCOMPARE(result->m_addresses.size(), size_t{1});
+  QCOMPARE(stub.m_calls.load(), 1);
+}
+
+void HostResolverTests::resolve_cacheExpires()
+{
+  ResultQueue events;
+  StubLookup stub;
+  HostResolver resolver(&events, lookupWith(stub), 0s);
+
+  resolver.resolve(kServer, this);
+  QVERIFY(events.waitForResult(1) != nullptr);
+  resolver.resolve(kServer, this);
+  QVERIFY(events.waitForResult(2) != nullptr);
+
+  QCOMPARE(stub.m_calls.load(), 2);
+}
+
+void HostResolverTests::resolve_sharesPendingLookup()
+{
+  ResultQueue events;
+  StubLookup stub;
+  stub.m_block = true;
+  HostResolver resolver(&events, lookupWith(stub));
+
+  const auto first = resolver.resolve(kServer, this);
+  const auto second = resolver.resolve(kServer, this);
+  QVERIFY(first != second);
+
+  stub.m_unblock.set_value();
+  QVERIFY(events.waitForResult(2) != nullptr);
+  QCOMPARE(stub.m_calls.load(), 1);
+}
+
+void HostResolverTests::resolve_failureIsNotCached()
+{
+  ResultQueue events;
+  StubLookup stub;
+  stub.m_fail = true;
+  HostResolver resolver(&events, lookupWith(stub));
+
+  resolver.resolve(kServer, this);
+  const auto *result = events.waitForResult(1);
+  QVERIFY(result != nullptr);
+  QVERIFY(result->m_addresses.empty());
+  QVERIFY(!result->m_error.empty());
+
+  resolver.resolve(kServer, this);
+  QVERIFY(events.waitForResult(2) != nullptr);
+  QCOMPARE(stub.m_calls.load(), 2);
+}
+
+void HostResolverTests::clear_forgetsCache()
+{
+  ResultQueue events;
+  StubLookup stub;
+  HostResolver resolver(&events, lookupWith(stub));
+
+  resolver.resolve(kServer, this);
+  QVERIFY(events.waitForResult(1) != nullptr);
+  resolver.clear();
+  resolver.resolve(kServer, this);
+  QVERIFY(events.waitForResult(2) != nullptr);
+
+  QCOMPARE(stub.m_calls.load(), 2);
+}
+
+QTEST_MAIN(HostResolverTests)
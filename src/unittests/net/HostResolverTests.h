@@ -0,0 +1,27 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "base/Log.h"
+
+#include <QObject>
+
+class HostResolverTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void resolve_deliversAddresses();
+  void resolve_doesNotBlockCaller();
+  void resolve_usesCache();
+  void resolve_cacheExpires();
+  void resolve_sharesPendingLookup();
+  void resolve_failureIsNotCached();
+  void clear_forgetsCache();
+
+private:
+  Log m_log;
+};
@@ -0,0 +1,268 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "SecureSocketTests.h"
+
+#include "base/BaseException.h"
+#include "base/EventQueue.h"
+#include "common/Settings.h"
+#include "net/FingerprintDatabase.h"
+#include "net/IDataSocket.h"
+#include "net/IListenSocket.h"
+#include "net/NetworkAddress.h"
+#include "net/SecureUtils.h"
+#include "net/SocketMultiplexer.h"
+#include "net/TCPSocketFactory.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTest>
+
+#include <memory>
+#include <openssl/pem.h>
+
+namespace {
+
+using enum IArchNetwork::AddressFamily;
+
+const int kFirstPort = 24900;
+const int kLastPort = 25000;
+const double kTimeout = 10.0;
+const int kTransferSize = 16 * 1024 * 1024;
+
+Fingerprint fingerprintOf(const QString &path)
+{
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return {};
+  }
+  const auto pem = file.readAll();
+
+  BIO *bio = BIO_new_mem_buf(pem.constData(), static_cast<int>(pem.size()));
+  X509 *cert = PEM_read_bio_X509(bio, nullptr, nullptr, nullptr);
+  BIO_free(bio);
+
+  auto fingerprint = deskflow::sslCertFingerprint(cert, QCryptographicHash::Sha256);
+  X509_free(cert);
+  return fingerprint;
+}
+
+// a connected pair of sockets over loopback, plain or secure
+class Loopback
+{
+public:
+  explicit Loopback(bool secure) : m_level(secure ? SecurityLevel::Encrypted : SecurityLevel::PlainText)
+  {
+    // do nothing
+  }
+
+  ~Loopback()
+  {
+    if (m_server) {
+      m_events.removeHandlers(m_server->getEventTarget());
+    }
+    if (m_client) {
+      m_events.removeHandlers(m_client->getEventTarget());
+    }
+    if (m_listener) {
+      m_events.removeHandlers(m_listener.get());
+    }
+  }
+
+  Loopback(const Loopback &) = delete;
+  Loopback &operator=(const Loopback &) = delete;
+
+  //! Connect a client to a new listener, including the tls handshake
+  bool open()
+  {
+    using enum EventTypes;
+
+    m_listener.reset(m_factory.createListen(INet, m_level));
+    const int port = listen();
+    if (port == 0) {
+      return false;
+    }
+
+    m_events.addHandler(ListenSocketConnecting, m_listener.get(), [this](const auto &) {
+      m_server = m_listener->accept();
+      if (!m_server) {
+        quit();
+      } else if (m_level == SecurityLevel::PlainText) {
+        serverReady();
+      } else {
+        m_events.addHandler(ClientListenerAccepted, m_server->getEventTarget(), [this](const auto &) {
+          serverReady();
+        });
+      }
+    });
+
+    m_client.reset(m_factory.create(INet, m_level));
+    const auto connected = m_level == SecurityLevel::PlainText ? DataSocketConnected : DataSocketSecureConnected;
+    m_events.addHandler(connected, m_client->getEventTarget(), [this](const auto &) {
+      m_clientReady = true;
+      checkReady();
+    });
+
+    NetworkAddress address("127.0.0.1", port);
+    address.resolve();
+    m_client->connect(address);
+    run();
+    return m_serverReady && m_clientReady;
+  }
+
+  //! Write \p data on the client and return what the server reads
+  QByteArray send(const QByteArray &data)
+  {
+    m_received.clear();
+    m_expected = data.size();
+    m_client->write(data.constData(), static_cast<uint32_t>(data.size()));
+    run();
+    return m_received;
+  }
+
+private:
+  int listen()
+  {
+    for (int port = kFirstPort; port < kLastPort; ++port) {
+      try {
+        NetworkAddress address("127.0.0.1", port);
+        address.resolve();
+        m_listener->bind(address);
+        return port;
+      } catch (BaseException &) {
+        // in use, try the next one
+      }
+    }
+    return 0;
+  }
+
+  void serverReady()
+  {
+    m_serverReady = true;
+    m_events.addHandler(EventTypes::StreamInputReady, m_server->getEventTarget(), [this](const auto &) {
+      char buffer[64 * 1024];
+      while (uint32_t n = m_server->read(buffer, sizeof(buffer))) {
+        m_received.append(buffer, n);
+      }
+      if (m_received.size() >= m_expected) {
+        quit();
+      }
+    });
+    checkReady();
+  }
+
+  void checkReady()
+  {
+    if (m_serverReady && m_clientReady) {
+      quit();
+    }
+  }
+
+  void quit()
+  {
+    m_events.addEvent(Event(EventTypes::Quit));
+  }
+
+  // runs the event loop until something quits it or it times out
+  void run()
+  {
+    EventQueueTimer *timeout = m_events.newOneShotTimer(kTimeout, nullptr);
+    m_events.addHandler(EventTypes::Timer, timeout, [this](const auto &) { quit(); });
+    m_events.loop();
+    m_events.removeHandler(EventTypes::Timer, timeout);
+    m_events.deleteTimer(timeout);
+  }
+
+  EventQueue m_events;
+  SocketMultiplexer m_multiplexer;
+  TCPSocketFactory m_factory{&m_events, &m_multiplexer};
+  SecurityLevel m_level;
+  std::unique_ptr<IListenSocket> m_listener;
+  std::unique_ptr<IDataSocket> m_server;
+  std::unique_ptr<IDataSocket> m_client;
+  bool m_serverReady = false;
+  bool m_clientReady = false;
+  QByteArray m_received;
+  qsizetype m_expected = 0;
+};
+
+void addModes()
+{
+  QTest::addColumn<bool>("secure");
+  QTest::addColumn<bool>("kernelTls");
+
+  QTest::newRow("plaintext") << false << false;
+  QTest::newRow("openssl") << true << false;
+  QTest::newRow("ktls") << true << true;
+}
+
+} // namespace
+
+void SecureSocketTests::initTestCase()
+{
+#ifdef Q_OS_WIN
+  // the trusted fingerprint database lives outside the settings dir
+  QSKIP("tls dir is not relocatable on windows");
+#endif
+
+  m_arch.init();
+  QVERIFY(m_dir.isValid());
+  Settings::setSettingsFile(m_dir.filePath(QStringLiteral("Deskflow.conf")));
+
+  const auto certificate = m_dir.filePath(QStringLiteral("Deskflow.pem"));
+  deskflow::generatePemSelfSignedCert(certificate);
+  Settings::setValue(Settings::Security::Certificate, certificate);
+
+  // the client refuses servers that it doesn't already trust
+  FingerprintDatabase db;
+  db.addTrusted(fingerprintOf(certificate));
+  QVERIFY(QDir().mkpath(Settings::tlsDir()));
+  QVERIFY(db.write(Settings::tlsTrustedServersDb()));
+}
+
+void SecureSocketTests::transfer_data()
+{
+  addModes();
+}
+
+void SecureSocketTests::transfer()
+{
+  QFETCH(bool, secure);
+  QFETCH(bool, kernelTls);
+  Settings::setValue(Settings::Security::KernelTls, kernelTls);
+
+  Loopback loopback(secure);
+  QVERIFY(loopback.open());
+
+  QByteArray data(1024 * 1024, Qt::Uninitialized);
+  for (qsizetype i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<char>(i * 7);
+  }
+
+  QCOMPARE(loopback.send(data), data);
+}
+
+void SecureSocketTests::benchmarkLoopback_data()
+{
+  addModes();
+}
+
+void SecureSocketTests::benchmarkLoopback()
+{
+  QFETCH(bool, secure);
+  QFETCH(bool, kernelTls);
+  Settings::setValue(Settings::Security::KernelTls, kernelTls);
+
+  Loopback loopback(secure);
+  QVERIFY(loopback.open());
+  const QByteArray data(kTransferSize, 'x');
+
+  QBENCHMARK {
+    QCOMPARE(loopback.send(data).size(), data.size());
+  }
+}
+
+QTEST_MAIN(SecureSocketTests)
@@ -0,0 +1,29 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "arch/Arch.h"
+#include "base/Log.h"
+
+#include <QObject>
+#include <QTemporaryDir>
+
+class SecureSocketTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void initTestCase();
+  void transfer_data();
+  void transfer();
+  void benchmarkLoopback_data();
+  void benchmarkLoopback();
+
+private:
+  Arch m_arch;
+  Log m_log;
+  QTemporaryDir m_dir;
+};
@@ -0,0 +1,262 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "TCPSocketTests.h"
+
+#include "base/BaseException.h"
+#include "base/EventQueue.h"
+#include "net/NetworkAddress.h"
+#include "net/SocketMultiplexer.h"
+#include "net/SocketMultiplexerPool.h"
+#include "net/TCPListenSocket.h"
+#include "net/TCPSocket.h"
+
+#include <QTest>
+
+#include <memory>
+#include <string>
+
+namespace {
+
+using enum IArchNetwork::AddressFamily;
+
+const int kFirstPort = 24900;
+const int kLastPort = 25000;
+const double kTimeout = 5.0;
+
+std::string packet(const std::string &payload)
+{
+  const auto n = static_cast<uint32_t>(payload.size());
+  std::string result(4, '\0');
+  result[0] = static_cast<char>(n >> 24);
+  result[1] = static_cast<char>(n >> 16);
+  result[2] = static_cast<char>(n >> 8);
+  result[3] = static_cast<char>(n);
+  return result + payload;
+}
+
+std::string readAll(deskflow::IStream &stream)
+{
+  char buffer[256];
+  const auto n = stream.read(buffer, sizeof(buffer));
+  return {buffer, n};
+}
+
+// a connected pair of plain sockets over loopback
+class Loopback
+{
+public:
+  explicit Loopback(SocketMultiplexerPool *acceptPool = nullptr)
+      : m_listener{&m_events, &m_multiplexer, INet, acceptPool}
+  {
+    // do nothing
+  }
+
+  ~Loopback()
+  {
+    if (m_server) {
+      m_events.removeHandlers(m_server->getEventTarget());
+    }
+    m_events.removeHandlers(m_client.getEventTarget());
+    m_events.removeHandlers(&m_listener);
+  }
+
+  bool open()
+  {
+    const int port = listen();
+    if (port == 0) {
+      return false;
+    }
+
+    m_events.addHandler(EventTypes::ListenSocketConnecting, &m_listener, [this](const auto &) {
+      m_server = m_listener.accept();
+      quit();
+    });
+
+    NetworkAddress address("127.0.0.1", port);
+    address.resolve();
+    m_client.connect(address);
+    run();
+    return m_server != nullptr;
+  }
+
+  //! Run the event loop until \p type is sent for \p socket
+  bool waitFor(EventTypes type, const IDataSocket &socket)
+  {
+    bool sent = false;
+    m_events.addHandler(type, socket.getEventTarget(), [this, &sent](const auto &) {
+      sent = true;
+      quit();
+    });
+    run();
+    m_events.removeHandler(type, socket.getEventTarget());
+    return sent;
+  }
+
+  IDataSocket &server()
+  {
+    return *m_server;
+  }
+
+  TCPSocket &client()
+  {
+    return m_client;
+  }
+
+private:
+  int listen()
+  {
+    for (int port = kFirstPort; port < kLastPort; ++port) {
+      try {
+        NetworkAddress address("127.0.0.1", port);
+        address.resolve();
+        m_listener.bind(address);
+        return port;
+      } catch (BaseException &) {
+        // in use, try the next one
+      }
+    }
+    return 0;
+  }
+
+  void quit()
+  {
+    m_events.addEvent(Event(EventTypes::Quit));
+  }
+
+  void run()
+  {
+    EventQueueTimer *timeout = m_events.newOneShotTimer(kTimeout, nullptr);
+    m_events.addHandler(EventTypes::Timer, timeout, [this](const auto &) { quit(); });
+    m_events.loop();
+    m_events.removeHandler(EventTypes::Timer, timeout);
+    m_events.deleteTimer(timeout);
+  }
+
+  EventQueue m_events;
+  SocketMultiplexer m_multiplexer;
+  TCPListenSocket m_listener;
+  TCPSocket m_client{&m_events, &m_multiplexer, INet};
+  std::unique_ptr<IDataSocket> m_server;
+};
+
+} // namespace
+
+void TCPSocketTests::initTestCase()
+{
+  m_arch.init();
+}
+
+void TCPSocketTests::framed_readsWholePackets()
+{
+  Loopback loopback;
+  QVERIFY(loopback.open());
+  loopback.server().setFramed(1024);
+
+  const auto data = packet("hello") + packet("") + packet("abc");
+  loopback.client().write(data.data(), 7);
+  QVERIFY(loopback.waitFor(EventTypes::StreamOutputFlushed, loopback.client()));
+  QVERIFY(!loopback.server().isReady());
+  QCOMPARE(readAll(loopback.server()), std::string());
+
+  loopback.client().write(data.data() + 7, static_cast<uint32_t>(data.size() - 7));
+  QVERIFY(loopback.waitFor(EventTypes::StreamInputReady, loopback.server()));
+
+  QCOMPARE(loopback.server().getSize(), 5u);
+  QCOMPARE(readAll(loopback.server()), std::string("hello"));
+  QCOMPARE(readAll(loopback.server()), std::string("abc"));
+  QCOMPARE(readAll(loopback.server()), std::string());
+}
+
+void TCPSocketTests::framed_writesLength()
+{
+  Loopback loopback;
+  QVERIFY(loopback.open());
+  loopback.client().setFramed(1024);
+
+  loopback.client().write("abc", 3);
+  QVERIFY(loopback.waitFor(EventTypes::StreamInputReady, loopback.server()));
+
+  QCOMPARE(readAll(loopback.server()), packet("abc"));
+}
+
+void TCPSocketTests::framed_rejectsOversizedPacket()
+{
+  Loopback loopback;
+  QVERIFY(loopback.open());
+  loopback.server().setFramed(4);
+
+  const auto data = packet("hello");
+  loopback.client().write(data.data(), static_cast<uint32_t>(data.size()));
+
+  QVERIFY(loopback.waitFor(EventTypes::StreamInputFormatError, loopback.server()));
+  QVERIFY(!loopback.server().isReady());
+}
+
+void TCPSocketTests::framed_shutdownAfterPackets()
+{
+  Loopback loopback;
+  QVERIFY(loopback.open());
+  loopback.server().setFramed(1024);
+
+  const auto data = packet("abc");
+  loopback.client().write(data.data(), static_cast<uint32_t>(data.size()));
+  loopback.client().shutdownOutput();
+  QVERIFY(loopback.waitFor(EventTypes::StreamInputReady, loopback.server()));
+
+  // the shutdown only shows up once the buffered packet is read
+  QCOMPARE(readAll(loopback.server()), std::string("abc"));
+  QVERIFY(loopback.waitFor(EventTypes::StreamInputShutdown, loopback.server()));
+}
+
+void TCPSocketTests::framed_truncatedPacketIsError()
+{
+  Loopback loopback;
+  QVERIFY(loopback.open());
+  loopback.server().setFramed(1024);
+
+  const auto data = packet("abc") + packet("hello");
+  loopback.client().write(data.data(), static_cast<uint32_t>(data.size() - 2));
+  loopback.client().shutdownOutput();
+  QVERIFY(loopback.waitFor(EventTypes::StreamInputReady, loopback.server()));
+
+  QCOMPARE(readAll(loopback.server()), std::string("abc"));
+  QVERIFY(loopback.waitFor(EventTypes::StreamInputFormatError, loopback.server()));
+}
+
+void TCPSocketTests::pool_roundRobin()
+{
+  SocketMultiplexerPool pool(3);
+  QCOMPARE(pool.size(), size_t{3});
+
+  const auto *first = pool.next();
+  const auto *second = pool.next();
+  const auto *third = pool.next();
+  QVERIFY(first != second && second != third && first != third);
+  QCOMPARE(pool.next(), first);
+
+  QCOMPARE(SocketMultiplexerPool(0).size(), size_t{1});
+  QCOMPARE(SocketMultiplexerPool::sizeFor(2), size_t{2});
+  QVERIFY(SocketMultiplexerPool::sizeFor(0) >= 1);
+}
+
+void TCPSocketTests::pool_acceptedSocketsWork()
+{
+  // the accepted socket is serviced by another thread than the client
+  SocketMultiplexerPool pool(2);
+  Loopback loopback(&pool);
+  QVERIFY(loopback.open());
+
+  loopback.client().write("ping", 4);
+  QVERIFY(loopback.waitFor(EventTypes::StreamInputReady, loopback.server()));
+  QCOMPARE(readAll(loopback.server()), std::string("ping"));
+
+  loopback.server().write("pong", 4);
+  QVERIFY(loopback.waitFor(EventTypes::StreamInputReady, loopback.client()));
+  QCOMPARE(readAll(loopback.client()), std::string("pong"));
+}
+
+QTEST_MAIN(TCPSocketTests)
@@ -0,0 +1,30 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "arch/Arch.h"
+#include "base/Log.h"
+
+#include <QObject>
+
+class TCPSocketTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void initTestCase();
+  void framed_readsWholePackets();
+  void framed_writesLength();
+  void framed_rejectsOversizedPacket();
+  void framed_shutdownAfterPackets();
+  void framed_truncatedPacketIsError();
+  void pool_roundRobin();
+  void pool_acceptedSocketsWork();
+
+private:
+  Arch m_arch;
+  Log m_log;
+};
@@ -9,6 +9,9 @@
 #include "XWindowsClipboardTests.h"
 
 #include "platform/XWindowsClipboard.h"
+#include "platform/XWindowsUtil.h"
+
+#include <QElapsedTimer>
 
 class TestXWindowsClipboard : public XWindowsClipboard
 {
@@ -69,6 +72,200 @@ void XWindowsClipboardTests::singleFormat()
   QCOMPARE(clipboard.get(XWindowsClipboard::kText), m_testString2);
 }
 
+void XWindowsClipboardTests::sharedFormat()
+{
+  auto &clipboard = getClipboard();
+  QVERIFY(clipboard.empty());
+
+  // the clipboard keeps shared data rather than copying it
+  const auto data = std::make_shared<const std::string>(m_testString);
+  clipboard.addShared(XWindowsClipboard::Format::Text, {data, *data});
+  const auto shared = clipboard.getShared(XWindowsClipboard::Format::Text);
+  QVERIFY(shared.owner == data);
+  QCOMPARE(static_cast<const void *>(shared.data.data()), static_cast<const void *>(data->data()));
+  QCOMPARE(clipboard.get(XWindowsClipboard::Format::Text), m_testString);
+
+  // data that's added is shared too
+  clipboard.add(XWindowsClipboard::Format::Text, m_testString2);
+  QVERIFY(clipboard.getShared(XWindowsClipboard::Format::Text).owner != nullptr);
+  QCOMPARE(std::string(clipboard.getShared(XWindowsClipboard::Format::Text).data), m_testString2);
+}
+
+void XWindowsClipboardTests::fetchSlowOwner()
+{
+  using enum XWindowsClipboard::FetchStatus;
+
+  // another client owns the selection and takes a while to reply
+  Display *owner = XOpenDisplay(nullptr);
+  Window ownerWindow = XCreateSimpleWindow(owner, DefaultRootWindow(owner), 0, 0, 1, 1, 0, 0, 0);
+  const Atom selection = XInternAtom(owner, "CLIPBOARD", False);
+  const Atom utf8 = XInternAtom(owner, "UTF8_STRING", False);
+  XSetSelectionOwner(owner, selection, ownerWindow, CurrentTime);
+  XSync(owner, False);
+
+  XWindowsClipboard clipboard(m_display, m_window, kClipboardClipboard);
+  QElapsedTimer timer;
+  timer.start();
+  clipboard.fetch(CurrentTime);
+  QVERIFY(timer.elapsed() < 100);
+  QVERIFY(clipboard.isFetching());
+
+  auto status = Pending;
+  while (status == Pending && timer.elapsed() < 5000) {
+    // answer whatever has been asked for, after a delay
+    if (XPending(owner) > 0) {
+      QTest::qSleep(150);
+    }
+    while (XPending(owner) > 0) {
+      XEvent request;
+      XNextEvent(owner, &request);
+      if (request.type != SelectionRequest) {
+        continue;
+      }
+      XEvent reply = {};
+      reply.xselection.type = SelectionNotify;
+      reply.xselection.requestor = request.xselectionrequest.requestor;
+      reply.xselection.selection = request.xselectionrequest.selection;
+      reply.xselection.target = request.xselectionrequest.target;
+      reply.xselection.time = request.xselectionrequest.time;
+      reply.xselection.property = None;
+      if (request.xselectionrequest.target == utf8) {
+        reply.xselection.property = request.xselectionrequest.property;
+        XChangeProperty(
+            owner, reply.xselection.requestor, reply.xselection.property, utf8, 8, PropModeReplace,
+            reinterpret_cast<const unsigned char *>(m_testString.data()), static_cast<int>(m_testString.size())
+        );
+      }
+      XSendEvent(owner, reply.xselection.requestor, False, 0, &reply);
+    }
+    XFlush(owner);
+
+    // the retrieval only moves on with events
+    while (status == Pending && XPending(m_display) > 0) {
+      XEvent xevent;
+      XNextEvent(m_display, &xevent);
+      if (const auto next = clipboard.processFetchEvent(&xevent); next != Ignored) {
+        status = next;
+      }
+    }
+    if (status == Pending) {
+      QTest::qSleep(10);
+      status = clipboard.expireFetch();
+    }
+  }
+
+  QCOMPARE(status, Changed);
+  QVERIFY(!clipboard.isFetching());
+  QVERIFY(clipboard.open(0));
+  QVERIFY(clipboard.has(XWindowsClipboard::Format::Text));
+  QCOMPARE(clipboard.get(XWindowsClipboard::Format::Text), m_testString);
+  clipboard.close();
+
+  XDestroyWindow(owner, ownerWindow);
+  XCloseDisplay(owner);
+}
+
+void XWindowsClipboardTests::fetchStaleReply()
+{
+  using enum XWindowsClipboard::FetchStatus;
+
+  Display *owner = XOpenDisplay(nullptr);
+  Window ownerWindow = XCreateSimpleWindow(owner, DefaultRootWindow(owner), 0, 0, 1, 1, 0, 0, 0);
+  const Atom selection = XInternAtom(owner, "CLIPBOARD", False);
+  const Atom utf8 = XInternAtom(owner, "UTF8_STRING", False);
+  XSetSelectionOwner(owner, selection, ownerWindow, CurrentTime);
+  XSync(owner, False);
+
+  // answers a request for UTF-8 with data and refuses anything else
+  const auto reply = [&](const XSelectionRequestEvent &request, const std::string &data) {
+    XEvent notify = {};
+    notify.xselection.type = SelectionNotify;
+    notify.xselection.requestor = request.requestor;
+    notify.xselection.selection = request.selection;
+    notify.xselection.target = request.target;
+    notify.xselection.time = request.time;
+    notify.xselection.property = None;
+    if (request.target == utf8) {
+      notify.xselection.property = request.property;
+      XChangeProperty(
+          owner, request.requestor, request.property, utf8, 8, PropModeReplace,
+          reinterpret_cast<const unsigned char *>(data.data()), static_cast<int>(data.size())
+      );
+    }
+    XSendEvent(owner, request.requestor, False, 0, &notify);
+    XSync(owner, False);
+  };
+
+  // refuses what the owner is asked for, except UTF-8 which is held,
+  // and lets the clipboard go on with the retrieval
+  XWindowsClipboard clipboard(m_display, m_window, kClipboardClipboard);
+  auto status = Pending;
+  std::vector<XSelectionRequestEvent> held;
+  const auto pump = [&]() {
+    while (XPending(owner) > 0) {
+      XEvent request;
+      XNextEvent(owner, &request);
+      if (request.type != SelectionRequest) {
+        continue;
+      }
+      if (request.xselectionrequest.target == utf8) {
+        held.push_back(request.xselectionrequest);
+      } else {
+        reply(request.xselectionrequest, {});
+      }
+    }
+    while (XPending(m_display) > 0) {
+      XEvent xevent;
+      XNextEvent(m_display, &xevent);
+      if (const auto next = clipboard.processFetchEvent(&xevent); next != Ignored) {
+        status = next;
+      }
+    }
+  };
+  const auto pumpUntil = [&](const auto &done) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!done() && timer.elapsed() < 5000) {
+      pump();
+      QTest::qSleep(10);
+    }
+  };
+
+  // the owner sits on the first retrieval's request for UTF-8
+  const ::Time firstTime = XWindowsUtil::getCurrentTime(m_display, m_window);
+  clipboard.fetch(firstTime);
+  pumpUntil([&] { return !held.empty(); });
+  QCOMPARE(held.size(), std::size_t{1});
+  const auto staleRequest = held.front();
+  QCOMPARE(staleRequest.time, firstTime);
+  held.clear();
+
+  // a second retrieval asks for UTF-8 too, then the reply to the first
+  // arrives
+  QTest::qSleep(10);
+  const ::Time secondTime = XWindowsUtil::getCurrentTime(m_display, m_window);
+  clipboard.fetch(secondTime);
+  pumpUntil([&] { return !held.empty(); });
+  QCOMPARE(held.size(), std::size_t{1});
+  QCOMPARE(held.front().time, secondTime);
+  reply(staleRequest, m_testString2);
+  XSync(m_display, False);
+  pump();
+  QCOMPARE(status, Pending);
+
+  // the stale reply is ignored and the current one is taken
+  reply(held.front(), m_testString);
+  pumpUntil([&] { return status != Pending; });
+
+  QCOMPARE(status, Changed);
+  QVERIFY(clipboard.open(0));
+  QCOMPARE(clipboard.get(XWindowsClipboard::Format::Text), m_testString);
+  clipboard.close();
+
+  XDestroyWindow(owner, ownerWindow);
+  XCloseDisplay(owner);
+}
+
 XWindowsClipboard &XWindowsClipboardTests::getClipboard()
 {
   return *m_clipboard;
@@ -24,6 +24,9 @@ private Q_SLOTS:
   void cleanupTestCase();
   void open();
   void singleFormat();
+  void sharedFormat();
+  void fetchSlowOwner();
+  void fetchStaleReply();
 #endif
 private:
   Log m_log;
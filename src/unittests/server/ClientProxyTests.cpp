@@ -0,0 +1,270 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "ClientProxyTests.h"
+
+#include "base/EventQueue.h"
+#include "deskflow/MotionChannel.h"
+#include "deskflow/ProtocolTypes.h"
+#include "deskflow/ProtocolUtil.h"
+#include "io/IStream.h"
+#include "net/IDatagramSocket.h"
+#include "server/ClientProxy1_9.h"
+
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace {
+
+// what the proxy sent, in order: the code of each message written to the
+// connection, or "UDP" for each datagram
+using Wire = std::vector<std::string>;
+
+class RecordingStream : public deskflow::IStream
+{
+public:
+  explicit RecordingStream(Wire &wire) : m_wire(wire)
+  {
+    // do nothing
+  }
+
+  // queues a message's parameters for the proxy to read
+  void push(const std::vector<uint8_t> &bytes)
+  {
+    m_input.insert(m_input.end(), bytes.begin(), bytes.end());
+  }
+
+  void close() override
+  {
+    // do nothing
+  }
+
+  uint32_t read(void *buffer, uint32_t n) override
+  {
+    n = std::min(n, static_cast<uint32_t>(m_input.size()));
+    if (buffer != nullptr) {
+      std::copy_n(m_input.begin(), n, static_cast<uint8_t *>(buffer));
+    }
+    m_input.erase(m_input.begin(), m_input.begin() + n);
+    return n;
+  }
+
+  void write(const void *buffer, uint32_t n) override
+  {
+    m_wire.emplace_back(static_cast<const char *>(buffer), std::min(n, uint32_t{4}));
+  }
+
+  void flush() override
+  {
+    // do nothing
+  }
+
+  void shutdownInput() override
+  {
+    // do nothing
+  }
+
+  void shutdownOutput() override
+  {
+    // do nothing
+  }
+
+  void *getEventTarget() const override
+  {
+    return const_cast<void *>(static_cast<const void *>(this));
+  }
+
+  bool isReady() const override
+  {
+    return !m_input.empty();
+  }
+
+  uint32_t getSize() const override
+  {
+    return static_cast<uint32_t>(m_input.size());
+  }
+
+private:
+  Wire &m_wire;
+  std::deque<uint8_t> m_input;
+};
+
+class RecordingSocket : public IDatagramSocket
+{
+public:
+  explicit RecordingSocket(Wire &wire) : m_wire(wire)
+  {
+    // do nothing
+  }
+
+  // queues a datagram for the proxy's channel to receive
+  void push(const std::vector<uint8_t> &datagram)
+  {
+    m_input.push_back(datagram);
+  }
+
+  // ISocket overrides
+  void bind(const NetworkAddress &) override
+  {
+    // do nothing
+  }
+
+  void close() override
+  {
+    // do nothing
+  }
+
+  void *getEventTarget() const override
+  {
+    return const_cast<void *>(static_cast<const void *>(this));
+  }
+
+  // IDatagramSocket overrides
+  void connect(const NetworkAddress &) override
+  {
+    // do nothing
+  }
+
+  void connectToSender() override
+  {
+    // do nothing
+  }
+
+  bool send(const void *, uint32_t) override
+  {
+    m_wire.emplace_back("UDP");
+    return true;
+  }
+
+  uint32_t receive(void *buffer, uint32_t size) override
+  {
+    if (m_input.empty()) {
+      return 0;
+    }
+    const auto datagram = m_input.front();
+    m_input.pop_front();
+    const auto n = std::min(size, static_cast<uint32_t>(datagram.size()));
+    std::copy_n(datagram.begin(), n, static_cast<uint8_t *>(buffer));
+    return static_cast<uint32_t>(datagram.size());
+  }
+
+  int getPort() const override
+  {
+    return 24800;
+  }
+
+private:
+  Wire &m_wire;
+  std::deque<std::vector<uint8_t>> m_input;
+};
+
+// a proxy whose messages from the client can be fed in one at a time
+class TestProxy : public ClientProxy1_9
+{
+public:
+  TestProxy(RecordingStream *stream, IEventQueue *events, RecordingSocket *socket)
+      // the server is only used for clipboard transfers, which these tests don't do
+      : ClientProxy1_9("client", stream, reinterpret_cast<Server *>(0x1), events, socket),
+        m_stream(stream)
+  {
+    // do nothing
+  }
+
+  template <typename... Args> bool receive(const char *fmt, Args... args)
+  {
+    std::vector<uint8_t> message;
+    ProtocolUtil::appendf(message, fmt, args...);
+    m_stream->push({message.begin() + 4, message.end()});
+    return parseMessage(message.data());
+  }
+
+private:
+  RecordingStream *m_stream;
+};
+
+std::string batchCode()
+{
+  return {kMsgDInputBatch, 4};
+}
+
+// a proxy that batches input and has a motion channel up
+struct Connection
+{
+  explicit Connection(EventQueue &events)
+      : m_stream(new RecordingStream(m_wire)),
+        m_socket(new RecordingSocket(m_wire)),
+        m_proxy(m_stream, &events, m_socket)
+  {
+    const std::string noRecords;
+    QVERIFY(m_proxy.receive(kMsgDInputBatch, 0, 0, &noRecords));
+
+    // the greeting is queued before the key arrives, accepting reads it
+    const auto key = MotionChannel::newKey();
+    m_socket->push(MotionChannel::seal(key, {MotionChannel::Kind::Hello, 0, 0, 0}));
+    QVERIFY(m_proxy.receive(kMsgDMotionChannel, &key));
+    QVERIFY(m_proxy.receive(kMsgCMotionChannelReady));
+    m_wire.clear();
+  }
+
+  Wire m_wire;
+  RecordingStream *m_stream;
+  RecordingSocket *m_socket;
+  TestProxy m_proxy;
+};
+
+} // namespace
+
+void ClientProxyTests::initTestCase()
+{
+  m_arch.init();
+}
+
+void ClientProxyTests::motionChannel_sendsBatchedInputFirst()
+{
+  EventQueue events;
+  Connection connection(events);
+
+  // the press is batched, the move goes on the channel at once
+  connection.m_proxy.mouseDown(kButtonLeft);
+  connection.m_proxy.mouseMove(10, 20);
+  QCOMPARE(connection.m_wire, Wire({batchCode(), "UDP"}));
+}
+
+void ClientProxyTests::motionChannel_sendsBatchedInputFirstRelative()
+{
+  EventQueue events;
+  Connection connection(events);
+
+  connection.m_proxy.mouseUp(kButtonLeft);
+  connection.m_proxy.mouseRelativeMove(-3, 4);
+  QCOMPARE(connection.m_wire, Wire({batchCode(), "UDP"}));
+}
+
+void ClientProxyTests::inputTime_sampled()
+{
+  // timestamps without batching or a motion channel
+  EventQueue events;
+  Wire wire;
+  TestProxy proxy(new RecordingStream(wire), &events, nullptr);
+  QVERIFY(proxy.receive(kMsgCKeepAliveTime, 0, 1, 0, 0, 0, 0));
+  wire.clear();
+
+  const std::string inputTime(kMsgDInputTime, 4);
+  const std::string move(kMsgDMouseMoveDelta, 4);
+  for (uint32_t i = 0; i < 2 * kInputTimeInterval; ++i) {
+    proxy.sendInputTime(1000 + i);
+    proxy.mouseMove(static_cast<int32_t>(i), 0);
+  }
+
+  QCOMPARE(static_cast<uint32_t>(std::ranges::count(wire, move)), 2 * kInputTimeInterval);
+  QCOMPARE(std::ranges::count(wire, inputTime), std::ptrdiff_t{2});
+  QCOMPARE(wire.front(), inputTime);
+  QCOMPARE(wire[kInputTimeInterval + 1], inputTime);
+}
+
+QTEST_MAIN(ClientProxyTests)
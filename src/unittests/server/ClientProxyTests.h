@@ -0,0 +1,26 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#pragma once
+
+#include "arch/Arch.h"
+#include "base/Log.h"
+
+#include <QTest>
+
+class ClientProxyTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void initTestCase();
+  void motionChannel_sendsBatchedInputFirst();
+  void motionChannel_sendsBatchedInputFirstRelative();
+  void inputTime_sampled();
+
+private:
+  Arch m_arch;
+  Log m_log;
+};
@@ -0,0 +1,125 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "CompiledConfigTests.h"
+
+#include "server/CompiledConfig.h"
+#include "server/Config.h"
+
+#include <sstream>
+
+using namespace deskflow::server;
+
+namespace {
+
+const char *const kText = R"(section: screens
+  left:
+    halfDuplexCapsLock = true
+  middle:
+  right:
+    switchCornerSize = 10
+end
+section: aliases
+  middle:
+    centre
+    center
+end
+section: links
+  left:
+    right = middle
+  middle:
+    left(0,50) = left(50,100)
+    left(50,100) = left
+    right = right
+  right:
+    left = centre
+end
+section: options
+  keystroke(Control+Alt+Left) = switchInDirection(left)
+  keystroke(Control+Alt+1) = switchToScreen(left), keystroke(Shift+a,right); lockCursorToScreen(off)
+  keystroke(Super+b) = keyboardBroadcast(on,left:right)
+  keystroke(Control+Tab) = switchToNextScreen, mousebutton(Shift+1)
+end
+)";
+
+void readText(Config &config)
+{
+  std::istringstream stream(kText);
+  stream >> config;
+}
+
+// a valid compiled config of the text above
+std::string compiled()
+{
+  Config config(nullptr);
+  readText(config);
+  return CompiledConfig::write(config);
+}
+
+} // namespace
+
+void CompiledConfigTests::initTestCase()
+{
+  m_arch.init();
+}
+
+void CompiledConfigTests::roundTrip()
+{
+  Config text(nullptr);
+  readText(text);
+  QVERIFY(text.isScreen("center"));
+  QCOMPARE(text.getInputFilter()->getNumRules(), 4u);
+
+  const auto data = CompiledConfig::write(text);
+  QVERIFY(CompiledConfig::isCompiled(data));
+
+  Config binary(nullptr);
+  CompiledConfig::read(data, binary);
+  QVERIFY(binary == text);
+  QCOMPARE(binary.getCanonicalName("CENTRE"), "middle");
+
+  // compiling again gives the same bytes
+  QCOMPARE(CompiledConfig::write(binary), data);
+}
+
+void CompiledConfigTests::isCompiled_text()
+{
+  QVERIFY(!CompiledConfig::isCompiled(kText));
+  QVERIFY(!CompiledConfig::isCompiled(""));
+  QVERIFY(!CompiledConfig::isCompiled("DF"));
+}
+
+void CompiledConfigTests::read_corrupt()
+{
+  auto data = compiled();
+  data[data.size() / 2] = static_cast<char>(data[data.size() / 2] ^ 0x5a);
+
+  Config config(nullptr);
+  QVERIFY(config.addScreen("untouched"));
+  QVERIFY_THROWS_EXCEPTION(ServerConfigReadException, CompiledConfig::read(data, config));
+  QVERIFY(config.isScreen("untouched"));
+}
+
+void CompiledConfigTests::read_truncated()
+{
+  const auto data = compiled();
+
+  Config config(nullptr);
+  QVERIFY_THROWS_EXCEPTION(ServerConfigReadException, CompiledConfig::read(data.substr(0, data.size() - 1), config));
+  QVERIFY_THROWS_EXCEPTION(ServerConfigReadException, CompiledConfig::read(data.substr(0, 6), config));
+}
+
+void CompiledConfigTests::read_wrongVersion()
+{
+  // the version follows the four byte magic number
+  auto data = compiled();
+  data[4] = static_cast<char>(data[4] + 1);
+
+  Config config(nullptr);
+  QVERIFY_THROWS_EXCEPTION(ServerConfigReadException, CompiledConfig::read(data, config));
+}
+
+QTEST_MAIN(CompiledConfigTests)
@@ -0,0 +1,154 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "ConfigDiffTests.h"
+
+#include "server/Config.h"
+#include "server/ConfigDiff.h"
+
+using namespace deskflow::server;
+
+namespace {
+
+// three screens in a row
+void makeRow(Config &config)
+{
+  QVERIFY(config.addScreen("left"));
+  QVERIFY(config.addScreen("middle"));
+  QVERIFY(config.addScreen("right"));
+  QVERIFY(config.connect("left", Direction::Right, 0.0f, 1.0f, "middle", 0.0f, 1.0f));
+  QVERIFY(config.connect("middle", Direction::Left, 0.0f, 1.0f, "left", 0.0f, 1.0f));
+  QVERIFY(config.connect("middle", Direction::Right, 0.0f, 1.0f, "right", 0.0f, 1.0f));
+  QVERIFY(config.connect("right", Direction::Left, 0.0f, 1.0f, "middle", 0.0f, 1.0f));
+  QVERIFY(config.addOption("", kOptionHeartbeat, 5000));
+}
+
+} // namespace
+
+void ConfigDiffTests::same()
+{
+  Config a(nullptr);
+  Config b(nullptr);
+  makeRow(a);
+  makeRow(b);
+
+  const ConfigDiff diff(a, b);
+  QVERIFY(diff.isEmpty());
+  QVERIFY(!diff.linksChanged());
+  QVERIFY(!diff.optionsChanged("middle"));
+  QCOMPARE(diff.summary(), "no changes");
+}
+
+void ConfigDiffTests::screenAdded()
+{
+  Config a(nullptr);
+  Config b(nullptr);
+  makeRow(a);
+  makeRow(b);
+  QVERIFY(b.addScreen("above"));
+  QVERIFY(b.connect("above", Direction::Bottom, 0.0f, 1.0f, "middle", 0.0f, 1.0f));
+  QVERIFY(b.connect("middle", Direction::Top, 0.0f, 1.0f, "above", 0.0f, 1.0f));
+
+  const ConfigDiff diff(a, b);
+  QVERIFY(diff.linksChanged());
+  QCOMPARE(diff.addedScreens().size(), size_t{1});
+  QVERIFY(diff.addedScreens().contains("ABOVE"));
+  QVERIFY(diff.removedScreens().empty());
+  QCOMPARE(diff.relinkedScreens().size(), size_t{1});
+  QVERIFY(diff.relinkedScreens().contains("middle"));
+
+  // a new screen needs its options, the others don't
+  QVERIFY(diff.optionsChanged("above"));
+  QVERIFY(!diff.optionsChanged("left"));
+}
+
+void ConfigDiffTests::screenRemoved()
+{
+  Config a(nullptr);
+  Config b(nullptr);
+  makeRow(a);
+  QVERIFY(b.addScreen("left"));
+  QVERIFY(b.addScreen("middle"));
+  QVERIFY(b.connect("left", Direction::Right, 0.0f, 1.0f, "middle", 0.0f, 1.0f));
+  QVERIFY(b.connect("middle", Direction::Left, 0.0f, 1.0f, "left", 0.0f, 1.0f));
+  QVERIFY(b.addOption("", kOptionHeartbeat, 5000));
+
+  const ConfigDiff diff(a, b);
+  QVERIFY(diff.linksChanged());
+  QCOMPARE(diff.removedScreens().size(), size_t{1});
+  QVERIFY(diff.removedScreens().contains("right"));
+  QVERIFY(diff.relinkedScreens().contains("middle"));
+  QVERIFY(!diff.relinkedScreens().contains("left"));
+  QVERIFY(!diff.optionsChanged("left"));
+}
+
+void ConfigDiffTests::linkChanged()
+{
+  Config a(nullptr);
+  Config b(nullptr);
+  makeRow(a);
+  makeRow(b);
+  QVERIFY(b.disconnect("right", Direction::Left));
+  QVERIFY(b.connect("right", Direction::Left, 0.0f, 0.5f, "middle", 0.0f, 1.0f));
+
+  const ConfigDiff diff(a, b);
+  QVERIFY(!diff.isEmpty());
+  QVERIFY(diff.linksChanged());
+  QVERIFY(diff.addedScreens().empty());
+  QVERIFY(diff.removedScreens().empty());
+  QCOMPARE(diff.relinkedScreens().size(), size_t{1});
+  QVERIFY(diff.relinkedScreens().contains("right"));
+  QVERIFY(!diff.optionsChanged("right"));
+}
+
+void ConfigDiffTests::aliasChanged()
+{
+  Config a(nullptr);
+  Config b(nullptr);
+  makeRow(a);
+  makeRow(b);
+  QVERIFY(b.addAlias("middle", "centre"));
+
+  const ConfigDiff diff(a, b);
+  QVERIFY(diff.linksChanged());
+  QVERIFY(diff.relinkedScreens().empty());
+  QVERIFY(!diff.optionsChanged("middle"));
+}
+
+void ConfigDiffTests::screenOptionChanged()
+{
+  Config a(nullptr);
+  Config b(nullptr);
+  makeRow(a);
+  makeRow(b);
+  QVERIFY(b.addOption("left", kOptionHalfDuplexCapsLock, 1));
+
+  const ConfigDiff diff(a, b);
+  QVERIFY(!diff.isEmpty());
+  QVERIFY(!diff.linksChanged());
+  QVERIFY(!diff.globalOptionsChanged());
+  QVERIFY(diff.optionsChanged("left"));
+  QVERIFY(!diff.optionsChanged("middle"));
+  QVERIFY(!diff.optionsChanged("right"));
+}
+
+void ConfigDiffTests::globalOptionChanged()
+{
+  Config a(nullptr);
+  Config b(nullptr);
+  makeRow(a);
+  makeRow(b);
+  QVERIFY(b.addOption("", kOptionHeartbeat, 3000));
+
+  const ConfigDiff diff(a, b);
+  QVERIFY(!diff.linksChanged());
+  QVERIFY(diff.globalOptionsChanged());
+  QVERIFY(diff.optionsChanged("left"));
+  QVERIFY(diff.optionsChanged("middle"));
+  QVERIFY(diff.reoptionedScreens().empty());
+}
+
+QTEST_MAIN(ConfigDiffTests)
@@ -0,0 +1,20 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include <QTest>
+
+class ConfigDiffTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void same();
+  void screenAdded();
+  void screenRemoved();
+  void linkChanged();
+  void aliasChanged();
+  void screenOptionChanged();
+  void globalOptionChanged();
+};
@@ -0,0 +1,121 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include "NeighborGraphTests.h"
+
+#include "server/Config.h"
+#include "server/NeighborGraph.h"
+
+#include <array>
+
+using namespace deskflow::server;
+
+namespace {
+// the graph never dereferences client pointers so any distinct address will do
+std::array<char, 4> g_clients;
+BaseClientProxy *client(size_t index)
+{
+  return reinterpret_cast<BaseClientProxy *>(&g_clients.at(index));
+}
+} // namespace
+
+void NeighborGraphTests::emptyGraph()
+{
+  NeighborGraph graph;
+  QVERIFY(graph.getNeighbor(client(0), Direction::Left, 0.5f).m_client == nullptr);
+  QVERIFY(!graph.hasAnyNeighbor(client(0), Direction::Left));
+  QVERIFY(!graph.hasNeighbor(client(0), Direction::Left, 0.5f));
+}
+
+void NeighborGraphTests::connectedNeighbor()
+{
+  Config config(nullptr);
+  QVERIFY(config.addScreen("screenA"));
+  QVERIFY(config.addScreen("screenB"));
+  QVERIFY(config.connect("screenA", Direction::Right, 0.0f, 1.0f, "screenB", 0.0f, 1.0f));
+
+  NeighborGraph graph(config, {{"screenA", client(0)}, {"screenB", client(1)}});
+
+  const auto neighbor = graph.getNeighbor(client(0), Direction::Right, 0.25f);
+  QCOMPARE(neighbor.m_client, client(1));
+  QCOMPARE(neighbor.m_position, 0.25f);
+  QVERIFY(graph.hasAnyNeighbor(client(0), Direction::Right));
+  QVERIFY(!graph.hasAnyNeighbor(client(0), Direction::Left));
+  QVERIFY(!graph.hasAnyNeighbor(client(1), Direction::Left));
+  QVERIFY(graph.getNeighbor(client(1), Direction::Left, 0.25f).m_client == nullptr);
+}
+
+void NeighborGraphTests::partialEdge()
+{
+  Config config(nullptr);
+  QVERIFY(config.addScreen("screenA"));
+  QVERIFY(config.addScreen("screenB"));
+  QVERIFY(config.addScreen("screenC"));
+  QVERIFY(config.connect("screenA", Direction::Bottom, 0.0f, 0.5f, "screenB", 0.0f, 1.0f));
+  QVERIFY(config.connect("screenA", Direction::Bottom, 0.5f, 1.0f, "screenC", 0.5f, 1.0f));
+
+  NeighborGraph graph(config, {{"screenA", client(0)}, {"screenB", client(1)}, {"screenC", client(2)}});
+
+  auto neighbor = graph.getNeighbor(client(0), Direction::Bottom, 0.25f);
+  QCOMPARE(neighbor.m_client, client(1));
+  QCOMPARE(neighbor.m_position, 0.5f);
+
+  neighbor = graph.getNeighbor(client(0), Direction::Bottom, 0.75f);
+  QCOMPARE(neighbor.m_client, client(2));
+  QCOMPARE(neighbor.m_position, 0.75f);
+
+  QVERIFY(graph.hasNeighbor(client(0), Direction::Bottom, 0.0f));
+  QVERIFY(!graph.hasNeighbor(client(0), Direction::Bottom, 1.0f));
+}
+
+void NeighborGraphTests::skipsUnconnected()
+{
+  Config config(nullptr);
+  QVERIFY(config.addScreen("screenA"));
+  QVERIFY(config.addScreen("screenB"));
+  QVERIFY(config.addScreen("screenC"));
+  QVERIFY(config.connect("screenA", Direction::Right, 0.0f, 1.0f, "screenB", 0.0f, 1.0f));
+  QVERIFY(config.connect("screenB", Direction::Right, 0.0f, 1.0f, "screenC", 0.0f, 1.0f));
+
+  NeighborGraph graph(config, {{"screenA", client(0)}, {"screenC", client(2)}});
+
+  const auto neighbor = graph.getNeighbor(client(0), Direction::Right, 0.5f);
+  QCOMPARE(neighbor.m_client, client(2));
+  QCOMPARE(neighbor.m_position, 0.5f);
+
+  // unconnected screens still count as configured neighbors
+  QVERIFY(graph.hasNeighbor(client(0), Direction::Right, 0.5f));
+}
+
+void NeighborGraphTests::unconnectedCycle()
+{
+  Config config(nullptr);
+  QVERIFY(config.addScreen("screenA"));
+  QVERIFY(config.addScreen("screenB"));
+  QVERIFY(config.addScreen("screenC"));
+  QVERIFY(config.connect("screenA", Direction::Right, 0.0f, 1.0f, "screenB", 0.0f, 1.0f));
+  QVERIFY(config.connect("screenB", Direction::Right, 0.0f, 1.0f, "screenC", 0.0f, 1.0f));
+  QVERIFY(config.connect("screenC", Direction::Right, 0.0f, 1.0f, "screenB", 0.0f, 1.0f));
+
+  NeighborGraph graph(config, {{"screenA", client(0)}});
+
+  QVERIFY(graph.getNeighbor(client(0), Direction::Right, 0.5f).m_client == nullptr);
+}
+
+void NeighborGraphTests::aliasLinks()
+{
+  Config config(nullptr);
+  QVERIFY(config.addScreen("screenA"));
+  QVERIFY(config.addScreen("screenB"));
+  QVERIFY(config.addAlias("screenB", "aliasB"));
+  QVERIFY(config.connect("screenA", Direction::Top, 0.0f, 1.0f, "aliasB", 0.0f, 1.0f));
+
+  NeighborGraph graph(config, {{"screenA", client(0)}, {"screenB", client(1)}});
+
+  QCOMPARE(graph.getNeighbor(client(0), Direction::Top, 0.5f).m_client, client(1));
+}
+
+QTEST_MAIN(NeighborGraphTests)
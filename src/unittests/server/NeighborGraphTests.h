@@ -0,0 +1,19 @@
+/*
+ * Deskflow -- mouse and keyboard sharing utility
+ * SPDX-FileCopyrightText: (C) 2026 Deskflow Developers
+ * SPDX-License-Identifier: GPL-2.0-only WITH LicenseRef-OpenSSL-Exception
+ */
+
+#include <QTest>
+
+class NeighborGraphTests : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+  void emptyGraph();
+  void connectedNeighbor();
+  void partialEdge();
+  void skipsUnconnected();
+  void unconnectedCycle();
+  void aliasLinks();
+};